@@ -5,12 +5,22 @@
 **  This program is under the terms of the BSD License.
 */
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <triton/api.hpp>
 #include <triton/exceptions.hpp>
 
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <map>
 #include <new>
+#include <vector>
 
 /*!
 
@@ -445,6 +455,13 @@ std::vector<triton::uint8> API::getConcreteMemoryAreaValue(
   return this->arch.getConcreteMemoryAreaValue(baseAddr, size, execCallbacks);
 }
 
+void API::getConcreteMemoryAreaValue(triton::uint64 baseAddr,
+                                     triton::uint8* area, triton::usize size,
+                                     bool execCallbacks) const {
+  this->checkArchitecture();
+  this->arch.getConcreteMemoryAreaValue(baseAddr, area, size, execCallbacks);
+}
+
 triton::uint512 API::getConcreteRegisterValue(const triton::arch::Register& reg,
                                               bool execCallbacks) const {
   this->checkArchitecture();
@@ -508,7 +525,8 @@ void API::initEngines(void) {
   if (this->symbolic == nullptr)
     throw triton::exceptions::API("API::initEngines(): No enough memory.");
 
-  this->solver = new (std::nothrow) triton::engines::solver::SolverEngine();
+  this->solver =
+      new (std::nothrow) triton::engines::solver::SolverEngine(this->modes);
   if (this->solver == nullptr)
     throw triton::exceptions::API("API::initEngines(): No enough memory.");
 
@@ -521,15 +539,23 @@ void API::initEngines(void) {
       &this->arch, this->modes, this->astCtxt, this->symbolic, this->taint);
   if (this->irBuilder == nullptr)
     throw triton::exceptions::API("API::initEngines(): No enough memory.");
+
+  this->interpreter = new (std::nothrow) triton::arch::ConcreteInterpreter(
+      &this->arch, this->modes, this->irBuilder, this->symbolic, this->taint,
+      &this->callbacks);
+  if (this->interpreter == nullptr)
+    throw triton::exceptions::API("API::initEngines(): No enough memory.");
 }
 
 void API::removeEngines(void) {
   if (this->isArchitectureValid()) {
+    delete this->interpreter;
     delete this->irBuilder;
     delete this->solver;
     delete this->symbolic;
     delete this->taint;
 
+    this->interpreter = nullptr;
     this->irBuilder = nullptr;
     this->solver = nullptr;
     this->symbolic = nullptr;
@@ -545,19 +571,39 @@ void API::removeEngines(void) {
 
 void API::reset(void) {
   if (this->isArchitectureValid()) {
+    /* The finalizers may still use the engines */
+    this->removeAllCallbacks();
     this->removeEngines();
     this->initEngines();
     this->clearArchitecture();
-    this->removeAllCallbacks();
   }
 }
 
 bool API::processing(triton::arch::Instruction& inst) {
   this->checkArchitecture();
   this->arch.disassembly(inst);
+  if (this->interpreter->processConcrete(inst))
+    return true;
   return this->irBuilder->buildSemantics(inst);
 }
 
+triton::usize API::runUntil(triton::uint64 addr, triton::usize count) {
+  this->checkArchitecture();
+  return this->interpreter->run(addr, count);
+}
+
+triton::usize
+API::runUntil(const std::function<bool(triton::uint64)>& stop,
+              triton::usize count) {
+  this->checkArchitecture();
+  return this->interpreter->run(stop, count);
+}
+
+triton::usize API::getNativeCount(void) const {
+  this->checkArchitecture();
+  return this->interpreter->getNativeCount();
+}
+
 /* IR builder API
  * =================================================================================
  */
@@ -613,6 +659,14 @@ void API::addCallback(triton::callbacks::symbolicSimplificationCallback cb) {
 
 void API::removeAllCallbacks(void) { this->callbacks.removeAllCallbacks(); }
 
+triton::usize API::addCallbacksFinalizer(const std::function<void(void)>& fn) {
+  return this->callbacks.addFinalizer(fn);
+}
+
+void API::removeCallbacksFinalizer(triton::usize id) {
+  this->callbacks.removeFinalizer(id);
+}
+
 void API::removeCallback(triton::callbacks::getConcreteMemoryValueCallback cb) {
   this->callbacks.removeCallback(cb);
 }
@@ -909,6 +963,67 @@ void API::setConcreteVariableValue(
   this->symbolic->setConcreteVariableValue(symVar, value);
 }
 
+void API::saveState(std::ostream& stream) const {
+  this->checkSymbolic();
+  this->symbolic->saveState(stream);
+}
+
+void API::saveState(const std::string& path) const {
+  std::ofstream stream(path, std::ios::binary);
+
+  if (!stream.is_open())
+    throw triton::exceptions::Os("API::saveState(): Cannot open " + path + ".");
+
+  this->saveState(stream);
+}
+
+void API::loadState(const triton::uint8* data, triton::usize size) {
+  this->checkSymbolic();
+  this->symbolic->loadState(data, size);
+}
+
+void API::loadState(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+  struct stat st;
+  void* addr = nullptr;
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw triton::exceptions::Os("API::loadState(): Cannot open " + path + ".");
+
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    throw triton::exceptions::Os("API::loadState(): Cannot stat " + path +
+                                 " or the file is empty.");
+  }
+
+  addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (addr == MAP_FAILED)
+    throw triton::exceptions::Os("API::loadState(): Cannot mmap " + path + ".");
+
+  try {
+    this->loadState(reinterpret_cast<const triton::uint8*>(addr),
+                    static_cast<triton::usize>(st.st_size));
+  } catch (...) {
+    munmap(addr, st.st_size);
+    throw;
+  }
+
+  munmap(addr, st.st_size);
+#else
+  std::ifstream stream(path, std::ios::binary);
+
+  if (!stream.is_open())
+    throw triton::exceptions::Os("API::loadState(): Cannot open " + path + ".");
+
+  std::vector<triton::uint8> data((std::istreambuf_iterator<char>(stream)),
+                                  std::istreambuf_iterator<char>());
+  this->loadState(data.data(), data.size());
+#endif
+}
+
 const triton::engines::symbolic::SharedSymbolicVariable&
 API::getSymbolicVariableFromId(triton::usize symVarId) const {
   this->checkSymbolic();
@@ -932,6 +1047,18 @@ triton::ast::SharedAbstractNode API::getPathConstraintsAst(void) {
   return this->symbolic->getPathConstraintsAst();
 }
 
+triton::ast::SharedAbstractNode
+API::getPrefixPathConstraintsAst(triton::usize index) {
+  this->checkSymbolic();
+  return this->symbolic->getPrefixPathConstraintsAst(index);
+}
+
+triton::ast::SharedAbstractNode
+API::getNegatedPathConstraintsAst(triton::usize index) {
+  this->checkSymbolic();
+  return this->symbolic->getNegatedPathConstraintsAst(index);
+}
+
 void API::addPathConstraint(
     const triton::arch::Instruction& inst,
     const triton::engines::symbolic::SharedSymbolicExpression& expr) {
@@ -944,6 +1071,18 @@ void API::clearPathConstraints(void) {
   this->symbolic->clearPathConstraints();
 }
 
+void API::setPathConstraintsCompression(triton::uint64 addr,
+                                        triton::usize first,
+                                        triton::usize last) {
+  this->checkSymbolic();
+  this->symbolic->setPathConstraintsCompression(addr, first, last);
+}
+
+void API::removePathConstraintsCompression(triton::uint64 addr) {
+  this->checkSymbolic();
+  this->symbolic->removePathConstraintsCompression(addr);
+}
+
 void API::enableSymbolicEngine(bool flag) {
   this->checkSymbolic();
   this->symbolic->enable(flag);
@@ -999,6 +1138,59 @@ void API::concretizeRegister(const triton::arch::Register& reg) {
   this->symbolic->concretizeRegister(reg);
 }
 
+void API::setMemoryBudget(triton::usize maxBytes) {
+  this->checkSymbolic();
+  this->symbolic->setMemoryBudget(maxBytes);
+}
+
+triton::usize API::getMemoryBudget(void) const {
+  this->checkSymbolic();
+  return this->symbolic->getMemoryBudget();
+}
+
+void API::setMemoryBudgetDepth(triton::uint32 maxDepth) {
+  this->checkSymbolic();
+  this->symbolic->setMemoryBudgetDepth(maxDepth);
+}
+
+triton::uint32 API::getMemoryBudgetDepth(void) const {
+  this->checkSymbolic();
+  return this->symbolic->getMemoryBudgetDepth();
+}
+
+void API::setMemoryBudgetPolicy(
+    triton::engines::symbolic::budget_policy_e policy) {
+  this->checkSymbolic();
+  this->symbolic->setMemoryBudgetPolicy(policy);
+}
+
+triton::engines::symbolic::budget_policy_e
+API::getMemoryBudgetPolicy(void) const {
+  this->checkSymbolic();
+  return this->symbolic->getMemoryBudgetPolicy();
+}
+
+triton::usize API::getMemoryBudgetUsage(void) const {
+  this->checkSymbolic();
+  return this->symbolic->getMemoryBudgetUsage();
+}
+
+void API::enforceMemoryBudget(void) {
+  this->checkSymbolic();
+  this->symbolic->enforceMemoryBudget();
+}
+
+const std::vector<triton::engines::symbolic::BudgetDrop>&
+API::getMemoryBudgetDrops(void) const {
+  this->checkSymbolic();
+  return this->symbolic->getMemoryBudgetDrops();
+}
+
+void API::clearMemoryBudgetDrops(void) {
+  this->checkSymbolic();
+  this->symbolic->clearMemoryBudgetDrops();
+}
+
 std::map<triton::usize, triton::engines::symbolic::SharedSymbolicExpression>
 API::sliceExpressions(
     const triton::engines::symbolic::SharedSymbolicExpression& expr) {
@@ -1006,6 +1198,13 @@ API::sliceExpressions(
   return this->symbolic->sliceExpressions(expr);
 }
 
+std::map<triton::usize, triton::engines::symbolic::SharedSymbolicVariable>
+API::sliceVariables(
+    const triton::engines::symbolic::SharedSymbolicExpression& expr) const {
+  this->checkSymbolic();
+  return this->symbolic->sliceVariables(expr);
+}
+
 std::list<triton::engines::symbolic::SharedSymbolicExpression>
 API::getTaintedSymbolicExpressions(void) const {
   this->checkSymbolic();
@@ -1019,6 +1218,12 @@ API::getSymbolicExpressions(void) const {
   return this->symbolic->getSymbolicExpressions();
 }
 
+const triton::engines::symbolic::SymbolicExpressionTable&
+API::getSymbolicExpressionTable(void) const {
+  this->checkSymbolic();
+  return this->symbolic->getSymbolicExpressionTable();
+}
+
 const std::unordered_map<triton::usize,
                          triton::engines::symbolic::SharedSymbolicVariable>&
 API::getSymbolicVariables(void) const {
@@ -1064,22 +1269,89 @@ bool API::isSolverValid(void) const {
   return this->solver->isValid();
 }
 
-std::map<triton::uint32, triton::engines::solver::SolverModel> API::getModel(
-    const triton::ast::SharedAbstractNode& node) const {
+std::map<triton::uint32, triton::engines::solver::SolverModel>
+API::getModel(const triton::ast::SharedAbstractNode& node,
+              triton::engines::solver::status_e* status,
+              triton::uint32 timeout) const {
   this->checkSolver();
-  return this->solver->getModel(node);
+  return this->solver->getModel(node, status, timeout);
 }
 
 std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>>
 API::getModels(const triton::ast::SharedAbstractNode& node,
-               triton::uint32 limit) const {
+               triton::uint32 limit, triton::engines::solver::status_e* status,
+               triton::uint32 timeout) const {
+  this->checkSolver();
+  return this->solver->getModels(node, limit, status, timeout);
+}
+
+bool API::isSat(const triton::ast::SharedAbstractNode& node,
+                triton::engines::solver::status_e* status,
+                triton::uint32 timeout) const {
+  this->checkSolver();
+  return this->solver->isSat(node, status, timeout);
+}
+
+void API::enumerateModels(
+    const triton::ast::SharedAbstractNode& node,
+    const std::vector<triton::engines::symbolic::SharedSymbolicVariable>&
+        projection,
+    const triton::engines::solver::ModelCallback& callback,
+    triton::uint32 limit, triton::uint32 threads,
+    triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+  this->checkSolver();
+  this->solver->enumerateModels(node, projection, callback, limit, threads,
+                                status, timeout);
+}
+
+void API::setSolverTimeout(triton::uint32 ms) {
+  this->checkSolver();
+  this->solver->setTimeout(ms);
+}
+
+void API::setSolverResourceLimit(triton::uint32 rlimit) {
+  this->checkSolver();
+  this->solver->setResourceLimit(rlimit);
+}
+
+void API::setSolverMemoryLimit(triton::uint32 mb) {
+  this->checkSolver();
+  this->solver->setMemoryLimit(mb);
+}
+
+void API::setSolverPool(triton::usize workers, triton::uint32 timeout,
+                        triton::usize maxQueries) {
+  this->checkSolver();
+  this->solver->setSolverPool(workers, timeout, maxQueries);
+}
+
+std::vector<triton::uint32> API::getSolverPoolWorkers(void) const {
+  this->checkSolver();
+  return this->solver->getSolverPoolWorkers();
+}
+
+triton::usize API::submitQuery(const triton::ast::SharedAbstractNode& node,
+                               triton::uint32 limit, triton::uint32 timeout) {
+  this->checkSolver();
+  return this->solver->submitQuery(node, limit, timeout);
+}
+
+bool API::pollQuery(triton::usize ticket) const {
+  this->checkSolver();
+  return this->solver->pollQuery(ticket);
+}
+
+triton::engines::solver::status_e API::waitQuery(
+    triton::usize ticket,
+    std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>>*
+        models) {
   this->checkSolver();
-  return this->solver->getModels(node, limit);
+  return this->solver->waitQuery(ticket, models);
 }
 
-bool API::isSat(const triton::ast::SharedAbstractNode& node) const {
+bool API::cancelQuery(triton::usize ticket) {
   this->checkSolver();
-  return this->solver->isSat(node);
+  return this->solver->cancelQuery(ticket);
 }
 
 triton::uint512 API::evaluateAstViaZ3(
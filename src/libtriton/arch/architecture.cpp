@@ -225,6 +225,13 @@ namespace triton {
     }
 
 
+    void Architecture::getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::uint8* area, triton::usize size, bool execCallbacks) const {
+      if (!this->cpu)
+        throw triton::exceptions::Architecture("Architecture::getConcreteMemoryAreaValue(): You must define an architecture.");
+      this->cpu->getConcreteMemoryAreaValue(baseAddr, area, size, execCallbacks);
+    }
+
+
     triton::uint512 Architecture::getConcreteRegisterValue(const triton::arch::Register& reg, bool execCallbacks) const {
       if (!this->cpu)
         throw triton::exceptions::Architecture("Architecture::getConcreteRegisterValue(): You must define an architecture.");
@@ -232,17 +239,17 @@ namespace triton {
     }
 
 
-    void Architecture::setConcreteMemoryValue(triton::uint64 addr, triton::uint8 value) {
+    void Architecture::setConcreteMemoryValue(triton::uint64 addr, triton::uint8 value, bool execCallbacks) {
       if (!this->cpu)
         throw triton::exceptions::Architecture("Architecture::setConcreteMemoryValue(): You must define an architecture.");
-      this->cpu->setConcreteMemoryValue(addr, value);
+      this->cpu->setConcreteMemoryValue(addr, value, execCallbacks);
     }
 
 
-    void Architecture::setConcreteMemoryValue(const triton::arch::MemoryAccess& mem, const triton::uint512& value) {
+    void Architecture::setConcreteMemoryValue(const triton::arch::MemoryAccess& mem, const triton::uint512& value, bool execCallbacks) {
       if (!this->cpu)
         throw triton::exceptions::Architecture("Architecture::setConcreteMemoryValue(): You must define an architecture.");
-      this->cpu->setConcreteMemoryValue(mem, value);
+      this->cpu->setConcreteMemoryValue(mem, value, execCallbacks);
     }
 
 
@@ -260,10 +267,10 @@ namespace triton {
     }
 
 
-    void Architecture::setConcreteRegisterValue(const triton::arch::Register& reg, const triton::uint512& value) {
+    void Architecture::setConcreteRegisterValue(const triton::arch::Register& reg, const triton::uint512& value, bool execCallbacks) {
       if (!this->cpu)
         throw triton::exceptions::Architecture("Architecture::setConcreteRegisterValue(): You must define an architecture.");
-      this->cpu->setConcreteRegisterValue(reg, value);
+      this->cpu->setConcreteRegisterValue(reg, value, execCallbacks);
     }
 
 
@@ -0,0 +1,1125 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include <triton/aarch64Specifications.hpp>
+#include <triton/concreteInterpreter.hpp>
+#include <triton/cpuSize.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/x86Specifications.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+
+    namespace {
+      //! The number of bytes fetched to decode an instruction.
+      const triton::uint32 FETCH_SIZE = 16;
+
+      /* Returns the mask of a `bits` bits vector */
+      triton::uint64 mask(triton::uint32 bits) {
+        return (bits >= QWORD_SIZE_BIT) ? ~static_cast<triton::uint64>(0) : ((static_cast<triton::uint64>(1) << bits) - 1);
+      }
+
+      /* Returns the bit `n` of a value, 0 if `n` is out of the value */
+      bool bit(triton::uint64 value, triton::uint64 n) {
+        return (n < QWORD_SIZE_BIT) ? ((value >> n) & 1) : false;
+      }
+
+      /* Returns the most significant bit of a `bits` bits value */
+      bool msb(triton::uint64 value, triton::uint32 bits) {
+        return bit(value, bits - 1);
+      }
+
+      /* Sign extends a `from` bits value to `to` bits */
+      triton::uint64 sx(triton::uint64 value, triton::uint32 from, triton::uint32 to) {
+        if (from < QWORD_SIZE_BIT && msb(value, from))
+          value |= ~mask(from);
+        return value & mask(to);
+      }
+
+      /* Returns true if the low byte of a value has an even number of bits set */
+      bool parity(triton::uint64 value) {
+        triton::uint8 b = static_cast<triton::uint8>(value);
+        b ^= b >> 4;
+        b ^= b >> 2;
+        b ^= b >> 1;
+        return !(b & 1);
+      }
+    };
+
+
+    ConcreteInterpreter::ConcreteInterpreter(triton::arch::Architecture* architecture,
+                                             triton::modes::Modes& modes,
+                                             triton::arch::IrBuilder* irBuilder,
+                                             triton::engines::symbolic::SymbolicEngine* symbolicEngine,
+                                             triton::engines::taint::TaintEngine* taintEngine,
+                                             triton::callbacks::Callbacks* callbacks)
+      : modes(modes) {
+
+      if (architecture == nullptr)
+        throw triton::exceptions::ConcreteInterpreter("ConcreteInterpreter::ConcreteInterpreter(): The architecture API must be defined.");
+
+      if (irBuilder == nullptr)
+        throw triton::exceptions::ConcreteInterpreter("ConcreteInterpreter::ConcreteInterpreter(): The IR builder API must be defined.");
+
+      if (symbolicEngine == nullptr)
+        throw triton::exceptions::ConcreteInterpreter("ConcreteInterpreter::ConcreteInterpreter(): The symbolic engine API must be defined.");
+
+      if (taintEngine == nullptr)
+        throw triton::exceptions::ConcreteInterpreter("ConcreteInterpreter::ConcreteInterpreter(): The taint engine API must be defined.");
+
+      this->architecture   = architecture;
+      this->irBuilder      = irBuilder;
+      this->symbolicEngine = symbolicEngine;
+      this->taintEngine    = taintEngine;
+      this->callbacks      = callbacks;
+      this->nativeCount    = 0;
+      this->fallbackCount  = 0;
+
+      this->journal.enabled        = false;
+      this->journal.execCallbacks  = true;
+      this->journal.conditionTaken = false;
+    }
+
+
+    const triton::arch::Instruction& ConcreteInterpreter::fetch(triton::uint64 addr) {
+      auto it = this->cache.find(addr);
+
+      /* The cached instruction is used as long as its bytes are unchanged */
+      if (it != this->cache.end()) {
+        triton::uint8 bytes[FETCH_SIZE];
+        triton::uint32 size = it->second.getSize();
+        this->architecture->getConcreteMemoryAreaValue(addr, bytes, size, false);
+        if (std::memcmp(bytes, it->second.getOpcode(), size) == 0)
+          return it->second;
+        this->cache.erase(it);
+      }
+
+      triton::uint8 opcode[FETCH_SIZE];
+      this->architecture->getConcreteMemoryAreaValue(addr, opcode, FETCH_SIZE);
+
+      triton::arch::Instruction inst(opcode, FETCH_SIZE);
+      inst.setAddress(addr);
+      this->architecture->disassembly(inst);
+
+      return this->cache.emplace(addr, inst).first->second;
+    }
+
+
+    bool ConcreteInterpreter::isSupported(const triton::arch::OperandWrapper& op) const {
+      const triton::arch::Register* regs[2] = {nullptr, nullptr};
+
+      switch (op.getType()) {
+        case triton::arch::OP_IMM: {
+          const triton::arch::Immediate& imm = op.getConstImmediate();
+          return imm.getBitSize() <= QWORD_SIZE_BIT &&
+                 imm.getShiftType() == triton::arch::aarch64::ID_SHIFT_INVALID &&
+                 imm.getExtendType() == triton::arch::aarch64::ID_EXTEND_INVALID;
+        }
+
+        case triton::arch::OP_REG:
+          regs[0] = &op.getConstRegister();
+          break;
+
+        case triton::arch::OP_MEM: {
+          const triton::arch::MemoryAccess& mem = op.getConstMemory();
+          if (mem.getSize() > QWORD_SIZE)
+            return false;
+          if (this->architecture->isRegisterValid(mem.getConstBaseRegister()))
+            regs[0] = &mem.getConstBaseRegister();
+          if (this->architecture->isRegisterValid(mem.getConstIndexRegister()))
+            regs[1] = &mem.getConstIndexRegister();
+          break;
+        }
+
+        default:
+          return false;
+      }
+
+      for (const triton::arch::Register* reg : regs) {
+        if (reg == nullptr)
+          continue;
+
+        triton::arch::register_e id = reg->getId();
+
+        /* Only the general purpose registers are handled, without shift nor extension */
+        if (reg->getShiftType() != triton::arch::aarch64::ID_SHIFT_INVALID || reg->getExtendType() != triton::arch::aarch64::ID_EXTEND_INVALID)
+          return false;
+
+        switch (this->architecture->getArchitecture()) {
+          case triton::arch::ARCH_X86:
+          case triton::arch::ARCH_X86_64:
+            if (id < triton::arch::ID_REG_X86_RAX || id > triton::arch::ID_REG_X86_IP)
+              return false;
+            break;
+
+          case triton::arch::ARCH_AARCH64:
+            if (id < triton::arch::ID_REG_AARCH64_X0 || id > triton::arch::ID_REG_AARCH64_WZR || id == triton::arch::ID_REG_AARCH64_SPSR)
+              return false;
+            break;
+
+          default:
+            return false;
+        }
+      }
+
+      return true;
+    }
+
+
+    triton::uint64 ConcreteInterpreter::getEffectiveAddress(const triton::arch::MemoryAccess& mem) {
+      const triton::arch::Register& base  = mem.getConstBaseRegister();
+      const triton::arch::Register& index = mem.getConstIndexRegister();
+      const triton::arch::Register& seg   = mem.getConstSegmentRegister();
+      triton::uint64 segmentValue         = (this->architecture->isRegisterValid(seg) ? this->getRegister(seg) : 0);
+      triton::uint32 bitSize              = (this->architecture->isRegisterValid(index) ? index.getBitSize() :
+                                              (this->architecture->isRegisterValid(base) ? base.getBitSize() :
+                                                (mem.getConstDisplacement().getBitSize() ? mem.getConstDisplacement().getBitSize() :
+                                                  this->architecture->gprBitSize()
+                                                )
+                                              )
+                                            );
+
+      /* Same computation as SymbolicEngine::initLeaAst() -> ((pc + base) + (index * scale) + disp) */
+      triton::uint64 lea = (mem.getPcRelative() ? mem.getPcRelative() : (this->architecture->isRegisterValid(base) ? this->getRegister(base) : 0));
+      if (this->architecture->isRegisterValid(index))
+        lea += this->getRegister(index) * mem.getConstScale().getValue();
+      lea = (lea + mem.getConstDisplacement().getValue()) & mask(bitSize);
+
+      /* Use segments as base address instead of selector into the GDT. */
+      if (segmentValue)
+        lea = (segmentValue + sx(lea, bitSize, seg.getBitSize())) & mask(seg.getBitSize());
+
+      return lea;
+    }
+
+
+    triton::uint64 ConcreteInterpreter::getRegister(const triton::arch::Register& reg) {
+      if (this->journal.enabled)
+        this->journal.readRegisters.push_back(reg);
+      return this->architecture->getConcreteRegisterValue(reg, this->journal.execCallbacks).convert_to<triton::uint64>();
+    }
+
+
+    void ConcreteInterpreter::setRegister(const triton::arch::Register& reg, triton::uint64 value) {
+      const triton::arch::Register& parent = this->architecture->getParentRegister(reg);
+
+      /* Same rules as SymbolicEngine::createSymbolicRegisterExpression() */
+      if (!parent.isMutable())
+        return;
+
+      value &= mask(reg.getBitSize());
+
+      /* 8 and 16 bits registers keep the rest of their parent, wider ones are zero extended */
+      bool partial                         = (reg.getSize() == BYTE_SIZE || reg.getSize() == WORD_SIZE) && reg.getId() != parent.getId();
+      const triton::arch::Register& target = (partial ? reg : parent);
+
+      if (this->journal.enabled) {
+        /* The expression of a partial write is built on the rest of the parent */
+        if (partial)
+          this->journal.readRegisters.push_back(parent);
+        this->journal.writtenRegisters.push_back(std::make_pair(target, this->architecture->getConcreteRegisterValue(target, false)));
+      }
+
+      this->architecture->setConcreteRegisterValue(target, value, this->journal.execCallbacks);
+    }
+
+
+    triton::uint64 ConcreteInterpreter::read(const triton::arch::OperandWrapper& op, triton::uint64 addr) {
+      switch (op.getType()) {
+        case triton::arch::OP_IMM:
+          return op.getConstImmediate().getValue();
+        case triton::arch::OP_REG:
+          return this->getRegister(op.getConstRegister());
+        case triton::arch::OP_MEM:
+          return this->load(addr, op.getSize());
+        default:
+          throw triton::exceptions::ConcreteInterpreter("ConcreteInterpreter::read(): Invalid operand.");
+      }
+    }
+
+
+    void ConcreteInterpreter::write(const triton::arch::OperandWrapper& op, triton::uint64 addr, triton::uint64 value) {
+      switch (op.getType()) {
+        case triton::arch::OP_REG:
+          this->setRegister(op.getConstRegister(), value);
+          break;
+        case triton::arch::OP_MEM:
+          this->store(addr, op.getSize(), value);
+          break;
+        default:
+          throw triton::exceptions::ConcreteInterpreter("ConcreteInterpreter::write(): Invalid operand.");
+      }
+    }
+
+
+    triton::uint64 ConcreteInterpreter::load(triton::uint64 addr, triton::uint32 size) {
+      triton::arch::MemoryAccess mem(addr, size);
+
+      if (this->journal.enabled)
+        this->journal.loadAccess.push_back(mem);
+
+      return this->architecture->getConcreteMemoryValue(mem, this->journal.execCallbacks).convert_to<triton::uint64>();
+    }
+
+
+    void ConcreteInterpreter::store(triton::uint64 addr, triton::uint32 size, triton::uint64 value) {
+      triton::arch::MemoryAccess mem(addr, size);
+
+      if (this->journal.enabled)
+        this->journal.storeAccess.push_back(std::make_pair(mem, this->architecture->getConcreteMemoryValue(mem, false)));
+
+      this->architecture->setConcreteMemoryValue(mem, value & mask(mem.getBitSize()), this->journal.execCallbacks);
+    }
+
+
+    bool ConcreteInterpreter::getFlag(triton::arch::register_e flag) {
+      return this->getRegister(this->architecture->getRegister(flag)) != 0;
+    }
+
+
+    void ConcreteInterpreter::setFlag(triton::arch::register_e flag, bool value) {
+      this->setRegister(this->architecture->getRegister(flag), value);
+    }
+
+
+    void ConcreteInterpreter::undefineFlag(triton::arch::register_e flag) {
+      if (this->journal.enabled)
+        this->journal.undefinedRegisters.push_back(this->architecture->getRegister(flag));
+    }
+
+
+    /* The restore is not an access of the program, the callbacks are not executed */
+    void ConcreteInterpreter::undo(void) {
+      for (auto it = this->journal.storeAccess.rbegin(); it != this->journal.storeAccess.rend(); it++)
+        this->architecture->setConcreteMemoryValue(it->first, it->second, false);
+
+      for (auto it = this->journal.writtenRegisters.rbegin(); it != this->journal.writtenRegisters.rend(); it++)
+        this->architecture->setConcreteRegisterValue(it->first, it->second, false);
+    }
+
+
+    bool ConcreteInterpreter::executeJournaled(const triton::arch::Instruction& inst, bool execCallbacks) {
+      this->journal.enabled        = true;
+      this->journal.execCallbacks  = execCallbacks;
+      this->journal.conditionTaken = false;
+      this->journal.addresses.clear();
+      this->journal.readRegisters.clear();
+      this->journal.loadAccess.clear();
+      this->journal.writtenRegisters.clear();
+      this->journal.storeAccess.clear();
+      this->journal.undefinedRegisters.clear();
+
+      bool executed = this->execute(inst);
+      this->journal.enabled       = false;
+      this->journal.execCallbacks = true;
+
+      if (!executed)
+        return false;
+
+      /*
+       * Any symbolized read would have produced a symbolized expression, and
+       * any tainted read would have been spread by the semantics.
+       */
+      bool tainted    = this->taintEngine->isEnabled();
+      bool symbolized = false;
+
+      for (const auto& reg : this->journal.readRegisters) {
+        symbolized = symbolized || this->symbolicEngine->isRegisterSymbolized(reg);
+        symbolized = symbolized || (tainted && this->taintEngine->isRegisterTainted(reg));
+      }
+
+      for (const auto& mem : this->journal.loadAccess) {
+        symbolized = symbolized || this->symbolicEngine->isMemorySymbolized(mem);
+        symbolized = symbolized || (tainted && this->taintEngine->isMemoryTainted(mem));
+      }
+
+      if (symbolized) {
+        this->undo();
+        return false;
+      }
+
+      return true;
+    }
+
+
+    bool ConcreteInterpreter::execute(const triton::arch::Instruction& inst) {
+      switch (this->architecture->getArchitecture()) {
+        case triton::arch::ARCH_X86:
+        case triton::arch::ARCH_X86_64:
+          return this->executeX86(inst);
+
+        case triton::arch::ARCH_AARCH64:
+          return this->executeAArch64(inst);
+
+        default:
+          return false;
+      }
+    }
+
+
+    bool ConcreteInterpreter::executeX86(const triton::arch::Instruction& inst) {
+      using namespace triton::arch::x86;
+
+      const std::vector<triton::arch::OperandWrapper>& ops = inst.operands;
+      const triton::arch::Register& stack                 = this->architecture->getStackPointer();
+      triton::uint64 addrs[3]                             = {0, 0, 0};
+      triton::uint64 pc                                   = inst.getNextAddress();
+      bool taken                                          = false;
+
+      /* REP prefixes loop on the instruction and LOCK is left to the semantics */
+      if (inst.getPrefix() != ID_PREFIX_INVALID || ops.size() > 3)
+        return false;
+
+      /* Memory operands are resolved before any side effect, like in IrBuilder::buildSemantics() */
+      for (triton::usize i = 0; i < ops.size(); i++) {
+        if (!this->isSupported(ops[i]))
+          return false;
+        if (ops[i].getType() == triton::arch::OP_MEM)
+          addrs[i] = this->getEffectiveAddress(ops[i].getConstMemory());
+      }
+
+      /* The condition of Jcc, CMOVcc and SETcc. Every flag of a condition is read, like in its AST */
+      switch (inst.getType()) {
+        case ID_INS_JA:  case ID_INS_CMOVA:  case ID_INS_SETA:  { bool cf = this->getFlag(ID_REG_X86_CF); bool zf = this->getFlag(ID_REG_X86_ZF); taken = !cf && !zf; break; }
+        case ID_INS_JAE: case ID_INS_CMOVAE: case ID_INS_SETAE: taken = !this->getFlag(ID_REG_X86_CF); break;
+        case ID_INS_JB:  case ID_INS_CMOVB:  case ID_INS_SETB:  taken = this->getFlag(ID_REG_X86_CF); break;
+        case ID_INS_JBE: case ID_INS_CMOVBE: case ID_INS_SETBE: { bool cf = this->getFlag(ID_REG_X86_CF); bool zf = this->getFlag(ID_REG_X86_ZF); taken = cf || zf; break; }
+        case ID_INS_JE:  case ID_INS_CMOVE:  case ID_INS_SETE:  taken = this->getFlag(ID_REG_X86_ZF); break;
+        case ID_INS_JNE: case ID_INS_CMOVNE: case ID_INS_SETNE: taken = !this->getFlag(ID_REG_X86_ZF); break;
+        case ID_INS_JG:  case ID_INS_CMOVG:  case ID_INS_SETG:  { bool zf = this->getFlag(ID_REG_X86_ZF); bool sf = this->getFlag(ID_REG_X86_SF); bool of = this->getFlag(ID_REG_X86_OF); taken = !zf && (sf == of); break; }
+        case ID_INS_JGE: case ID_INS_CMOVGE: case ID_INS_SETGE: taken = (this->getFlag(ID_REG_X86_SF) == this->getFlag(ID_REG_X86_OF)); break;
+        case ID_INS_JL:  case ID_INS_CMOVL:  case ID_INS_SETL:  taken = (this->getFlag(ID_REG_X86_SF) != this->getFlag(ID_REG_X86_OF)); break;
+        case ID_INS_JLE: case ID_INS_CMOVLE: case ID_INS_SETLE: { bool zf = this->getFlag(ID_REG_X86_ZF); bool sf = this->getFlag(ID_REG_X86_SF); bool of = this->getFlag(ID_REG_X86_OF); taken = zf || (sf != of); break; }
+        case ID_INS_JNO: case ID_INS_CMOVNO: case ID_INS_SETNO: taken = !this->getFlag(ID_REG_X86_OF); break;
+        case ID_INS_JNP: case ID_INS_CMOVNP: case ID_INS_SETNP: taken = !this->getFlag(ID_REG_X86_PF); break;
+        case ID_INS_JNS: case ID_INS_CMOVNS: case ID_INS_SETNS: taken = !this->getFlag(ID_REG_X86_SF); break;
+        case ID_INS_JO:  case ID_INS_CMOVO:  case ID_INS_SETO:  taken = this->getFlag(ID_REG_X86_OF); break;
+        case ID_INS_JP:  case ID_INS_CMOVP:  case ID_INS_SETP:  taken = this->getFlag(ID_REG_X86_PF); break;
+        case ID_INS_JS:  case ID_INS_CMOVS:  case ID_INS_SETS:  taken = this->getFlag(ID_REG_X86_SF); break;
+        default:
+          break;
+      }
+
+      /* Sets PF, SF and ZF according to a result */
+      auto setResultFlags = [this](triton::uint64 res, triton::uint32 size) {
+        this->setFlag(ID_REG_X86_PF, parity(res));
+        this->setFlag(ID_REG_X86_SF, msb(res, size));
+        this->setFlag(ID_REG_X86_ZF, res == 0);
+      };
+
+      switch (inst.getType()) {
+        case ID_INS_NOP:
+          break;
+
+        case ID_INS_MOV:
+        case ID_INS_MOVZX: {
+          if (ops.size() != 2)
+            return false;
+          this->write(ops[0], addrs[0], this->read(ops[1], addrs[1]));
+          break;
+        }
+
+        case ID_INS_MOVSX:
+        case ID_INS_MOVSXD: {
+          if (ops.size() != 2)
+            return false;
+          this->write(ops[0], addrs[0], sx(this->read(ops[1], addrs[1]), ops[1].getBitSize(), ops[0].getBitSize()));
+          break;
+        }
+
+        case ID_INS_LEA: {
+          if (ops.size() != 2 || ops[0].getType() != triton::arch::OP_REG || ops[1].getType() != triton::arch::OP_MEM)
+            return false;
+
+          const triton::arch::MemoryAccess& mem = ops[1].getConstMemory();
+          const triton::arch::Register& base    = mem.getConstBaseRegister();
+          const triton::arch::Register& index   = mem.getConstIndexRegister();
+          const triton::arch::Register& dst     = ops[0].getConstRegister();
+          triton::uint32 leaSize                = (this->architecture->isRegisterValid(base) ? base.getBitSize() :
+                                                    (this->architecture->isRegisterValid(index) ? index.getBitSize() : mem.getConstDisplacement().getBitSize()));
+
+          /* Same computation as x86Semantics::lea_s() -> disp + base + index * scale */
+          triton::uint64 ea = mem.getConstDisplacement().getValue();
+          if (this->architecture->isRegisterValid(base)) {
+            ea += this->getRegister(base);
+            if (this->architecture->getParentRegister(base) == this->architecture->getProgramCounter())
+              ea += inst.getSize();
+          }
+          if (this->architecture->isRegisterValid(index))
+            ea += this->getRegister(index) * mem.getConstScale().getValue();
+
+          this->setRegister(dst, ea & mask(std::min(leaSize, dst.getBitSize())));
+          break;
+        }
+
+        case ID_INS_ADD:
+        case ID_INS_SUB:
+        case ID_INS_CMP: {
+          if (ops.size() != 2)
+            return false;
+
+          triton::uint32 size = ops[0].getBitSize();
+          triton::uint64 a    = this->read(ops[0], addrs[0]);
+          triton::uint64 b    = this->read(ops[1], addrs[1]);
+          triton::uint64 res  = 0;
+
+          if (inst.getType() == ID_INS_CMP)
+            b = sx(b, ops[1].getBitSize(), size);
+
+          if (inst.getType() == ID_INS_ADD) {
+            res = (a + b) & mask(size);
+            this->setFlag(ID_REG_X86_CF, msb((a & b) ^ ((a ^ b ^ res) & (a ^ b)), size));
+            this->setFlag(ID_REG_X86_OF, msb((a ^ ~b) & (a ^ res), size));
+          }
+          else {
+            res = (a - b) & mask(size);
+            this->setFlag(ID_REG_X86_CF, msb((a ^ b ^ res) ^ ((a ^ res) & (a ^ b)), size));
+            this->setFlag(ID_REG_X86_OF, msb((a ^ b) & (a ^ res), size));
+          }
+
+          this->setFlag(ID_REG_X86_AF, ((a ^ b ^ res) & 0x10) != 0);
+          setResultFlags(res, size);
+
+          if (inst.getType() != ID_INS_CMP)
+            this->write(ops[0], addrs[0], res);
+          break;
+        }
+
+        case ID_INS_AND:
+        case ID_INS_OR:
+        case ID_INS_XOR:
+        case ID_INS_TEST: {
+          if (ops.size() != 2)
+            return false;
+
+          triton::uint32 size = ops[0].getBitSize();
+          triton::uint64 a    = this->read(ops[0], addrs[0]);
+          triton::uint64 b    = this->read(ops[1], addrs[1]);
+          triton::uint64 res  = 0;
+
+          switch (inst.getType()) {
+            case ID_INS_OR:  res = a | b; break;
+            case ID_INS_XOR: res = a ^ b; break;
+            default:         res = a & b; break;
+          }
+          res &= mask(size);
+
+          /* AF is undefined and keeps its value */
+          this->undefineFlag(ID_REG_X86_AF);
+          this->setFlag(ID_REG_X86_CF, false);
+          this->setFlag(ID_REG_X86_OF, false);
+          setResultFlags(res, size);
+
+          if (inst.getType() != ID_INS_TEST)
+            this->write(ops[0], addrs[0], res);
+          break;
+        }
+
+        case ID_INS_INC:
+        case ID_INS_DEC: {
+          if (ops.size() != 1)
+            return false;
+
+          triton::uint32 size = ops[0].getBitSize();
+          triton::uint64 a    = this->read(ops[0], addrs[0]);
+          triton::uint64 b    = 1;
+          triton::uint64 res  = 0;
+
+          /* CF is not affected */
+          if (inst.getType() == ID_INS_INC) {
+            res = (a + b) & mask(size);
+            this->setFlag(ID_REG_X86_OF, msb((a ^ ~b) & (a ^ res), size));
+          }
+          else {
+            res = (a - b) & mask(size);
+            this->setFlag(ID_REG_X86_OF, msb((a ^ b) & (a ^ res), size));
+          }
+
+          this->setFlag(ID_REG_X86_AF, ((a ^ b ^ res) & 0x10) != 0);
+          setResultFlags(res, size);
+          this->write(ops[0], addrs[0], res);
+          break;
+        }
+
+        case ID_INS_NEG: {
+          if (ops.size() != 1)
+            return false;
+
+          triton::uint32 size = ops[0].getBitSize();
+          triton::uint64 a    = this->read(ops[0], addrs[0]);
+          triton::uint64 res  = (0 - a) & mask(size);
+
+          this->setFlag(ID_REG_X86_AF, ((a ^ res) & 0x10) != 0);
+          this->setFlag(ID_REG_X86_CF, a != 0);
+          this->setFlag(ID_REG_X86_OF, msb(res & a, size));
+          setResultFlags(res, size);
+          this->write(ops[0], addrs[0], res);
+          break;
+        }
+
+        case ID_INS_NOT: {
+          if (ops.size() != 1)
+            return false;
+          this->write(ops[0], addrs[0], ~this->read(ops[0], addrs[0]));
+          break;
+        }
+
+        case ID_INS_SHL:
+        case ID_INS_SAL:
+        case ID_INS_SHR:
+        case ID_INS_SAR: {
+          if (ops.size() != 2)
+            return false;
+
+          triton::uint32 size  = ops[0].getBitSize();
+          triton::uint64 a     = this->read(ops[0], addrs[0]);
+          triton::uint64 count = this->read(ops[1], addrs[1]);
+          triton::uint64 n     = count & ((size == QWORD_SIZE_BIT) ? (QWORD_SIZE_BIT - 1) : (DWORD_SIZE_BIT - 1));
+          triton::uint64 res   = 0;
+          bool cf              = false;
+          bool of              = false;
+
+          /* The flag ASTs keep the previous flags when the count is zero */
+          if (this->journal.enabled) {
+            this->getFlag(ID_REG_X86_CF);
+            this->getFlag(ID_REG_X86_OF);
+            this->getFlag(ID_REG_X86_PF);
+            this->getFlag(ID_REG_X86_SF);
+            this->getFlag(ID_REG_X86_ZF);
+          }
+
+          /* Same flags as x86Semantics::{cf,of}{Shl,Shr,Sar}_s(), count larger than the size included */
+          switch (inst.getType()) {
+            case ID_INS_SHR:
+              res = (n >= size) ? 0 : (a >> n);
+              cf  = bit(a, n - 1);
+              of  = msb(a, size);
+              break;
+
+            case ID_INS_SAR:
+              res = (n >= size) ? (msb(a, size) ? mask(size) : 0) : (static_cast<triton::uint64>(static_cast<triton::sint64>(sx(a, size, QWORD_SIZE_BIT)) >> n) & mask(size));
+              cf  = (n > size) ? msb(a, size) : bit(a, n - 1);
+              of  = false;
+              break;
+
+            default:
+              res = (n >= size) ? 0 : ((a << n) & mask(size));
+              cf  = (n <= size) ? bit(a, size - n) : false;
+              of  = msb(a, size) ^ bit(a, size - 2);
+              break;
+          }
+
+          this->write(ops[0], addrs[0], res);
+
+          if (n != 0) {
+            this->setFlag(ID_REG_X86_CF, cf);
+            if (n == 1)
+              this->setFlag(ID_REG_X86_OF, of);
+            setResultFlags(res, size);
+          }
+
+          /* Same undefined flags as the semantics */
+          if (n != 0)
+            this->undefineFlag(ID_REG_X86_AF);
+          if (inst.getType() != ID_INS_SAR && count > size)
+            this->undefineFlag(ID_REG_X86_CF);
+          if (n > 1)
+            this->undefineFlag(ID_REG_X86_OF);
+          break;
+        }
+
+        case ID_INS_PUSH: {
+          if (ops.size() != 1)
+            return false;
+
+          /* If it's an immediate source, the memory access is always based on the arch size */
+          triton::uint32 size  = (ops[0].getType() == triton::arch::OP_IMM) ? stack.getSize() : ops[0].getSize();
+          triton::uint64 value = this->read(ops[0], addrs[0]);
+          triton::uint64 sp    = (this->getRegister(stack) - size) & mask(stack.getBitSize());
+
+          this->setRegister(stack, sp);
+          this->store(sp, size, value);
+          break;
+        }
+
+        case ID_INS_POP: {
+          if (ops.size() != 1)
+            return false;
+
+          triton::uint32 size  = ops[0].getSize();
+          triton::uint64 sp    = this->getRegister(stack);
+          triton::uint64 value = this->load(sp, size);
+          bool stackRelative   = false;
+
+          /* The effective address of a destination based on the stack pointer is computed after the increment */
+          if (ops[0].getType() == triton::arch::OP_MEM) {
+            if (this->architecture->getParentRegister(ops[0].getConstMemory().getConstBaseRegister()) == stack) {
+              this->setRegister(stack, sp + size);
+              addrs[0] = this->getEffectiveAddress(ops[0].getConstMemory());
+              stackRelative = true;
+            }
+          }
+          /* Don't increment SP if the destination register is SP */
+          else if (ops[0].getType() == triton::arch::OP_REG) {
+            if (this->architecture->getParentRegister(ops[0].getConstRegister()) == stack)
+              stackRelative = true;
+          }
+
+          this->write(ops[0], addrs[0], value);
+
+          if (!stackRelative)
+            this->setRegister(stack, this->getRegister(stack) + size);
+          break;
+        }
+
+        case ID_INS_CALL: {
+          if (ops.size() != 1)
+            return false;
+
+          triton::uint64 sp = (this->getRegister(stack) - stack.getSize()) & mask(stack.getBitSize());
+          this->setRegister(stack, sp);
+
+          pc = this->read(ops[0], addrs[0]);
+          this->store(sp, stack.getSize(), inst.getNextAddress());
+          break;
+        }
+
+        case ID_INS_RET: {
+          if (ops.size() > 1 || (ops.size() == 1 && ops[0].getType() != triton::arch::OP_IMM))
+            return false;
+
+          triton::uint64 sp = this->getRegister(stack);
+
+          pc = this->load(sp, stack.getSize());
+          sp += stack.getSize();
+          if (ops.size() == 1)
+            sp += static_cast<triton::uint32>(ops[0].getConstImmediate().getValue());
+
+          this->setRegister(stack, sp);
+          break;
+        }
+
+        case ID_INS_LEAVE: {
+          if (ops.size() != 0)
+            return false;
+
+          const triton::arch::Register& base = this->architecture->getParentRegister(ID_REG_X86_BP);
+          triton::uint64 bp                  = this->getRegister(base);
+
+          this->setRegister(stack, bp);
+          this->setRegister(base, this->load(bp, base.getSize()));
+          this->setRegister(stack, this->getRegister(stack) + base.getSize());
+          break;
+        }
+
+        case ID_INS_JMP: {
+          if (ops.size() != 1)
+            return false;
+          pc    = this->read(ops[0], addrs[0]);
+          taken = true;
+          break;
+        }
+
+        case ID_INS_JA:  case ID_INS_JAE: case ID_INS_JB:  case ID_INS_JBE:
+        case ID_INS_JE:  case ID_INS_JNE: case ID_INS_JG:  case ID_INS_JGE:
+        case ID_INS_JL:  case ID_INS_JLE: case ID_INS_JNO: case ID_INS_JNP:
+        case ID_INS_JNS: case ID_INS_JO:  case ID_INS_JP:  case ID_INS_JS: {
+          if (ops.size() != 1)
+            return false;
+          if (taken)
+            pc = this->read(ops[0], addrs[0]);
+          break;
+        }
+
+        case ID_INS_CMOVA:  case ID_INS_CMOVAE: case ID_INS_CMOVB:  case ID_INS_CMOVBE:
+        case ID_INS_CMOVE:  case ID_INS_CMOVNE: case ID_INS_CMOVG:  case ID_INS_CMOVGE:
+        case ID_INS_CMOVL:  case ID_INS_CMOVLE: case ID_INS_CMOVNO: case ID_INS_CMOVNP:
+        case ID_INS_CMOVNS: case ID_INS_CMOVO:  case ID_INS_CMOVP:  case ID_INS_CMOVS: {
+          if (ops.size() != 2)
+            return false;
+          /* Both operands are read and the destination is always written, so a 32-bit destination is always zero extended */
+          triton::uint64 src = this->read(ops[1], addrs[1]);
+          triton::uint64 dst = this->read(ops[0], addrs[0]);
+          this->write(ops[0], addrs[0], taken ? src : dst);
+          break;
+        }
+
+        case ID_INS_SETA:  case ID_INS_SETAE: case ID_INS_SETB:  case ID_INS_SETBE:
+        case ID_INS_SETE:  case ID_INS_SETNE: case ID_INS_SETG:  case ID_INS_SETGE:
+        case ID_INS_SETL:  case ID_INS_SETLE: case ID_INS_SETNO: case ID_INS_SETNP:
+        case ID_INS_SETNS: case ID_INS_SETO:  case ID_INS_SETP:  case ID_INS_SETS: {
+          if (ops.size() != 1)
+            return false;
+          this->write(ops[0], addrs[0], taken ? 1 : 0);
+          break;
+        }
+
+        default:
+          return false;
+      }
+
+      this->setRegister(this->architecture->getProgramCounter(), pc);
+
+      this->journal.conditionTaken = taken;
+      this->journal.addresses.assign(addrs, addrs + ops.size());
+      return true;
+    }
+
+
+    bool ConcreteInterpreter::executeAArch64(const triton::arch::Instruction& inst) {
+      using namespace triton::arch::aarch64;
+
+      const std::vector<triton::arch::OperandWrapper>& ops = inst.operands;
+      triton::uint64 addrs[3]                             = {0, 0, 0};
+      triton::uint64 pc                                   = inst.getNextAddress();
+      bool taken                                          = false;
+
+      /* Post-indexed and pre-indexed accesses update their base register */
+      if (inst.isWriteBack() || ops.size() > 3)
+        return false;
+
+      for (triton::usize i = 0; i < ops.size(); i++) {
+        if (!this->isSupported(ops[i]))
+          return false;
+        if (ops[i].getType() == triton::arch::OP_MEM)
+          addrs[i] = this->getEffectiveAddress(ops[i].getConstMemory());
+      }
+
+      /* The condition of B.cond. Only the flags of the condition are read, like in its AST */
+      if (inst.getType() == ID_INS_B) {
+        auto n = [this]() { return this->getFlag(ID_REG_AARCH64_N); };
+        auto z = [this]() { return this->getFlag(ID_REG_AARCH64_Z); };
+        auto c = [this]() { return this->getFlag(ID_REG_AARCH64_C); };
+        auto v = [this]() { return this->getFlag(ID_REG_AARCH64_V); };
+
+        switch (inst.getCodeCondition()) {
+          case ID_CONDITION_EQ: taken = z(); break;
+          case ID_CONDITION_NE: taken = !z(); break;
+          case ID_CONDITION_HS: taken = c(); break;
+          case ID_CONDITION_LO: taken = !c(); break;
+          case ID_CONDITION_MI: taken = n(); break;
+          case ID_CONDITION_PL: taken = !n(); break;
+          case ID_CONDITION_VS: taken = v(); break;
+          case ID_CONDITION_VC: taken = !v(); break;
+          case ID_CONDITION_HI: { bool cf = c(); bool zf = z(); taken = cf && !zf; break; }
+          case ID_CONDITION_LS: { bool cf = c(); bool zf = z(); taken = !cf || zf; break; }
+          case ID_CONDITION_GE: taken = (n() == v()); break;
+          case ID_CONDITION_LT: taken = (n() != v()); break;
+          case ID_CONDITION_GT: { bool zf = z(); bool nf = n(); bool vf = v(); taken = !zf && (nf == vf); break; }
+          case ID_CONDITION_LE: { bool zf = z(); bool nf = n(); bool vf = v(); taken = zf || (nf != vf); break; }
+          default:              taken = true; break;
+        }
+      }
+
+      /* Sets N and Z according to a result */
+      auto setResultFlags = [this](triton::uint64 res, triton::uint32 size) {
+        this->setFlag(ID_REG_AARCH64_N, msb(res, size));
+        this->setFlag(ID_REG_AARCH64_Z, res == 0);
+      };
+
+      switch (inst.getType()) {
+        case ID_INS_NOP:
+          break;
+
+        case ID_INS_ADD:
+        case ID_INS_SUB:
+        case ID_INS_CMP:
+        case ID_INS_CMN: {
+          bool compare = (inst.getType() == ID_INS_CMP || inst.getType() == ID_INS_CMN);
+          if (ops.size() != (compare ? 2U : 3U))
+            return false;
+
+          const triton::arch::OperandWrapper& src1 = ops[compare ? 0 : 1];
+          const triton::arch::OperandWrapper& src2 = ops[compare ? 1 : 2];
+          triton::uint32 size                      = ops[0].getBitSize();
+          triton::uint64 a                         = this->read(src1, addrs[compare ? 0 : 1]);
+          triton::uint64 b                         = this->read(src2, addrs[compare ? 1 : 2]);
+          bool addition                            = (inst.getType() == ID_INS_ADD || inst.getType() == ID_INS_CMN);
+          triton::uint64 res                       = (addition ? (a + b) : (a - b)) & mask(size);
+
+          if (!compare)
+            this->write(ops[0], addrs[0], res);
+
+          /* CMP and CMN always update the flags */
+          if (compare || inst.isUpdateFlag()) {
+            if (addition) {
+              this->setFlag(ID_REG_AARCH64_C, msb((a & b) ^ ((a ^ b ^ res) & (a ^ b)), size));
+              this->setFlag(ID_REG_AARCH64_V, msb((a ^ ~b) & (a ^ res), size));
+            }
+            else {
+              this->setFlag(ID_REG_AARCH64_C, !msb((a ^ b ^ res) ^ ((a ^ res) & (a ^ b)), size));
+              this->setFlag(ID_REG_AARCH64_V, msb((a ^ b) & (a ^ res), size));
+            }
+            setResultFlags(res, size);
+          }
+          break;
+        }
+
+        case ID_INS_AND:
+        case ID_INS_ORR:
+        case ID_INS_EOR:
+        case ID_INS_TST: {
+          bool compare = (inst.getType() == ID_INS_TST);
+          if (ops.size() != (compare ? 2U : 3U))
+            return false;
+
+          triton::uint32 size = ops[0].getBitSize();
+          triton::uint64 a    = this->read(ops[compare ? 0 : 1], addrs[compare ? 0 : 1]);
+          triton::uint64 b    = this->read(ops[compare ? 1 : 2], addrs[compare ? 1 : 2]);
+          triton::uint64 res  = 0;
+
+          switch (inst.getType()) {
+            case ID_INS_ORR: res = a | b; break;
+            case ID_INS_EOR: res = a ^ b; break;
+            default:         res = a & b; break;
+          }
+          res &= mask(size);
+
+          if (!compare)
+            this->write(ops[0], addrs[0], res);
+
+          /* Only ANDS and TST update the flags */
+          if ((inst.getType() == ID_INS_AND || compare) && inst.isUpdateFlag()) {
+            this->setFlag(ID_REG_AARCH64_C, false);
+            this->setFlag(ID_REG_AARCH64_V, false);
+            setResultFlags(res, size);
+          }
+          break;
+        }
+
+        case ID_INS_MOV:
+        case ID_INS_MOVZ: {
+          if (ops.size() != 2)
+            return false;
+          this->write(ops[0], addrs[0], this->read(ops[1], addrs[1]));
+          break;
+        }
+
+        case ID_INS_LDR: {
+          if (ops.size() != 2 || ops[1].getType() != triton::arch::OP_MEM)
+            return false;
+          this->write(ops[0], addrs[0], this->read(ops[1], addrs[1]));
+          break;
+        }
+
+        case ID_INS_STR: {
+          if (ops.size() != 2 || ops[1].getType() != triton::arch::OP_MEM)
+            return false;
+          this->write(ops[1], addrs[1], this->read(ops[0], addrs[0]));
+          break;
+        }
+
+        case ID_INS_B: {
+          if (ops.size() != 1)
+            return false;
+          if (taken)
+            pc = this->read(ops[0], addrs[0]);
+          break;
+        }
+
+        case ID_INS_BL:
+        case ID_INS_BLR: {
+          if (ops.size() != 1)
+            return false;
+          pc = this->read(ops[0], addrs[0]);
+          this->setRegister(this->architecture->getRegister(ID_REG_AARCH64_X30), inst.getNextAddress());
+          break;
+        }
+
+        case ID_INS_BR: {
+          if (ops.size() != 1)
+            return false;
+          pc = this->read(ops[0], addrs[0]);
+          break;
+        }
+
+        case ID_INS_RET: {
+          if (ops.size() > 1)
+            return false;
+          pc = (ops.size() == 1) ? this->read(ops[0], addrs[0]) : this->getRegister(this->architecture->getRegister(ID_REG_AARCH64_X30));
+          break;
+        }
+
+        case ID_INS_CBZ:
+        case ID_INS_CBNZ: {
+          if (ops.size() != 2)
+            return false;
+          bool zero = (this->read(ops[0], addrs[0]) == 0);
+          if (zero == (inst.getType() == ID_INS_CBZ))
+            pc = this->read(ops[1], addrs[1]);
+          break;
+        }
+
+        case ID_INS_TBZ:
+        case ID_INS_TBNZ: {
+          if (ops.size() != 3)
+            return false;
+          bool set = bit(this->read(ops[0], addrs[0]), this->read(ops[1], addrs[1]));
+          if (set == (inst.getType() == ID_INS_TBNZ))
+            pc = this->read(ops[2], addrs[2]);
+          break;
+        }
+
+        default:
+          return false;
+      }
+
+      this->setRegister(this->architecture->getProgramCounter(), pc);
+
+      /* Unlike the x86 ones, the AArch64 semantics don't tag taken conditions */
+      this->journal.addresses.assign(addrs, addrs + ops.size());
+      return true;
+    }
+
+
+    bool ConcreteInterpreter::step(void) {
+      const triton::arch::Register& reg = this->architecture->getProgramCounter();
+      triton::uint64 addr               = this->getRegister(reg);
+      const triton::arch::Instruction& decoded = this->fetch(addr);
+
+      /* Nothing but the concrete state has to be updated when both engines are idle */
+      if (!this->symbolicEngine->isEnabled() && !this->taintEngine->isEnabled()) {
+        if (this->execute(decoded)) {
+          this->nativeCount++;
+          return true;
+        }
+      }
+
+      /* The cached instruction is kept free of any semantics */
+      triton::arch::Instruction inst = decoded;
+      if (this->processConcrete(inst))
+        return true;
+
+      if (!this->irBuilder->buildSemantics(inst)) {
+        std::ostringstream msg;
+        msg << "ConcreteInterpreter::step(): Instruction not supported: " << inst;
+        throw triton::exceptions::ConcreteInterpreter(msg.str());
+      }
+
+      this->fallbackCount++;
+      return false;
+    }
+
+
+    bool ConcreteInterpreter::processConcrete(triton::arch::Instruction& inst) {
+      /* The concrete path constraints are only dropped with PC_TRACKING_SYMBOLIC */
+      if (!this->symbolicEngine->isEnabled())
+        return false;
+
+      if (!this->modes.isModeEnabled(triton::modes::ONLY_ON_SYMBOLIZED) || !this->modes.isModeEnabled(triton::modes::PC_TRACKING_SYMBOLIC))
+        return false;
+
+      /* Same as IrBuilder::preIrInit() */
+      if (!inst.getAddress())
+        inst.setAddress(this->architecture->getConcreteRegisterValue(this->architecture->getProgramCounter()).convert_to<triton::uint64>());
+
+      /* The semantics use the address of a memory operand when it is already defined */
+      for (const auto& operand : inst.operands) {
+        if (operand.getType() == triton::arch::OP_MEM && operand.getConstMemory().getAddress())
+          return false;
+      }
+
+      /*
+       * A first execution without callbacks decides whether the semantics are
+       * needed. The callbacks only see the execution which is kept: it is run
+       * again with them, or the semantics run once the first one is undone.
+       */
+      if (!this->executeJournaled(inst, false))
+        return false;
+
+      if (this->callbacks && this->callbacks->isDefined) {
+        this->undo();
+        if (!this->executeJournaled(inst, true))
+          return false;
+      }
+
+      bool tainted = this->taintEngine->isEnabled();
+
+      /* Same state as IrBuilder::postIrInit() once the concrete expressions are removed */
+      inst.symbolicExpressions.clear();
+      inst.getLoadAccess().clear();
+      inst.getReadRegisters().clear();
+      inst.getReadImmediates().clear();
+      inst.getStoreAccess().clear();
+      inst.getWrittenRegisters().clear();
+
+      /* Without tainted source, the semantics untaint every destination */
+      for (const auto& item : this->journal.writtenRegisters) {
+        this->symbolicEngine->concretizeRegister(item.first);
+        if (tainted)
+          this->taintEngine->setTaintRegister(item.first, false);
+      }
+
+      for (const auto& item : this->journal.storeAccess) {
+        this->symbolicEngine->concretizeMemory(item.first);
+        if (tainted)
+          this->taintEngine->setTaintMemory(item.first, false);
+      }
+
+      for (const auto& reg : this->journal.undefinedRegisters) {
+        if (this->modes.isModeEnabled(triton::modes::CONCRETIZE_UNDEFINED_REGISTERS))
+          this->symbolicEngine->concretizeRegister(reg);
+        if (tainted)
+          this->taintEngine->setTaintRegister(reg, false);
+        inst.setUndefinedRegister(reg);
+      }
+
+      if (this->journal.conditionTaken)
+        inst.setConditionTaken(true);
+
+      for (triton::usize i = 0; i < inst.operands.size(); i++) {
+        if (inst.operands[i].getType() == triton::arch::OP_MEM)
+          inst.operands[i].getMemory().setAddress(this->journal.addresses[i]);
+      }
+
+      this->nativeCount++;
+      return true;
+    }
+
+
+    triton::usize ConcreteInterpreter::run(triton::uint64 addr, triton::usize count) {
+      return this->run([addr](triton::uint64 pc) { return pc == addr; }, count);
+    }
+
+
+    triton::usize ConcreteInterpreter::run(const std::function<bool(triton::uint64)>& stop, triton::usize count) {
+      const triton::arch::Register& reg = this->architecture->getProgramCounter();
+      triton::usize executed            = 0;
+
+      while (count == 0 || executed < count) {
+        if (stop(this->getRegister(reg)))
+          break;
+        this->step();
+        executed++;
+      }
+
+      return executed;
+    }
+
+
+    triton::usize ConcreteInterpreter::getNativeCount(void) const {
+      return this->nativeCount;
+    }
+
+
+    triton::usize ConcreteInterpreter::getFallbackCount(void) const {
+      return this->fallbackCount;
+    }
+
+
+    void ConcreteInterpreter::clearCache(void) {
+      this->cache.clear();
+    }
+
+  };
+};
@@ -220,6 +220,15 @@ namespace triton {
         /* Symbolic Expressions */
         this->removeSymbolicExpressions(inst);
       }
+
+      // ----------------------------------------------------------------------
+
+      /*
+       * If a memory budget is defined, drop the stale symbolic entries
+       * once the instruction is fully processed.
+       */
+      if (this->symbolicEngine->isEnabled())
+        this->symbolicEngine->enforceMemoryBudget();
     }
 
 
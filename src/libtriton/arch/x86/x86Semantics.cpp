@@ -5,6 +5,8 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+
 #include <triton/cpuSize.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/x86Semantics.hpp>
@@ -833,6 +835,149 @@ namespace triton {
       }
 
 
+      bool x86Semantics::repString_s(triton::arch::Instruction& inst, triton::uint32 size, const std::string& comment) {
+        auto& dst     = inst.operands[0];
+        auto& src     = inst.operands[1];
+        auto  pc      = triton::arch::OperandWrapper(this->architecture->getProgramCounter());
+        auto  counter = triton::arch::OperandWrapper(this->architecture->getParentRegister(ID_REG_X86_CX));
+        auto  index1  = triton::arch::OperandWrapper(this->architecture->getParentRegister(ID_REG_X86_DI));
+        auto  index2  = triton::arch::OperandWrapper(this->architecture->getParentRegister(ID_REG_X86_SI));
+        auto  df      = triton::arch::OperandWrapper(this->architecture->getRegister(ID_REG_X86_DF));
+        bool  isMovs  = false;
+
+        switch (inst.getType()) {
+          case ID_INS_MOVSB:
+          case ID_INS_MOVSD:
+          case ID_INS_MOVSQ:
+          case ID_INS_MOVSW:
+            isMovs = true;
+            break;
+          default:
+            break;
+        }
+
+        if (!this->modes.isModeEnabled(triton::modes::BULK_REP_STRINGS) || inst.getPrefix() != triton::arch::x86::ID_PREFIX_REP)
+          return false;
+
+        /* Only the string forms (e.g. not the SSE MOVSD) */
+        if (dst.getType() != triton::arch::OP_MEM || src.getType() != (isMovs ? triton::arch::OP_MEM : triton::arch::OP_REG))
+          return false;
+
+        /* The number of iterations and the direction must be known */
+        if (this->symbolicEngine->isRegisterSymbolized(counter.getConstRegister()) || this->symbolicEngine->isRegisterSymbolized(df.getConstRegister()))
+          return false;
+
+        /* Create symbolic operands */
+        auto op1 = this->symbolicEngine->getOperandAst(inst, counter);
+        auto op2 = this->symbolicEngine->getOperandAst(inst, index1);
+        auto op3 = this->symbolicEngine->getOperandAst(inst, index2);
+        auto op4 = this->symbolicEngine->getOperandAst(inst, df);
+        auto op5 = isMovs ? nullptr : this->symbolicEngine->getOperandAst(inst, src);
+
+        triton::uint64 mask     = (this->architecture->gprBitSize() == QWORD_SIZE_BIT) ? static_cast<triton::uint64>(-1) : ((1ULL << this->architecture->gprBitSize()) - 1);
+        triton::uint64 total    = op1->evaluate().convert_to<triton::uint64>();
+        triton::uint64 count    = std::min<triton::uint64>(total, 0x1000 / size);
+        triton::uint64 length   = count * size;
+        triton::uint64 diAddr   = op2->evaluate().convert_to<triton::uint64>();
+        triton::uint64 siAddr   = op3->evaluate().convert_to<triton::uint64>();
+        bool           backward = !op4->evaluate().is_zero();
+
+        /* Lowest addresses of both ranges */
+        triton::uint64 dstBase = backward ? ((diAddr - length + size) & mask) : diAddr;
+        triton::uint64 srcBase = backward ? ((siAddr - length + size) & mask) : siAddr;
+
+        if (isMovs) {
+          /*
+           * Without overlap, the whole range is moved at once. Otherwise, elements are moved one by one
+           * in the iteration order to keep the REP MOVS semantics (e.g. a pattern replicated forward).
+           */
+          bool overlap = (dstBase > mask - length || srcBase > mask - length || (dstBase < srcBase + length && srcBase < dstBase + length));
+          triton::uint64 chunk = overlap ? size : length;
+
+          for (triton::uint64 done = 0; done < length; done += chunk) {
+            triton::uint64 offset = backward ? (length - done - chunk) : done;
+            std::vector<triton::ast::SharedAbstractNode> nodes(chunk);
+            std::vector<bool> taints(chunk);
+
+            /* Read the source states before writing anything */
+            std::vector<triton::uint8> area = this->architecture->getConcreteMemoryAreaValue((srcBase + offset) & mask, chunk);
+            for (triton::uint64 i = 0; i < chunk; i++) {
+              triton::uint64 addr = (srcBase + offset + i) & mask;
+              if (this->symbolicEngine->isMemorySymbolized(addr))
+                nodes[i] = this->symbolicEngine->getMemoryAst(inst, triton::arch::MemoryAccess(addr, BYTE_SIZE));
+              taints[i] = this->taintEngine->isMemoryTainted(addr);
+            }
+
+            /* Symbolic references only for the bytes coming from symbolic sources */
+            this->architecture->setConcreteMemoryAreaValue((dstBase + offset) & mask, area);
+            for (triton::uint64 i = 0; i < chunk; i++) {
+              triton::uint64 addr = (dstBase + offset + i) & mask;
+              if (nodes[i] != nullptr)
+                this->symbolicEngine->createSymbolicMemoryExpression(inst, nodes[i], triton::arch::MemoryAccess(addr, BYTE_SIZE), comment);
+              else
+                this->symbolicEngine->concretizeMemory(addr);
+              if (taints[i])
+                this->taintEngine->taintMemory(addr);
+              else
+                this->taintEngine->untaintMemory(addr);
+            }
+          }
+        }
+
+        else {
+          triton::uint512 value = op5->evaluate();
+          bool symbolized       = this->symbolicEngine->isRegisterSymbolized(src.getConstRegister());
+          bool tainted          = this->taintEngine->isRegisterTainted(src.getConstRegister());
+
+          /* Concrete fill */
+          std::vector<triton::uint8> area(length);
+          for (triton::uint64 i = 0; i < length; i++)
+            area[i] = static_cast<triton::uint8>(((value >> ((i % size) * BYTE_SIZE_BIT)) & 0xff).convert_to<triton::uint32>());
+          this->architecture->setConcreteMemoryAreaValue(dstBase, area);
+
+          for (triton::uint64 i = 0; i < count; i++) {
+            triton::uint64 addr = (dstBase + i * size) & mask;
+            if (symbolized)
+              this->symbolicEngine->createSymbolicMemoryExpression(inst, op5, triton::arch::MemoryAccess(addr, size), comment);
+            for (triton::uint32 j = 0; j < size; j++) {
+              if (!symbolized)
+                this->symbolicEngine->concretizeMemory((addr + j) & mask);
+              if (tainted)
+                this->taintEngine->taintMemory((addr + j) & mask);
+              else
+                this->taintEngine->untaintMemory((addr + j) & mask);
+            }
+          }
+        }
+
+        /*
+         * Create the semantics of the indexes, the counter and the PC. At most one page is
+         * processed at once, the PC stays on the instruction until the counter reaches zero.
+         */
+        auto node1 = backward ? this->astCtxt.bvsub(op2, this->astCtxt.bv(length, index1.getBitSize())) : this->astCtxt.bvadd(op2, this->astCtxt.bv(length, index1.getBitSize()));
+        auto node2 = backward ? this->astCtxt.bvsub(op3, this->astCtxt.bv(length, index2.getBitSize())) : this->astCtxt.bvadd(op3, this->astCtxt.bv(length, index2.getBitSize()));
+        auto node3 = this->astCtxt.bv(total - count, counter.getBitSize());
+        auto node4 = this->astCtxt.bv((total == count) ? inst.getNextAddress() : inst.getAddress(), pc.getBitSize());
+
+        /* Create symbolic expression */
+        auto expr1 = this->symbolicEngine->createSymbolicExpression(inst, node1, index1, "Index (DI) operation");
+        auto expr3 = this->symbolicEngine->createSymbolicExpression(inst, node3, counter, "Counter operation");
+        auto expr4 = this->symbolicEngine->createSymbolicExpression(inst, node4, pc, "Program Counter");
+
+        /* Spread taint */
+        expr1->isTainted = this->taintEngine->taintUnion(index1, index1);
+        expr3->isTainted = this->taintEngine->taintUnion(counter, counter);
+        expr4->isTainted = this->taintEngine->taintAssignment(pc, counter);
+
+        if (isMovs) {
+          auto expr2 = this->symbolicEngine->createSymbolicExpression(inst, node2, index2, "Index (SI) operation");
+          expr2->isTainted = this->taintEngine->taintUnion(index2, index2);
+        }
+
+        return true;
+      }
+
+
       void x86Semantics::af_s(triton::arch::Instruction& inst,
                               const triton::engines::symbolic::SharedSymbolicExpression& parent,
                               triton::arch::OperandWrapper& dst,
@@ -6897,6 +7042,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, BYTE_SIZE, "MOVSB operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index1);
@@ -6946,6 +7095,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, DWORD_SIZE, "MOVSD operation"))
+          return;
+
         /*
          * F2 0F 10 /r MOVSD xmm1, xmm2
          * F2 0F 10 /r MOVSD xmm1, m64
@@ -7062,6 +7215,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, QWORD_SIZE, "MOVSQ operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index1);
@@ -7111,6 +7268,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, WORD_SIZE, "MOVSW operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index1);
@@ -12135,6 +12296,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, BYTE_SIZE, "STOSB operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index);
@@ -12175,6 +12340,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, DWORD_SIZE, "STOSD operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index);
@@ -12215,6 +12384,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, QWORD_SIZE, "STOSQ operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index);
@@ -12255,6 +12428,10 @@ namespace triton {
           return;
         }
 
+        /* Perform all iterations at once if possible */
+        if (this->repString_s(inst, WORD_SIZE, "STOSW operation"))
+          return;
+
         /* Create symbolic operands */
         auto op1 = this->symbolicEngine->getOperandAst(inst, src);
         auto op2 = this->symbolicEngine->getOperandAst(inst, index);
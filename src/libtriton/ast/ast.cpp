@@ -7,9 +7,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <new>
+#include <set>
 #include <stack>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include <triton/ast.hpp>
@@ -27,10 +32,15 @@ namespace triton {
     /* ====== Abstract node */
 
     AbstractNode::AbstractNode(triton::ast::ast_e type, AstContext& ctxt): ctxt(ctxt) {
-      this->eval        = 0;
-      this->size        = 0;
-      this->symbolized  = false;
-      this->type        = type;
+      this->depth         = 1;
+      this->eval          = 0;
+      this->size          = 0;
+      this->symbolized    = false;
+      this->type          = type;
+      this->unrolledHash  = 0;
+      this->unrolledSize  = 1;
+      this->variableIds   = nullptr;
+      this->variableIdsPending = false;
     }
 
 
@@ -73,6 +83,157 @@ namespace triton {
     }
 
 
+    triton::uint32 AbstractNode::getDepth(void) const {
+      return this->depth;
+    }
+
+
+    triton::uint64 AbstractNode::getUnrolledSize(void) const {
+      return this->unrolledSize;
+    }
+
+
+    triton::uint64 AbstractNode::getUnrolledHash(void) const {
+      return this->unrolledHash;
+    }
+
+
+    const std::vector<triton::usize>& AbstractNode::getVariableIds(void) const {
+      static const std::vector<triton::usize> empty;
+
+      if (this->variableIdsPending)
+        this->resolveVariableIds();
+
+      if (this->variableIds == nullptr)
+        return empty;
+
+      return *this->variableIds;
+    }
+
+
+    /*
+     * The depth and the unrolled size are computed from the children. The set
+     * of variable ids is shared with a child when no other child brings a new
+     * variable, so that long chains of operations on the same inputs do not
+     * duplicate it. Otherwise it is merged on the first getVariableIds().
+     */
+    void AbstractNode::initMetrics(void) {
+      std::shared_ptr<const std::vector<triton::usize>> vars = nullptr;
+      bool merge = false;
+
+      this->depth = 0;
+      this->unrolledSize = 1;
+      this->unrolledHash = 0;
+      this->mixUnrolledHash(this->type);
+      this->mixUnrolledHash(this->size);
+
+      for (const auto& child : this->children) {
+        this->depth = std::max(this->depth, child->depth);
+        this->mixUnrolledHash(child->unrolledHash);
+
+        /* Saturate on overflow, the unrolled size of a DAG may be exponential */
+        if (child->unrolledSize > std::numeric_limits<triton::uint64>::max() - this->unrolledSize)
+          this->unrolledSize = std::numeric_limits<triton::uint64>::max();
+        else
+          this->unrolledSize += child->unrolledSize;
+
+        if (child->variableIdsPending) {
+          merge = true;
+          continue;
+        }
+
+        if (child->variableIds == nullptr || child->variableIds == vars)
+          continue;
+
+        if (vars == nullptr)
+          vars = child->variableIds;
+        else
+          merge = true;
+      }
+      this->depth++;
+
+      this->variableIds        = merge ? nullptr : vars;
+      this->variableIdsPending = merge;
+    }
+
+
+    void AbstractNode::initMetrics(const AbstractNode& unrolled) {
+      this->depth         = unrolled.depth;
+      this->unrolledHash  = unrolled.unrolledHash;
+      this->unrolledSize  = unrolled.unrolledSize;
+      this->variableIds   = unrolled.variableIds;
+      this->variableIdsPending = unrolled.variableIdsPending;
+    }
+
+
+    /*
+     * The operands of a reference are its unrolled node. The pending operands are
+     * resolved first with an explicit stack, so that a long chain of pending nodes
+     * does not overflow the call stack.
+     */
+    void AbstractNode::resolveVariableIds(void) const {
+      std::vector<std::pair<const AbstractNode*, bool>> worklist;
+
+      worklist.push_back(std::make_pair(this, false));
+      while (!worklist.empty()) {
+        const AbstractNode* node = worklist.back().first;
+        std::vector<const AbstractNode*> operands;
+
+        if (!node->variableIdsPending) {
+          worklist.pop_back();
+          continue;
+        }
+
+        if (node->type == REFERENCE_NODE)
+          operands.push_back(reinterpret_cast<const ReferenceNode*>(node)->getSymbolicExpression()->getAst().get());
+        else {
+          for (const auto& child : node->children)
+            operands.push_back(child.get());
+        }
+
+        /* Resolve the pending operands before the node */
+        if (!worklist.back().second) {
+          worklist.back().second = true;
+          for (const auto* op : operands) {
+            if (op->variableIdsPending)
+              worklist.push_back(std::make_pair(op, false));
+          }
+          continue;
+        }
+        worklist.pop_back();
+
+        std::vector<triton::usize> ids;
+        for (const auto* op : operands) {
+          if (op->variableIds != nullptr)
+            ids.insert(ids.end(), op->variableIds->begin(), op->variableIds->end());
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+        /* Reuse the set of an operand if it already holds every variable */
+        node->variableIds = nullptr;
+        for (const auto* op : operands) {
+          if (op->variableIds != nullptr && op->variableIds->size() == ids.size()) {
+            node->variableIds = op->variableIds;
+            break;
+          }
+        }
+        if (node->variableIds == nullptr && !ids.empty())
+          node->variableIds = std::make_shared<const std::vector<triton::usize>>(std::move(ids));
+        node->variableIdsPending = false;
+      }
+    }
+
+
+    /* The order of the values matters, so that (bvsub x y) and (bvsub y x) differ */
+    void AbstractNode::mixUnrolledHash(triton::uint64 value) {
+      triton::uint64 h = this->unrolledHash ^ (value + 0x9e3779b97f4a7c15ULL + (this->unrolledHash << 6) + (this->unrolledHash >> 2));
+      h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+      this->unrolledHash = h ^ (h >> 31);
+    }
+
+
     bool AbstractNode::isLogical(void) const {
       switch (this->type) {
         case BVSGE_NODE:
@@ -114,9 +275,51 @@ namespace triton {
     }
 
 
+    /* True while the ancestors of a node are reinitialized, their own init() then leaves their parents to the outer call */
+    static thread_local bool initializingParents = false;
+
+
+    /*
+     * The ancestors are reinitialized once each and after their children, without recursion. A node
+     * may have a lot of them, e.g. a variable under a long chain of path constraints.
+     */
     void AbstractNode::initParents(void) {
-      for (auto& sp : this->getParents())
-        sp->init();
+      std::vector<std::tuple<SharedAbstractNode, std::vector<SharedAbstractNode>, triton::usize>> worklist;
+      std::vector<SharedAbstractNode> order;
+      std::unordered_set<AbstractNode*> visited;
+
+      if (initializingParents || this->parents.empty())
+        return;
+
+      /* A node is ordered after its own parents, the reverse order is topological */
+      worklist.emplace_back(nullptr, this->getParents(), 0);
+      while (!worklist.empty()) {
+        auto& frame = worklist.back();
+        auto& parents = std::get<1>(frame);
+        auto& index = std::get<2>(frame);
+
+        if (index < parents.size()) {
+          SharedAbstractNode parent = parents[index++];
+          if (visited.insert(parent.get()).second)
+            worklist.emplace_back(parent, parent->getParents(), 0);
+          continue;
+        }
+
+        if (std::get<0>(frame) != nullptr)
+          order.push_back(std::get<0>(frame));
+        worklist.pop_back();
+      }
+
+      initializingParents = true;
+      try {
+        for (auto it = order.rbegin(); it != order.rend(); it++)
+          (*it)->init();
+      }
+      catch (...) {
+        initializingParents = false;
+        throw;
+      }
+      initializingParents = false;
     }
 
 
@@ -244,6 +447,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -284,6 +490,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -324,6 +533,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -397,6 +609,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -437,6 +652,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -477,6 +695,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -517,6 +738,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -553,6 +777,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -593,6 +820,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -629,6 +859,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -669,6 +902,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -720,6 +956,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -771,6 +1010,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -824,6 +1066,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -871,6 +1116,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -918,6 +1166,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -958,6 +1209,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1005,6 +1259,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1052,6 +1309,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1103,6 +1363,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1154,6 +1417,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1194,6 +1460,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1238,6 +1507,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1278,6 +1550,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1318,6 +1593,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1358,6 +1636,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1398,6 +1679,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1442,6 +1726,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1482,6 +1769,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1522,6 +1812,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1574,6 +1867,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1605,6 +1901,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1651,6 +1950,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1690,6 +1992,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1730,6 +2035,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1770,6 +2078,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1823,6 +2134,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1869,6 +2183,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1897,6 +2214,11 @@ namespace triton {
       this->size        = 0;
       this->symbolized  = false;
 
+      /* Init metrics */
+      this->initMetrics();
+      for (triton::uint32 index = 0; index < MAX_BITS_SUPPORTED; index += QWORD_SIZE_BIT)
+        this->mixUnrolledHash(((this->value >> index) & std::numeric_limits<triton::uint64>::max()).convert_to<triton::uint64>());
+
       /* Init parents */
       this->initParents();
     }
@@ -1943,6 +2265,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -1984,6 +2309,9 @@ namespace triton {
           throw triton::exceptions::Ast("LandNode::init(): Must take logical nodes as arguments.");
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -2025,6 +2353,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -2065,6 +2396,9 @@ namespace triton {
       }
 
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -2106,6 +2440,9 @@ namespace triton {
           throw triton::exceptions::Ast("LorNode::init(): Must take logical nodes as arguments.");
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -2138,6 +2475,9 @@ namespace triton {
 
       this->expr->getAst()->setParent(this);
 
+      /* Init metrics */
+      this->initMetrics(*this->expr->getAst());
+
       /* Init parents */
       this->initParents();
     }
@@ -2168,6 +2508,10 @@ namespace triton {
       this->size        = 0;
       this->symbolized  = false;
 
+      /* Init metrics */
+      this->initMetrics();
+      this->mixUnrolledHash(std::hash<std::string>()(this->value));
+
       /* Init parents */
       this->initParents();
     }
@@ -2220,6 +2564,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -2249,6 +2596,15 @@ namespace triton {
       this->eval        = ctxt.getVariableValue(this->symVar->getName()) & this->getBitvectorMask();
       this->symbolized  = true;
 
+      /* Init metrics */
+      this->depth         = 1;
+      this->unrolledSize  = 1;
+      this->variableIds   = std::make_shared<const std::vector<triton::usize>>(1, this->symVar->getId());
+      this->variableIdsPending = false;
+      this->unrolledHash  = 0;
+      this->mixUnrolledHash(this->type);
+      this->mixUnrolledHash(this->symVar->getId());
+
       /* Init parents */
       this->initParents();
     }
@@ -2303,6 +2659,9 @@ namespace triton {
         this->symbolized |= this->children[index]->isSymbolized();
       }
 
+      /* Init metrics */
+      this->initMetrics();
+
       /* Init parents */
       this->initParents();
     }
@@ -2568,5 +2927,98 @@ namespace triton {
       return result;
     }
 
+
+    /* The shared pairs of nodes are compared once, so that the comparison is linear in the size of the DAGs */
+    bool unrolledEqualTo(const SharedAbstractNode& node1, const SharedAbstractNode& node2) {
+      std::stack<std::pair<AbstractNode*, AbstractNode*>> worklist;
+      std::set<std::pair<AbstractNode*, AbstractNode*>>   visited;
+
+      worklist.push(std::make_pair(node1.get(), node2.get()));
+      while (!worklist.empty()) {
+        AbstractNode* n1 = worklist.top().first;
+        AbstractNode* n2 = worklist.top().second;
+        worklist.pop();
+
+        while (n1->getType() == REFERENCE_NODE)
+          n1 = reinterpret_cast<ReferenceNode*>(n1)->getSymbolicExpression()->getAst().get();
+
+        while (n2->getType() == REFERENCE_NODE)
+          n2 = reinterpret_cast<ReferenceNode*>(n2)->getSymbolicExpression()->getAst().get();
+
+        if (n1 == n2 || !visited.insert(std::make_pair(n1, n2)).second)
+          continue;
+
+        if (n1->getType() != n2->getType() ||
+            n1->getBitvectorSize() != n2->getBitvectorSize() ||
+            n1->getUnrolledHash() != n2->getUnrolledHash() ||
+            n1->evaluate() != n2->evaluate() ||
+            n1->getChildren().size() != n2->getChildren().size())
+          return false;
+
+        switch (n1->getType()) {
+          case INTEGER_NODE:
+            if (reinterpret_cast<IntegerNode*>(n1)->getInteger() != reinterpret_cast<IntegerNode*>(n2)->getInteger())
+              return false;
+            break;
+
+          case STRING_NODE:
+            if (reinterpret_cast<StringNode*>(n1)->getString() != reinterpret_cast<StringNode*>(n2)->getString())
+              return false;
+            break;
+
+          case VARIABLE_NODE:
+            if (reinterpret_cast<VariableNode*>(n1)->getSymbolicVariable()->getId() != reinterpret_cast<VariableNode*>(n2)->getSymbolicVariable()->getId())
+              return false;
+            break;
+
+          default:
+            break;
+        }
+
+        for (triton::usize i = 0; i < n1->getChildren().size(); i++)
+          worklist.push(std::make_pair(n1->getChildren()[i].get(), n2->getChildren()[i].get()));
+      }
+
+      return true;
+    }
+
+
+    SharedAbstractNode flattenConjunction(const SharedAbstractNode& node) {
+      std::vector<SharedAbstractNode> operands;
+      std::set<AbstractNode*> visited;
+      std::stack<SharedAbstractNode> worklist;
+      bool nested = false;
+
+      if (node == nullptr || node->getType() != LAND_NODE)
+        return node;
+
+      for (const auto& child : node->getChildren())
+        nested |= (child->getType() == LAND_NODE);
+
+      if (!nested)
+        return node;
+
+      /* The operands are kept from left to right, a shared conjunction is only visited once */
+      worklist.push(node);
+      while (!worklist.empty()) {
+        SharedAbstractNode n = worklist.top();
+        worklist.pop();
+
+        if (n->getType() != LAND_NODE) {
+          operands.push_back(n);
+          continue;
+        }
+
+        if (!visited.insert(n.get()).second)
+          continue;
+
+        const auto& children = n->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); it++)
+          worklist.push(*it);
+      }
+
+      return node->getContext().land(operands);
+    }
+
   }; /* ast namespace */
 }; /* triton namespace */
@@ -0,0 +1,836 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include <triton/astBytecode.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/symbolicExpression.hpp>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+  #if defined(__SSE4_2__)
+    #include <nmmintrin.h>
+  #endif
+#endif
+
+
+
+namespace triton {
+  namespace ast {
+
+    namespace {
+      /*
+       * Arithmetic helpers on the two kinds of registers. They follow the semantics of the
+       * AbstractNode::init() methods, including the truncation of the shift amounts to 32 bits.
+       */
+      template <typename T>
+      struct Word;
+
+
+      template <>
+      struct Word<triton::uint64> {
+        typedef triton::sint64 Signed;
+
+        static triton::uint64 mask(triton::uint32 size) {
+          return (size >= 64) ? ~static_cast<triton::uint64>(0) : ((static_cast<triton::uint64>(1) << size) - 1);
+        }
+
+        static Signed toSigned(triton::uint64 value, triton::uint32 size) {
+          if (size < 64 && ((value >> (size - 1)) & 1))
+            value |= ~mask(size);
+          return static_cast<Signed>(value);
+        }
+
+        static triton::uint64 fromSigned(Signed value, triton::uint32 size) {
+          return static_cast<triton::uint64>(value) & mask(size);
+        }
+
+        static triton::uint32 amount(triton::uint64 value) {
+          return static_cast<triton::uint32>(value);
+        }
+
+        static triton::uint64 shl(triton::uint64 value, triton::uint32 n) {
+          return (n >= 64) ? 0 : (value << n);
+        }
+
+        static triton::uint64 shr(triton::uint64 value, triton::uint32 n) {
+          return (n >= 64) ? 0 : (value >> n);
+        }
+      };
+
+
+      template <>
+      struct Word<triton::uint512> {
+        typedef triton::sint512 Signed;
+
+        static triton::uint512 mask(triton::uint32 size) {
+          triton::uint512 one = 1;
+          return (size >= 512) ? ~triton::uint512(0) : ((one << size) - 1);
+        }
+
+        static Signed toSigned(const triton::uint512& value, triton::uint32 size) {
+          Signed ret = 0;
+          if ((value >> (size - 1)) & 1) {
+            ret = -1;
+            ret = ((ret << size) | value);
+          }
+          else {
+            ret = value;
+          }
+          return ret;
+        }
+
+        static triton::uint512 fromSigned(const Signed& value, triton::uint32 size) {
+          return (value.convert_to<triton::uint512>() & mask(size));
+        }
+
+        static triton::uint32 amount(const triton::uint512& value) {
+          return value.convert_to<triton::uint32>();
+        }
+
+        static triton::uint512 shl(const triton::uint512& value, triton::uint32 n) {
+          return (value << n);
+        }
+
+        static triton::uint512 shr(const triton::uint512& value, triton::uint32 n) {
+          return (value >> n);
+        }
+      };
+
+
+      /*
+       * Vector operations on the lanes of the 64-bit registers. AVX2 processes four lanes at once,
+       * SSE2 two. The comparisons need SSE4.2 and the per-lane shifts need AVX2, the operations
+       * which are not available on the target are performed by the scalar path.
+       */
+      #if defined(__AVX2__)
+        #define TRITON_LANES_VECTOR
+        #define TRITON_LANES_COMPARE
+        #define TRITON_LANES_SHIFT
+
+        typedef __m256i Vector;
+        const triton::uint32 VECTOR_WIDTH = 4;
+
+        inline Vector vload(const triton::uint64* p)  { return _mm256_loadu_si256(reinterpret_cast<const Vector*>(p)); }
+        inline void vstore(triton::uint64* p, Vector v) { _mm256_storeu_si256(reinterpret_cast<Vector*>(p), v); }
+        inline Vector vset(triton::uint64 v)          { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+        inline Vector vadd(Vector a, Vector b)        { return _mm256_add_epi64(a, b); }
+        inline Vector vsub(Vector a, Vector b)        { return _mm256_sub_epi64(a, b); }
+        inline Vector vand(Vector a, Vector b)        { return _mm256_and_si256(a, b); }
+        inline Vector vandnot(Vector a, Vector b)     { return _mm256_andnot_si256(a, b); }
+        inline Vector vor(Vector a, Vector b)         { return _mm256_or_si256(a, b); }
+        inline Vector vxor(Vector a, Vector b)        { return _mm256_xor_si256(a, b); }
+        inline Vector veq(Vector a, Vector b)         { return _mm256_cmpeq_epi64(a, b); }
+        inline Vector vgt(Vector a, Vector b)         { return _mm256_cmpgt_epi64(a, b); }
+        inline Vector vshl(Vector a, triton::uint32 n) { return _mm256_sll_epi64(a, _mm_cvtsi32_si128(static_cast<int>(n))); }
+        inline Vector vshr(Vector a, triton::uint32 n) { return _mm256_srl_epi64(a, _mm_cvtsi32_si128(static_cast<int>(n))); }
+        inline Vector vshlv(Vector a, Vector n)       { return _mm256_sllv_epi64(a, n); }
+        inline Vector vshrv(Vector a, Vector n)       { return _mm256_srlv_epi64(a, n); }
+
+      #elif defined(__SSE2__)
+        #define TRITON_LANES_VECTOR
+        #if defined(__SSE4_2__)
+          #define TRITON_LANES_COMPARE
+        #endif
+
+        typedef __m128i Vector;
+        const triton::uint32 VECTOR_WIDTH = 2;
+
+        inline Vector vload(const triton::uint64* p)  { return _mm_loadu_si128(reinterpret_cast<const Vector*>(p)); }
+        inline void vstore(triton::uint64* p, Vector v) { _mm_storeu_si128(reinterpret_cast<Vector*>(p), v); }
+        inline Vector vset(triton::uint64 v)          { return _mm_set1_epi64x(static_cast<long long>(v)); }
+        inline Vector vadd(Vector a, Vector b)        { return _mm_add_epi64(a, b); }
+        inline Vector vsub(Vector a, Vector b)        { return _mm_sub_epi64(a, b); }
+        inline Vector vand(Vector a, Vector b)        { return _mm_and_si128(a, b); }
+        inline Vector vandnot(Vector a, Vector b)     { return _mm_andnot_si128(a, b); }
+        inline Vector vor(Vector a, Vector b)         { return _mm_or_si128(a, b); }
+        inline Vector vxor(Vector a, Vector b)        { return _mm_xor_si128(a, b); }
+        inline Vector vshl(Vector a, triton::uint32 n) { return _mm_sll_epi64(a, _mm_cvtsi32_si128(static_cast<int>(n))); }
+        inline Vector vshr(Vector a, triton::uint32 n) { return _mm_srl_epi64(a, _mm_cvtsi32_si128(static_cast<int>(n))); }
+
+        /* SSE2 only compares 32-bit words, both halves must be equal */
+        inline Vector veq(Vector a, Vector b) {
+          Vector t = _mm_cmpeq_epi32(a, b);
+          return _mm_and_si128(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+
+        #if defined(__SSE4_2__)
+        inline Vector vgt(Vector a, Vector b)         { return _mm_cmpgt_epi64(a, b); }
+        #endif
+      #endif
+
+      #if defined(TRITON_LANES_VECTOR)
+      /* Stores f(lane) for each full vector of lanes and returns the number of lanes done */
+      template <typename F>
+      triton::uint32 vectorize(triton::uint64* dst, triton::uint32 count, const F& f) {
+        triton::uint32 lane = 0;
+        for (; lane + VECTOR_WIDTH <= count; lane += VECTOR_WIDTH)
+          vstore(dst + lane, f(lane));
+        return lane;
+      }
+      #endif
+    };
+
+
+    const triton::uint32 AstBytecode::BATCH_LANES;
+
+
+    AstBytecode::AstBytecode(const SharedAbstractNode& node) {
+      std::unordered_map<const AbstractNode*, Operand> regs;
+      std::map<triton::usize, std::pair<triton::engines::symbolic::SharedSymbolicVariable, Operand>> vars;
+      std::vector<std::pair<AbstractNode*, bool>> worklist;
+
+      if (node == nullptr)
+        throw triton::exceptions::Ast("AstBytecode::AstBytecode(): node cannot be null.");
+
+      /*
+       * Post-order walk of the DAG with an explicit stack. A node is compiled once all
+       * its operands are compiled, shared nodes are compiled once.
+       */
+      worklist.push_back(std::make_pair(node.get(), false));
+      while (!worklist.empty()) {
+        AbstractNode* current = worklist.back().first;
+
+        if (regs.find(current) != regs.end()) {
+          worklist.pop_back();
+          continue;
+        }
+
+        std::vector<AbstractNode*> args = AstBytecode::getOperandNodes(current);
+
+        if (worklist.back().second == false) {
+          worklist.back().second = true;
+          for (AbstractNode* arg : args) {
+            if (regs.find(arg) == regs.end())
+              worklist.push_back(std::make_pair(arg, false));
+          }
+          continue;
+        }
+
+        worklist.pop_back();
+
+        switch (current->getType()) {
+          case BV_NODE: {
+            Operand dst = this->allocate(current->getBitvectorSize());
+            if (dst.wide)
+              this->wide[dst.index] = current->evaluate();
+            else
+              this->narrow[dst.index] = current->evaluate().convert_to<triton::uint64>();
+            regs[current] = dst;
+            break;
+          }
+
+          case VARIABLE_NODE: {
+            const auto& var = reinterpret_cast<VariableNode*>(current)->getSymbolicVariable();
+            auto it = vars.find(var->getId());
+            if (it == vars.end())
+              it = vars.insert(std::make_pair(var->getId(), std::make_pair(var, this->allocate(current->getBitvectorSize())))).first;
+            regs[current] = it->second.second;
+            break;
+          }
+
+          /* These nodes are their operand */
+          case LET_NODE:
+          case REFERENCE_NODE:
+            regs[current] = regs[args[0]];
+            break;
+
+          default: {
+            std::vector<Operand> operands;
+            for (AbstractNode* arg : args)
+              operands.push_back(regs[arg]);
+            Operand dst = this->allocate(current->getBitvectorSize());
+            this->emit(current, args, operands, dst);
+            regs[current] = dst;
+            break;
+          }
+        }
+      }
+
+      for (const auto& item : vars) {
+        this->variables.push_back(item.second.first);
+        this->inputs.push_back(item.second.second);
+      }
+
+      this->result = regs[node.get()];
+      this->size   = node->getBitvectorSize();
+    }
+
+
+    AstBytecode::Operand AstBytecode::allocate(triton::uint32 size) {
+      Operand reg;
+
+      reg.wide = (size > 64);
+      if (reg.wide) {
+        reg.index = static_cast<triton::uint32>(this->wide.size());
+        this->wide.push_back(0);
+      }
+      else {
+        reg.index = static_cast<triton::uint32>(this->narrow.size());
+        this->narrow.push_back(0);
+      }
+
+      return reg;
+    }
+
+
+    std::vector<AbstractNode*> AstBytecode::getOperandNodes(AbstractNode* node) {
+      std::vector<AbstractNode*> ret;
+      auto& children = node->getChildren();
+
+      switch (node->getType()) {
+        case BV_NODE:
+        case VARIABLE_NODE:
+          break;
+
+        case REFERENCE_NODE:
+          ret.push_back(reinterpret_cast<ReferenceNode*>(node)->getSymbolicExpression()->getAst().get());
+          break;
+
+        case EXTRACT_NODE:
+        case LET_NODE:
+          ret.push_back(children[2].get());
+          break;
+
+        case SX_NODE:
+        case ZX_NODE:
+          ret.push_back(children[1].get());
+          break;
+
+        case BVROL_NODE:
+        case BVROR_NODE:
+          ret.push_back(children[0].get());
+          break;
+
+        case ASSERT_NODE:
+        case COMPOUND_NODE:
+        case DECLARE_NODE:
+        case INTEGER_NODE:
+        case STRING_NODE:
+          throw triton::exceptions::Ast("AstBytecode::getOperandNodes(): Unsupported node.");
+
+        default:
+          for (const auto& child : children)
+            ret.push_back(child.get());
+          break;
+      }
+
+      return ret;
+    }
+
+
+    void AstBytecode::emit(AbstractNode* node, const std::vector<AbstractNode*>& args, const std::vector<Operand>& regs, Operand dst) {
+      Instruction ins;
+
+      ins.first = static_cast<triton::uint32>(this->operands.size());
+      ins.count = static_cast<triton::uint32>(regs.size());
+      ins.dst   = dst;
+      ins.imm   = 0;
+      ins.size  = args.empty() ? 0 : args[0]->getBitvectorSize();
+      ins.wide  = dst.wide;
+
+      for (triton::uint32 index = 0; index < args.size(); index++) {
+        this->operands.push_back(regs[index]);
+        this->operandSizes.push_back(args[index]->getBitvectorSize());
+        ins.wide |= regs[index].wide;
+      }
+
+      switch (node->getType()) {
+        case BVADD_NODE:    ins.opcode = OP_BVADD;    break;
+        case BVAND_NODE:    ins.opcode = OP_BVAND;    break;
+        case BVASHR_NODE:   ins.opcode = OP_BVASHR;   break;
+        case BVLSHR_NODE:   ins.opcode = OP_BVLSHR;   break;
+        case BVMUL_NODE:    ins.opcode = OP_BVMUL;    break;
+        case BVNAND_NODE:   ins.opcode = OP_BVNAND;   break;
+        case BVNEG_NODE:    ins.opcode = OP_BVNEG;    break;
+        case BVNOR_NODE:    ins.opcode = OP_BVNOR;    break;
+        case BVNOT_NODE:    ins.opcode = OP_BVNOT;    break;
+        case BVOR_NODE:     ins.opcode = OP_BVOR;     break;
+        case BVSDIV_NODE:   ins.opcode = OP_BVSDIV;   break;
+        case BVSGE_NODE:    ins.opcode = OP_BVSGE;    break;
+        case BVSGT_NODE:    ins.opcode = OP_BVSGT;    break;
+        case BVSHL_NODE:    ins.opcode = OP_BVSHL;    break;
+        case BVSLE_NODE:    ins.opcode = OP_BVSLE;    break;
+        case BVSLT_NODE:    ins.opcode = OP_BVSLT;    break;
+        case BVSMOD_NODE:   ins.opcode = OP_BVSMOD;   break;
+        case BVSREM_NODE:   ins.opcode = OP_BVSREM;   break;
+        case BVSUB_NODE:    ins.opcode = OP_BVSUB;    break;
+        case BVUDIV_NODE:   ins.opcode = OP_BVUDIV;   break;
+        case BVUGE_NODE:    ins.opcode = OP_BVUGE;    break;
+        case BVUGT_NODE:    ins.opcode = OP_BVUGT;    break;
+        case BVULE_NODE:    ins.opcode = OP_BVULE;    break;
+        case BVULT_NODE:    ins.opcode = OP_BVULT;    break;
+        case BVUREM_NODE:   ins.opcode = OP_BVUREM;   break;
+        case BVXNOR_NODE:   ins.opcode = OP_BVXNOR;   break;
+        case BVXOR_NODE:    ins.opcode = OP_BVXOR;    break;
+        case DISTINCT_NODE: ins.opcode = OP_DISTINCT; break;
+        case EQUAL_NODE:    ins.opcode = OP_EQUAL;    break;
+        case IFF_NODE:      ins.opcode = OP_IFF;      break;
+        case LAND_NODE:     ins.opcode = OP_LAND;     break;
+        case LNOT_NODE:     ins.opcode = OP_LNOT;     break;
+        case LOR_NODE:      ins.opcode = OP_LOR;      break;
+
+        case ITE_NODE:
+          ins.opcode = OP_ITE;
+          ins.size   = node->getBitvectorSize();
+          break;
+
+        case BVROL_NODE:
+        case BVROR_NODE:
+          ins.opcode = (node->getType() == BVROL_NODE) ? OP_BVROL : OP_BVROR;
+          ins.imm    = reinterpret_cast<IntegerNode*>(node->getChildren()[1].get())->getInteger().convert_to<triton::uint32>() % ins.size;
+          break;
+
+        case CONCAT_NODE:
+          ins.opcode = OP_CONCAT;
+          ins.size   = node->getBitvectorSize();
+          break;
+
+        case EXTRACT_NODE:
+          ins.opcode = OP_EXTRACT;
+          ins.imm    = reinterpret_cast<IntegerNode*>(node->getChildren()[1].get())->getInteger().convert_to<triton::uint32>();
+          ins.size   = node->getBitvectorSize();
+          break;
+
+        case SX_NODE:
+        case ZX_NODE:
+          ins.opcode = (node->getType() == SX_NODE) ? OP_SX : OP_ZX;
+          ins.size   = node->getBitvectorSize();
+          break;
+
+        default:
+          throw triton::exceptions::Ast("AstBytecode::emit(): Unsupported node.");
+      }
+
+      this->code.push_back(ins);
+    }
+
+
+    template <typename T, typename Load>
+    T AstBytecode::execute(const Instruction& ins, const Load& load) const {
+      typedef Word<T> W;
+      const T mask = W::mask(ins.size);
+
+      switch (ins.opcode) {
+        case OP_BVADD:    return ((load(0) + load(1)) & mask);
+        case OP_BVAND:    return (load(0) & load(1));
+        case OP_BVMUL:    return ((load(0) * load(1)) & mask);
+        case OP_BVNAND:   return (~(load(0) & load(1)) & mask);
+        case OP_BVNEG:    return ((T(0) - load(0)) & mask);
+        case OP_BVNOR:    return (~(load(0) | load(1)) & mask);
+        case OP_BVNOT:    return (~load(0) & mask);
+        case OP_BVOR:     return (load(0) | load(1));
+        case OP_BVSUB:    return ((load(0) - load(1)) & mask);
+        case OP_BVXNOR:   return (~(load(0) ^ load(1)) & mask);
+        case OP_BVXOR:    return (load(0) ^ load(1));
+        case OP_BVSHL:    return (W::shl(load(0), W::amount(load(1))) & mask);
+        case OP_BVLSHR:   return W::shr(load(0), W::amount(load(1)));
+        case OP_BVUGE:    return T(load(0) >= load(1));
+        case OP_BVUGT:    return T(load(0) > load(1));
+        case OP_BVULE:    return T(load(0) <= load(1));
+        case OP_BVULT:    return T(load(0) < load(1));
+        case OP_BVSGE:    return T(W::toSigned(load(0), ins.size) >= W::toSigned(load(1), ins.size));
+        case OP_BVSGT:    return T(W::toSigned(load(0), ins.size) > W::toSigned(load(1), ins.size));
+        case OP_BVSLE:    return T(W::toSigned(load(0), ins.size) <= W::toSigned(load(1), ins.size));
+        case OP_BVSLT:    return T(W::toSigned(load(0), ins.size) < W::toSigned(load(1), ins.size));
+        case OP_DISTINCT: return T(load(0) != load(1));
+        case OP_EQUAL:    return T(load(0) == load(1));
+        case OP_ITE:      return (load(0) != 0) ? load(1) : load(2);
+        case OP_LNOT:     return T(load(0) == 0);
+
+        case OP_BVASHR: {
+          T value = load(0);
+          triton::uint32 shift = W::amount(load(1));
+          bool negative = ((value >> (ins.size - 1)) & 1) != 0;
+          if (shift >= ins.size)
+            return negative ? mask : T(0);
+          value = W::shr(value, shift);
+          if (negative)
+            value |= (mask & ~W::shr(mask, shift));
+          return value;
+        }
+
+        case OP_BVROL:
+        case OP_BVROR: {
+          T value = load(0);
+          if (ins.imm == 0)
+            return value;
+          if (ins.opcode == OP_BVROL)
+            return ((W::shl(value, ins.imm) | W::shr(value, ins.size - ins.imm)) & mask);
+          return ((W::shr(value, ins.imm) | W::shl(value, ins.size - ins.imm)) & mask);
+        }
+
+        case OP_BVUDIV: {
+          T divisor = load(1);
+          return (divisor == 0) ? mask : T(load(0) / divisor);
+        }
+
+        case OP_BVUREM: {
+          T divisor = load(1);
+          return (divisor == 0) ? load(0) : T(load(0) % divisor);
+        }
+
+        case OP_BVSDIV: {
+          typename W::Signed op1 = W::toSigned(load(0), ins.size);
+          typename W::Signed op2 = W::toSigned(load(1), ins.size);
+          if (op2 == 0)
+            return W::fromSigned(op1 < 0 ? 1 : -1, ins.size);
+          /* Avoids the overflow of the native division */
+          if (op2 == -1)
+            return ((T(0) - load(0)) & mask);
+          return W::fromSigned(op1 / op2, ins.size);
+        }
+
+        case OP_BVSREM:
+        case OP_BVSMOD: {
+          typename W::Signed op1 = W::toSigned(load(0), ins.size);
+          typename W::Signed op2 = W::toSigned(load(1), ins.size);
+          if (op2 == 0)
+            return load(0);
+          if (op2 == -1)
+            return T(0);
+          typename W::Signed rem = op1 - ((op1 / op2) * op2);
+          /* The sign of bvsmod follows the divisor */
+          if (ins.opcode == OP_BVSMOD && rem != 0 && ((rem < 0) != (op2 < 0)))
+            rem += op2;
+          return W::fromSigned(rem, ins.size);
+        }
+
+        case OP_CONCAT: {
+          T value = load(0);
+          for (triton::uint32 index = 1; index < ins.count; index++)
+            value = (W::shl(value, this->operandSizes[ins.first + index]) | load(index));
+          return value;
+        }
+
+        case OP_EXTRACT:
+          return (W::shr(load(0), ins.imm) & mask);
+
+        case OP_ZX:
+          return load(0);
+
+        case OP_SX: {
+          T value = load(0);
+          triton::uint32 inner = this->operandSizes[ins.first];
+          if ((value >> (inner - 1)) & 1)
+            value = ((value | ~W::mask(inner)) & mask);
+          return value;
+        }
+
+        case OP_IFF: {
+          bool p = (load(0) != 0);
+          bool q = (load(1) != 0);
+          return T((p && q) || (!p && !q));
+        }
+
+        case OP_LAND:
+          for (triton::uint32 index = 0; index < ins.count; index++) {
+            if (load(index) == 0)
+              return T(0);
+          }
+          return T(1);
+
+        case OP_LOR:
+          for (triton::uint32 index = 0; index < ins.count; index++) {
+            if (load(index) != 0)
+              return T(1);
+          }
+          return T(0);
+      }
+
+      throw triton::exceptions::Ast("AstBytecode::execute(): Invalid opcode.");
+    }
+
+
+    void AstBytecode::executeLanes(const Instruction& ins, triton::uint32 count) {
+      const Operand* args    = &this->operands[ins.first];
+      triton::uint64* lanes  = this->narrowLanes.data();
+      triton::uint64* dst    = lanes + ins.dst.index * BATCH_LANES;
+      triton::uint32 lane    = 0;
+
+      #if defined(TRITON_LANES_VECTOR)
+      {
+        const triton::uint64* a = lanes + args[0].index * BATCH_LANES;
+        const triton::uint64* b = (ins.count > 1) ? lanes + args[1].index * BATCH_LANES : a;
+        const triton::uint64* c = (ins.count > 2) ? lanes + args[2].index * BATCH_LANES : a;
+        const Vector mask = vset(Word<triton::uint64>::mask(ins.size));
+        const Vector zero = vset(0);
+        const Vector one  = vset(1);
+
+        switch (ins.opcode) {
+          case OP_BVADD:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(vadd(vload(a + i), vload(b + i)), mask); }); break;
+          case OP_BVAND:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(vload(a + i), vload(b + i)); }); break;
+          case OP_BVNAND:   lane = vectorize(dst, count, [&](triton::uint32 i) { return vxor(vand(vload(a + i), vload(b + i)), mask); }); break;
+          case OP_BVNEG:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(vsub(zero, vload(a + i)), mask); }); break;
+          case OP_BVNOR:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vxor(vor(vload(a + i), vload(b + i)), mask); }); break;
+          case OP_BVNOT:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vxor(vload(a + i), mask); }); break;
+          case OP_BVOR:     lane = vectorize(dst, count, [&](triton::uint32 i) { return vor(vload(a + i), vload(b + i)); }); break;
+          case OP_BVSUB:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(vsub(vload(a + i), vload(b + i)), mask); }); break;
+          case OP_BVXNOR:   lane = vectorize(dst, count, [&](triton::uint32 i) { return vxor(vxor(vload(a + i), vload(b + i)), mask); }); break;
+          case OP_BVXOR:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vxor(vload(a + i), vload(b + i)); }); break;
+          case OP_DISTINCT: lane = vectorize(dst, count, [&](triton::uint32 i) { return vandnot(veq(vload(a + i), vload(b + i)), one); }); break;
+          case OP_EQUAL:    lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(veq(vload(a + i), vload(b + i)), one); }); break;
+          case OP_LNOT:     lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(veq(vload(a + i), zero), one); }); break;
+          case OP_ZX:       lane = vectorize(dst, count, [&](triton::uint32 i) { return vload(a + i); }); break;
+          case OP_EXTRACT:  lane = vectorize(dst, count, [&](triton::uint32 i) { return vand(vshr(vload(a + i), ins.imm), mask); }); break;
+
+          case OP_IFF:
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              return vandnot(vxor(veq(vload(a + i), zero), veq(vload(b + i), zero)), one);
+            });
+            break;
+
+          case OP_ITE:
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              Vector cond = veq(vload(a + i), zero);
+              return vor(vandnot(cond, vload(b + i)), vand(cond, vload(c + i)));
+            });
+            break;
+
+          case OP_LAND:
+          case OP_LOR:
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              /* For land, true if any operand is false. For lor, true if all operands are false */
+              Vector acc = (ins.opcode == OP_LAND) ? zero : veq(zero, zero);
+              for (triton::uint32 index = 0; index < ins.count; index++) {
+                Vector isZero = veq(vload(lanes + args[index].index * BATCH_LANES + i), zero);
+                acc = (ins.opcode == OP_LAND) ? vor(acc, isZero) : vand(acc, isZero);
+              }
+              return vandnot(acc, one);
+            });
+            break;
+
+          case OP_BVROL:
+          case OP_BVROR:
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              Vector value = vload(a + i);
+              if (ins.imm == 0)
+                return value;
+              if (ins.opcode == OP_BVROL)
+                return vand(vor(vshl(value, ins.imm), vshr(value, ins.size - ins.imm)), mask);
+              return vand(vor(vshr(value, ins.imm), vshl(value, ins.size - ins.imm)), mask);
+            });
+            break;
+
+          case OP_CONCAT:
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              Vector value = vload(a + i);
+              for (triton::uint32 index = 1; index < ins.count; index++)
+                value = vor(vshl(value, this->operandSizes[ins.first + index]), vload(lanes + args[index].index * BATCH_LANES + i));
+              return value;
+            });
+            break;
+
+          case OP_SX: {
+            triton::uint32 inner = this->operandSizes[ins.first];
+            const Vector sign    = vset(static_cast<triton::uint64>(1) << (inner - 1));
+            const Vector ext     = vset(~Word<triton::uint64>::mask(inner) & Word<triton::uint64>::mask(ins.size));
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              Vector value = vload(a + i);
+              return vor(value, vandnot(veq(vand(value, sign), zero), ext));
+            });
+            break;
+          }
+
+          #if defined(TRITON_LANES_COMPARE)
+          case OP_BVUGE:
+          case OP_BVUGT:
+          case OP_BVULE:
+          case OP_BVULT:
+          case OP_BVSGE:
+          case OP_BVSGT:
+          case OP_BVSLE:
+          case OP_BVSLT: {
+            /*
+             * Only signed 64-bit comparisons exist. Unsigned operands are biased by the sign bit,
+             * signed operands are shifted so that their sign bit becomes bit 63.
+             */
+            bool isSigned = (ins.opcode == OP_BVSGE || ins.opcode == OP_BVSGT || ins.opcode == OP_BVSLE || ins.opcode == OP_BVSLT);
+            bool swap     = (ins.opcode == OP_BVUGE || ins.opcode == OP_BVULT || ins.opcode == OP_BVSGE || ins.opcode == OP_BVSLT);
+            bool negate   = (ins.opcode == OP_BVUGE || ins.opcode == OP_BVULE || ins.opcode == OP_BVSGE || ins.opcode == OP_BVSLE);
+            const Vector bias = vset(static_cast<triton::uint64>(1) << 63);
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              Vector x = vload(a + i);
+              Vector y = vload(b + i);
+              if (isSigned) {
+                x = vshl(x, 64 - ins.size);
+                y = vshl(y, 64 - ins.size);
+              }
+              else {
+                x = vxor(x, bias);
+                y = vxor(y, bias);
+              }
+              /* x > y, with the operands swapped for < and >=, negated for <= and >= */
+              Vector gt = swap ? vgt(y, x) : vgt(x, y);
+              return negate ? vandnot(gt, one) : vand(gt, one);
+            });
+            break;
+          }
+          #endif
+
+          #if defined(TRITON_LANES_SHIFT)
+          case OP_BVSHL:
+          case OP_BVLSHR: {
+            /* The shift amounts are truncated to 32 bits like in the scalar path */
+            const Vector low = vset(0xffffffff);
+            lane = vectorize(dst, count, [&](triton::uint32 i) -> Vector {
+              Vector n = vand(vload(b + i), low);
+              if (ins.opcode == OP_BVSHL)
+                return vand(vshlv(vload(a + i), n), mask);
+              return vshrv(vload(a + i), n);
+            });
+            break;
+          }
+          #endif
+
+          default:
+            break;
+        }
+      }
+      #endif
+
+      /* Remaining lanes and operations without vector form */
+      for (; lane < count; lane++) {
+        const auto load = [lanes, args, lane](triton::uint32 index) -> triton::uint64 {
+          return lanes[args[index].index * BATCH_LANES + lane];
+        };
+        dst[lane] = this->execute<triton::uint64>(ins, load);
+      }
+    }
+
+
+    const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& AstBytecode::getVariables(void) const {
+      return this->variables;
+    }
+
+
+    triton::uint32 AstBytecode::getBitvectorSize(void) const {
+      return this->size;
+    }
+
+
+    triton::usize AstBytecode::getInstructionCount(void) const {
+      return this->code.size();
+    }
+
+
+    triton::uint512 AstBytecode::evaluate(const std::vector<triton::uint512>& values) {
+      if (values.size() != this->variables.size())
+        throw triton::exceptions::Ast("AstBytecode::evaluate(): The number of values must be equal to the number of variables.");
+
+      /* Load the inputs */
+      for (triton::usize index = 0; index < values.size(); index++) {
+        const Operand& reg = this->inputs[index];
+        triton::uint512 value = values[index] & Word<triton::uint512>::mask(this->variables[index]->getSize());
+        if (reg.wide)
+          this->wide[reg.index] = value;
+        else
+          this->narrow[reg.index] = value.convert_to<triton::uint64>();
+      }
+
+      for (const auto& ins : this->code) {
+        const Operand* args = &this->operands[ins.first];
+
+        if (ins.wide == false) {
+          const auto load = [this, args](triton::uint32 index) -> triton::uint64 {
+            return this->narrow[args[index].index];
+          };
+          this->narrow[ins.dst.index] = this->execute<triton::uint64>(ins, load);
+          continue;
+        }
+
+        const auto load = [this, args](triton::uint32 index) -> triton::uint512 {
+          if (args[index].wide)
+            return this->wide[args[index].index];
+          return this->narrow[args[index].index];
+        };
+        triton::uint512 value = this->execute<triton::uint512>(ins, load);
+        if (ins.dst.wide)
+          this->wide[ins.dst.index] = value;
+        else
+          this->narrow[ins.dst.index] = value.convert_to<triton::uint64>();
+      }
+
+      if (this->result.wide)
+        return this->wide[this->result.index];
+      return this->narrow[this->result.index];
+    }
+
+
+    std::vector<triton::uint512> AstBytecode::evaluateBatch(const std::vector<std::vector<triton::uint512>>& assignments) {
+      std::vector<triton::uint512> ret;
+
+      for (const auto& values : assignments) {
+        if (values.size() != this->variables.size())
+          throw triton::exceptions::Ast("AstBytecode::evaluateBatch(): The number of values must be equal to the number of variables.");
+      }
+
+      /* Broadcast the constants, the other registers are written before being read */
+      this->narrowLanes.resize(this->narrow.size() * BATCH_LANES);
+      this->wideLanes.resize(this->wide.size() * BATCH_LANES);
+      for (triton::usize index = 0; index < this->narrow.size(); index++)
+        std::fill(this->narrowLanes.begin() + index * BATCH_LANES, this->narrowLanes.begin() + (index + 1) * BATCH_LANES, this->narrow[index]);
+      for (triton::usize index = 0; index < this->wide.size(); index++)
+        std::fill(this->wideLanes.begin() + index * BATCH_LANES, this->wideLanes.begin() + (index + 1) * BATCH_LANES, this->wide[index]);
+
+      ret.reserve(assignments.size());
+      for (triton::usize base = 0; base < assignments.size(); base += BATCH_LANES) {
+        triton::uint32 count = static_cast<triton::uint32>(std::min<triton::usize>(BATCH_LANES, assignments.size() - base));
+
+        /* Load the inputs */
+        for (triton::usize index = 0; index < this->inputs.size(); index++) {
+          const Operand& reg = this->inputs[index];
+          const triton::uint512 mask = Word<triton::uint512>::mask(this->variables[index]->getSize());
+          for (triton::uint32 lane = 0; lane < count; lane++) {
+            triton::uint512 value = assignments[base + lane][index] & mask;
+            if (reg.wide)
+              this->wideLanes[reg.index * BATCH_LANES + lane] = value;
+            else
+              this->narrowLanes[reg.index * BATCH_LANES + lane] = value.convert_to<triton::uint64>();
+          }
+        }
+
+        for (const auto& ins : this->code) {
+          if (ins.wide == false) {
+            this->executeLanes(ins, count);
+            continue;
+          }
+
+          const Operand* args = &this->operands[ins.first];
+          for (triton::uint32 lane = 0; lane < count; lane++) {
+            const auto load = [this, args, lane](triton::uint32 index) -> triton::uint512 {
+              if (args[index].wide)
+                return this->wideLanes[args[index].index * BATCH_LANES + lane];
+              return this->narrowLanes[args[index].index * BATCH_LANES + lane];
+            };
+            triton::uint512 value = this->execute<triton::uint512>(ins, load);
+            if (ins.dst.wide)
+              this->wideLanes[ins.dst.index * BATCH_LANES + lane] = value;
+            else
+              this->narrowLanes[ins.dst.index * BATCH_LANES + lane] = value.convert_to<triton::uint64>();
+          }
+        }
+
+        for (triton::uint32 lane = 0; lane < count; lane++) {
+          if (this->result.wide)
+            ret.push_back(this->wideLanes[this->result.index * BATCH_LANES + lane]);
+          else
+            ret.push_back(this->narrowLanes[this->result.index * BATCH_LANES + lane]);
+        }
+      }
+
+      return ret;
+    }
+
+  };
+};
@@ -5,6 +5,8 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+
 #include <triton/ast.hpp>
 #include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
@@ -16,6 +18,14 @@
 namespace triton {
   namespace ast {
 
+    namespace {
+      /* Returns the value of the n-th child of a node, which must be an integer node */
+      triton::uint32 getIntegerChild(const SharedAbstractNode& node, triton::uint32 index) {
+        return reinterpret_cast<IntegerNode*>(node->getChildren()[index].get())->getInteger().convert_to<triton::uint32>();
+      }
+    };
+
+
     AstContext::AstContext(triton::modes::Modes& modes)
       : modes(modes) {
     }
@@ -41,6 +51,62 @@ namespace triton {
     }
 
 
+    /*
+     * The builders fold on the values of the operands before allocating their node. A reference
+     * is not folded itself, but an operator on concrete references is, like on any other operand.
+     */
+    bool AstContext::isFoldable(const SharedAbstractNode& expr) const {
+      return this->modes.isModeEnabled(triton::modes::CONSTANT_FOLDING) && !expr->isSymbolized();
+    }
+
+
+    /* The operands of different sizes are left to the node, which reports the error */
+    bool AstContext::isFoldable(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) const {
+      return this->isFoldable(expr1) && !expr2->isSymbolized() && expr1->getBitvectorSize() == expr2->getBitvectorSize();
+    }
+
+
+    /* The bv leaf keeps its value as given, an unmasked one would be printed and hashed as is */
+    SharedAbstractNode AstContext::folded(const triton::uint512& value, triton::uint32 size) {
+      triton::uint512 mask = -1;
+      return this->bv(value & (mask >> (512 - size)), size);
+    }
+
+
+    std::vector<SharedAbstractNode> AstContext::mergeConcat(const std::vector<SharedAbstractNode>& exprs) {
+      std::vector<SharedAbstractNode> stack;
+
+      for (const auto& expr : exprs) {
+        stack.push_back(expr);
+        while (stack.size() >= 2) {
+          const SharedAbstractNode& left  = stack[stack.size() - 2];
+          const SharedAbstractNode& right = stack[stack.size() - 1];
+          SharedAbstractNode merged       = nullptr;
+
+          /* Optimization: concat(extract(h, m + 1, A), extract(m, l, A)) = extract(h, l, A) */
+          if (left->getType() == EXTRACT_NODE && right->getType() == EXTRACT_NODE &&
+              left->getChildren()[2] == right->getChildren()[2] &&
+              getIntegerChild(left, 1) == getIntegerChild(right, 0) + 1) {
+            merged = this->extract(getIntegerChild(left, 0), getIntegerChild(right, 1), left->getChildren()[2]);
+          }
+
+          /* Optimization: concat(bv, bv) = bv' */
+          else if (left->getType() == BV_NODE && right->getType() == BV_NODE) {
+            merged = this->bv((left->evaluate() << right->getBitvectorSize()) | right->evaluate(), left->getBitvectorSize() + right->getBitvectorSize());
+          }
+
+          if (merged == nullptr)
+            break;
+
+          stack.pop_back();
+          stack.back() = merged;
+        }
+      }
+
+      return stack;
+    }
+
+
     SharedAbstractNode AstContext::assert_(const SharedAbstractNode& expr) {
       SharedAbstractNode node = std::make_shared<AssertNode>(expr);
       if (node == nullptr)
@@ -70,6 +136,10 @@ namespace triton {
           return expr1;
       }
 
+      /* Constant folding: the sum of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() + expr2->evaluate(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvaddNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -102,6 +172,10 @@ namespace triton {
           return expr1;
       }
 
+      /* Constant folding: the conjunction of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() & expr2->evaluate(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvandNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -122,6 +196,22 @@ namespace triton {
           return expr1;
       }
 
+      /* Constant folding: the arithmetic shift of the operands, the sign bit fills the vacated bits */
+      if (this->isFoldable(expr1, expr2)) {
+        triton::uint32 size   = expr1->getBitvectorSize();
+        triton::uint32 shift  = expr2->evaluate().convert_to<triton::uint32>();
+        triton::uint512 value = expr1->evaluate();
+        bool sign             = ((value >> (size - 1)) & 1) == 1;
+
+        if (shift >= size)
+          return this->folded(sign ? expr1->getBitvectorMask() : 0, size);
+
+        value >>= shift;
+        if (sign)
+          value |= (expr1->getBitvectorMask() << (size - shift));
+        return this->folded(value, size);
+      }
+
       SharedAbstractNode node = std::make_shared<BvashrNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -155,6 +245,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
+      /* Constant folding: the logical shift of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() >> expr2->evaluate().convert_to<triton::uint32>(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvlshrNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -175,6 +269,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
+      /* Constant folding: the product of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() * expr2->evaluate(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvmulNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -185,6 +283,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvnand(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      /* Constant folding: the nand of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(~(expr1->evaluate() & expr2->evaluate()), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvnandNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -194,6 +296,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvneg(const SharedAbstractNode& expr) {
+      /* Constant folding: the opposite of the operand */
+      if (this->isFoldable(expr))
+        return this->folded((-(expr->evaluate().convert_to<triton::sint512>())).convert_to<triton::uint512>(), expr->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvnegNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -203,6 +309,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvnor(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      /* Constant folding: the nor of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(~(expr1->evaluate() | expr2->evaluate()), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvnorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -212,6 +322,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvnot(const SharedAbstractNode& expr) {
+      /* Constant folding: the complement of the operand */
+      if (this->isFoldable(expr))
+        return this->folded(~expr->evaluate(), expr->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvnotNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -243,6 +357,10 @@ namespace triton {
           return expr1;
       }
 
+      /* Constant folding: the disjunction of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() | expr2->evaluate(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -253,6 +371,14 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvrol(const SharedAbstractNode& expr, triton::uint32 rot) {
+      /* Constant folding: the rotated operand */
+      if (this->isFoldable(expr)) {
+        triton::uint32 size   = expr->getBitvectorSize();
+        triton::uint512 value = expr->evaluate();
+        rot %= size;
+        return this->folded((value << rot) | (value >> (size - rot)), size);
+      }
+
       SharedAbstractNode node = std::make_shared<BvrolNode>(expr, rot);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -280,6 +406,9 @@ namespace triton {
       }
 
       /* Otherwise, we concretize the index rotation */
+      if (this->isFoldable(expr))
+        return this->bvrol(expr, rot->evaluate().convert_to<triton::uint32>());
+
       SharedAbstractNode node = std::make_shared<BvrolNode>(expr, this->integer(rot->evaluate()));
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -290,6 +419,14 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvror(const SharedAbstractNode& expr, triton::uint32 rot) {
+      /* Constant folding: the rotated operand */
+      if (this->isFoldable(expr)) {
+        triton::uint32 size   = expr->getBitvectorSize();
+        triton::uint512 value = expr->evaluate();
+        rot %= size;
+        return this->folded((value >> rot) | (value << (size - rot)), size);
+      }
+
       SharedAbstractNode node = std::make_shared<BvrorNode>(expr, rot);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -317,6 +454,9 @@ namespace triton {
       }
 
       /* Otherwise, we concretize the index rotation */
+      if (this->isFoldable(expr))
+        return this->bvror(expr, rot->evaluate().convert_to<triton::uint32>());
+
       SharedAbstractNode node = std::make_shared<BvrorNode>(expr, this->integer(rot->evaluate()));
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -333,6 +473,15 @@ namespace triton {
           return expr1;
       }
 
+      /* Constant folding: the signed quotient, -1 or 1 for a zero divisor */
+      if (this->isFoldable(expr1, expr2)) {
+        triton::sint512 op1Signed = triton::ast::modularSignExtend(expr1.get());
+        triton::sint512 op2Signed = triton::ast::modularSignExtend(expr2.get());
+        if (op2Signed == 0)
+          return this->folded(op1Signed < 0 ? 1 : expr1->getBitvectorMask(), expr1->getBitvectorSize());
+        return this->folded((op1Signed / op2Signed).convert_to<triton::uint512>(), expr1->getBitvectorSize());
+      }
+
       SharedAbstractNode node = std::make_shared<BvsdivNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -375,6 +524,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
+      /* Constant folding: the left shift of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() << expr2->evaluate().convert_to<triton::uint32>(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvshlNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -403,6 +556,15 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsmod(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      /* Constant folding: the signed modulo with the sign of the divisor, the dividend for a zero divisor */
+      if (this->isFoldable(expr1, expr2)) {
+        triton::sint512 op1Signed = triton::ast::modularSignExtend(expr1.get());
+        triton::sint512 op2Signed = triton::ast::modularSignExtend(expr2.get());
+        if (op2Signed == 0)
+          return this->folded(expr1->evaluate(), expr1->getBitvectorSize());
+        return this->folded((((op1Signed % op2Signed) + op2Signed) % op2Signed).convert_to<triton::uint512>(), expr1->getBitvectorSize());
+      }
+
       SharedAbstractNode node = std::make_shared<BvsmodNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -412,6 +574,15 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsrem(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      /* Constant folding: the signed remainder with the sign of the dividend, the dividend for a zero divisor */
+      if (this->isFoldable(expr1, expr2)) {
+        triton::sint512 op1Signed = triton::ast::modularSignExtend(expr1.get());
+        triton::sint512 op2Signed = triton::ast::modularSignExtend(expr2.get());
+        if (op2Signed == 0)
+          return this->folded(expr1->evaluate(), expr1->getBitvectorSize());
+        return this->folded((op1Signed - ((op1Signed / op2Signed) * op2Signed)).convert_to<triton::uint512>(), expr1->getBitvectorSize());
+      }
+
       SharedAbstractNode node = std::make_shared<BvsremNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -435,6 +606,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
+      /* Constant folding: the difference of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() - expr2->evaluate(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvsubNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -460,6 +635,10 @@ namespace triton {
           return expr1;
       }
 
+      /* Constant folding: the unsigned quotient, all ones for a zero divisor */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded((expr2->evaluate() == 0) ? expr1->getBitvectorMask() : (expr1->evaluate() / expr2->evaluate()), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvudivNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -506,6 +685,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvurem(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      /* Constant folding: the unsigned remainder, the dividend for a zero divisor */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded((expr2->evaluate() == 0) ? expr1->evaluate() : (expr1->evaluate() % expr2->evaluate()), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvuremNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -515,6 +698,10 @@ namespace triton {
 
 
      SharedAbstractNode AstContext::bvxnor(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      /* Constant folding: the xnor of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(~(expr1->evaluate() ^ expr2->evaluate()), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvxnorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -538,6 +725,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
+      /* Constant folding: the exclusive disjunction of the operands */
+      if (this->isFoldable(expr1, expr2))
+        return this->folded(expr1->evaluate() ^ expr2->evaluate(), expr1->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<BvxorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -552,6 +743,16 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::concat(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
+      if (this->modes.isModeEnabled(triton::modes::AST_OPTIMIZATIONS)) {
+        std::vector<SharedAbstractNode> exprs = this->mergeConcat({expr1, expr2});
+        if (exprs.size() == 1)
+          return exprs[0];
+      }
+
+      /* Constant folding: the concatenation of the operands */
+      if (this->isFoldable(expr1) && this->isFoldable(expr2) && expr1->getBitvectorSize() + expr2->getBitvectorSize() <= MAX_BITS_SUPPORTED)
+        return this->folded((expr1->evaluate() << expr2->getBitvectorSize()) | expr2->evaluate(), expr1->getBitvectorSize() + expr2->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<ConcatNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -596,6 +797,68 @@ namespace triton {
       if (low == 0 && (high + 1) == expr->getBitvectorSize())
         return expr;
 
+      if (this->modes.isModeEnabled(triton::modes::AST_OPTIMIZATIONS)) {
+        switch (expr->getType()) {
+          /* Optimization: extract(h, l, bv) = bv' */
+          case BV_NODE:
+            return this->bv((expr->evaluate() >> low) & ((triton::uint512(1) << ((high - low) + 1)) - 1), (high - low) + 1);
+
+          /* Optimization: extract(h, l, extract(h', l', A)) = extract(h + l', l + l', A) */
+          case EXTRACT_NODE: {
+            triton::uint32 offset = getIntegerChild(expr, 1);
+            return this->extract(high + offset, low + offset, expr->getChildren()[2]);
+          }
+
+          /* Optimization: extract(h, l, concat(A, B, ...)) = concat of the extracted parts of A, B, ... */
+          case CONCAT_NODE: {
+            std::vector<SharedAbstractNode> parts;
+            triton::uint32 offset = 0;
+
+            /* The last child holds the least significant bits */
+            const std::vector<SharedAbstractNode>& children = expr->getChildren();
+            for (auto it = children.rbegin(); it != children.rend() && offset <= high; it++) {
+              triton::uint32 size = (*it)->getBitvectorSize();
+              if (offset + size > low)
+                parts.insert(parts.begin(), this->extract(std::min(high, offset + size - 1) - offset, std::max(low, offset) - offset, *it));
+              offset += size;
+            }
+
+            if (parts.size() == 1)
+              return parts[0];
+            return this->concat(parts);
+          }
+
+          /* Optimization: extract(h, l, zx(n, A)) = extract(h, l, A), 0 or zx(n', extract(size(A) - 1, l, A)) */
+          case ZX_NODE: {
+            const SharedAbstractNode& child = expr->getChildren()[1];
+            triton::uint32 size = child->getBitvectorSize();
+            if (high < size)
+              return this->extract(high, low, child);
+            if (low >= size)
+              return this->bv(0, (high - low) + 1);
+            return this->zx(high - size + 1, this->extract(size - 1, low, child));
+          }
+
+          /* Optimization: extract(h, l, sx(n, A)) = extract(h, l, A), sx(n', extract(size(A) - 1, l, A)) or sx(n', sign(A)) */
+          case SX_NODE: {
+            const SharedAbstractNode& child = expr->getChildren()[1];
+            triton::uint32 size = child->getBitvectorSize();
+            if (high < size)
+              return this->extract(high, low, child);
+            if (low >= size)
+              return this->sx(high - low, this->extract(size - 1, size - 1, child));
+            return this->sx(high - size + 1, this->extract(size - 1, low, child));
+          }
+
+          default:
+            break;
+        }
+      }
+
+      /* Constant folding: the extracted bits */
+      if (this->isFoldable(expr) && low <= high && high < expr->getBitvectorSize())
+        return this->folded(expr->evaluate() >> low, (high - low) + 1);
+
       SharedAbstractNode node = std::make_shared<ExtractNode>(high, low, expr);
 
       if (node == nullptr)
@@ -625,6 +888,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::ite(const SharedAbstractNode& ifExpr, const SharedAbstractNode& thenExpr, const SharedAbstractNode& elseExpr) {
+      /* Constant folding: the value of the taken branch */
+      if (this->isFoldable(thenExpr, elseExpr) && ifExpr->isLogical() && !ifExpr->isSymbolized())
+        return this->folded(ifExpr->evaluate() ? thenExpr->evaluate() : elseExpr->evaluate(), thenExpr->getBitvectorSize());
+
       SharedAbstractNode node = std::make_shared<IteNode>(ifExpr, thenExpr, elseExpr);
       if (node == nullptr)
         throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -700,6 +967,38 @@ namespace triton {
       if (sizeExt == 0)
         return expr;
 
+      if (this->modes.isModeEnabled(triton::modes::AST_OPTIMIZATIONS)) {
+        triton::uint32 size = expr->getBitvectorSize();
+        switch (expr->getType()) {
+          /* Optimization: sx(n, bv) = bv' */
+          case BV_NODE: {
+            triton::uint512 value = expr->evaluate();
+            if ((value >> (size - 1)) & 1)
+              value |= (((triton::uint512(1) << sizeExt) - 1) << size);
+            return this->bv(value, size + sizeExt);
+          }
+
+          /* Optimization: sx(n, sx(m, A)) = sx(n + m, A) */
+          case SX_NODE:
+            return this->sx(sizeExt + getIntegerChild(expr, 0), expr->getChildren()[1]);
+
+          /* Optimization: sx(n, zx(m, A)) = zx(n + m, A) */
+          case ZX_NODE:
+            return this->zx(sizeExt + getIntegerChild(expr, 0), expr->getChildren()[1]);
+
+          default:
+            break;
+        }
+      }
+
+      /* Constant folding: the operand with its sign bit replicated */
+      if (this->isFoldable(expr) && expr->getBitvectorSize() + sizeExt <= MAX_BITS_SUPPORTED) {
+        triton::uint512 value = expr->evaluate();
+        if (expr->isSigned())
+          value |= ~expr->getBitvectorMask();
+        return this->folded(value, expr->getBitvectorSize() + sizeExt);
+      }
+
       SharedAbstractNode node = std::make_shared<SxNode>(sizeExt, expr);
 
       if (node == nullptr)
@@ -740,6 +1039,25 @@ namespace triton {
       if (sizeExt == 0)
         return expr;
 
+      if (this->modes.isModeEnabled(triton::modes::AST_OPTIMIZATIONS)) {
+        switch (expr->getType()) {
+          /* Optimization: zx(n, bv) = bv' */
+          case BV_NODE:
+            return this->bv(expr->evaluate(), expr->getBitvectorSize() + sizeExt);
+
+          /* Optimization: zx(n, zx(m, A)) = zx(n + m, A) */
+          case ZX_NODE:
+            return this->zx(sizeExt + getIntegerChild(expr, 0), expr->getChildren()[1]);
+
+          default:
+            break;
+        }
+      }
+
+      /* Constant folding: the operand */
+      if (this->isFoldable(expr) && expr->getBitvectorSize() + sizeExt <= MAX_BITS_SUPPORTED)
+        return this->folded(expr->evaluate(), expr->getBitvectorSize() + sizeExt);
+
       SharedAbstractNode node = std::make_shared<ZxNode>(sizeExt, expr);
 
       if (node == nullptr)
@@ -784,6 +1102,11 @@ namespace triton {
     }
 
 
+    void AstContext::clearVariables(void) {
+      this->valueMapping.clear();
+    }
+
+
     void AstContext::setRepresentationMode(triton::uint32 mode) {
       this->astRepresentation.setMode(mode);
     }
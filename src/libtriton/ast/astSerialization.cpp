@@ -0,0 +1,525 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <cstring>
+#include <utility>
+
+#include <triton/astContext.hpp>
+#include <triton/astSerialization.hpp>
+#include <triton/cpuSize.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/memoryAccess.hpp>
+
+
+
+namespace triton {
+  namespace ast {
+
+    namespace {
+      /* Returns the value of the n-th child of a node, which must be an integer node */
+      triton::uint32 getIntegerChild(const std::vector<SharedAbstractNode>& children, triton::uint32 index) {
+        if (children[index]->getType() != INTEGER_NODE)
+          throw triton::exceptions::Ast("AstReader::build(): Expects an integer node.");
+        return reinterpret_cast<IntegerNode*>(children[index].get())->getInteger().convert_to<triton::uint32>();
+      }
+
+      /* Checks the number of children of a node */
+      void checkArity(const std::vector<SharedAbstractNode>& children, triton::usize arity) {
+        if (children.size() != arity)
+          throw triton::exceptions::Ast("AstReader::build(): Invalid number of children.");
+      }
+    };
+
+
+    AstWriter::AstWriter(std::ostream& stream, const AstContext& ctxt)
+      : stream(stream),
+        ctxt(ctxt) {
+      this->count = 0;
+    }
+
+
+    void AstWriter::writeInteger(triton::uint64 value) {
+      while (value >= 0x80) {
+        this->stream.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+      }
+      this->stream.put(static_cast<char>(value));
+    }
+
+
+    void AstWriter::writeInteger(const triton::uint512& value) {
+      triton::uint512 v = value;
+      while (v >= 0x80) {
+        this->stream.put(static_cast<char>((v & 0x7f).convert_to<triton::uint32>() | 0x80));
+        v >>= 7;
+      }
+      this->stream.put(static_cast<char>(v.convert_to<triton::uint32>()));
+    }
+
+
+    void AstWriter::writeString(const std::string& value) {
+      this->writeInteger(static_cast<triton::uint64>(value.size()));
+      this->stream.write(value.data(), value.size());
+    }
+
+
+    void AstWriter::writeNodeIndex(const SharedAbstractNode& node) {
+      auto it = this->indexes.find(node.get());
+      if (it == this->indexes.end())
+        throw triton::exceptions::Ast("AstWriter::writeNodeIndex(): The node is not written.");
+      this->writeInteger(static_cast<triton::uint64>(this->count - it->second));
+    }
+
+
+    void AstWriter::writeVariable(const triton::engines::symbolic::SharedSymbolicVariable& var) {
+      if (!this->variables.insert(var->getId()).second)
+        return;
+
+      this->writeInteger(static_cast<triton::uint64>(VARIABLE_RECORD));
+      this->writeInteger(static_cast<triton::uint64>(var->getId()));
+      this->writeInteger(static_cast<triton::uint64>(var->getType()));
+      this->writeInteger(var->getOrigin());
+      this->writeInteger(static_cast<triton::uint64>(var->getSize()));
+      this->writeString(var->getAlias());
+      this->writeString(var->getComment());
+      /* A variable never used in an AST has no value yet, it takes the default one of AstContext::variable() */
+      try {
+        this->writeInteger(this->ctxt.getVariableValue(var->getName()));
+      }
+      catch (const triton::exceptions::Ast&) {
+        this->writeInteger(0);
+      }
+    }
+
+
+    void AstWriter::emit(const triton::engines::symbolic::SharedSymbolicExpression& expr) {
+      this->writeInteger(static_cast<triton::uint64>(EXPRESSION_RECORD));
+      this->writeInteger(static_cast<triton::uint64>(expr->getId()));
+      this->writeInteger(static_cast<triton::uint64>(expr->getType()));
+
+      switch (expr->getType()) {
+        case triton::engines::symbolic::REGISTER_EXPRESSION:
+          this->writeInteger(static_cast<triton::uint64>(expr->getOriginRegister().getId()));
+          break;
+        case triton::engines::symbolic::MEMORY_EXPRESSION:
+          this->writeInteger(expr->getOriginMemory().getAddress());
+          this->writeInteger(static_cast<triton::uint64>(expr->getOriginMemory().getSize()));
+          break;
+        default:
+          break;
+      }
+
+      this->writeString(expr->getComment());
+      this->writeInteger(static_cast<triton::uint64>(expr->isTainted));
+      this->writeNodeIndex(expr->getAst());
+    }
+
+
+    void AstWriter::emit(const SharedAbstractNode& node) {
+      switch (node->getType()) {
+        case VARIABLE_NODE:
+          this->writeVariable(reinterpret_cast<VariableNode*>(node.get())->getSymbolicVariable());
+          break;
+        case REFERENCE_NODE: {
+          const auto& expr = reinterpret_cast<ReferenceNode*>(node.get())->getSymbolicExpression();
+          if (this->expressions.insert(expr->getId()).second)
+            this->emit(expr);
+          break;
+        }
+        default:
+          break;
+      }
+
+      this->writeInteger(static_cast<triton::uint64>(NODE_RECORD));
+      this->writeInteger(static_cast<triton::uint64>(node->getType()));
+
+      switch (node->getType()) {
+        case BV_NODE:
+          this->writeInteger(node->evaluate());
+          this->writeInteger(static_cast<triton::uint64>(node->getBitvectorSize()));
+          break;
+        case INTEGER_NODE:
+          this->writeInteger(reinterpret_cast<IntegerNode*>(node.get())->getInteger());
+          break;
+        case STRING_NODE:
+          this->writeString(reinterpret_cast<StringNode*>(node.get())->getString());
+          break;
+        case VARIABLE_NODE:
+          this->writeInteger(static_cast<triton::uint64>(reinterpret_cast<VariableNode*>(node.get())->getSymbolicVariable()->getId()));
+          break;
+        case REFERENCE_NODE:
+          this->writeInteger(static_cast<triton::uint64>(reinterpret_cast<ReferenceNode*>(node.get())->getSymbolicExpression()->getId()));
+          break;
+        default:
+          this->writeInteger(static_cast<triton::uint64>(node->getChildren().size()));
+          for (const auto& child : node->getChildren())
+            this->writeNodeIndex(child);
+          break;
+      }
+
+      this->indexes[node.get()] = this->count++;
+    }
+
+
+    void AstWriter::writeNode(const SharedAbstractNode& node) {
+      std::unordered_set<AbstractNode*> visited;
+      std::vector<std::pair<SharedAbstractNode, bool>> worklist;
+
+      /* Post order walk of the nodes which are not written yet, references included */
+      worklist.push_back(std::make_pair(node, false));
+      while (!worklist.empty()) {
+        SharedAbstractNode current = worklist.back().first;
+        bool operandsWritten = worklist.back().second;
+        worklist.pop_back();
+
+        if (operandsWritten) {
+          this->emit(current);
+          continue;
+        }
+
+        if (this->indexes.find(current.get()) != this->indexes.end() || !visited.insert(current.get()).second)
+          continue;
+
+        worklist.push_back(std::make_pair(current, true));
+        if (current->getType() == REFERENCE_NODE) {
+          worklist.push_back(std::make_pair(reinterpret_cast<ReferenceNode*>(current.get())->getSymbolicExpression()->getAst(), false));
+          continue;
+        }
+
+        for (const auto& child : current->getChildren())
+          worklist.push_back(std::make_pair(child, false));
+      }
+    }
+
+
+    void AstWriter::writeExpression(const triton::engines::symbolic::SharedSymbolicExpression& expr) {
+      if (this->expressions.find(expr->getId()) != this->expressions.end())
+        return;
+
+      this->writeNode(expr->getAst());
+      this->expressions.insert(expr->getId());
+      this->emit(expr);
+    }
+
+
+    void AstWriter::writeAst(const SharedAbstractNode& node) {
+      this->writeNode(node);
+      this->writeInteger(static_cast<triton::uint64>(END_RECORD));
+    }
+
+
+    AstReader::AstReader(const triton::uint8* data, triton::usize size, AstContext& ctxt, const triton::arch::Architecture* architecture)
+      : ctxt(ctxt) {
+      this->architecture = architecture;
+      this->data         = data;
+      this->size         = size;
+      this->offset       = 0;
+    }
+
+
+    bool AstReader::isEnd(void) const {
+      return this->offset == this->size;
+    }
+
+
+    void AstReader::readBytes(triton::uint8* buffer, triton::usize length) {
+      if (length > this->size - this->offset)
+        throw triton::exceptions::Ast("AstReader::readBytes(): Unexpected end of data.");
+      std::memcpy(buffer, this->data + this->offset, length);
+      this->offset += length;
+    }
+
+
+    triton::uint64 AstReader::readInteger(void) {
+      triton::uint64 value = 0;
+
+      for (triton::uint32 shift = 0; shift < 64; shift += 7) {
+        if (this->offset == this->size)
+          throw triton::exceptions::Ast("AstReader::readInteger(): Unexpected end of data.");
+
+        triton::uint8 byte = this->data[this->offset++];
+        value |= static_cast<triton::uint64>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+          return value;
+      }
+
+      throw triton::exceptions::Ast("AstReader::readInteger(): Integer too large.");
+    }
+
+
+    triton::uint512 AstReader::readBigInteger(void) {
+      triton::uint512 value = 0;
+
+      for (triton::uint32 shift = 0; shift < 512; shift += 7) {
+        if (this->offset == this->size)
+          throw triton::exceptions::Ast("AstReader::readBigInteger(): Unexpected end of data.");
+
+        triton::uint8 byte = this->data[this->offset++];
+        value |= triton::uint512(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+          return value;
+      }
+
+      throw triton::exceptions::Ast("AstReader::readBigInteger(): Integer too large.");
+    }
+
+
+    std::string AstReader::readString(void) {
+      triton::uint64 length = this->readInteger();
+
+      if (length > this->size - this->offset)
+        throw triton::exceptions::Ast("AstReader::readString(): Unexpected end of data.");
+
+      std::string value(reinterpret_cast<const char*>(this->data + this->offset), static_cast<triton::usize>(length));
+      this->offset += static_cast<triton::usize>(length);
+      return value;
+    }
+
+
+    const SharedAbstractNode& AstReader::readNodeIndex(void) {
+      triton::uint64 delta = this->readInteger();
+
+      if (delta == 0 || delta > this->nodes.size())
+        throw triton::exceptions::Ast("AstReader::readNodeIndex(): Invalid node reference.");
+
+      return this->nodes[this->nodes.size() - static_cast<triton::usize>(delta)];
+    }
+
+
+    SharedAbstractNode AstReader::build(triton::ast::ast_e type, const std::vector<SharedAbstractNode>& children) {
+      SharedAbstractNode node = nullptr;
+
+      switch (type) {
+        case ASSERT_NODE:   checkArity(children, 1); node = std::make_shared<AssertNode>(children[0]); break;
+        case BVADD_NODE:    checkArity(children, 2); node = std::make_shared<BvaddNode>(children[0], children[1]); break;
+        case BVAND_NODE:    checkArity(children, 2); node = std::make_shared<BvandNode>(children[0], children[1]); break;
+        case BVASHR_NODE:   checkArity(children, 2); node = std::make_shared<BvashrNode>(children[0], children[1]); break;
+        case BVLSHR_NODE:   checkArity(children, 2); node = std::make_shared<BvlshrNode>(children[0], children[1]); break;
+        case BVMUL_NODE:    checkArity(children, 2); node = std::make_shared<BvmulNode>(children[0], children[1]); break;
+        case BVNAND_NODE:   checkArity(children, 2); node = std::make_shared<BvnandNode>(children[0], children[1]); break;
+        case BVNEG_NODE:    checkArity(children, 1); node = std::make_shared<BvnegNode>(children[0]); break;
+        case BVNOR_NODE:    checkArity(children, 2); node = std::make_shared<BvnorNode>(children[0], children[1]); break;
+        case BVNOT_NODE:    checkArity(children, 1); node = std::make_shared<BvnotNode>(children[0]); break;
+        case BVOR_NODE:     checkArity(children, 2); node = std::make_shared<BvorNode>(children[0], children[1]); break;
+        case BVROL_NODE:    checkArity(children, 2); node = std::make_shared<BvrolNode>(children[0], children[1]); break;
+        case BVROR_NODE:    checkArity(children, 2); node = std::make_shared<BvrorNode>(children[0], children[1]); break;
+        case BVSDIV_NODE:   checkArity(children, 2); node = std::make_shared<BvsdivNode>(children[0], children[1]); break;
+        case BVSGE_NODE:    checkArity(children, 2); node = std::make_shared<BvsgeNode>(children[0], children[1]); break;
+        case BVSGT_NODE:    checkArity(children, 2); node = std::make_shared<BvsgtNode>(children[0], children[1]); break;
+        case BVSHL_NODE:    checkArity(children, 2); node = std::make_shared<BvshlNode>(children[0], children[1]); break;
+        case BVSLE_NODE:    checkArity(children, 2); node = std::make_shared<BvsleNode>(children[0], children[1]); break;
+        case BVSLT_NODE:    checkArity(children, 2); node = std::make_shared<BvsltNode>(children[0], children[1]); break;
+        case BVSMOD_NODE:   checkArity(children, 2); node = std::make_shared<BvsmodNode>(children[0], children[1]); break;
+        case BVSREM_NODE:   checkArity(children, 2); node = std::make_shared<BvsremNode>(children[0], children[1]); break;
+        case BVSUB_NODE:    checkArity(children, 2); node = std::make_shared<BvsubNode>(children[0], children[1]); break;
+        case BVUDIV_NODE:   checkArity(children, 2); node = std::make_shared<BvudivNode>(children[0], children[1]); break;
+        case BVUGE_NODE:    checkArity(children, 2); node = std::make_shared<BvugeNode>(children[0], children[1]); break;
+        case BVUGT_NODE:    checkArity(children, 2); node = std::make_shared<BvugtNode>(children[0], children[1]); break;
+        case BVULE_NODE:    checkArity(children, 2); node = std::make_shared<BvuleNode>(children[0], children[1]); break;
+        case BVULT_NODE:    checkArity(children, 2); node = std::make_shared<BvultNode>(children[0], children[1]); break;
+        case BVUREM_NODE:   checkArity(children, 2); node = std::make_shared<BvuremNode>(children[0], children[1]); break;
+        case BVXNOR_NODE:   checkArity(children, 2); node = std::make_shared<BvxnorNode>(children[0], children[1]); break;
+        case BVXOR_NODE:    checkArity(children, 2); node = std::make_shared<BvxorNode>(children[0], children[1]); break;
+        case COMPOUND_NODE: node = std::make_shared<CompoundNode>(children, this->ctxt); break;
+        case CONCAT_NODE:   node = std::make_shared<ConcatNode>(children, this->ctxt); break;
+        case DECLARE_NODE:  checkArity(children, 1); node = std::make_shared<DeclareNode>(children[0]); break;
+        case DISTINCT_NODE: checkArity(children, 2); node = std::make_shared<DistinctNode>(children[0], children[1]); break;
+        case EQUAL_NODE:    checkArity(children, 2); node = std::make_shared<EqualNode>(children[0], children[1]); break;
+        case EXTRACT_NODE:  checkArity(children, 3); node = std::make_shared<ExtractNode>(getIntegerChild(children, 0), getIntegerChild(children, 1), children[2]); break;
+        case IFF_NODE:      checkArity(children, 2); node = std::make_shared<IffNode>(children[0], children[1]); break;
+        case ITE_NODE:      checkArity(children, 3); node = std::make_shared<IteNode>(children[0], children[1], children[2]); break;
+        case LAND_NODE:     node = std::make_shared<LandNode>(children, this->ctxt); break;
+        case LNOT_NODE:     checkArity(children, 1); node = std::make_shared<LnotNode>(children[0]); break;
+        case LOR_NODE:      node = std::make_shared<LorNode>(children, this->ctxt); break;
+        case SX_NODE:       checkArity(children, 2); node = std::make_shared<SxNode>(getIntegerChild(children, 0), children[1]); break;
+        case ZX_NODE:       checkArity(children, 2); node = std::make_shared<ZxNode>(getIntegerChild(children, 0), children[1]); break;
+
+        case LET_NODE: {
+          checkArity(children, 3);
+          if (children[0]->getType() != STRING_NODE)
+            throw triton::exceptions::Ast("AstReader::build(): Expects a string node.");
+          node = std::make_shared<LetNode>(reinterpret_cast<StringNode*>(children[0].get())->getString(), children[1], children[2]);
+          break;
+        }
+
+        default:
+          throw triton::exceptions::Ast("AstReader::build(): Invalid type node.");
+      }
+
+      if (node == nullptr)
+        throw triton::exceptions::Ast("AstReader::build(): Not enough memory.");
+
+      node->init();
+      return node;
+    }
+
+
+    const SharedAbstractNode& AstReader::readNode(void) {
+      triton::ast::ast_e type = static_cast<triton::ast::ast_e>(this->readInteger());
+      SharedAbstractNode node = nullptr;
+
+      switch (type) {
+        case BV_NODE: {
+          triton::uint512 value = this->readBigInteger();
+          triton::uint32 size   = static_cast<triton::uint32>(this->readInteger());
+          node = this->ctxt.bv(value, size);
+          break;
+        }
+
+        case INTEGER_NODE:
+          node = this->ctxt.integer(this->readBigInteger());
+          break;
+
+        case STRING_NODE:
+          node = this->ctxt.string(this->readString());
+          break;
+
+        case VARIABLE_NODE: {
+          auto it = this->variables.find(static_cast<triton::usize>(this->readInteger()));
+          if (it == this->variables.end())
+            throw triton::exceptions::Ast("AstReader::readNode(): Unknown symbolic variable.");
+          node = this->ctxt.variable(it->second);
+          break;
+        }
+
+        case REFERENCE_NODE:
+          node = this->ctxt.reference(this->getExpression(static_cast<triton::usize>(this->readInteger())));
+          break;
+
+        default: {
+          std::vector<SharedAbstractNode> children;
+          triton::uint64 n = this->readInteger();
+
+          /* Each child takes at least one byte */
+          if (n > this->size - this->offset)
+            throw triton::exceptions::Ast("AstReader::readNode(): Unexpected end of data.");
+
+          children.reserve(static_cast<triton::usize>(n));
+          for (triton::uint64 index = 0; index < n; index++)
+            children.push_back(this->readNodeIndex());
+
+          node = this->build(type, children);
+          break;
+        }
+      }
+
+      this->nodes.push_back(node);
+      return this->nodes.back();
+    }
+
+
+    const triton::engines::symbolic::SharedSymbolicExpression& AstReader::readExpression(void) {
+      triton::arch::register_e regId = triton::arch::ID_REG_INVALID;
+      triton::uint64 memAddr = 0;
+      triton::uint32 memSize = 0;
+
+      triton::usize id = static_cast<triton::usize>(this->readInteger());
+      triton::uint64 type = this->readInteger();
+
+      switch (type) {
+        case triton::engines::symbolic::REGISTER_EXPRESSION:
+          regId = static_cast<triton::arch::register_e>(this->readInteger());
+          break;
+        case triton::engines::symbolic::MEMORY_EXPRESSION:
+          memAddr = this->readInteger();
+          memSize = static_cast<triton::uint32>(this->readInteger());
+          break;
+        case triton::engines::symbolic::VOLATILE_EXPRESSION:
+          break;
+        default:
+          throw triton::exceptions::Ast("AstReader::readExpression(): Invalid expression type.");
+      }
+
+      std::string comment = this->readString();
+      bool tainted = (this->readInteger() != 0);
+      const SharedAbstractNode& node = this->readNodeIndex();
+
+      if (this->expressions.find(id) != this->expressions.end())
+        throw triton::exceptions::Ast("AstReader::readExpression(): Duplicated symbolic expression.");
+
+      auto expr = std::make_shared<triton::engines::symbolic::SymbolicExpression>(node, id, static_cast<triton::engines::symbolic::expression_e>(type), comment);
+      if (expr == nullptr)
+        throw triton::exceptions::Ast("AstReader::readExpression(): Not enough memory.");
+
+      expr->isTainted = tainted;
+      if (type == triton::engines::symbolic::REGISTER_EXPRESSION && this->architecture && this->architecture->isRegisterValid(regId))
+        expr->setOriginRegister(this->architecture->getRegister(regId));
+      else if (type == triton::engines::symbolic::MEMORY_EXPRESSION)
+        expr->setOriginMemory(triton::arch::MemoryAccess(memAddr, memSize));
+
+      return this->expressions[id] = expr;
+    }
+
+
+    const triton::engines::symbolic::SharedSymbolicVariable& AstReader::readVariable(void) {
+      triton::usize id      = static_cast<triton::usize>(this->readInteger());
+      triton::uint64 type   = this->readInteger();
+      triton::uint64 origin = this->readInteger();
+      triton::uint32 size   = static_cast<triton::uint32>(this->readInteger());
+      std::string alias     = this->readString();
+      std::string comment   = this->readString();
+      triton::uint512 value = this->readBigInteger();
+
+      if (type > triton::engines::symbolic::UNDEFINED_VARIABLE)
+        throw triton::exceptions::Ast("AstReader::readVariable(): Invalid variable type.");
+
+      if (size == 0 || size > MAX_BITS_SUPPORTED)
+        throw triton::exceptions::Ast("AstReader::readVariable(): Invalid variable size.");
+
+      if (this->variables.find(id) != this->variables.end())
+        throw triton::exceptions::Ast("AstReader::readVariable(): Duplicated symbolic variable.");
+
+      auto var = std::make_shared<triton::engines::symbolic::SymbolicVariable>(static_cast<triton::engines::symbolic::variable_e>(type), origin, id, size, comment);
+      if (var == nullptr)
+        throw triton::exceptions::Ast("AstReader::readVariable(): Not enough memory.");
+
+      var->setAlias(alias);
+      this->ctxt.variable(var);
+      this->ctxt.updateVariable(var->getName(), value);
+
+      return this->variables[id] = var;
+    }
+
+
+    SharedAbstractNode AstReader::readAst(void) {
+      SharedAbstractNode node = nullptr;
+
+      while (true) {
+        switch (this->readInteger()) {
+          case VARIABLE_RECORD:
+            this->readVariable();
+            break;
+
+          case NODE_RECORD:
+            node = this->readNode();
+            break;
+
+          case EXPRESSION_RECORD:
+            this->readExpression();
+            break;
+
+          case END_RECORD:
+            if (node == nullptr)
+              throw triton::exceptions::Ast("AstReader::readAst(): Empty AST.");
+            return node;
+
+          default:
+            throw triton::exceptions::Ast("AstReader::readAst(): Invalid record.");
+        }
+      }
+    }
+
+
+    const triton::engines::symbolic::SharedSymbolicExpression& AstReader::getExpression(triton::usize id) const {
+      auto it = this->expressions.find(id);
+      if (it == this->expressions.end())
+        throw triton::exceptions::Ast("AstReader::getExpression(): Unknown symbolic expression.");
+      return it->second;
+    }
+
+  }; /* ast namespace */
+}; /* triton namespace */
@@ -0,0 +1,282 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <utility>
+
+#include <triton/astSmtExporter.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/symbolicVariable.hpp>
+
+
+
+namespace triton {
+  namespace ast {
+
+    namespace {
+      /* Returns the value of the n-th child of a node, which must be an integer node */
+      triton::uint512 getIntegerChild(const SharedAbstractNode& node, triton::uint32 index) {
+        return reinterpret_cast<IntegerNode*>(node->getChildren()[index].get())->getInteger();
+      }
+    };
+
+
+    AstSmtExporter::AstSmtExporter(std::ostream& stream)
+      : stream(stream) {
+      this->count = 0;
+    }
+
+
+    std::vector<SharedAbstractNode> AstSmtExporter::getOperands(const SharedAbstractNode& node) const {
+      std::vector<SharedAbstractNode> operands;
+
+      if (node->getType() == REFERENCE_NODE) {
+        operands.push_back(reinterpret_cast<ReferenceNode*>(node.get())->getSymbolicExpression()->getAst());
+        return operands;
+      }
+
+      for (const auto& child : node->getChildren()) {
+        if (child->getType() != INTEGER_NODE)
+          operands.push_back(child);
+      }
+
+      return operands;
+    }
+
+
+    void AstSmtExporter::prepare(const SharedAbstractNode& node) {
+      std::unordered_map<AbstractNode*, triton::uint32> uses;
+      std::unordered_set<AbstractNode*> targets;
+      std::vector<SharedAbstractNode> order;
+      std::vector<std::pair<SharedAbstractNode, bool>> worklist;
+
+      /* Post order of the nodes which are not emitted yet, with their number of uses */
+      worklist.push_back(std::make_pair(node, false));
+      while (!worklist.empty()) {
+        SharedAbstractNode current = worklist.back().first;
+        bool visited = worklist.back().second;
+        worklist.pop_back();
+
+        if (visited) {
+          order.push_back(current);
+          continue;
+        }
+
+        if (uses[current.get()]++ != 0 || this->names.find(current) != this->names.end())
+          continue;
+
+        worklist.push_back(std::make_pair(current, true));
+        for (const auto& operand : this->getOperands(current)) {
+          if (current->getType() == REFERENCE_NODE)
+            targets.insert(operand.get());
+          worklist.push_back(std::make_pair(operand, false));
+        }
+      }
+
+      for (const auto& n : order) {
+        switch (n->getType()) {
+          case VARIABLE_NODE: {
+            const auto& var = reinterpret_cast<VariableNode*>(n.get())->getSymbolicVariable();
+            if (this->symbols.insert(var->getName()).second)
+              this->stream << "(declare-fun " << var->getName() << " () (_ BitVec " << var->getSize() << "))" << std::endl;
+            break;
+          }
+
+          case BV_NODE:
+          case REFERENCE_NODE:
+            break;
+
+          default: {
+            /* The root is not shared within this walk, it is printed by the caller */
+            if (n == node || (uses[n.get()] < 2 && targets.find(n.get()) == targets.end()))
+              break;
+            this->emit(n);
+            break;
+          }
+        }
+      }
+    }
+
+
+    void AstSmtExporter::printSort(const SharedAbstractNode& node) {
+      if (node->isLogical())
+        this->stream << "Bool";
+      else
+        this->stream << "(_ BitVec " << node->getBitvectorSize() << ")";
+    }
+
+
+    void AstSmtExporter::printOperator(const SharedAbstractNode& node) {
+      switch (node->getType()) {
+        case BVADD_NODE:    this->stream << "(bvadd"; break;
+        case BVAND_NODE:    this->stream << "(bvand"; break;
+        case BVASHR_NODE:   this->stream << "(bvashr"; break;
+        case BVLSHR_NODE:   this->stream << "(bvlshr"; break;
+        case BVMUL_NODE:    this->stream << "(bvmul"; break;
+        case BVNAND_NODE:   this->stream << "(bvnand"; break;
+        case BVNEG_NODE:    this->stream << "(bvneg"; break;
+        case BVNOR_NODE:    this->stream << "(bvnor"; break;
+        case BVNOT_NODE:    this->stream << "(bvnot"; break;
+        case BVOR_NODE:     this->stream << "(bvor"; break;
+        case BVROL_NODE:    this->stream << "((_ rotate_left " << getIntegerChild(node, 1) << ")"; break;
+        case BVROR_NODE:    this->stream << "((_ rotate_right " << getIntegerChild(node, 1) << ")"; break;
+        case BVSDIV_NODE:   this->stream << "(bvsdiv"; break;
+        case BVSGE_NODE:    this->stream << "(bvsge"; break;
+        case BVSGT_NODE:    this->stream << "(bvsgt"; break;
+        case BVSHL_NODE:    this->stream << "(bvshl"; break;
+        case BVSLE_NODE:    this->stream << "(bvsle"; break;
+        case BVSLT_NODE:    this->stream << "(bvslt"; break;
+        case BVSMOD_NODE:   this->stream << "(bvsmod"; break;
+        case BVSREM_NODE:   this->stream << "(bvsrem"; break;
+        case BVSUB_NODE:    this->stream << "(bvsub"; break;
+        case BVUDIV_NODE:   this->stream << "(bvudiv"; break;
+        case BVUGE_NODE:    this->stream << "(bvuge"; break;
+        case BVUGT_NODE:    this->stream << "(bvugt"; break;
+        case BVULE_NODE:    this->stream << "(bvule"; break;
+        case BVULT_NODE:    this->stream << "(bvult"; break;
+        case BVUREM_NODE:   this->stream << "(bvurem"; break;
+        case BVXNOR_NODE:   this->stream << "(bvxnor"; break;
+        case BVXOR_NODE:    this->stream << "(bvxor"; break;
+        case CONCAT_NODE:   this->stream << "(concat"; break;
+        case DISTINCT_NODE: this->stream << "(distinct"; break;
+        case EQUAL_NODE:    this->stream << "(="; break;
+        case EXTRACT_NODE:  this->stream << "((_ extract " << getIntegerChild(node, 0) << " " << getIntegerChild(node, 1) << ")"; break;
+        case IFF_NODE:      this->stream << "(="; break;
+        case ITE_NODE:      this->stream << "(ite"; break;
+        case LAND_NODE:     this->stream << "(and"; break;
+        case LNOT_NODE:     this->stream << "(not"; break;
+        case LOR_NODE:      this->stream << "(or"; break;
+        case SX_NODE:       this->stream << "((_ sign_extend " << getIntegerChild(node, 0) << ")"; break;
+        case ZX_NODE:       this->stream << "((_ zero_extend " << getIntegerChild(node, 0) << ")"; break;
+        default:
+          throw triton::exceptions::Ast("AstSmtExporter::printOperator(): Unsupported node.");
+      }
+    }
+
+
+    void AstSmtExporter::printTerm(const SharedAbstractNode& node, bool body) {
+      /* Each item is a node and the index of its next operand to print */
+      std::vector<std::pair<SharedAbstractNode, triton::usize>> stack;
+      std::vector<std::vector<SharedAbstractNode>> operands;
+
+      SharedAbstractNode current = node;
+      while (true) {
+        auto it = this->names.find(current);
+
+        /* Leaves and defined subterms */
+        if (it != this->names.end() && !(body && current == node)) {
+          this->stream << it->second;
+        }
+        else if (current->getType() == REFERENCE_NODE) {
+          current = reinterpret_cast<ReferenceNode*>(current.get())->getSymbolicExpression()->getAst();
+          continue;
+        }
+        else if (current->getType() == BV_NODE || current->getType() == VARIABLE_NODE) {
+          this->stream << this->getLeaf(current);
+        }
+        else {
+          this->printOperator(current);
+          stack.push_back(std::make_pair(current, 0));
+          operands.push_back(this->getOperands(current));
+        }
+
+        /* Close the applications whose operands are all printed */
+        while (!stack.empty() && stack.back().second == operands.back().size()) {
+          this->stream << ")";
+          stack.pop_back();
+          operands.pop_back();
+        }
+
+        if (stack.empty())
+          break;
+
+        this->stream << " ";
+        current = operands.back()[stack.back().second++];
+      }
+    }
+
+
+    std::string AstSmtExporter::getLeaf(const SharedAbstractNode& node) const {
+      if (node->getType() == VARIABLE_NODE)
+        return reinterpret_cast<VariableNode*>(node.get())->getSymbolicVariable()->getName();
+      return "(_ bv" + node->evaluate().str() + " " + std::to_string(node->getBitvectorSize()) + ")";
+    }
+
+
+    void AstSmtExporter::setLogic(const std::string& logic) {
+      this->stream << "(set-logic " << logic << ")" << std::endl;
+    }
+
+
+    std::string AstSmtExporter::emit(const SharedAbstractNode& node) {
+      std::string name;
+
+      /* The AST of a symbolic expression is named after it */
+      for (const auto& parent : node->getParents()) {
+        if (parent->getType() == REFERENCE_NODE) {
+          name = "ref!" + std::to_string(reinterpret_cast<ReferenceNode*>(parent.get())->getSymbolicExpression()->getId());
+          break;
+        }
+      }
+
+      if (name.empty() || this->symbols.find(name) != this->symbols.end())
+        name = "t!" + std::to_string(this->count++);
+
+      this->stream << "(define-fun " << name << " () ";
+      this->printSort(node);
+      this->stream << " ";
+      this->printTerm(node, true);
+      this->stream << ")" << std::endl;
+
+      this->names[node] = name;
+      this->symbols.insert(name);
+      return name;
+    }
+
+
+    std::string AstSmtExporter::define(const SharedAbstractNode& node) {
+      auto it = this->names.find(node);
+      if (it != this->names.end())
+        return it->second;
+
+      this->prepare(node);
+
+      /* The AST of a reference has been defined by prepare(), unless it is a leaf which is used as it is */
+      if (node->getType() == REFERENCE_NODE) {
+        SharedAbstractNode ast = node;
+        while (ast->getType() == REFERENCE_NODE)
+          ast = reinterpret_cast<ReferenceNode*>(ast.get())->getSymbolicExpression()->getAst();
+
+        if (ast->getType() == BV_NODE || ast->getType() == VARIABLE_NODE)
+          this->names[node] = this->getLeaf(ast);
+        else
+          this->names[node] = this->names.at(ast);
+
+        return this->names[node];
+      }
+
+      return this->emit(node);
+    }
+
+
+    void AstSmtExporter::assert_(const SharedAbstractNode& node) {
+      if (!node->isLogical())
+        throw triton::exceptions::Ast("AstSmtExporter::assert_(): The node must be logical.");
+
+      this->prepare(node);
+      this->stream << "(assert ";
+      this->printTerm(node, false);
+      this->stream << ")" << std::endl;
+    }
+
+
+    void AstSmtExporter::checkSat(void) {
+      this->stream << "(check-sat)" << std::endl;
+    }
+
+  }; /* ast namespace */
+}; /* triton namespace */
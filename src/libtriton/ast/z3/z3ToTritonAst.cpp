@@ -6,6 +6,9 @@
 */
 
 #include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
@@ -22,14 +25,52 @@ namespace triton {
 
 
     SharedAbstractNode Z3ToTritonAst::convert(const z3::expr& expr) {
-      SharedAbstractNode node = nullptr;
+      std::unordered_map<triton::uint32, SharedAbstractNode> results;
+      std::vector<std::pair<z3::expr, bool>> worklist;
+
+      /*
+       * The Z3's expressions are DAGs, each subterm is converted once and
+       * its Triton's node is shared by all its parents.
+       */
+      worklist.push_back(std::make_pair(expr, false));
+      while (!worklist.empty()) {
+        z3::expr current = worklist.back().first;
+        bool visited     = worklist.back().second;
+        worklist.pop_back();
+
+        if (results.find(current.id()) != results.end())
+          continue;
+
+        if (visited) {
+          results.insert(std::make_pair(current.id(), this->do_convert(current, results)));
+          continue;
+        }
+
+        /* Currently, only support application node */
+        if (current.is_quantifier())
+          throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Quantifier not supported yet.");
+
+        if (!current.is_app())
+          throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): At this moment only application are supported.");
 
-      /* Currently, only support application node */
-      if (expr.is_quantifier())
-        throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Quantifier not supported yet.");
+        worklist.push_back(std::make_pair(current, true));
+        for (triton::uint32 i = current.num_args(); i > 0; i--) {
+          if (results.find(current.arg(i - 1).id()) == results.end())
+            worklist.push_back(std::make_pair(current.arg(i - 1), false));
+        }
+      }
+
+      return results.at(expr.id());
+    }
+
+
+    SharedAbstractNode Z3ToTritonAst::do_convert(const z3::expr& expr, const std::unordered_map<triton::uint32, SharedAbstractNode>& results) {
+      SharedAbstractNode node = nullptr;
 
-      if (!expr.is_app())
-        throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): At this moment only application are supported.");
+      /* Get the converted children */
+      std::vector<SharedAbstractNode> children;
+      for (triton::uint32 i = 0; i < expr.num_args(); i++)
+        children.push_back(results.at(expr.arg(i).id()));
 
       /* Get the function declaration */
       z3::func_decl function = expr.decl();
@@ -40,30 +81,30 @@ namespace triton {
         case Z3_OP_EQ: {
           if (expr.num_args() != 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_EQ must contain two arguments.");
-          node = this->astCtxt.equal(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.equal(children[0], children[1]);
           break;
         }
 
         case Z3_OP_DISTINCT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_DISTINCT must contain at least two arguments.");
-          node = this->astCtxt.distinct(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.distinct(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.distinct(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.distinct(node, children[i]);
           break;
         }
 
         case Z3_OP_IFF: {
           if (expr.num_args() != 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_IFF must contain two arguments.");
-          node = this->astCtxt.iff(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.iff(children[0], children[1]);
           break;
         }
 
         case Z3_OP_ITE: {
           if (expr.num_args() != 3)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ITE must contain three arguments.");
-          node = this->astCtxt.ite(this->convert(expr.arg(0)), this->convert(expr.arg(1)), this->convert(expr.arg(2)));
+          node = this->astCtxt.ite(children[0], children[1], children[2]);
           break;
         }
 
@@ -73,7 +114,7 @@ namespace triton {
 
           std::list<SharedAbstractNode> args;
           for (triton::uint32 i = 0; i < expr.num_args(); i++) {
-            args.push_back(this->convert(expr.arg(i)));
+            args.push_back(children[i]);
           }
 
           node = this->astCtxt.land(args);
@@ -86,7 +127,7 @@ namespace triton {
 
           std::list<SharedAbstractNode> args;
           for (triton::uint32 i = 0; i < expr.num_args(); i++) {
-            args.push_back(this->convert(expr.arg(i)));
+            args.push_back(children[i]);
           }
 
           node = this->astCtxt.lor(args);
@@ -97,7 +138,7 @@ namespace triton {
         case Z3_OP_NOT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_NOT must contain one argument.");
-          node = this->astCtxt.lnot(this->convert(expr.arg(0)));
+          node = this->astCtxt.lnot(children[0]);
           break;
         }
 
@@ -111,34 +152,34 @@ namespace triton {
         case Z3_OP_BNEG: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNEG must contain one argument.");
-          node = this->astCtxt.bvneg(this->convert(expr.arg(0)));
+          node = this->astCtxt.bvneg(children[0]);
           break;
         }
 
         case Z3_OP_BADD: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BADD must contain at least two arguments.");
-          node = this->astCtxt.bvadd(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvadd(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvadd(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvadd(node, children[i]);
           break;
         }
 
         case Z3_OP_BSUB: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSUB must contain at least two arguments.");
-          node = this->astCtxt.bvsub(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsub(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsub(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsub(node, children[i]);
           break;
         }
 
         case Z3_OP_BMUL: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BMUL must contain at least two arguments.");
-          node = this->astCtxt.bvmul(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvmul(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvmul(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvmul(node, children[i]);
           break;
         }
 
@@ -146,9 +187,9 @@ namespace triton {
         case Z3_OP_BSDIV: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSDIV must contain at least two arguments.");
-          node = this->astCtxt.bvsdiv(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsdiv(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsdiv(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsdiv(node, children[i]);
           break;
         }
 
@@ -156,9 +197,9 @@ namespace triton {
         case Z3_OP_BUDIV: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BUDIV must contain at least two arguments.");
-          node = this->astCtxt.bvudiv(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvudiv(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvudiv(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvudiv(node, children[i]);
           break;
         }
 
@@ -166,9 +207,9 @@ namespace triton {
         case Z3_OP_BSREM: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSREM must contain at least two arguments.");
-          node = this->astCtxt.bvsrem(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsrem(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsrem(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsrem(node, children[i]);
           break;
         }
 
@@ -176,9 +217,9 @@ namespace triton {
         case Z3_OP_BUREM: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BUREM must contain at least two arguments.");
-          node = this->astCtxt.bvurem(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvurem(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvurem(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvurem(node, children[i]);
           break;
         }
 
@@ -186,142 +227,142 @@ namespace triton {
         case Z3_OP_BSMOD: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSMOD must contain at least two arguments.");
-          node = this->astCtxt.bvsmod(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsmod(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsmod(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsmod(node, children[i]);
           break;
         }
 
         case Z3_OP_ULEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ULEQ must contain at least two arguments.");
-          node = this->astCtxt.bvule(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvule(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvule(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvule(node, children[i]);
           break;
         }
 
         case Z3_OP_SLEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SLEQ must contain at least two arguments.");
-          node = this->astCtxt.bvsle(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsle(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsle(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsle(node, children[i]);
           break;
         }
 
         case Z3_OP_UGEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_UGEQ must contain at least two arguments.");
-          node = this->astCtxt.bvuge(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvuge(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvuge(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvuge(node, children[i]);
           break;
         }
 
         case Z3_OP_SGEQ: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SGEQ must contain at least two arguments.");
-          node = this->astCtxt.bvsge(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsge(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsge(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsge(node, children[i]);
           break;
         }
 
         case Z3_OP_ULT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ULT must contain at least two arguments.");
-          node = this->astCtxt.bvult(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvult(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvult(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvult(node, children[i]);
           break;
         }
 
         case Z3_OP_SLT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SLT must contain at least two arguments.");
-          node = this->astCtxt.bvslt(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvslt(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvslt(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvslt(node, children[i]);
           break;
         }
 
         case Z3_OP_UGT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_UGT must contain at least two arguments.");
-          node = this->astCtxt.bvugt(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvugt(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvugt(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvugt(node, children[i]);
           break;
         }
 
         case Z3_OP_SGT: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SGT must contain at least two arguments.");
-          node = this->astCtxt.bvsgt(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvsgt(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvsgt(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvsgt(node, children[i]);
           break;
         }
 
         case Z3_OP_BAND: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BAND must contain at least two arguments.");
-          node = this->astCtxt.bvand(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvand(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvand(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvand(node, children[i]);
           break;
         }
 
         case Z3_OP_BOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BOR must contain at least two arguments.");
-          node = this->astCtxt.bvor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvor(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvor(node, children[i]);
           break;
         }
 
         case Z3_OP_BNOT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNOT must contain one argument.");
-          node = this->astCtxt.bvnot(this->convert(expr.arg(0)));
+          node = this->astCtxt.bvnot(children[0]);
           break;
         }
 
         case Z3_OP_BXOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BXOR must contain at least two arguments.");
-          node = this->astCtxt.bvxor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvxor(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvxor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvxor(node, children[i]);
           break;
         }
 
         case Z3_OP_BNAND: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNAND must contain at least two arguments.");
-          node = this->astCtxt.bvnand(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvnand(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvnand(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvnand(node, children[i]);
           break;
         }
 
         case Z3_OP_BNOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BNOR must contain at least two arguments.");
-          node = this->astCtxt.bvnor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvnor(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvnor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvnor(node, children[i]);
           break;
         }
 
         case Z3_OP_BXNOR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BXNOR must contain at least two arguments.");
-          node = this->astCtxt.bvxnor(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvxnor(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvxnor(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvxnor(node, children[i]);
           break;
         }
 
@@ -331,7 +372,7 @@ namespace triton {
 
           std::list<SharedAbstractNode> args;
           for (triton::uint32 i = 0; i < expr.num_args(); i++) {
-            args.push_back(this->convert(expr.arg(i)));
+            args.push_back(children[i]);
           }
 
           node = this->astCtxt.concat(args);
@@ -341,62 +382,62 @@ namespace triton {
         case Z3_OP_SIGN_EXT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_SIGN_EXT must contain one argument.");
-          node = this->astCtxt.sx(expr.hi(), this->convert(expr.arg(0)));
+          node = this->astCtxt.sx(expr.hi(), children[0]);
           break;
         }
 
         case Z3_OP_ZERO_EXT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ZERO_EXT must contain one argument.");
-          node = this->astCtxt.zx(expr.hi(), this->convert(expr.arg(0)));
+          node = this->astCtxt.zx(expr.hi(), children[0]);
           break;
         }
 
         case Z3_OP_EXTRACT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_EXTRACT must contain one argument.");
-          node = this->astCtxt.extract(expr.hi(), expr.lo(), this->convert(expr.arg(0)));
+          node = this->astCtxt.extract(expr.hi(), expr.lo(), children[0]);
           break;
         }
 
         case Z3_OP_BSHL: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BSHL must contain at least two arguments.");
-          node = this->astCtxt.bvshl(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvshl(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvshl(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvshl(node, children[i]);
           break;
         }
 
         case Z3_OP_BLSHR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BLSHR must contain at least two arguments.");
-          node = this->astCtxt.bvlshr(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvlshr(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvlshr(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvlshr(node, children[i]);
           break;
         }
 
         case Z3_OP_BASHR: {
           if (expr.num_args() < 2)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_BASHR must contain at least two arguments.");
-          node = this->astCtxt.bvashr(this->convert(expr.arg(0)), this->convert(expr.arg(1)));
+          node = this->astCtxt.bvashr(children[0], children[1]);
           for (triton::uint32 i = 2; i < expr.num_args(); i++)
-            node = this->astCtxt.bvashr(node, this->convert(expr.arg(i)));
+            node = this->astCtxt.bvashr(node, children[i]);
           break;
         }
 
         case Z3_OP_ROTATE_LEFT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ROTATE_LEFT must contain one argument.");
-          node = this->astCtxt.bvrol(this->convert(expr.arg(0)), expr.hi());
+          node = this->astCtxt.bvrol(children[0], expr.hi());
           break;
         }
 
         case Z3_OP_ROTATE_RIGHT: {
           if (expr.num_args() != 1)
             throw triton::exceptions::AstTranslations("Z3ToTritonAst::visit(): Z3_OP_ROTATE_RIGHT must contain one argument.");
-          node = this->astCtxt.bvror(this->convert(expr.arg(0)), expr.hi());
+          node = this->astCtxt.bvror(children[0], expr.hi());
           break;
         }
 
@@ -37,18 +37,39 @@ Enabled, Triton will keep a map of aligned memory to reduce the symbolic memory
 - **MODE.AST_OPTIMIZATIONS**<br>
 Enabled, Triton will reduces the depth of the trees using classical arithmetic optimisations.
 
+- **MODE.BULK_REP_STRINGS**<br>
+Enabled, Triton will perform every iteration of a `rep movs` or `rep stos` in a single `processing()` if the
+counter and the direction flag are concrete. The concrete memory is copied at once and symbolic expressions
+are only created for the bytes copied from symbolic sources. At most one page (4096 bytes) is processed at once,
+a larger counter takes one `processing()` per page.
+
 - **MODE.CONCRETIZE_UNDEFINED_REGISTERS**<br>
 Enabled, Triton will concretize every registers tagged as undefined (see #750).
 
+- **MODE.CONSTANT_FOLDING**<br>
+Enabled, Triton will fold every bitvector node whose children are not symbolized into a single `bv` node.
+The value is computed on the children, so the folded node is never built. Logical nodes are kept as they
+are. A reference is not folded itself, but a node on concrete references is, so the slices of its symbolic
+expression do not reach the expressions of these references.
+
 - **MODE.ONLY_ON_SYMBOLIZED**<br>
 Enabled, Triton will perform symbolic execution only on symbolized expressions.
 
 - **MODE.ONLY_ON_TAINTED**<br>
 Enabled, Triton will perform symbolic execution only on tainted instructions.
 
+- **MODE.PC_DEDUPLICATION**<br>
+Enabled, Triton will not record a path constraint if the same branch was already recorded with a structurally
+identical constraint, e.g. a loop guard which compares the same input at every iteration. References are looked
+through, so the constraints built at different iterations match.
+
 - **MODE.PC_TRACKING_SYMBOLIC**<br>
 Enabled, Triton will track path constraints only if they are symbolized. This mode is enabled by default.
 
+- **MODE.PRESOLVING**<br>
+Enabled, the queries made of comparisons between a constant and invertible operations (`bvadd`, `bvsub`, `bvxor`,
+`bvnot`, `extract`, `zx`, ...) over a single variable, and their conjunctions, are decided without the solver.
+
 - **MODE.SYMBOLIZE_INDEX_ROTATION**<br>
 Enabled, Triton will symbolize the index of rotation for `bvror` and `bvrol` nodes. This mode increases the complexity of solving.
 
@@ -65,10 +86,14 @@ namespace triton {
       void initModeNamespace(PyObject* modeDict) {
         xPyDict_SetItemString(modeDict, "ALIGNED_MEMORY",                 PyLong_FromUint32(triton::modes::ALIGNED_MEMORY));
         xPyDict_SetItemString(modeDict, "AST_OPTIMIZATIONS",              PyLong_FromUint32(triton::modes::AST_OPTIMIZATIONS));
+        xPyDict_SetItemString(modeDict, "BULK_REP_STRINGS",               PyLong_FromUint32(triton::modes::BULK_REP_STRINGS));
         xPyDict_SetItemString(modeDict, "CONCRETIZE_UNDEFINED_REGISTERS", PyLong_FromUint32(triton::modes::CONCRETIZE_UNDEFINED_REGISTERS));
+        xPyDict_SetItemString(modeDict, "CONSTANT_FOLDING",               PyLong_FromUint32(triton::modes::CONSTANT_FOLDING));
         xPyDict_SetItemString(modeDict, "ONLY_ON_SYMBOLIZED",             PyLong_FromUint32(triton::modes::ONLY_ON_SYMBOLIZED));
         xPyDict_SetItemString(modeDict, "ONLY_ON_TAINTED",                PyLong_FromUint32(triton::modes::ONLY_ON_TAINTED));
+        xPyDict_SetItemString(modeDict, "PC_DEDUPLICATION",               PyLong_FromUint32(triton::modes::PC_DEDUPLICATION));
         xPyDict_SetItemString(modeDict, "PC_TRACKING_SYMBOLIC",           PyLong_FromUint32(triton::modes::PC_TRACKING_SYMBOLIC));
+        xPyDict_SetItemString(modeDict, "PRESOLVING",                     PyLong_FromUint32(triton::modes::PRESOLVING));
         xPyDict_SetItemString(modeDict, "SYMBOLIZE_INDEX_ROTATION",       PyLong_FromUint32(triton::modes::SYMBOLIZE_INDEX_ROTATION));
         xPyDict_SetItemString(modeDict, "TAINT_THROUGH_POINTERS",         PyLong_FromUint32(triton::modes::TAINT_THROUGH_POINTERS));
       }
@@ -0,0 +1,69 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <triton/pythonBindings.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/solverEnums.hpp>
+
+
+
+/*! \page py_SOLVER_STATE_page SOLVER_STATE
+    \brief [**python api**] All information about the SOLVER_STATE python namespace.
+
+\tableofcontents
+
+\section SOLVER_STATE_py_description Description
+<hr>
+
+The SOLVER_STATE namespace contains all the status of a solver query.
+
+\subsection SOLVER_STATE_py_example Example
+
+~~~~~~~~~~~~~{.py}
+>>> model, status = ctx.getModel(constraint, True, 1000)
+>>> status == SOLVER_STATE.TIMEOUT
+False
+~~~~~~~~~~~~~
+
+\section SOLVER_STATE_py_api Python API - Items of the SOLVER_STATE namespace
+<hr>
+
+- **SOLVER_STATE.OUTOFMEM**<br>
+The memory limit has been reached.
+
+- **SOLVER_STATE.SAT**<br>
+The constraint is satisfiable.
+
+- **SOLVER_STATE.TIMEOUT**<br>
+The time limit has been reached.
+
+- **SOLVER_STATE.UNKNOWN**<br>
+The solver could not decide, e.g. the resource limit has been reached or the query has been cancelled.
+
+- **SOLVER_STATE.UNSAT**<br>
+The constraint is not satisfiable.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      void initSolverStateNamespace(PyObject* solverStateDict) {
+        xPyDict_SetItemString(solverStateDict, "OUTOFMEM", PyLong_FromUint32(triton::engines::solver::OUTOFMEM));
+        xPyDict_SetItemString(solverStateDict, "SAT",      PyLong_FromUint32(triton::engines::solver::SAT));
+        xPyDict_SetItemString(solverStateDict, "TIMEOUT",  PyLong_FromUint32(triton::engines::solver::TIMEOUT));
+        xPyDict_SetItemString(solverStateDict, "UNKNOWN",  PyLong_FromUint32(triton::engines::solver::UNKNOWN));
+        xPyDict_SetItemString(solverStateDict, "UNSAT",    PyLong_FromUint32(triton::engines::solver::UNSAT));
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
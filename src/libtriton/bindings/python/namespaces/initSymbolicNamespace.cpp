@@ -20,11 +20,15 @@
 \section SYMBOLIC_py_description Description
 <hr>
 
-The SYMBOLIC namespace contains all types of symbolic expressions and variables.
+The SYMBOLIC namespace contains all types of symbolic expressions and variables, and the
+policies of the memory budget.
 
 \section SYMBOLIC_py_api Python API - Items of the SYMBOLIC namespace
 <hr>
 
+- **SYMBOLIC.BUDGET_DEPTH**
+- **SYMBOLIC.BUDGET_LRU**
+- **SYMBOLIC.BUDGET_NOT_SYMBOLIZED**
 - **SYMBOLIC.MEMORY_EXPRESSION**
 - **SYMBOLIC.MEMORY_VARIABLE**
 - **SYMBOLIC.REGISTER_EXPRESSION**
@@ -41,6 +45,9 @@ namespace triton {
     namespace python {
 
       void initSymbolicNamespace(PyObject* symbolicDict) {
+        xPyDict_SetItemString(symbolicDict, "BUDGET_DEPTH",          PyLong_FromUint32(triton::engines::symbolic::BUDGET_DEPTH));
+        xPyDict_SetItemString(symbolicDict, "BUDGET_LRU",            PyLong_FromUint32(triton::engines::symbolic::BUDGET_LRU));
+        xPyDict_SetItemString(symbolicDict, "BUDGET_NOT_SYMBOLIZED", PyLong_FromUint32(triton::engines::symbolic::BUDGET_NOT_SYMBOLIZED));
         xPyDict_SetItemString(symbolicDict, "MEMORY_EXPRESSION",     PyLong_FromUint32(triton::engines::symbolic::MEMORY_EXPRESSION));
         xPyDict_SetItemString(symbolicDict, "MEMORY_VARIABLE",       PyLong_FromUint32(triton::engines::symbolic::MEMORY_VARIABLE));
         xPyDict_SetItemString(symbolicDict, "REGISTER_EXPRESSION",   PyLong_FromUint32(triton::engines::symbolic::REGISTER_EXPRESSION));
@@ -0,0 +1,264 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <triton/pythonObjects.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/astBytecode.hpp>
+#include <triton/exceptions.hpp>
+
+
+
+/*! \page py_AstBytecode_page AstBytecode
+    \brief [**python api**] All information about the AstBytecode python object.
+
+\tableofcontents
+
+\section py_AstBytecode_description Description
+<hr>
+
+This object is returned by \ref py_AstContext_page `compile()`. The AST is flattened once into a linear
+bytecode which can then be evaluated under many assignments of its variables without building nodes
+and without touching the values of the variables in the symbolic engine. Shared sub-expressions are
+evaluated once per evaluation. The result is the same as `evaluate()` on the AST with the same values.
+
+~~~~~~~~~~~~~{.py}
+>>> from triton import TritonContext, ARCH
+>>> ctxt = TritonContext()
+>>> ctxt.setArchitecture(ARCH.X86_64)
+>>> ast = ctxt.getAstContext()
+>>> x = ast.variable(ctxt.newSymbolicVariable(32))
+>>> y = ast.variable(ctxt.newSymbolicVariable(32))
+>>> bc = ast.compile((x * y) + x)
+>>> [str(v) for v in bc.getVariables()]
+['SymVar_0', 'SymVar_1']
+>>> bc.evaluate([3, 5])
+18L
+>>> bc.evaluate([0xffffffff, 2])
+4294967293L
+>>> bc.evaluateBatch([[3, 5], [0xffffffff, 2], [1, 1]])
+[18L, 4294967293L, 2L]
+
+~~~~~~~~~~~~~
+
+\section AstBytecode_py_api Python API - Methods of the AstBytecode class
+<hr>
+
+- <b>integer evaluate([integer, ...])</b><br>
+Evaluates the AST with the values of the variables given in the order of `getVariables()`.
+
+- <b>[integer, ...] evaluateBatch([[integer, ...], ...])</b><br>
+Evaluates the AST under several assignments and returns the list of the results. Each assignment is a
+list of values given in the order of `getVariables()`. The assignments are evaluated together with
+SIMD instructions when possible, which is much faster than one `evaluate()` per assignment.
+
+- <b>integer getBitvectorSize(void)</b><br>
+Returns the size of the root node.
+
+- <b>integer getInstructionCount(void)</b><br>
+Returns the number of instructions of the bytecode.
+
+- <b>[\ref py_SymbolicVariable_page, ...] getVariables(void)</b><br>
+Returns the variables of the AST, sorted by id.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      //! AstBytecode destructor.
+      void AstBytecode_dealloc(PyObject* self) {
+        std::cout << std::flush;
+        delete PyAstBytecode_AsAstBytecode(self);
+        Py_TYPE(self)->tp_free((PyObject*)self);
+      }
+
+
+      static PyObject* AstBytecode_evaluate(PyObject* self, PyObject* valuesList) {
+        std::vector<triton::uint512> values;
+
+        if (valuesList == nullptr || !PyList_Check(valuesList))
+          return PyErr_Format(PyExc_TypeError, "AstBytecode::evaluate(): Expects a list of integers as argument.");
+
+        for (Py_ssize_t i = 0; i < PyList_Size(valuesList); i++) {
+          PyObject* item = PyList_GetItem(valuesList, i);
+
+          if (!PyLong_Check(item) && !PyInt_Check(item))
+            return PyErr_Format(PyExc_TypeError, "AstBytecode::evaluate(): Each element from the list must be an integer.");
+
+          values.push_back(PyLong_AsUint512(item));
+        }
+
+        try {
+          return PyLong_FromUint512(PyAstBytecode_AsAstBytecode(self)->evaluate(values));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstBytecode_evaluateBatch(PyObject* self, PyObject* assignmentsList) {
+        std::vector<std::vector<triton::uint512>> assignments;
+
+        if (assignmentsList == nullptr || !PyList_Check(assignmentsList))
+          return PyErr_Format(PyExc_TypeError, "AstBytecode::evaluateBatch(): Expects a list of lists of integers as argument.");
+
+        for (Py_ssize_t i = 0; i < PyList_Size(assignmentsList); i++) {
+          PyObject* valuesList = PyList_GetItem(assignmentsList, i);
+          std::vector<triton::uint512> values;
+
+          if (!PyList_Check(valuesList))
+            return PyErr_Format(PyExc_TypeError, "AstBytecode::evaluateBatch(): Each element from the list must be a list of integers.");
+
+          for (Py_ssize_t j = 0; j < PyList_Size(valuesList); j++) {
+            PyObject* item = PyList_GetItem(valuesList, j);
+
+            if (!PyLong_Check(item) && !PyInt_Check(item))
+              return PyErr_Format(PyExc_TypeError, "AstBytecode::evaluateBatch(): Each element from the list must be a list of integers.");
+
+            values.push_back(PyLong_AsUint512(item));
+          }
+
+          assignments.push_back(values);
+        }
+
+        try {
+          std::vector<triton::uint512> results = PyAstBytecode_AsAstBytecode(self)->evaluateBatch(assignments);
+          PyObject* ret = xPyList_New(results.size());
+          triton::usize index = 0;
+
+          for (const auto& value : results)
+            PyList_SetItem(ret, index++, PyLong_FromUint512(value));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstBytecode_getBitvectorSize(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint32(PyAstBytecode_AsAstBytecode(self)->getBitvectorSize());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstBytecode_getInstructionCount(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyAstBytecode_AsAstBytecode(self)->getInstructionCount());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstBytecode_getVariables(PyObject* self, PyObject* noarg) {
+        try {
+          const auto& variables = PyAstBytecode_AsAstBytecode(self)->getVariables();
+          PyObject* ret = xPyList_New(variables.size());
+          triton::usize index = 0;
+
+          for (const auto& var : variables)
+            PyList_SetItem(ret, index++, PySymbolicVariable(var));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      //! AstBytecode methods.
+      PyMethodDef AstBytecode_callbacks[] = {
+        {"evaluate",            AstBytecode_evaluate,             METH_O,       ""},
+        {"evaluateBatch",       AstBytecode_evaluateBatch,        METH_O,       ""},
+        {"getBitvectorSize",    AstBytecode_getBitvectorSize,     METH_NOARGS,  ""},
+        {"getInstructionCount", AstBytecode_getInstructionCount,  METH_NOARGS,  ""},
+        {"getVariables",        AstBytecode_getVariables,         METH_NOARGS,  ""},
+        {nullptr,               nullptr,                          0,            nullptr}
+      };
+
+
+      PyTypeObject AstBytecode_Type = {
+        PyObject_HEAD_INIT(&PyType_Type)
+        0,                                          /* ob_size */
+        "AstBytecode",                              /* tp_name */
+        sizeof(AstBytecode_Object),                 /* tp_basicsize */
+        0,                                          /* tp_itemsize */
+        (destructor)AstBytecode_dealloc,            /* tp_dealloc */
+        0,                                          /* tp_print */
+        0,                                          /* tp_getattr */
+        0,                                          /* tp_setattr */
+        0,                                          /* tp_compare */
+        0,                                          /* tp_repr */
+        0,                                          /* tp_as_number */
+        0,                                          /* tp_as_sequence */
+        0,                                          /* tp_as_mapping */
+        0,                                          /* tp_hash */
+        0,                                          /* tp_call */
+        0,                                          /* tp_str */
+        0,                                          /* tp_getattro */
+        0,                                          /* tp_setattro */
+        0,                                          /* tp_as_buffer */
+        Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+        "AstBytecode objects",                      /* tp_doc */
+        0,                                          /* tp_traverse */
+        0,                                          /* tp_clear */
+        0,                                          /* tp_richcompare */
+        0,                                          /* tp_weaklistoffset */
+        0,                                          /* tp_iter */
+        0,                                          /* tp_iternext */
+        AstBytecode_callbacks,                      /* tp_methods */
+        0,                                          /* tp_members */
+        0,                                          /* tp_getset */
+        0,                                          /* tp_base */
+        0,                                          /* tp_dict */
+        0,                                          /* tp_descr_get */
+        0,                                          /* tp_descr_set */
+        0,                                          /* tp_dictoffset */
+        0,                                          /* tp_init */
+        0,                                          /* tp_alloc */
+        0,                                          /* tp_new */
+        0,                                          /* tp_free */
+        0,                                          /* tp_is_gc */
+        0,                                          /* tp_bases */
+        0,                                          /* tp_mro */
+        0,                                          /* tp_cache */
+        0,                                          /* tp_subclasses */
+        0,                                          /* tp_weaklist */
+        0,                                          /* tp_del */
+        0                                           /* tp_version_tag */
+      };
+
+
+      PyObject* PyAstBytecode(triton::ast::AstBytecode* bytecode) {
+        AstBytecode_Object* object;
+
+        PyType_Ready(&AstBytecode_Type);
+        object = PyObject_NEW(AstBytecode_Object, &AstBytecode_Type);
+        if (object != NULL)
+          object->bytecode = bytecode;
+        else
+          delete bytecode;
+
+        return (PyObject*)object;
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
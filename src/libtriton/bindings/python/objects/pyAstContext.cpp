@@ -5,10 +5,14 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <fstream>
+#include <sstream>
+
 #include <triton/pythonObjects.hpp>
 #include <triton/pythonUtils.hpp>
 #include <triton/pythonXFunctions.hpp>
 #include <triton/astContext.hpp>
+#include <triton/astSmtExporter.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/register.hpp>
 #ifdef Z3_INTERFACE
@@ -179,6 +183,9 @@ e.g: `(bvxnor expr1 expr2)`.
 Creates a `bvxor` node.<br>
 e.g: `(bvxor expr1 epxr2)`.
 
+- <b>\ref py_AstBytecode_page compile(\ref py_AstNode_page node)</b><br>
+Compiles an AST into a bytecode which can be evaluated under many assignments of its variables.
+
 - <b>\ref py_AstNode_page concat([\ref py_AstNode_page, ...])</b><br>
 Concatenates several nodes.
 
@@ -243,6 +250,11 @@ e.g: `((_ zero_extend sizeExt) expr1)`.
 - <b>\ref py_AstNode_page duplicate(\ref py_AstNode_page expr)</b><br>
 Duplicates the node and returns a new instance as \ref py_AstNode_page.
 
+- <b>string exportSmt(\ref py_AstNode_page node, string path=None)</b><br>
+Exports a node, or a list of nodes, as a self-contained SMT-LIB2 script. The logical nodes are asserted and
+the other ones are defined. Each variable is declared once and each shared subterm is defined once with `define-fun`,
+the AST is not unrolled. The script is written to `path` if it is given, returned as a string otherwise.
+
 - <b>[\ref py_AstNode_page, ...] lookingForNodes(\ref py_AstNode_page expr, \ref py_AST_NODE_page match)</b><br>
 Returns a list of collected matched nodes via a depth-first pre order traversal.
 
@@ -1044,6 +1056,79 @@ namespace triton {
       }
 
 
+      static PyObject* AstContext_exportSmt(PyObject* self, PyObject* args) {
+        std::vector<triton::ast::SharedAbstractNode> nodes;
+        PyObject* node = nullptr;
+        PyObject* path = nullptr;
+
+        /* Extract arguments */
+        if (PyArg_ParseTuple(args, "|OO", &node, &path) == false) {
+          return PyErr_Format(PyExc_TypeError, "exportSmt(): Invalid number of arguments");
+        }
+
+        if (node != nullptr && PyAstNode_Check(node)) {
+          nodes.push_back(PyAstNode_AsAstNode(node));
+        }
+        else if (node != nullptr && PyList_Check(node)) {
+          for (Py_ssize_t i = 0; i < PyList_Size(node); i++) {
+            PyObject* item = PyList_GetItem(node, i);
+            if (!PyAstNode_Check(item))
+              return PyErr_Format(PyExc_TypeError, "exportSmt(): Each element from the list must be a AstNode");
+            nodes.push_back(PyAstNode_AsAstNode(item));
+          }
+        }
+        else {
+          return PyErr_Format(PyExc_TypeError, "exportSmt(): Expects a AstNode or a list of AstNodes as first argument.");
+        }
+
+        if (path != nullptr && path != Py_None && !PyString_Check(path))
+          return PyErr_Format(PyExc_TypeError, "exportSmt(): Expects a string as second argument.");
+
+        try {
+          std::ostringstream ss;
+          std::ofstream fs;
+
+          if (path != nullptr && path != Py_None) {
+            fs.open(PyString_AsString(path));
+            if (!fs.is_open())
+              return PyErr_Format(PyExc_TypeError, "exportSmt(): Cannot open %s.", PyString_AsString(path));
+          }
+
+          std::ostream& stream = fs.is_open() ? static_cast<std::ostream&>(fs) : static_cast<std::ostream&>(ss);
+          triton::ast::AstSmtExporter exporter(stream);
+
+          exporter.setLogic();
+          for (const auto& n : nodes) {
+            if (n->isLogical())
+              exporter.assert_(n);
+            else
+              exporter.define(n);
+          }
+          exporter.checkSat();
+
+          if (fs.is_open())
+            Py_RETURN_NONE;
+          return Py_BuildValue("s", ss.str().c_str());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstContext_compile(PyObject* self, PyObject* node) {
+        if (!PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "compile(): expected a AstNode as argument");
+
+        try {
+          return PyAstBytecode(new triton::ast::AstBytecode(PyAstNode_AsAstNode(node)));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* AstContext_compound(PyObject* self, PyObject* exprsList) {
         std::vector<triton::ast::SharedAbstractNode> exprs;
 
@@ -1494,12 +1579,14 @@ namespace triton {
         {"bvurem",          AstContext_bvurem,          METH_VARARGS,     ""},
         {"bvxnor",          AstContext_bvxnor ,         METH_VARARGS,     ""},
         {"bvxor",           AstContext_bvxor,           METH_VARARGS,     ""},
+        {"compile",         AstContext_compile,         METH_O,           ""},
         {"compound",        AstContext_compound,        METH_O,           ""},
         {"concat",          AstContext_concat,          METH_O,           ""},
         {"declare",         AstContext_declare,         METH_O,           ""},
         {"distinct",        AstContext_distinct,        METH_VARARGS,     ""},
         {"duplicate",       AstContext_duplicate,       METH_O,           ""},
         {"equal",           AstContext_equal,           METH_VARARGS,     ""},
+        {"exportSmt",       AstContext_exportSmt,       METH_VARARGS,     ""},
         {"extract",         AstContext_extract,         METH_VARARGS,     ""},
         {"iff",             AstContext_iff,             METH_VARARGS,     ""},
         {"ite",             AstContext_ite,             METH_VARARGS,     ""},
@@ -70,6 +70,9 @@ Returns the node vector size.
 - <b>[\ref py_AstNode_page, ...] getChildren(void)</b><br>
 Returns the list of child nodes.
 
+- <b>integer getDepth(void)</b><br>
+Returns the depth of the tree once references are unrolled. This is computed when the node is built.
+
 - <b>integer getHash(void)</b><br>
 Returns the hash (signature) of the AST .
 
@@ -92,6 +95,14 @@ Returns the symbolic variable of the node. Only available on `VARIABLE_NODE`, ra
 Returns the kind of the node.<br>
 e.g: `AST_NODE.BVADD`
 
+- <b>integer getUnrolledSize(void)</b><br>
+Returns the approximate number of nodes of the tree once shared nodes and references are unrolled. This
+is computed when the node is built.
+
+- <b>[integer, ...] getVariableIds(void)</b><br>
+Returns the sorted ids of the symbolic variables reachable from the node, references included. This is
+computed when the node is built.
+
 - <b>bool isLogical(void)</b><br>
 Returns true if it's a logical node.
 e.g: `AST_NODE.EQUAL`, `AST_NODE.LNOT`, `AST_NODE.LAND`...
@@ -211,6 +222,16 @@ namespace triton {
       }
 
 
+      static PyObject* AstNode_getDepth(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint32(PyAstNode_AsAstNode(self)->getDepth());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* AstNode_getHash(PyObject* self, PyObject* noarg) {
         try {
           return PyLong_FromUint512(PyAstNode_AsAstNode(self)->hash(1));
@@ -307,6 +328,33 @@ namespace triton {
       }
 
 
+      static PyObject* AstNode_getUnrolledSize(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint64(PyAstNode_AsAstNode(self)->getUnrolledSize());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstNode_getVariableIds(PyObject* self, PyObject* noarg) {
+        try {
+          PyObject* ret;
+          const auto& ids = PyAstNode_AsAstNode(self)->getVariableIds();
+
+          ret = xPyList_New(ids.size());
+          for (triton::usize index = 0; index < ids.size(); index++)
+            PyList_SetItem(ret, index, PyLong_FromUsize(ids[index]));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* AstNode_isLogical(PyObject* self, PyObject* noarg) {
         try {
           if (PyAstNode_AsAstNode(self)->isLogical())
@@ -615,6 +663,7 @@ namespace triton {
         {"getBitvectorMask",        AstNode_getBitvectorMask,       METH_NOARGS,     ""},
         {"getBitvectorSize",        AstNode_getBitvectorSize,       METH_NOARGS,     ""},
         {"getChildren",             AstNode_getChildren,            METH_NOARGS,     ""},
+        {"getDepth",                AstNode_getDepth,               METH_NOARGS,     ""},
         {"getHash",                 AstNode_getHash,                METH_NOARGS,     ""},
         {"getInteger",              AstNode_getInteger,             METH_NOARGS,     ""},
         {"getParents",              AstNode_getParents,             METH_NOARGS,     ""},
@@ -622,6 +671,8 @@ namespace triton {
         {"getSymbolicExpression",   AstNode_getSymbolicExpression,  METH_NOARGS,     ""},
         {"getSymbolicVariable",     AstNode_getSymbolicVariable,    METH_NOARGS,     ""},
         {"getType",                 AstNode_getType,                METH_NOARGS,     ""},
+        {"getUnrolledSize",         AstNode_getUnrolledSize,        METH_NOARGS,     ""},
+        {"getVariableIds",          AstNode_getVariableIds,         METH_NOARGS,     ""},
         {"isLogical",               AstNode_isLogical,              METH_NOARGS,     ""},
         {"isSigned",                AstNode_isSigned,               METH_NOARGS,     ""},
         {"isSymbolized",            AstNode_isSymbolized,           METH_NOARGS,     ""},
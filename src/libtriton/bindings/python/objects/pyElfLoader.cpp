@@ -0,0 +1,381 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <triton/pythonObjects.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/elfLoader.hpp>
+#include <triton/exceptions.hpp>
+
+
+
+/*! \page py_ElfLoader_page ElfLoader
+    \brief [**python api**] All information about the ElfLoader python object.
+
+\tableofcontents
+
+\section py_ElfLoader_description Description
+<hr>
+
+This object is returned by \ref py_TritonContext_page `loadElf()` and represents an ELF image
+mapped into the concrete memory of a context. By default, segments are lazily mapped: a page is
+copied from the file the first time it is read or written. The pages still pending are mapped
+before the callbacks of the context are removed (e.g. `removeAllCallbacks()`, `reset()`) and when
+the ElfLoader object is dropped, so that the image stays whole. Dynamic relocations are applied
+at load time and imported symbols may be bound to arbitrary addresses (e.g. stubs you hook).
+
+~~~~~~~~~~~~~{.py}
+from triton import TritonContext, ARCH, MemoryAccess, CPUSIZE
+
+ctxt = TritonContext()
+ctxt.setArchitecture(ARCH.X86_64)
+
+elf = ctxt.loadElf('./crackme_xor')
+pc  = elf.getEntryPoint()
+
+# Bind every imported function to a stub address and catch them in the emulation loop
+stubs = elf.bindImports(0x10000000)
+puts  = ctxt.getConcreteMemoryValue(MemoryAccess(0x601018, CPUSIZE.QWORD))
+print elf.getImportName(puts) # puts
+~~~~~~~~~~~~~
+
+\section ElfLoader_py_api Python API - Methods of the ElfLoader class
+<hr>
+
+- <b>void bindImport(string name, integer addr)</b><br>
+Binds an imported symbol to `addr` and patches every relocation referencing it.
+
+- <b>dict bindImports(integer stubBase, integer stubSize=1)</b><br>
+Binds every imported symbol to a unique address starting at `stubBase` and returns
+the bound stubs as a dictionary `{address: name}`.
+
+- <b>integer getBaseAddress(void)</b><br>
+Returns the base address of the image.
+
+- <b>integer getEntryPoint(void)</b><br>
+Returns the entry point (base address included).
+
+- <b>list getImportedSymbols(void)</b><br>
+Returns the names of the undefined symbols referenced by dynamic relocations.
+
+- <b>string getImportName(integer addr)</b><br>
+Returns the name of the imported symbol bound to `addr`.
+
+- <b>dict getImportStubs(void)</b><br>
+Returns the bound imported symbols as a dictionary `{address: name}`.
+
+- <b>list getRelocations(void)</b><br>
+Returns the dynamic relocations as a list of dictionaries with the `address`, `type`, `addend`
+and `symbol` keys.
+
+- <b>list getSegments(void)</b><br>
+Returns the PT_LOAD segments as a list of dictionaries with the `vaddr`, `memsz`, `offset`,
+`filesz` and `flags` keys.
+
+- <b>bool isImportStub(integer addr)</b><br>
+Returns true if `addr` is the address of a bound imported symbol.
+
+- <b>void mapAll(void)</b><br>
+Maps every page not mapped yet into the concrete memory and removes the callbacks of the lazy
+mapping, so that the memory accesses are not slowed down anymore.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      //! ElfLoader destructor.
+      void ElfLoader_dealloc(PyObject* self) {
+        std::cout << std::flush;
+        delete PyElfLoader_AsElfLoader(self);
+        Py_XDECREF(((ElfLoader_Object*)(self))->context);
+        Py_TYPE(self)->tp_free((PyObject*)self);
+      }
+
+
+      static PyObject* ElfLoader_bindImport(PyObject* self, PyObject* args) {
+        PyObject* name = nullptr;
+        PyObject* addr = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &name, &addr);
+
+        if (name == nullptr || !PyString_Check(name))
+          return PyErr_Format(PyExc_TypeError, "ElfLoader::bindImport(): Expects a string as first argument.");
+
+        if (addr == nullptr || (!PyLong_Check(addr) && !PyInt_Check(addr)))
+          return PyErr_Format(PyExc_TypeError, "ElfLoader::bindImport(): Expects an integer as second argument.");
+
+        try {
+          PyElfLoader_AsElfLoader(self)->bindImport(PyString_AsString(name), PyLong_AsUint64(addr));
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getImportStubs(PyObject* self, PyObject* noarg) {
+        try {
+          PyObject* ret = xPyDict_New();
+
+          for (const auto& stub : PyElfLoader_AsElfLoader(self)->getImportStubs())
+            xPyDict_SetItem(ret, PyLong_FromUint64(stub.first), xPyString_FromString(stub.second.c_str()));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_bindImports(PyObject* self, PyObject* args) {
+        PyObject* base = nullptr;
+        PyObject* size = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &base, &size);
+
+        if (base == nullptr || (!PyLong_Check(base) && !PyInt_Check(base)))
+          return PyErr_Format(PyExc_TypeError, "ElfLoader::bindImports(): Expects an integer as first argument.");
+
+        if (size != nullptr && !PyLong_Check(size) && !PyInt_Check(size))
+          return PyErr_Format(PyExc_TypeError, "ElfLoader::bindImports(): Expects an integer as second argument.");
+
+        try {
+          PyElfLoader_AsElfLoader(self)->bindImports(PyLong_AsUint64(base), (size != nullptr) ? PyLong_AsUint64(size) : 1);
+          return ElfLoader_getImportStubs(self, nullptr);
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getBaseAddress(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint64(PyElfLoader_AsElfLoader(self)->getBaseAddress());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getEntryPoint(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint64(PyElfLoader_AsElfLoader(self)->getEntryPoint());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getImportedSymbols(PyObject* self, PyObject* noarg) {
+        try {
+          const auto& imports = PyElfLoader_AsElfLoader(self)->getImportedSymbols();
+          PyObject* ret = xPyList_New(imports.size());
+          triton::uint32 index = 0;
+
+          for (const auto& name : imports)
+            PyList_SetItem(ret, index++, xPyString_FromString(name.c_str()));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getImportName(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "ElfLoader::getImportName(): Expects an integer as argument.");
+
+        try {
+          return xPyString_FromString(PyElfLoader_AsElfLoader(self)->getImportName(PyLong_AsUint64(addr)).c_str());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getRelocations(PyObject* self, PyObject* noarg) {
+        try {
+          const auto& relocations = PyElfLoader_AsElfLoader(self)->getRelocations();
+          PyObject* ret = xPyList_New(relocations.size());
+          triton::uint32 index = 0;
+
+          for (const auto& reloc : relocations) {
+            PyObject* item = xPyDict_New();
+            xPyDict_SetItemString(item, "address", PyLong_FromUint64(reloc.address));
+            xPyDict_SetItemString(item, "type",    PyLong_FromUint32(reloc.type));
+            xPyDict_SetItemString(item, "addend",  PyLong_FromLongLong(reloc.addend));
+            xPyDict_SetItemString(item, "symbol",  xPyString_FromString(reloc.symbol.c_str()));
+            PyList_SetItem(ret, index++, item);
+          }
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_getSegments(PyObject* self, PyObject* noarg) {
+        try {
+          const auto& segments = PyElfLoader_AsElfLoader(self)->getSegments();
+          PyObject* ret = xPyList_New(segments.size());
+          triton::uint32 index = 0;
+
+          for (const auto& seg : segments) {
+            PyObject* item = xPyDict_New();
+            xPyDict_SetItemString(item, "vaddr",  PyLong_FromUint64(seg.vaddr));
+            xPyDict_SetItemString(item, "memsz",  PyLong_FromUint64(seg.memsz));
+            xPyDict_SetItemString(item, "offset", PyLong_FromUint64(seg.offset));
+            xPyDict_SetItemString(item, "filesz", PyLong_FromUint64(seg.filesz));
+            xPyDict_SetItemString(item, "flags",  PyLong_FromUint32(seg.flags));
+            PyList_SetItem(ret, index++, item);
+          }
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_isImportStub(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "ElfLoader::isImportStub(): Expects an integer as argument.");
+
+        try {
+          if (PyElfLoader_AsElfLoader(self)->isImportStub(PyLong_AsUint64(addr)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* ElfLoader_mapAll(PyObject* self, PyObject* noarg) {
+        try {
+          PyElfLoader_AsElfLoader(self)->mapAll();
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      //! ElfLoader methods.
+      PyMethodDef ElfLoader_callbacks[] = {
+        {"bindImport",          ElfLoader_bindImport,           METH_VARARGS,   ""},
+        {"bindImports",         ElfLoader_bindImports,          METH_VARARGS,   ""},
+        {"getBaseAddress",      ElfLoader_getBaseAddress,       METH_NOARGS,    ""},
+        {"getEntryPoint",       ElfLoader_getEntryPoint,        METH_NOARGS,    ""},
+        {"getImportedSymbols",  ElfLoader_getImportedSymbols,   METH_NOARGS,    ""},
+        {"getImportName",       ElfLoader_getImportName,        METH_O,         ""},
+        {"getImportStubs",      ElfLoader_getImportStubs,       METH_NOARGS,    ""},
+        {"getRelocations",      ElfLoader_getRelocations,       METH_NOARGS,    ""},
+        {"getSegments",         ElfLoader_getSegments,          METH_NOARGS,    ""},
+        {"isImportStub",        ElfLoader_isImportStub,         METH_O,         ""},
+        {"mapAll",              ElfLoader_mapAll,               METH_NOARGS,    ""},
+        {nullptr,               nullptr,                        0,              nullptr}
+      };
+
+
+      PyTypeObject ElfLoader_Type = {
+        PyObject_HEAD_INIT(&PyType_Type)
+        0,                                          /* ob_size */
+        "ElfLoader",                                /* tp_name */
+        sizeof(ElfLoader_Object),                   /* tp_basicsize */
+        0,                                          /* tp_itemsize */
+        (destructor)ElfLoader_dealloc,              /* tp_dealloc */
+        0,                                          /* tp_print */
+        0,                                          /* tp_getattr */
+        0,                                          /* tp_setattr */
+        0,                                          /* tp_compare */
+        0,                                          /* tp_repr */
+        0,                                          /* tp_as_number */
+        0,                                          /* tp_as_sequence */
+        0,                                          /* tp_as_mapping */
+        0,                                          /* tp_hash */
+        0,                                          /* tp_call */
+        0,                                          /* tp_str */
+        0,                                          /* tp_getattro */
+        0,                                          /* tp_setattro */
+        0,                                          /* tp_as_buffer */
+        Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+        "ElfLoader objects",                        /* tp_doc */
+        0,                                          /* tp_traverse */
+        0,                                          /* tp_clear */
+        0,                                          /* tp_richcompare */
+        0,                                          /* tp_weaklistoffset */
+        0,                                          /* tp_iter */
+        0,                                          /* tp_iternext */
+        ElfLoader_callbacks,                        /* tp_methods */
+        0,                                          /* tp_members */
+        0,                                          /* tp_getset */
+        0,                                          /* tp_base */
+        0,                                          /* tp_dict */
+        0,                                          /* tp_descr_get */
+        0,                                          /* tp_descr_set */
+        0,                                          /* tp_dictoffset */
+        0,                                          /* tp_init */
+        0,                                          /* tp_alloc */
+        0,                                          /* tp_new */
+        0,                                          /* tp_free */
+        0,                                          /* tp_is_gc */
+        0,                                          /* tp_bases */
+        0,                                          /* tp_mro */
+        0,                                          /* tp_cache */
+        0,                                          /* tp_subclasses */
+        0,                                          /* tp_weaklist */
+        0,                                          /* tp_del */
+        0                                           /* tp_version_tag */
+      };
+
+
+      PyObject* PyElfLoader(PyObject* context, triton::os::unix::ElfLoader* loader) {
+        ElfLoader_Object* object;
+
+        PyType_Ready(&ElfLoader_Type);
+        object = PyObject_NEW(ElfLoader_Object, &ElfLoader_Type);
+        if (object != NULL) {
+          /* The loader holds a reference on the API, keep the context alive */
+          Py_INCREF(context);
+          object->context = context;
+          object->loader  = loader;
+        }
+        else
+          delete loader;
+
+        return (PyObject*)object;
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
+
+#endif /* __unix__ || __APPLE__ */
@@ -0,0 +1,309 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <triton/pythonObjects.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/libcSummaries.hpp>
+
+
+
+/*! \page py_LibcSummaries_page LibcSummaries
+    \brief [**python api**] All information about the LibcSummaries python object.
+
+\tableofcontents
+
+\section py_LibcSummaries_description Description
+<hr>
+
+This object is returned by \ref py_TritonContext_page `newLibcSummaries()` and performs common libc
+routines natively for the x86-64 and AArch64 ABIs. Routines are bound to addresses (usually the import
+stubs of an \ref py_ElfLoader_page). When the program counter reaches a bound address, `emulate()` runs
+the whole routine in bulk on the concrete memory, propagates the symbolic and taint states of the bytes
+it touches, sets the return register and returns to the caller.
+
+Supported routines are calloc, free, malloc, memcpy, memmove, memset, printf, putchar, puts, strcmp
+and strlen. When the scanned strings contain symbolic bytes, strlen() and strcmp() return an `ite`
+chain with one level per symbolic byte, bounded by the concrete result, or by the next concrete
+terminator or mismatch when the byte which stops the scan is symbolic. printf() supports the integer,
+character, string and pointer conversions; its output is accumulated and returned by `getOutput()`.
+
+~~~~~~~~~~~~~{.py}
+from triton import TritonContext, ARCH, Instruction
+
+ctxt = TritonContext()
+ctxt.setArchitecture(ARCH.X86_64)
+
+elf  = ctxt.loadElf('./crackme_xor')
+elf.bindImports(0x7fff00000000)
+libc = ctxt.newLibcSummaries()
+libc.bindImports(elf)
+
+pc = elf.getEntryPoint()
+while pc:
+    if not libc.emulate():
+        inst = Instruction(pc, ctxt.getConcreteMemoryAreaValue(pc, 16))
+        ctxt.processing(inst)
+    pc = ctxt.getConcreteRegisterValue(ctxt.registers.rip)
+
+print libc.getOutput()
+~~~~~~~~~~~~~
+
+\section LibcSummaries_py_api Python API - Methods of the LibcSummaries class
+<hr>
+
+- <b>void bind(integer addr, string name)</b><br>
+Binds a routine to an address.
+
+- <b>integer bindImports(\ref py_ElfLoader_page loader)</b><br>
+Binds every supported import stub of a loader. Returns the number of bound routines.
+
+- <b>bool emulate(void)</b><br>
+If the program counter is on a bound address, performs the routine and returns to the caller. Returns
+false otherwise.
+
+- <b>dict getBindings(void)</b><br>
+Returns the bound routines as a dictionary of {address: name}.
+
+- <b>string getOutput(void)</b><br>
+Returns the characters written by printf(), puts() and putchar().
+
+- <b>bool isBound(integer addr)</b><br>
+Returns true if a routine is bound to the address.
+
+- <b>void setHeapBase(integer addr)</b><br>
+Sets the base address of the heap used by malloc() and calloc().
+
+- <b>void unbind(integer addr)</b><br>
+Unbinds an address.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      //! LibcSummaries destructor.
+      void LibcSummaries_dealloc(PyObject* self) {
+        std::cout << std::flush;
+        delete PyLibcSummaries_AsLibcSummaries(self);
+        Py_XDECREF(((LibcSummaries_Object*)(self))->context);
+        Py_TYPE(self)->tp_free((PyObject*)self);
+      }
+
+
+      static PyObject* LibcSummaries_bind(PyObject* self, PyObject* args) {
+        PyObject* addr = nullptr;
+        PyObject* name = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &addr, &name);
+
+        if (addr == nullptr || (!PyLong_Check(addr) && !PyInt_Check(addr)))
+          return PyErr_Format(PyExc_TypeError, "LibcSummaries::bind(): Expects an integer as first argument.");
+
+        if (name == nullptr || !PyString_Check(name))
+          return PyErr_Format(PyExc_TypeError, "LibcSummaries::bind(): Expects a string as second argument.");
+
+        try {
+          PyLibcSummaries_AsLibcSummaries(self)->bind(PyLong_AsUint64(addr), std::string(PyString_AsString(name)));
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_bindImports(PyObject* self, PyObject* loader) {
+        if (!PyElfLoader_Check(loader))
+          return PyErr_Format(PyExc_TypeError, "LibcSummaries::bindImports(): Expects an ElfLoader as argument.");
+
+        try {
+          return PyLong_FromUsize(PyLibcSummaries_AsLibcSummaries(self)->bindImports(*PyElfLoader_AsElfLoader(loader)));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_emulate(PyObject* self, PyObject* noarg) {
+        try {
+          if (PyLibcSummaries_AsLibcSummaries(self)->emulate() == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_getBindings(PyObject* self, PyObject* noarg) {
+        try {
+          PyObject* ret = xPyDict_New();
+          for (const auto& it : PyLibcSummaries_AsLibcSummaries(self)->getBindings())
+            xPyDict_SetItem(ret, PyLong_FromUint64(it.first), xPyString_FromString(triton::os::unix::LibcSummaries::getRoutineName(it.second).c_str()));
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_getOutput(PyObject* self, PyObject* noarg) {
+        try {
+          const std::string& output = PyLibcSummaries_AsLibcSummaries(self)->getOutput();
+          return PyString_FromStringAndSize(output.data(), output.size());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_isBound(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "LibcSummaries::isBound(): Expects an integer as argument.");
+
+        try {
+          if (PyLibcSummaries_AsLibcSummaries(self)->isBound(PyLong_AsUint64(addr)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_setHeapBase(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "LibcSummaries::setHeapBase(): Expects an integer as argument.");
+
+        try {
+          PyLibcSummaries_AsLibcSummaries(self)->setHeapBase(PyLong_AsUint64(addr));
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* LibcSummaries_unbind(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "LibcSummaries::unbind(): Expects an integer as argument.");
+
+        try {
+          PyLibcSummaries_AsLibcSummaries(self)->unbind(PyLong_AsUint64(addr));
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      //! LibcSummaries methods.
+      PyMethodDef LibcSummaries_callbacks[] = {
+        {"bind",          LibcSummaries_bind,           METH_VARARGS, ""},
+        {"bindImports",   LibcSummaries_bindImports,    METH_O,       ""},
+        {"emulate",       LibcSummaries_emulate,        METH_NOARGS,  ""},
+        {"getBindings",   LibcSummaries_getBindings,    METH_NOARGS,  ""},
+        {"getOutput",     LibcSummaries_getOutput,      METH_NOARGS,  ""},
+        {"isBound",       LibcSummaries_isBound,        METH_O,       ""},
+        {"setHeapBase",   LibcSummaries_setHeapBase,    METH_O,       ""},
+        {"unbind",        LibcSummaries_unbind,         METH_O,       ""},
+        {nullptr,         nullptr,                      0,            nullptr}
+      };
+
+
+      PyTypeObject LibcSummaries_Type = {
+        PyObject_HEAD_INIT(&PyType_Type)
+        0,                                          /* ob_size */
+        "LibcSummaries",                            /* tp_name */
+        sizeof(LibcSummaries_Object),               /* tp_basicsize */
+        0,                                          /* tp_itemsize */
+        (destructor)LibcSummaries_dealloc,          /* tp_dealloc */
+        0,                                          /* tp_print */
+        0,                                          /* tp_getattr */
+        0,                                          /* tp_setattr */
+        0,                                          /* tp_compare */
+        0,                                          /* tp_repr */
+        0,                                          /* tp_as_number */
+        0,                                          /* tp_as_sequence */
+        0,                                          /* tp_as_mapping */
+        0,                                          /* tp_hash */
+        0,                                          /* tp_call */
+        0,                                          /* tp_str */
+        0,                                          /* tp_getattro */
+        0,                                          /* tp_setattro */
+        0,                                          /* tp_as_buffer */
+        Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+        "LibcSummaries objects",                    /* tp_doc */
+        0,                                          /* tp_traverse */
+        0,                                          /* tp_clear */
+        0,                                          /* tp_richcompare */
+        0,                                          /* tp_weaklistoffset */
+        0,                                          /* tp_iter */
+        0,                                          /* tp_iternext */
+        LibcSummaries_callbacks,                    /* tp_methods */
+        0,                                          /* tp_members */
+        0,                                          /* tp_getset */
+        0,                                          /* tp_base */
+        0,                                          /* tp_dict */
+        0,                                          /* tp_descr_get */
+        0,                                          /* tp_descr_set */
+        0,                                          /* tp_dictoffset */
+        0,                                          /* tp_init */
+        0,                                          /* tp_alloc */
+        0,                                          /* tp_new */
+        0,                                          /* tp_free */
+        0,                                          /* tp_is_gc */
+        0,                                          /* tp_bases */
+        0,                                          /* tp_mro */
+        0,                                          /* tp_cache */
+        0,                                          /* tp_subclasses */
+        0,                                          /* tp_weaklist */
+        0,                                          /* tp_del */
+        0                                           /* tp_version_tag */
+      };
+
+
+      PyObject* PyLibcSummaries(PyObject* context, triton::os::unix::LibcSummaries* summaries) {
+        LibcSummaries_Object* object;
+
+        PyType_Ready(&LibcSummaries_Type);
+        object = PyObject_NEW(LibcSummaries_Object, &LibcSummaries_Type);
+        if (object != NULL) {
+          /* The summaries hold a reference on the API, keep the context alive */
+          Py_INCREF(context);
+          object->context   = context;
+          object->summaries = summaries;
+        }
+        else
+          delete summaries;
+
+        return (PyObject*)object;
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
+
+#endif /* __unix__ || __APPLE__ */
@@ -101,6 +101,10 @@ Returns the origin of the symbolic expression. For example, if the symbolic expr
 a \ref py_MemoryAccess_page, else if it is assigned to a register, this function returns a \ref py_Register_page otherwise it returns None. Note that
 for a \ref py_MemoryAccess_page all information about LEA are lost at this level.
 
+- <b>[\ref py_SymbolicExpression_page, ...] getReferences(void)</b><br>
+Returns the symbolic expressions directly referenced by the AST, sorted by id. These are the edges of the
+dependency graph walked by `TritonContext.sliceExpressions()`.
+
 - <b>\ref py_SYMBOLIC_page getType(void)</b><br>
 Returns the type of the symbolic expression.<br>
 e.g: `SYMBOLIC.REGISTER_EXPRESSION`
@@ -196,6 +200,23 @@ namespace triton {
       }
 
 
+      static PyObject* SymbolicExpression_getReferences(PyObject* self, PyObject* noarg) {
+        try {
+          const auto& refs = PySymbolicExpression_AsSymbolicExpression(self)->getReferences();
+          PyObject* ret    = xPyList_New(refs.size());
+          triton::usize index = 0;
+
+          for (const auto& ref : refs)
+            PyList_SetItem(ret, index++, PySymbolicExpression(ref));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* SymbolicExpression_getType(PyObject* self, PyObject* noarg) {
         try {
           return PyLong_FromUint32(PySymbolicExpression_AsSymbolicExpression(self)->getType());
@@ -317,6 +338,7 @@ namespace triton {
         {"getId",             SymbolicExpression_getId,             METH_NOARGS,    ""},
         {"getNewAst",         SymbolicExpression_getNewAst,         METH_NOARGS,    ""},
         {"getOrigin",         SymbolicExpression_getOrigin,         METH_NOARGS,    ""},
+        {"getReferences",     SymbolicExpression_getReferences,     METH_NOARGS,    ""},
         {"getType",           SymbolicExpression_getType,           METH_NOARGS,    ""},
         {"isMemory",          SymbolicExpression_isMemory,          METH_NOARGS,    ""},
         {"isRegister",        SymbolicExpression_isRegister,        METH_NOARGS,    ""},
@@ -0,0 +1,400 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <triton/pythonObjects.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/syscallEmulator.hpp>
+
+
+
+/*! \page py_SyscallEmulator_page SyscallEmulator
+    \brief [**python api**] All information about the SyscallEmulator python object.
+
+\tableofcontents
+
+\section py_SyscallEmulator_description Description
+<hr>
+
+This object is returned by \ref py_TritonContext_page `newSyscallEmulator()` and emulates the Linux
+system calls of the x86-64 and AArch64 ABIs natively. The syscall number and its arguments are read
+from the registers, the syscall is performed on a virtual file system and on the concrete memory, and
+the result is written into the return register (`rax` or `x0`). `/dev/stdin`, `/dev/stdout` and
+`/dev/stderr` are opened as fd 0, 1 and 2. Supported syscalls are read, write, readv, writev, open,
+openat, close, lseek, fstat, newfstatat, brk, mmap, munmap, mprotect, ioctl, arch_prctl, exit,
+exit_group and the get*id family. Other syscalls return `-ENOSYS`.
+
+Bytes returned by `read()` from a file added with `symbolize=True` (resp. `taint=True`) are
+converted into symbolic variables (resp. tainted) on the fly.
+
+~~~~~~~~~~~~~{.py}
+from triton import TritonContext, ARCH, Instruction
+
+ctxt = TritonContext()
+ctxt.setArchitecture(ARCH.X86_64)
+
+elf = ctxt.loadElf('./crackme_xor')
+sys = ctxt.newSyscallEmulator()
+sys.setStdin(b'password\n', True) # symbolized
+
+pc = elf.getEntryPoint()
+while not sys.hasExited():
+    inst = Instruction(pc, ctxt.getConcreteMemoryAreaValue(pc, 16))
+    ctxt.processing(inst)
+    if sys.isSyscall(inst):
+        sys.emulate()
+    pc = ctxt.getConcreteRegisterValue(ctxt.registers.rip)
+
+print sys.getFileContent('/dev/stdout')
+~~~~~~~~~~~~~
+
+\section SyscallEmulator_py_api Python API - Methods of the SyscallEmulator class
+<hr>
+
+- <b>void addFile(string path, bytes content, bool symbolize=False, bool taint=False)</b><br>
+Adds (or replaces the content of) a file of the virtual file system.
+
+- <b>bool emulate(void)</b><br>
+Emulates the system call described by the registers. Returns false if the syscall is not supported.
+
+- <b>integer getBrk(void)</b><br>
+Returns the current program break.
+
+- <b>integer getExitCode(void)</b><br>
+Returns the exit code of the program.
+
+- <b>bytes getFileContent(string path)</b><br>
+Returns the content of a file of the virtual file system (e.g. `/dev/stdout`).
+
+- <b>bool hasExited(void)</b><br>
+Returns true if the program called exit() or exit_group().
+
+- <b>bool isFile(string path)</b><br>
+Returns true if the path exists in the virtual file system.
+
+- <b>bool isSyscall(\ref py_Instruction_page inst)</b><br>
+Returns true if the instruction is a system call for the current architecture.
+
+- <b>void setBrk(integer addr)</b><br>
+Sets the initial program break (e.g. the end of the loaded image). Until it is set, brk() fails and
+the libc falls back on mmap().
+
+- <b>void setMmapBase(integer addr)</b><br>
+Sets the base address of the anonymous mappings.
+
+- <b>void setStdin(bytes content, bool symbolize=False, bool taint=False)</b><br>
+Sets the content of the standard input.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      //! SyscallEmulator destructor.
+      void SyscallEmulator_dealloc(PyObject* self) {
+        std::cout << std::flush;
+        delete PySyscallEmulator_AsSyscallEmulator(self);
+        Py_XDECREF(((SyscallEmulator_Object*)(self))->context);
+        Py_TYPE(self)->tp_free((PyObject*)self);
+      }
+
+
+      /* Copies a python buffer (bytes, bytearray, memoryview, ...) into a vector */
+      static bool SyscallEmulator_bufferToVector(PyObject* obj, std::vector<triton::uint8>& out) {
+        Py_buffer view;
+
+        if (!PyObject_CheckBuffer(obj) || PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS) < 0)
+          return false;
+
+        const triton::uint8* buf = reinterpret_cast<const triton::uint8*>(view.buf);
+        out.assign(buf, buf + view.len);
+        PyBuffer_Release(&view);
+
+        return true;
+      }
+
+
+      static PyObject* SyscallEmulator_addFile(PyObject* self, PyObject* args) {
+        PyObject* path      = nullptr;
+        PyObject* content   = nullptr;
+        PyObject* symbolize = nullptr;
+        PyObject* taint     = nullptr;
+        std::vector<triton::uint8> data;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OOOO", &path, &content, &symbolize, &taint);
+
+        if (path == nullptr || !PyString_Check(path))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::addFile(): Expects a string as path.");
+
+        if (content == nullptr || !SyscallEmulator_bufferToVector(content, data))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::addFile(): Expects a buffer as content.");
+
+        if ((symbolize != nullptr && !PyBool_Check(symbolize)) || (taint != nullptr && !PyBool_Check(taint)))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::addFile(): Expects booleans as symbolize and taint.");
+
+        try {
+          PySyscallEmulator_AsSyscallEmulator(self)->addFile(
+            PyString_AsString(path),
+            data,
+            (symbolize != nullptr) ? PyLong_AsBool(symbolize) : false,
+            (taint != nullptr) ? PyLong_AsBool(taint) : false
+          );
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_emulate(PyObject* self, PyObject* noarg) {
+        try {
+          if (PySyscallEmulator_AsSyscallEmulator(self)->emulate() == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_getBrk(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint64(PySyscallEmulator_AsSyscallEmulator(self)->getBrk());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_getExitCode(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint32(PySyscallEmulator_AsSyscallEmulator(self)->getExitCode());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_getFileContent(PyObject* self, PyObject* path) {
+        if (!PyString_Check(path))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::getFileContent(): Expects a string as argument.");
+
+        try {
+          const auto& content = PySyscallEmulator_AsSyscallEmulator(self)->getFileContent(PyString_AsString(path));
+          return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(content.data()), content.size());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_hasExited(PyObject* self, PyObject* noarg) {
+        try {
+          if (PySyscallEmulator_AsSyscallEmulator(self)->hasExited() == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_isFile(PyObject* self, PyObject* path) {
+        if (!PyString_Check(path))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::isFile(): Expects a string as argument.");
+
+        try {
+          if (PySyscallEmulator_AsSyscallEmulator(self)->isFile(PyString_AsString(path)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_isSyscall(PyObject* self, PyObject* inst) {
+        if (!PyInstruction_Check(inst))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::isSyscall(): Expects an Instruction as argument.");
+
+        try {
+          if (PySyscallEmulator_AsSyscallEmulator(self)->isSyscall(*PyInstruction_AsInstruction(inst)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_setBrk(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::setBrk(): Expects an integer as argument.");
+
+        try {
+          PySyscallEmulator_AsSyscallEmulator(self)->setBrk(PyLong_AsUint64(addr));
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_setMmapBase(PyObject* self, PyObject* addr) {
+        if (!PyLong_Check(addr) && !PyInt_Check(addr))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::setMmapBase(): Expects an integer as argument.");
+
+        try {
+          PySyscallEmulator_AsSyscallEmulator(self)->setMmapBase(PyLong_AsUint64(addr));
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* SyscallEmulator_setStdin(PyObject* self, PyObject* args) {
+        PyObject* content   = nullptr;
+        PyObject* symbolize = nullptr;
+        PyObject* taint     = nullptr;
+        std::vector<triton::uint8> data;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OOO", &content, &symbolize, &taint);
+
+        if (content == nullptr || !SyscallEmulator_bufferToVector(content, data))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::setStdin(): Expects a buffer as content.");
+
+        if ((symbolize != nullptr && !PyBool_Check(symbolize)) || (taint != nullptr && !PyBool_Check(taint)))
+          return PyErr_Format(PyExc_TypeError, "SyscallEmulator::setStdin(): Expects booleans as symbolize and taint.");
+
+        try {
+          PySyscallEmulator_AsSyscallEmulator(self)->setStdin(
+            data,
+            (symbolize != nullptr) ? PyLong_AsBool(symbolize) : false,
+            (taint != nullptr) ? PyLong_AsBool(taint) : false
+          );
+          Py_INCREF(Py_None);
+          return Py_None;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      //! SyscallEmulator methods.
+      PyMethodDef SyscallEmulator_callbacks[] = {
+        {"addFile",        SyscallEmulator_addFile,           METH_VARARGS, ""},
+        {"emulate",        SyscallEmulator_emulate,           METH_NOARGS,  ""},
+        {"getBrk",         SyscallEmulator_getBrk,            METH_NOARGS,  ""},
+        {"getExitCode",    SyscallEmulator_getExitCode,       METH_NOARGS,  ""},
+        {"getFileContent", SyscallEmulator_getFileContent,    METH_O,       ""},
+        {"hasExited",      SyscallEmulator_hasExited,         METH_NOARGS,  ""},
+        {"isFile",         SyscallEmulator_isFile,            METH_O,       ""},
+        {"isSyscall",      SyscallEmulator_isSyscall,         METH_O,       ""},
+        {"setBrk",         SyscallEmulator_setBrk,            METH_O,       ""},
+        {"setMmapBase",    SyscallEmulator_setMmapBase,       METH_O,       ""},
+        {"setStdin",       SyscallEmulator_setStdin,          METH_VARARGS, ""},
+        {nullptr,          nullptr,                           0,            nullptr}
+      };
+
+
+      PyTypeObject SyscallEmulator_Type = {
+        PyObject_HEAD_INIT(&PyType_Type)
+        0,                                          /* ob_size */
+        "SyscallEmulator",                          /* tp_name */
+        sizeof(SyscallEmulator_Object),             /* tp_basicsize */
+        0,                                          /* tp_itemsize */
+        (destructor)SyscallEmulator_dealloc,        /* tp_dealloc */
+        0,                                          /* tp_print */
+        0,                                          /* tp_getattr */
+        0,                                          /* tp_setattr */
+        0,                                          /* tp_compare */
+        0,                                          /* tp_repr */
+        0,                                          /* tp_as_number */
+        0,                                          /* tp_as_sequence */
+        0,                                          /* tp_as_mapping */
+        0,                                          /* tp_hash */
+        0,                                          /* tp_call */
+        0,                                          /* tp_str */
+        0,                                          /* tp_getattro */
+        0,                                          /* tp_setattro */
+        0,                                          /* tp_as_buffer */
+        Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+        "SyscallEmulator objects",                  /* tp_doc */
+        0,                                          /* tp_traverse */
+        0,                                          /* tp_clear */
+        0,                                          /* tp_richcompare */
+        0,                                          /* tp_weaklistoffset */
+        0,                                          /* tp_iter */
+        0,                                          /* tp_iternext */
+        SyscallEmulator_callbacks,                  /* tp_methods */
+        0,                                          /* tp_members */
+        0,                                          /* tp_getset */
+        0,                                          /* tp_base */
+        0,                                          /* tp_dict */
+        0,                                          /* tp_descr_get */
+        0,                                          /* tp_descr_set */
+        0,                                          /* tp_dictoffset */
+        0,                                          /* tp_init */
+        0,                                          /* tp_alloc */
+        0,                                          /* tp_new */
+        0,                                          /* tp_free */
+        0,                                          /* tp_is_gc */
+        0,                                          /* tp_bases */
+        0,                                          /* tp_mro */
+        0,                                          /* tp_cache */
+        0,                                          /* tp_subclasses */
+        0,                                          /* tp_weaklist */
+        0,                                          /* tp_del */
+        0                                           /* tp_version_tag */
+      };
+
+
+      PyObject* PySyscallEmulator(PyObject* context, triton::os::unix::SyscallEmulator* emulator) {
+        SyscallEmulator_Object* object;
+
+        PyType_Ready(&SyscallEmulator_Type);
+        object = PyObject_NEW(SyscallEmulator_Object, &SyscallEmulator_Type);
+        if (object != NULL) {
+          /* The emulator holds a reference on the API, keep the context alive */
+          Py_INCREF(context);
+          object->context  = context;
+          object->emulator = emulator;
+        }
+        else
+          delete emulator;
+
+        return (PyObject*)object;
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
+
+#endif /* __unix__ || __APPLE__ */
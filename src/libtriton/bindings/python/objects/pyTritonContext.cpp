@@ -12,6 +12,8 @@
 #include <triton/pythonXFunctions.hpp>
 #include <triton/register.hpp>
 
+#include <sstream>
+
 /*! \page py_TritonContext_page TritonContext
     \brief [**python api**] All information about the Triton Context class
     \anchor tritonContext
@@ -59,6 +61,13 @@ craft your expression with the `concat()` and `extract()` ast functions.
 Builds the instruction semantics. Returns true if the instruction is supported.
 You must define an architecture before.
 
+- <b>bool cancelQuery(integer ticket)</b><br>
+Cancels a query submitted with submitQuery(). Its status becomes
+`SOLVER_STATE.UNKNOWN`. Returns false if the query was already solved.
+
+- <b>void clearMemoryBudgetDrops(void)</b><br>
+Clears the record of the entries dropped by the memory budget.
+
 - <b>void clearPathConstraints(void)</b><br>
 Clears the logical conjunction vector of path constraints.
 
@@ -125,6 +134,19 @@ Enables or disables the symbolic execution engine.
 - <b>void enableTaintEngine(bool flag)</b><br>
 Enables or disables the taint engine.
 
+- <b>void enforceMemoryBudget(void)</b><br>
+Enforces the memory budget. This is automatically done after each instruction.
+
+- <b>\ref py_SOLVER_STATE_page enumerateModels(\ref py_AstNode_page node,
+function callback, [\ref py_SymbolicVariable_page, ...] projection=[], integer
+limit=0, integer threads=1, integer timeout=0)</b><br> Enumerates the models of
+a symbolic constraint and calls `callback` with each of them, as a dictionary
+of {integer symVarId : \ref py_SolverModel_page model}, as soon as it is found.
+The models are distinct on the variables of `projection`, or on all the
+variables if it is empty. The enumeration stops after `limit` models (0 for no
+limit) or when `callback` returns False. With `threads` > 1, the value space is
+split between several solvers. Returns the status of the enumeration.
+
 - <b>integer evaluateAstViaZ3(\ref py_AstNode_page node)</b><br>
 Evaluates an AST via Z3 and returns the symbolic value.
 
@@ -144,6 +166,11 @@ Returns the current AST representation mode.
 - <b>bytes getConcreteMemoryAreaValue(integer baseAddr, integer size)</b><br>
 Returns the concrete value of a memory area.
 
+- <b>memoryview getConcreteMemoryAreaValue(integer baseAddr, buffer area)</b><br>
+Fills a writable buffer (bytearray, numpy array, mmap, ...) with the concrete
+value of the memory area starting at `baseAddr` and returns a memoryview on it.
+The length of the area is the length of the buffer.
+
 - <b>integer getConcreteMemoryValue(integer addr)</b><br>
 Returns the concrete value of a memory cell.
 
@@ -169,13 +196,48 @@ Returns the AST corresponding to the \ref py_Immediate_page.
 Returns the AST corresponding to the \ref py_MemoryAccess_page with the SSA
 form.
 
-- <b>dict getModel(\ref py_AstNode_page node)</b><br>
-Computes and returns a model as a dictionary of {integer symVarId : \ref
-py_SolverModel_page model} from a symbolic constraint.
-
-- <b>[dict, ...] getModels(\ref py_AstNode_page node, integer limit)</b><br>
-Computes and returns several models from a symbolic constraint. The `limit` is
-the number of models returned.
+- <b>integer getMemoryBudget(void)</b><br>
+Returns the maximum number of symbolic bytes (memory cells and registers). 0
+means unlimited.
+
+- <b>integer getMemoryBudgetDepth(void)</b><br>
+Returns the maximum depth of the AST of an entry before being summarized. 0
+means unlimited.
+
+- <b>[dict, ...] getMemoryBudgetDrops(void)</b><br>
+Returns the entries dropped by the memory budget. Each entry is a dictionary
+holding the `id` of the dropped symbolic expression, its `address` or its
+\ref py_Register_page `register`, and `summarized` which is true if the entry
+has been replaced by a fresh symbolic variable and false if it has been
+concretized.
+
+- <b>\ref py_SYMBOLIC_page getMemoryBudgetPolicy(void)</b><br>
+Returns the policy used to select the entries dropped when the memory budget is
+exceeded.
+
+- <b>integer getMemoryBudgetUsage(void)</b><br>
+Returns the number of symbolic bytes (memory cells and registers).
+
+- <b>dict getModel(\ref py_AstNode_page node, bool status=False, integer
+timeout=0)</b><br> Computes and returns a model as a dictionary of {integer
+symVarId : \ref py_SolverModel_page model} from a symbolic constraint. If
+`status` is True, returns a tuple of the model and its \ref py_SOLVER_STATE_page.
+The `timeout` in milliseconds overrides the one set by setSolverTimeout().
+
+- <b>[dict, ...] getModels(\ref py_AstNode_page node, integer limit, bool
+status=False, integer timeout=0)</b><br> Computes and returns several models
+from a symbolic constraint. The `limit` is the number of models returned. If
+`status` is True, returns a tuple of the models and their \ref
+py_SOLVER_STATE_page.
+
+- <b>integer getNativeCount(void)</b><br>
+Returns the number of instructions executed natively on the concrete state by
+processing() and runUntil().
+
+- <b>\ref py_AstNode_page getNegatedPathConstraintsAst(integer index)</b><br>
+Returns the conjunction of the `index` first path constraints and of the
+negation of the `index`th one, i.e. the predicate to solve to take the other
+branch at `index`. Built in O(1) on the shared prefix conjunction.
 
 - <b>\ref py_Register_page getParentRegister(\ref py_Register_page reg)</b><br>
 Returns the parent \ref py_Register_page from a \ref py_Register_page.
@@ -189,7 +251,14 @@ Returns the logical conjunction vector of path constraints as list of \ref
 py_PathConstraint_page.
 
 - <b>\ref py_AstNode_page getPathConstraintsAst(void)</b><br>
-Returns the logical conjunction AST of path constraints.
+Returns the logical conjunction AST of path constraints in O(1). It is the last
+prefix conjunction, i.e. a chain of land nodes. The solver engine gives it flat
+to the solvers.
+
+- <b>\ref py_AstNode_page getPrefixPathConstraintsAst(integer index)</b><br>
+Returns the logical conjunction AST of the `index` first path constraints in
+O(1). Each prefix is the land of the previous one and of the next constraint,
+so the prefixes share their nodes.
 
 - <b>\ref py_Register_page getRegister(\ref py_REG_page id)</b><br>
 Returns the \ref py_Register_page class corresponding to a \ref py_REG_page id.
@@ -197,6 +266,10 @@ Returns the \ref py_Register_page class corresponding to a \ref py_REG_page id.
 - <b>\ref py_AstNode_page getRegisterAst(\ref py_Register_page reg)</b><br>
 Returns the AST corresponding to the \ref py_Register_page with the SSA form.
 
+- <b>[integer, ...] getSolverPoolWorkers(void)</b><br>
+Returns the pids of the workers of the solver pool, 0 for a worker not started
+yet. The list is empty without solver pool.
+
 - <b>\ref py_SymbolicExpression_page getSymbolicExpressionFromId(integer
 symExprId)</b><br> Returns the symbolic expression corresponding to an id.
 
@@ -299,6 +372,19 @@ Returns true if the symbolic expression id exists.
 - <b>bool isTaintEngineEnabled(void)</b><br>
 Returns true if the taint engine is enabled.
 
+- <b>\ref py_ElfLoader_page loadElf(string path, integer base=0, bool lazy=True)</b><br>
+Loads an ELF file into the concrete memory and applies its dynamic relocations. `base` is added to
+every address. If `lazy` is true, a page is only copied the first time it is accessed. Unix only.
+
+- <b>void loadState(string path | bytes data)</b><br>
+Replaces the symbolic state (symbolic variables and their concrete values, symbolic expressions, symbolic
+registers and memory cells, path constraints) by the one saved by saveState(). A file is mapped in memory
+rather than read. The concrete registers and memory are not part of the state.
+
+- <b>\ref py_LibcSummaries_page newLibcSummaries(void)</b><br>
+Returns new native summaries of common libc routines (x86-64 and AArch64 ABIs) working on this
+context. Unix only.
+
 - <b>\ref py_SymbolicExpression_page newSymbolicExpression(\ref py_AstNode_page
 node, string comment)</b><br> Returns a new symbolic expression. Note that if
 there are simplification passes recorded, simplifications will be applied.
@@ -306,19 +392,44 @@ there are simplification passes recorded, simplifications will be applied.
 - <b>\ref py_SymbolicVariable_page newSymbolicVariable(integer varSize, string
 comment)</b><br> Returns a new symbolic variable.
 
+- <b>\ref py_SyscallEmulator_page newSyscallEmulator(void)</b><br>
+Returns a new native Linux syscall emulator (x86-64 and AArch64 ABIs) working on this context. Unix only.
+
+- <b>bool pollQuery(integer ticket)</b><br>
+Returns true if a query submitted with submitQuery() is solved.
+
 - <b>bool processing(\ref py_Instruction_page inst)</b><br>
 Processes an instruction and updates engines according to the instruction
 semantics. Returns true if the instruction is supported. You must define an
 architecture before.
 
 - <b>void removeAllCallbacks(void)</b><br>
-Removes all recorded callbacks.
+Removes all recorded callbacks. A lazy \ref py_ElfLoader_page maps its pending pages first.
 
 - <b>void removeCallback(function cb, \ref py_CALLBACK_page kind)</b><br>
 Removes a recorded callback.
 
+- <b>void removePathConstraintsCompression(integer addr)</b><br>
+Removes the compression policy of the branch at `addr`. The path constraints already removed are lost.
+
+- <b>void removeSymbolicExpression(integer symExprId)</b><br>
+Removes the symbolic expression corresponding to the id and concretizes the registers and memory cells
+assigned to it.
+
 - <b>void reset(void)</b><br>
-Resets everything.
+Resets everything. A lazy \ref py_ElfLoader_page maps its pending pages first.
+
+- <b>integer runUntil(target, integer count=0)</b><br>
+Executes instructions from the program counter until it reaches `target` (an
+address), until `target` (a function taking the program counter) returns true,
+or until `count` instructions have been executed (0 for no limit, `target` may
+then be None). When the symbolic and taint engines are disabled, the common
+instructions are executed natively on the concrete state without building ASTs,
+the other ones are processed. Returns the number of executed instructions.
+
+- <b>bytes saveState(string path=None)</b><br>
+Saves the symbolic state in a compact binary format where the ASTs are stored as DAGs. The state is written
+to `path` if it is given, returned as bytes otherwise.
 
 - <b>void setArchitecture(\ref py_ARCH_page arch)</b><br>
 Initializes an architecture. This function must be called before any call to the
@@ -332,10 +443,12 @@ Sets the concrete value of a memory area. Note that by setting a concrete value
 will probably imply a desynchronization with the symbolic state (if it exists).
 You should probably use the concretize functions after this.
 
-- <b>void setConcreteMemoryAreaValue(integer baseAddr, bytes opcodes)</b><br>
-Sets the concrete value of a memory area. Note that by setting a concrete value
-will probably imply a desynchronization with the symbolic state (if it exists).
-You should probably use the concretize functions after this.
+- <b>void setConcreteMemoryAreaValue(integer baseAddr, buffer area)</b><br>
+Sets the concrete value of a memory area from any object implementing the
+buffer protocol (bytes, bytearray, memoryview, numpy array, mmap, ...). Note
+that by setting a concrete value will probably imply a desynchronization with
+the symbolic state (if it exists). You should probably use the concretize
+functions after this.
 
 - <b>void setConcreteMemoryValue(integer addr, integer value)</b><br>
 Sets the concrete value of a memory cell. Note that by setting a concrete value
@@ -355,6 +468,51 @@ concrete value will probably imply a desynchronization with the symbolic state
 - <b>void setConcreteVariableValue(\ref py_SymbolicVariable_page symVar, integer
 value)</b><br> Sets the concrete value of a symbolic variable.
 
+- <b>void setMemoryBudget(integer maxBytes)</b><br>
+Sets the maximum number of symbolic bytes (memory cells and registers). When
+exceeded after an instruction, entries are concretized in the order of the
+policy until a quarter of the budget is free. 0 means unlimited (default).
+
+- <b>void setMemoryBudgetDepth(integer maxDepth)</b><br>
+Sets the maximum depth of the AST of an entry. Entries assigned with a deeper
+AST are summarized by a fresh symbolic variable holding their concrete value. 0
+means unlimited (default).
+
+- <b>void setMemoryBudgetPolicy(\ref py_SYMBOLIC_page policy)</b><br>
+Sets the policy used to select the entries dropped when the memory budget is
+exceeded: `SYMBOLIC.BUDGET_LRU` (default), `SYMBOLIC.BUDGET_DEPTH` or
+`SYMBOLIC.BUDGET_NOT_SYMBOLIZED`.
+
+- <b>void setPathConstraintsCompression(integer addr, integer first, integer
+last)</b><br> Keeps only the `first` and the `last` path constraints of the
+branch at `addr`, so that a loop does not grow the path constraints with its
+trip count. The instances between them are removed as new ones are added. The
+path constraints are then an over-approximation of the path, and a model may
+follow another number of iterations.
+
+- <b>void setSolverMemoryLimit(integer mb)</b><br>
+Sets the memory limit of the solver in megabytes, 0 for no limit. A query which
+reaches it returns `SOLVER_STATE.OUTOFMEM`. With z3, this limit is global to the
+process.
+
+- <b>void setSolverPool(integer workers, integer timeout=0, integer
+maxQueries=0)</b><br> Solves the queries of getModel(), getModels(), isSat()
+and submitQuery() in a pool of `workers` processes, or in the process if
+`workers` is 0. A worker
+is killed after `timeout` milliseconds on a query without time limit, and a
+query which crashes or is killed returns `SOLVER_STATE.TIMEOUT` or
+`SOLVER_STATE.UNKNOWN` without stopping the analysis. A worker is replaced after
+`maxQueries` queries. Only the predefined solvers can be pooled.
+
+- <b>void setSolverResourceLimit(integer rlimit)</b><br>
+Sets the resource limit (z3 rlimit) of a query, 0 for no limit. Unlike a time
+limit, it gives the same result on every run. A query which reaches it returns
+`SOLVER_STATE.UNKNOWN`.
+
+- <b>void setSolverTimeout(integer ms)</b><br>
+Sets the default time limit of a query in milliseconds, 0 for no limit. A query
+which reaches it returns `SOLVER_STATE.TIMEOUT`.
+
 - <b>bool setTaintMemory(\ref py_MemoryAccess_page mem, bool flag)</b><br>
 Sets the targeted memory as tainted or not. Returns true if the memory is still
 tainted.
@@ -373,6 +531,16 @@ Slices expressions from a given one (backward slicing) and returns all symbolic
 expressions as a dictionary of {integer SymExprId : \ref
 py_SymbolicExpression_page expr}.
 
+- <b>dict sliceVariables(\ref py_SymbolicExpression_page expr)</b><br>
+Returns the symbolic variables which influence an expression as a dictionary of
+{integer SymVarId : \ref py_SymbolicVariable_page var}.
+
+- <b>integer submitQuery(\ref py_AstNode_page node, integer limit=1, integer
+timeout=0)</b><br> Submits a query to solve in the background and returns its
+ticket. If `limit` is 0, only the satisfiability is checked, otherwise at most
+`limit` models are computed. The queries are solved one at a time, on a copy of
+the constraint, so the analysis can go on meanwhile.
+
 - <b>bool taintAssignmentMemoryImmediate(\ref py_MemoryAccess_page
 memDst)</b><br> Taints `memDst` with an assignment - `memDst` is untained.
 Returns true if the `memDst` is still tainted.
@@ -450,6 +618,12 @@ Untaints a memory. Returns true if the memory is still tainted.
 - <b>bool untaintRegister(\ref py_Register_page reg)</b><br>
 Untaints a register. Returns true if the register is still tainted.
 
+- <b>tuple waitQuery(integer ticket)</b><br>
+Waits until a query submitted with submitQuery() is solved and returns a tuple
+of its \ref py_SOLVER_STATE_page and of its models as a list of dictionaries of
+{integer symVarId : \ref py_SolverModel_page model}. The ticket is then
+forgotten.
+
 */
 
 namespace triton {
@@ -888,6 +1062,33 @@ static PyObject* TritonContext_buildSemantics(PyObject* self, PyObject* inst) {
   }
 }
 
+static PyObject* TritonContext_cancelQuery(PyObject* self, PyObject* ticket) {
+  if (!PyLong_Check(ticket) && !PyInt_Check(ticket))
+    return PyErr_Format(PyExc_TypeError,
+                        "cancelQuery(): Expects an integer as argument.");
+
+  try {
+    if (PyTritonContext_AsTritonContext(self)->cancelQuery(
+            PyLong_AsUsize(ticket)) == true)
+      Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
+static PyObject* TritonContext_clearMemoryBudgetDrops(PyObject* self,
+                                                     PyObject* noarg) {
+  try {
+    PyTritonContext_AsTritonContext(self)->clearMemoryBudgetDrops();
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 static PyObject* TritonContext_clearPathConstraints(PyObject* self,
                                                     PyObject* noarg) {
   try {
@@ -1327,6 +1528,138 @@ static PyObject* TritonContext_enableTaintEngine(PyObject* self,
   return Py_None;
 }
 
+static PyObject* TritonContext_enforceMemoryBudget(PyObject* self,
+                                                   PyObject* noarg) {
+  try {
+    PyTritonContext_AsTritonContext(self)->enforceMemoryBudget();
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+/* Converts a model to a dictionary */
+static PyObject* TritonContext_modelToDict(
+    const std::map<triton::uint32, triton::engines::solver::SolverModel>&
+        model) {
+  PyObject* mdict = xPyDict_New();
+
+  for (auto it = model.begin(); it != model.end(); it++) {
+    xPyDict_SetItem(mdict, PyLong_FromUint32(it->first),
+                    PySolverModel(it->second));
+  }
+
+  return mdict;
+}
+
+static PyObject* TritonContext_enumerateModels(PyObject* self,
+                                               PyObject* args) {
+  std::vector<triton::engines::symbolic::SharedSymbolicVariable> projection;
+  triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
+  std::string error;
+  PyObject* node = nullptr;
+  PyObject* callback = nullptr;
+  PyObject* vars = nullptr;
+  PyObject* limit = nullptr;
+  PyObject* threads = nullptr;
+  PyObject* timeout = nullptr;
+  bool failed = false;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OOOOOO", &node, &callback, &vars, &limit, &threads,
+                   &timeout);
+
+  if (node == nullptr || !PyAstNode_Check(node))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "enumerateModels(): Expects a AstNode as first argument.");
+
+  if (callback == nullptr || !PyCallable_Check(callback))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "enumerateModels(): Expects a function as second argument.");
+
+  if (vars != nullptr && !PyList_Check(vars))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "enumerateModels(): Expects a list of SymbolicVariable as third "
+        "argument.");
+
+  if (limit != nullptr && (!PyLong_Check(limit) && !PyInt_Check(limit)))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "enumerateModels(): Expects an integer as fourth argument.");
+
+  if (threads != nullptr && (!PyLong_Check(threads) && !PyInt_Check(threads)))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "enumerateModels(): Expects an integer as fifth argument.");
+
+  if (timeout != nullptr && (!PyLong_Check(timeout) && !PyInt_Check(timeout)))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "enumerateModels(): Expects an integer as sixth argument.");
+
+  if (vars != nullptr) {
+    for (Py_ssize_t i = 0; i < PyList_Size(vars); i++) {
+      PyObject* item = PyList_GetItem(vars, i);
+      if (!PySymbolicVariable_Check(item))
+        return PyErr_Format(PyExc_TypeError,
+                            "enumerateModels(): Each element of the list must "
+                            "be a SymbolicVariable.");
+      projection.push_back(PySymbolicVariable_AsSymbolicVariable(item));
+    }
+  }
+
+  triton::API* api = PyTritonContext_AsTritonContext(self);
+  triton::ast::SharedAbstractNode constraint = PyAstNode_AsAstNode(node);
+  triton::uint32 maxModels = limit ? PyLong_AsUint32(limit) : 0;
+  triton::uint32 nthreads = threads ? PyLong_AsUint32(threads) : 1;
+  triton::uint32 ms = timeout ? PyLong_AsUint32(timeout) : 0;
+
+  /* The solver runs without the GIL, the callback takes it back */
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    api->enumerateModels(
+        constraint, projection,
+        [callback, &failed](
+            const std::map<triton::uint32,
+                           triton::engines::solver::SolverModel>& model) {
+          PyGILState_STATE gil = PyGILState_Ensure();
+          PyObject* mdict = TritonContext_modelToDict(model);
+          PyObject* ret = PyObject_CallFunctionObjArgs(callback, mdict, nullptr);
+          Py_DECREF(mdict);
+
+          /* The exception of the callback is raised once stopped */
+          bool next = false;
+          if (ret == nullptr) {
+            failed = true;
+          } else {
+            /* Only an explicit False stops the enumeration */
+            next = (ret != Py_False);
+            Py_DECREF(ret);
+          }
+
+          PyGILState_Release(gil);
+          return next;
+        },
+        maxModels, nthreads, &status, ms);
+  } catch (const triton::exceptions::Exception& e) {
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  if (!error.empty())
+    return PyErr_Format(PyExc_TypeError, "%s", error.c_str());
+
+  if (failed)
+    return nullptr;
+
+  return PyLong_FromUint32(status);
+}
+
 static PyObject* TritonContext_evaluateAstViaZ3(PyObject* self,
                                                 PyObject* node) {
   if (!PyAstNode_Check(node))
@@ -1392,7 +1725,6 @@ static PyObject* TritonContext_getAstRepresentationMode(PyObject* self,
 
 static PyObject* TritonContext_getConcreteMemoryAreaValue(PyObject* self,
                                                           PyObject* args) {
-  triton::uint8* area = nullptr;
   PyObject* ret = nullptr;
   PyObject* addr = nullptr;
   PyObject* size = nullptr;
@@ -1400,25 +1732,60 @@ static PyObject* TritonContext_getConcreteMemoryAreaValue(PyObject* self,
   /* Extract arguments */
   PyArg_ParseTuple(args, "|OO", &addr, &size);
 
-  try {
-    std::vector<triton::uint8> vv =
-        PyTritonContext_AsTritonContext(self)->getConcreteMemoryAreaValue(
-            PyLong_AsUint64(addr), PyLong_AsUsize(size));
-    area = new triton::uint8[vv.size()];
+  if (addr == nullptr || (!PyLong_Check(addr) && !PyInt_Check(addr)))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "getConcreteMemoryAreaValue(): Expects an integer as first argument.");
+
+  if (size == nullptr)
+    return PyErr_Format(PyExc_TypeError,
+                        "getConcreteMemoryAreaValue(): Expects an integer or "
+                        "a writable buffer as second argument.");
+
+  // Python object: Integer, returns a new bytes object filled in place
+  if (PyLong_Check(size) || PyInt_Check(size)) {
+    triton::usize length = PyLong_AsUsize(size);
+
+    ret = PyBytes_FromStringAndSize(nullptr, length);
+    if (ret == nullptr)
+      return nullptr;
 
-    for (triton::usize index = 0; index < vv.size(); index++)
-      area[index] = vv[index];
+    try {
+      PyTritonContext_AsTritonContext(self)->getConcreteMemoryAreaValue(
+          PyLong_AsUint64(addr),
+          reinterpret_cast<triton::uint8*>(PyBytes_AS_STRING(ret)), length);
+    } catch (const triton::exceptions::Exception& e) {
+      Py_DECREF(ret);
+      return PyErr_Format(PyExc_TypeError, "%s", e.what());
+    }
 
-    ret = PyBytes_FromStringAndSize(reinterpret_cast<const char*>(area),
-                                    vv.size());
-    delete[] area;
     return ret;
+  }
 
-  } catch (const triton::exceptions::Exception& e) {
-    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  // Python object: Writable buffer (bytearray, numpy array, mmap, ...)
+  if (PyObject_CheckBuffer(size)) {
+    Py_buffer view;
+
+    if (PyObject_GetBuffer(size, &view,
+                           PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) < 0)
+      return nullptr;
+
+    try {
+      PyTritonContext_AsTritonContext(self)->getConcreteMemoryAreaValue(
+          PyLong_AsUint64(addr), reinterpret_cast<triton::uint8*>(view.buf),
+          static_cast<triton::usize>(view.len));
+    } catch (const triton::exceptions::Exception& e) {
+      PyBuffer_Release(&view);
+      return PyErr_Format(PyExc_TypeError, "%s", e.what());
+    }
+
+    PyBuffer_Release(&view);
+    return PyMemoryView_FromObject(size);
   }
 
-  return ret;
+  return PyErr_Format(PyExc_TypeError,
+                      "getConcreteMemoryAreaValue(): Expects an integer or a "
+                      "writable buffer as second argument.");
 }
 
 static PyObject* TritonContext_getConcreteMemoryValue(PyObject* self,
@@ -1541,20 +1908,47 @@ static PyObject* TritonContext_getMemoryAst(PyObject* self, PyObject* mem) {
   }
 }
 
-static PyObject* TritonContext_getModel(PyObject* self, PyObject* node) {
-  PyObject* ret = nullptr;
+static PyObject* TritonContext_getMemoryBudget(PyObject* self,
+                                               PyObject* noarg) {
+  try {
+    return PyLong_FromUsize(
+        PyTritonContext_AsTritonContext(self)->getMemoryBudget());
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
 
-  if (!PyAstNode_Check(node))
-    return PyErr_Format(PyExc_TypeError,
-                        "getModel(): Expects a AstNode as argument.");
+static PyObject* TritonContext_getMemoryBudgetDepth(PyObject* self,
+                                                    PyObject* noarg) {
+  try {
+    return PyLong_FromUint32(
+        PyTritonContext_AsTritonContext(self)->getMemoryBudgetDepth());
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
+static PyObject* TritonContext_getMemoryBudgetDrops(PyObject* self,
+                                                    PyObject* noarg) {
+  PyObject* ret = nullptr;
 
   try {
-    ret = xPyDict_New();
-    auto model = PyTritonContext_AsTritonContext(self)->getModel(
-        PyAstNode_AsAstNode(node));
-    for (auto it = model.begin(); it != model.end(); it++) {
-      xPyDict_SetItem(ret, PyLong_FromUint32(it->first),
-                      PySolverModel(it->second));
+    triton::API* api = PyTritonContext_AsTritonContext(self);
+    const auto& drops = api->getMemoryBudgetDrops();
+    triton::uint32 index = 0;
+
+    ret = xPyList_New(drops.size());
+    for (const auto& drop : drops) {
+      PyObject* item = xPyDict_New();
+      xPyDict_SetItemString(item, "id", PyLong_FromUsize(drop.id));
+      if (drop.regId == triton::arch::ID_REG_INVALID)
+        xPyDict_SetItemString(item, "address", PyLong_FromUint64(drop.address));
+      else
+        xPyDict_SetItemString(item, "register",
+                              PyRegister(api->getRegister(drop.regId)));
+      xPyDict_SetItemString(item, "summarized",
+                            PyBool_FromLong(drop.summarized));
+      PyList_SetItem(ret, index++, item);
     }
   } catch (const triton::exceptions::Exception& e) {
     return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -1563,13 +1957,108 @@ static PyObject* TritonContext_getModel(PyObject* self, PyObject* node) {
   return ret;
 }
 
+static PyObject* TritonContext_getMemoryBudgetPolicy(PyObject* self,
+                                                     PyObject* noarg) {
+  try {
+    return PyLong_FromUint32(
+        PyTritonContext_AsTritonContext(self)->getMemoryBudgetPolicy());
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
+static PyObject* TritonContext_getMemoryBudgetUsage(PyObject* self,
+                                                    PyObject* noarg) {
+  try {
+    return PyLong_FromUsize(
+        PyTritonContext_AsTritonContext(self)->getMemoryBudgetUsage());
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
+static PyObject* TritonContext_getModel(PyObject* self, PyObject* args) {
+  std::map<triton::uint32, triton::engines::solver::SolverModel> model;
+  triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
+  std::string error;
+  PyObject* ret = nullptr;
+  PyObject* node = nullptr;
+  PyObject* wantStatus = nullptr;
+  PyObject* timeout = nullptr;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OOO", &node, &wantStatus, &timeout);
+
+  if (node == nullptr || !PyAstNode_Check(node))
+    return PyErr_Format(PyExc_TypeError,
+                        "getModel(): Expects a AstNode as first argument.");
+
+  if (wantStatus != nullptr && !PyBool_Check(wantStatus))
+    return PyErr_Format(PyExc_TypeError,
+                        "getModel(): Expects a boolean as second argument.");
+
+  if (timeout != nullptr && (!PyLong_Check(timeout) && !PyInt_Check(timeout)))
+    return PyErr_Format(PyExc_TypeError,
+                        "getModel(): Expects an integer as third argument.");
+
+  triton::API* api = PyTritonContext_AsTritonContext(self);
+  triton::ast::SharedAbstractNode constraint = PyAstNode_AsAstNode(node);
+  triton::uint32 ms = timeout ? PyLong_AsUint32(timeout) : 0;
+
+  /* The solver runs without the GIL */
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    model = api->getModel(constraint, &status, ms);
+  } catch (const triton::exceptions::Exception& e) {
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  if (!error.empty())
+    return PyErr_Format(PyExc_TypeError, "%s", error.c_str());
+
+  ret = TritonContext_modelToDict(model);
+
+  if (wantStatus != nullptr && PyLong_AsBool(wantStatus)) {
+    PyObject* tuple = xPyTuple_New(2);
+    PyTuple_SetItem(tuple, 0, ret);
+    PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+    return tuple;
+  }
+
+  return ret;
+}
+
+/* Converts a list of models to a list of dictionaries */
+static PyObject* TritonContext_modelsToList(
+    const std::list<std::map<triton::uint32,
+                             triton::engines::solver::SolverModel>>& models) {
+  PyObject* ret = xPyList_New(0);
+
+  for (auto it = models.begin(); it != models.end(); it++) {
+    if (it->size() == 0) continue;
+
+    PyObject* mdict = TritonContext_modelToDict(*it);
+    PyList_Append(ret, mdict);
+    Py_DECREF(mdict);
+  }
+
+  return ret;
+}
+
 static PyObject* TritonContext_getModels(PyObject* self, PyObject* args) {
+  std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>>
+      models;
+  triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
+  std::string error;
   PyObject* ret = nullptr;
   PyObject* node = nullptr;
   PyObject* limit = nullptr;
+  PyObject* wantStatus = nullptr;
+  PyObject* timeout = nullptr;
 
   /* Extract arguments */
-  PyArg_ParseTuple(args, "|OO", &node, &limit);
+  PyArg_ParseTuple(args, "|OOOO", &node, &limit, &wantStatus, &timeout);
 
   if (node == nullptr || !PyAstNode_Check(node))
     return PyErr_Format(PyExc_TypeError,
@@ -1579,27 +2068,66 @@ static PyObject* TritonContext_getModels(PyObject* self, PyObject* args) {
     return PyErr_Format(PyExc_TypeError,
                         "getModels(): Expects an integer as second argument.");
 
+  if (wantStatus != nullptr && !PyBool_Check(wantStatus))
+    return PyErr_Format(PyExc_TypeError,
+                        "getModels(): Expects a boolean as third argument.");
+
+  if (timeout != nullptr && (!PyLong_Check(timeout) && !PyInt_Check(timeout)))
+    return PyErr_Format(PyExc_TypeError,
+                        "getModels(): Expects an integer as fourth argument.");
+
+  triton::API* api = PyTritonContext_AsTritonContext(self);
+  triton::ast::SharedAbstractNode constraint = PyAstNode_AsAstNode(node);
+  triton::uint32 maxModels = PyLong_AsUint32(limit);
+  triton::uint32 ms = timeout ? PyLong_AsUint32(timeout) : 0;
+
+  /* The solver runs without the GIL */
+  Py_BEGIN_ALLOW_THREADS
   try {
-    auto models = PyTritonContext_AsTritonContext(self)->getModels(
-        PyAstNode_AsAstNode(node), PyLong_AsUint32(limit));
-    triton::uint32 index = 0;
+    models = api->getModels(constraint, maxModels, &status, ms);
+  } catch (const triton::exceptions::Exception& e) {
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
 
-    ret = xPyList_New(models.size());
-    for (auto it = models.begin(); it != models.end(); it++) {
-      PyObject* mdict = xPyDict_New();
-      auto model = *it;
+  if (!error.empty())
+    return PyErr_Format(PyExc_TypeError, "%s", error.c_str());
 
-      for (auto it2 = model.begin(); it2 != model.end(); it2++) {
-        xPyDict_SetItem(mdict, PyLong_FromUint32(it2->first),
-                        PySolverModel(it2->second));
-      }
-      if (model.size() > 0) PyList_SetItem(ret, index++, mdict);
-    }
+  ret = TritonContext_modelsToList(models);
+
+  if (wantStatus != nullptr && PyLong_AsBool(wantStatus)) {
+    PyObject* tuple = xPyTuple_New(2);
+    PyTuple_SetItem(tuple, 0, ret);
+    PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+    return tuple;
+  }
+
+  return ret;
+}
+
+static PyObject* TritonContext_getNativeCount(PyObject* self, PyObject* noarg) {
+  try {
+    return PyLong_FromUsize(
+        PyTritonContext_AsTritonContext(self)->getNativeCount());
   } catch (const triton::exceptions::Exception& e) {
     return PyErr_Format(PyExc_TypeError, "%s", e.what());
   }
+}
 
-  return ret;
+static PyObject* TritonContext_getNegatedPathConstraintsAst(PyObject* self,
+                                                            PyObject* index) {
+  if (!PyLong_Check(index) && !PyInt_Check(index))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "getNegatedPathConstraintsAst(): Expects an integer as argument.");
+
+  try {
+    return PyAstNode(
+        PyTritonContext_AsTritonContext(self)->getNegatedPathConstraintsAst(
+            PyLong_AsUsize(index)));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
 }
 
 static PyObject* TritonContext_getParentRegisters(PyObject* self,
@@ -1650,6 +2178,22 @@ static PyObject* TritonContext_getPathConstraintsAst(PyObject* self,
   }
 }
 
+static PyObject* TritonContext_getPrefixPathConstraintsAst(PyObject* self,
+                                                           PyObject* index) {
+  if (!PyLong_Check(index) && !PyInt_Check(index))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "getPrefixPathConstraintsAst(): Expects an integer as argument.");
+
+  try {
+    return PyAstNode(
+        PyTritonContext_AsTritonContext(self)->getPrefixPathConstraintsAst(
+            PyLong_AsUsize(index)));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
 static PyObject* TritonContext_getRegister(PyObject* self, PyObject* regIn) {
   triton::arch::register_e rid = triton::arch::ID_REG_INVALID;
 
@@ -1680,6 +2224,21 @@ static PyObject* TritonContext_getRegisterAst(PyObject* self, PyObject* reg) {
   }
 }
 
+static PyObject* TritonContext_getSolverPoolWorkers(PyObject* self,
+                                                   PyObject* noarg) {
+  try {
+    auto pids = PyTritonContext_AsTritonContext(self)->getSolverPoolWorkers();
+    PyObject* ret = xPyList_New(pids.size());
+
+    for (triton::usize i = 0; i < pids.size(); i++)
+      PyList_SetItem(ret, i, PyLong_FromUint32(pids[i]));
+
+    return ret;
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
 static PyObject* TritonContext_getSymbolicExpressionFromId(
     PyObject* self, PyObject* symExprId) {
   if (!PyLong_Check(symExprId) && !PyInt_Check(symExprId))
@@ -2113,14 +2672,26 @@ static PyObject* TritonContext_isSat(PyObject* self, PyObject* node) {
     return PyErr_Format(PyExc_TypeError,
                         "isSat(): Expects a AstNode as argument.");
 
+  triton::API* api = PyTritonContext_AsTritonContext(self);
+  triton::ast::SharedAbstractNode constraint = PyAstNode_AsAstNode(node);
+  std::string error;
+  bool sat = false;
+
+  /* The solver runs without the GIL */
+  Py_BEGIN_ALLOW_THREADS
   try {
-    if (PyTritonContext_AsTritonContext(self)->isSat(
-            PyAstNode_AsAstNode(node)) == true)
-      Py_RETURN_TRUE;
-    Py_RETURN_FALSE;
+    sat = api->isSat(constraint);
   } catch (const triton::exceptions::Exception& e) {
-    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+    error = e.what();
   }
+  Py_END_ALLOW_THREADS
+
+  if (!error.empty())
+    return PyErr_Format(PyExc_TypeError, "%s", error.c_str());
+
+  if (sat == true)
+    Py_RETURN_TRUE;
+  Py_RETURN_FALSE;
 }
 
 static PyObject* TritonContext_isSymbolicEngineEnabled(PyObject* self,
@@ -2178,23 +2749,92 @@ static PyObject* TritonContext_isTaintEngineEnabled(PyObject* self,
   }
 }
 
-static PyObject* TritonContext_newSymbolicExpression(PyObject* self,
-                                                     PyObject* args) {
-  PyObject* node = nullptr;
-  PyObject* comment = nullptr;
-  std::string ccomment = "";
+#if defined(__unix__) || defined(__APPLE__)
+static PyObject* TritonContext_loadElf(PyObject* self, PyObject* args) {
+  PyObject* path = nullptr;
+  PyObject* base = nullptr;
+  PyObject* lazy = nullptr;
 
   /* Extract arguments */
-  PyArg_ParseTuple(args, "|OO", &node, &comment);
+  PyArg_ParseTuple(args, "|OOO", &path, &base, &lazy);
 
-  if (node == nullptr || (!PyAstNode_Check(node)))
-    return PyErr_Format(
-        PyExc_TypeError,
-        "newSymbolicExpression(): Expects a AstNode as first argument.");
+  if (path == nullptr || !PyString_Check(path))
+    return PyErr_Format(PyExc_TypeError,
+                        "loadElf(): Expects a string as first argument.");
 
-  if (comment != nullptr && !PyString_Check(comment))
-    return PyErr_Format(
-        PyExc_TypeError,
+  if (base != nullptr && !PyLong_Check(base) && !PyInt_Check(base))
+    return PyErr_Format(PyExc_TypeError,
+                        "loadElf(): Expects an integer as second argument.");
+
+  if (lazy != nullptr && !PyBool_Check(lazy))
+    return PyErr_Format(PyExc_TypeError,
+                        "loadElf(): Expects a boolean as third argument.");
+
+  triton::os::unix::ElfLoader* loader = nullptr;
+  try {
+    loader = new triton::os::unix::ElfLoader(
+        *PyTritonContext_AsTritonContext(self));
+    loader->load(PyString_AsString(path),
+                 (base != nullptr) ? PyLong_AsUint64(base) : 0,
+                 (lazy != nullptr) ? PyLong_AsBool(lazy) : true);
+    return PyElfLoader(self, loader);
+  } catch (const triton::exceptions::Exception& e) {
+    delete loader;
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+#endif
+
+static PyObject* TritonContext_loadState(PyObject* self, PyObject* arg) {
+  try {
+    if (PyBytes_Check(arg)) {
+      PyTritonContext_AsTritonContext(self)->loadState(
+          reinterpret_cast<const triton::uint8*>(PyBytes_AsString(arg)),
+          static_cast<triton::usize>(PyBytes_Size(arg)));
+    } else if (PyString_Check(arg)) {
+      PyTritonContext_AsTritonContext(self)->loadState(
+          std::string(PyString_AsString(arg)));
+    } else {
+      return PyErr_Format(PyExc_TypeError,
+                          "loadState(): Expects a path or bytes as argument.");
+    }
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static PyObject* TritonContext_newLibcSummaries(PyObject* self,
+                                                PyObject* noarg) {
+  try {
+    return PyLibcSummaries(self, new triton::os::unix::LibcSummaries(
+                                     *PyTritonContext_AsTritonContext(self)));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+#endif
+
+static PyObject* TritonContext_newSymbolicExpression(PyObject* self,
+                                                     PyObject* args) {
+  PyObject* node = nullptr;
+  PyObject* comment = nullptr;
+  std::string ccomment = "";
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OO", &node, &comment);
+
+  if (node == nullptr || (!PyAstNode_Check(node)))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "newSymbolicExpression(): Expects a AstNode as first argument.");
+
+  if (comment != nullptr && !PyString_Check(comment))
+    return PyErr_Format(
+        PyExc_TypeError,
         "newSymbolicExpression(): Expects a sting as second argument.");
 
   if (comment != nullptr) ccomment = PyString_AsString(comment);
@@ -2238,6 +2878,33 @@ static PyObject* TritonContext_newSymbolicVariable(PyObject* self,
   }
 }
 
+#if defined(__unix__) || defined(__APPLE__)
+static PyObject* TritonContext_newSyscallEmulator(PyObject* self,
+                                                  PyObject* noarg) {
+  try {
+    return PySyscallEmulator(self, new triton::os::unix::SyscallEmulator(
+                                       *PyTritonContext_AsTritonContext(self)));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+#endif
+
+static PyObject* TritonContext_pollQuery(PyObject* self, PyObject* ticket) {
+  if (!PyLong_Check(ticket) && !PyInt_Check(ticket))
+    return PyErr_Format(PyExc_TypeError,
+                        "pollQuery(): Expects an integer as argument.");
+
+  try {
+    if (PyTritonContext_AsTritonContext(self)->pollQuery(
+            PyLong_AsUsize(ticket)) == true)
+      Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
 static PyObject* TritonContext_processing(PyObject* self, PyObject* inst) {
   if (!PyInstruction_Check(inst))
     return PyErr_Format(PyExc_TypeError,
@@ -2323,6 +2990,42 @@ static PyObject* TritonContext_removeCallback(PyObject* self, PyObject* args) {
   return Py_None;
 }
 
+static PyObject* TritonContext_removePathConstraintsCompression(PyObject* self,
+                                                                PyObject* addr) {
+  if (!PyLong_Check(addr) && !PyInt_Check(addr))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "removePathConstraintsCompression(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->removePathConstraintsCompression(
+        PyLong_AsUint64(addr));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_removeSymbolicExpression(PyObject* self,
+                                                        PyObject* symExprId) {
+  if (!PyInt_Check(symExprId) && !PyLong_Check(symExprId))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "removeSymbolicExpression(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->removeSymbolicExpression(
+        PyLong_AsUsize(symExprId));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 static PyObject* TritonContext_reset(PyObject* self, PyObject* noarg) {
   try {
     PyTritonContext_AsTritonContext(self)->reset();
@@ -2334,6 +3037,106 @@ static PyObject* TritonContext_reset(PyObject* self, PyObject* noarg) {
   return Py_None;
 }
 
+static PyObject* TritonContext_runUntil(PyObject* self, PyObject* args) {
+  PyObject* target = nullptr;
+  PyObject* count = nullptr;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OO", &target, &count);
+
+  if (target == nullptr ||
+      (target != Py_None && !PyCallable_Check(target) &&
+       !PyLong_Check(target) && !PyInt_Check(target)))
+    return PyErr_Format(PyExc_TypeError,
+                        "runUntil(): Expects an integer, a function or None "
+                        "as first argument.");
+
+  if (count != nullptr && (!PyLong_Check(count) && !PyInt_Check(count)))
+    return PyErr_Format(PyExc_TypeError,
+                        "runUntil(): Expects an integer as second argument.");
+
+  triton::usize limit = (count != nullptr) ? PyLong_AsUsize(count) : 0;
+  triton::usize executed = 0;
+
+  if (target == Py_None && limit == 0)
+    return PyErr_Format(
+        PyExc_TypeError,
+        "runUntil(): Expects a target or a count of instructions.");
+
+  try {
+    if (target == Py_None) {
+      executed = PyTritonContext_AsTritonContext(self)->runUntil(
+          [](triton::uint64) { return false; }, limit);
+    } else if (PyCallable_Check(target)) {
+      executed = PyTritonContext_AsTritonContext(self)->runUntil(
+          [target](triton::uint64 pc) {
+            PyObject* args = triton::bindings::python::xPyTuple_New(1);
+            PyTuple_SetItem(args, 0,
+                            triton::bindings::python::PyLong_FromUint64(pc));
+
+            /* Call the function */
+            PyObject* ret = PyObject_CallObject(target, args);
+            Py_DECREF(args);
+
+            /* Check the call */
+            if (ret == nullptr) {
+              PyObject* type = nullptr;
+              PyObject* value = nullptr;
+              PyObject* traceback = nullptr;
+
+              /* Fetch the last exception */
+              PyErr_Fetch(&type, &value, &traceback);
+
+              std::string str = PyString_AsString(PyObject_Str(value));
+              Py_XDECREF(type);
+              Py_XDECREF(value);
+              Py_XDECREF(traceback);
+              throw triton::exceptions::Bindings(str);
+            }
+
+            bool stop = PyObject_IsTrue(ret);
+            Py_DECREF(ret);
+            return stop;
+          },
+          limit);
+    } else {
+      executed = PyTritonContext_AsTritonContext(self)->runUntil(
+          PyLong_AsUint64(target), limit);
+    }
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  return PyLong_FromUsize(executed);
+}
+
+static PyObject* TritonContext_saveState(PyObject* self, PyObject* args) {
+  PyObject* path = nullptr;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|O", &path);
+
+  if (path != nullptr && path != Py_None && !PyString_Check(path))
+    return PyErr_Format(PyExc_TypeError,
+                        "saveState(): Expects a string as argument.");
+
+  try {
+    if (path != nullptr && path != Py_None) {
+      PyTritonContext_AsTritonContext(self)->saveState(
+          std::string(PyString_AsString(path)));
+      Py_INCREF(Py_None);
+      return Py_None;
+    }
+
+    std::ostringstream ss;
+    PyTritonContext_AsTritonContext(self)->saveState(ss);
+    std::string data = ss.str();
+    return PyBytes_FromStringAndSize(data.data(), data.size());
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
 static PyObject* TritonContext_setArchitecture(PyObject* self, PyObject* arg) {
   if (!PyLong_Check(arg) && !PyInt_Check(arg))
     return PyErr_Format(PyExc_TypeError,
@@ -2387,8 +3190,8 @@ static PyObject* TritonContext_setConcreteMemoryAreaValue(PyObject* self,
 
   if (values == nullptr)
     return PyErr_Format(PyExc_TypeError,
-                        "setConcreteMemoryAreaValue(): Expects a list or bytes "
-                        "as second argument.");
+                        "setConcreteMemoryAreaValue(): Expects a list or a "
+                        "buffer as second argument.");
 
   // Python object: List
   if (PyList_Check(values)) {
@@ -2412,39 +3215,32 @@ static PyObject* TritonContext_setConcreteMemoryAreaValue(PyObject* self,
     }
   }
 
-  // Python object: Bytes
-  else if (PyBytes_Check(values)) {
-    triton::uint8* area =
-        reinterpret_cast<triton::uint8*>(PyBytes_AsString(values));
-    triton::usize size = static_cast<triton::usize>(PyBytes_Size(values));
+  // Python object: Any buffer (bytes, bytearray, memoryview, numpy array,
+  // mmap, ...). The area is copied in one shot into the memory model.
+  else if (PyObject_CheckBuffer(values)) {
+    Py_buffer view;
 
-    try {
-      PyTritonContext_AsTritonContext(self)->setConcreteMemoryAreaValue(
-          PyLong_AsUint64(baseAddr), area, size);
-    } catch (const triton::exceptions::Exception& e) {
-      return PyErr_Format(PyExc_TypeError, "%s", e.what());
-    }
-  }
-
-  // Python object: ByteArray
-  else if (PyByteArray_Check(values)) {
-    triton::uint8* area =
-        reinterpret_cast<triton::uint8*>(PyByteArray_AsString(values));
-    triton::usize size = static_cast<triton::usize>(PyByteArray_Size(values));
+    if (PyObject_GetBuffer(values, &view, PyBUF_C_CONTIGUOUS) < 0)
+      return nullptr;
 
     try {
       PyTritonContext_AsTritonContext(self)->setConcreteMemoryAreaValue(
-          PyLong_AsUint64(baseAddr), area, size);
+          PyLong_AsUint64(baseAddr),
+          reinterpret_cast<const triton::uint8*>(view.buf),
+          static_cast<triton::usize>(view.len));
     } catch (const triton::exceptions::Exception& e) {
+      PyBuffer_Release(&view);
       return PyErr_Format(PyExc_TypeError, "%s", e.what());
     }
+
+    PyBuffer_Release(&view);
   }
 
   // Invalid Python object
   else
     return PyErr_Format(PyExc_TypeError,
-                        "setConcreteMemoryAreaValue(): Expects a list or bytes "
-                        "as second argument.");
+                        "setConcreteMemoryAreaValue(): Expects a list or a "
+                        "buffer as second argument.");
 
   Py_INCREF(Py_None);
   return Py_None;
@@ -2564,6 +3360,183 @@ static PyObject* TritonContext_setConcreteVariableValue(PyObject* self,
   return Py_None;
 }
 
+static PyObject* TritonContext_setMemoryBudget(PyObject* self,
+                                               PyObject* maxBytes) {
+  if (!PyLong_Check(maxBytes) && !PyInt_Check(maxBytes))
+    return PyErr_Format(PyExc_TypeError,
+                        "setMemoryBudget(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setMemoryBudget(
+        PyLong_AsUsize(maxBytes));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setMemoryBudgetDepth(PyObject* self,
+                                                    PyObject* maxDepth) {
+  if (!PyLong_Check(maxDepth) && !PyInt_Check(maxDepth))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "setMemoryBudgetDepth(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setMemoryBudgetDepth(
+        PyLong_AsUint32(maxDepth));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setMemoryBudgetPolicy(PyObject* self,
+                                                     PyObject* policy) {
+  if (!PyLong_Check(policy) && !PyInt_Check(policy))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "setMemoryBudgetPolicy(): Expects a SYMBOLIC policy as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setMemoryBudgetPolicy(
+        static_cast<triton::engines::symbolic::budget_policy_e>(
+            PyLong_AsUint32(policy)));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setPathConstraintsCompression(PyObject* self,
+                                                             PyObject* args) {
+  PyObject* addr = nullptr;
+  PyObject* first = nullptr;
+  PyObject* last = nullptr;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OOO", &addr, &first, &last);
+
+  if (addr == nullptr || (!PyLong_Check(addr) && !PyInt_Check(addr)))
+    return PyErr_Format(PyExc_TypeError,
+                        "setPathConstraintsCompression(): Expects an integer "
+                        "as first argument.");
+
+  if (first == nullptr || (!PyLong_Check(first) && !PyInt_Check(first)))
+    return PyErr_Format(PyExc_TypeError,
+                        "setPathConstraintsCompression(): Expects an integer "
+                        "as second argument.");
+
+  if (last == nullptr || (!PyLong_Check(last) && !PyInt_Check(last)))
+    return PyErr_Format(PyExc_TypeError,
+                        "setPathConstraintsCompression(): Expects an integer "
+                        "as third argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setPathConstraintsCompression(
+        PyLong_AsUint64(addr), PyLong_AsUsize(first), PyLong_AsUsize(last));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setSolverMemoryLimit(PyObject* self,
+                                                    PyObject* mb) {
+  if (!PyLong_Check(mb) && !PyInt_Check(mb))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "setSolverMemoryLimit(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setSolverMemoryLimit(
+        PyLong_AsUint32(mb));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setSolverPool(PyObject* self, PyObject* args) {
+  PyObject* workers = nullptr;
+  PyObject* timeout = nullptr;
+  PyObject* maxQueries = nullptr;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OOO", &workers, &timeout, &maxQueries);
+
+  if (workers == nullptr || (!PyLong_Check(workers) && !PyInt_Check(workers)))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "setSolverPool(): Expects an integer as first argument.");
+
+  if (timeout != nullptr && !PyLong_Check(timeout) && !PyInt_Check(timeout))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "setSolverPool(): Expects an integer as second argument.");
+
+  if (maxQueries != nullptr && !PyLong_Check(maxQueries) &&
+      !PyInt_Check(maxQueries))
+    return PyErr_Format(PyExc_TypeError,
+                        "setSolverPool(): Expects an integer as third argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setSolverPool(
+        PyLong_AsUsize(workers),
+        timeout != nullptr ? PyLong_AsUint32(timeout) : 0,
+        maxQueries != nullptr ? PyLong_AsUsize(maxQueries) : 0);
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setSolverResourceLimit(PyObject* self,
+                                                      PyObject* rlimit) {
+  if (!PyLong_Check(rlimit) && !PyInt_Check(rlimit))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "setSolverResourceLimit(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setSolverResourceLimit(
+        PyLong_AsUint32(rlimit));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* TritonContext_setSolverTimeout(PyObject* self, PyObject* ms) {
+  if (!PyLong_Check(ms) && !PyInt_Check(ms))
+    return PyErr_Format(PyExc_TypeError,
+                        "setSolverTimeout(): Expects an integer as argument.");
+
+  try {
+    PyTritonContext_AsTritonContext(self)->setSolverTimeout(
+        PyLong_AsUint32(ms));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 static PyObject* TritonContext_setTaintMemory(PyObject* self, PyObject* args) {
   PyObject* mem = nullptr;
   PyObject* flag = nullptr;
@@ -2669,6 +3642,58 @@ static PyObject* TritonContext_sliceExpressions(PyObject* self,
   return ret;
 }
 
+static PyObject* TritonContext_sliceVariables(PyObject* self, PyObject* expr) {
+  PyObject* ret = nullptr;
+
+  if (!PySymbolicExpression_Check(expr))
+    return PyErr_Format(
+        PyExc_TypeError,
+        "sliceVariables(): Expects a SymbolicExpression as argument.");
+
+  try {
+    auto vars = PyTritonContext_AsTritonContext(self)->sliceVariables(
+        PySymbolicExpression_AsSymbolicExpression(expr));
+
+    ret = xPyDict_New();
+    for (auto it = vars.begin(); it != vars.end(); it++)
+      xPyDict_SetItem(ret, PyLong_FromUsize(it->first),
+                      PySymbolicVariable(it->second));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+
+  return ret;
+}
+
+static PyObject* TritonContext_submitQuery(PyObject* self, PyObject* args) {
+  PyObject* node = nullptr;
+  PyObject* limit = nullptr;
+  PyObject* timeout = nullptr;
+
+  /* Extract arguments */
+  PyArg_ParseTuple(args, "|OOO", &node, &limit, &timeout);
+
+  if (node == nullptr || !PyAstNode_Check(node))
+    return PyErr_Format(PyExc_TypeError,
+                        "submitQuery(): Expects a AstNode as first argument.");
+
+  if (limit != nullptr && (!PyLong_Check(limit) && !PyInt_Check(limit)))
+    return PyErr_Format(PyExc_TypeError,
+                        "submitQuery(): Expects an integer as second argument.");
+
+  if (timeout != nullptr && (!PyLong_Check(timeout) && !PyInt_Check(timeout)))
+    return PyErr_Format(PyExc_TypeError,
+                        "submitQuery(): Expects an integer as third argument.");
+
+  try {
+    return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->submitQuery(
+        PyAstNode_AsAstNode(node), limit ? PyLong_AsUint32(limit) : 1,
+        timeout ? PyLong_AsUint32(timeout) : 0));
+  } catch (const triton::exceptions::Exception& e) {
+    return PyErr_Format(PyExc_TypeError, "%s", e.what());
+  }
+}
+
 static PyObject* TritonContext_taintAssignmentMemoryImmediate(PyObject* self,
                                                               PyObject* mem) {
   if (!PyMemoryAccess_Check(mem))
@@ -3077,6 +4102,37 @@ static PyObject* TritonContext_untaintRegister(PyObject* self, PyObject* reg) {
   }
 }
 
+static PyObject* TritonContext_waitQuery(PyObject* self, PyObject* ticket) {
+  std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>>
+      models;
+  triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
+  std::string error;
+
+  if (!PyLong_Check(ticket) && !PyInt_Check(ticket))
+    return PyErr_Format(PyExc_TypeError,
+                        "waitQuery(): Expects an integer as argument.");
+
+  triton::API* api = PyTritonContext_AsTritonContext(self);
+  triton::usize id = PyLong_AsUsize(ticket);
+
+  /* The query is waited without the GIL */
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    status = api->waitQuery(id, &models);
+  } catch (const triton::exceptions::Exception& e) {
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  if (!error.empty())
+    return PyErr_Format(PyExc_TypeError, "%s", error.c_str());
+
+  PyObject* ret = xPyTuple_New(2);
+  PyTuple_SetItem(ret, 0, PyLong_FromUint32(status));
+  PyTuple_SetItem(ret, 1, TritonContext_modelsToList(models));
+  return ret;
+}
+
 static PyObject* TritonContext_getParentRegister(PyObject* self,
                                                  PyObject* reg) {
   if (!PyRegister_Check(reg))
@@ -3127,6 +4183,9 @@ PyMethodDef TritonContext_callbacks[] = {
      (PyCFunction)TritonContext_assignSymbolicExpressionToRegister,
      METH_VARARGS, ""},
     {"buildSemantics", (PyCFunction)TritonContext_buildSemantics, METH_O, ""},
+    {"cancelQuery", (PyCFunction)TritonContext_cancelQuery, METH_O, ""},
+    {"clearMemoryBudgetDrops",
+     (PyCFunction)TritonContext_clearMemoryBudgetDrops, METH_NOARGS, ""},
     {"clearPathConstraints", (PyCFunction)TritonContext_clearPathConstraints,
      METH_NOARGS, ""},
     {"concretizeAllMemory", (PyCFunction)TritonContext_concretizeAllMemory,
@@ -3163,6 +4222,10 @@ PyMethodDef TritonContext_callbacks[] = {
      METH_O, ""},
     {"enableTaintEngine", (PyCFunction)TritonContext_enableTaintEngine, METH_O,
      ""},
+    {"enforceMemoryBudget", (PyCFunction)TritonContext_enforceMemoryBudget,
+     METH_NOARGS, ""},
+    {"enumerateModels", (PyCFunction)TritonContext_enumerateModels,
+     METH_VARARGS, ""},
     {"evaluateAstViaZ3", (PyCFunction)TritonContext_evaluateAstViaZ3, METH_O,
      ""},
     {"getAllRegisters", (PyCFunction)TritonContext_getAllRegisters, METH_NOARGS,
@@ -3186,8 +4249,22 @@ PyMethodDef TritonContext_callbacks[] = {
     {"getGprSize", (PyCFunction)TritonContext_getGprSize, METH_NOARGS, ""},
     {"getImmediateAst", (PyCFunction)TritonContext_getImmediateAst, METH_O, ""},
     {"getMemoryAst", (PyCFunction)TritonContext_getMemoryAst, METH_O, ""},
-    {"getModel", (PyCFunction)TritonContext_getModel, METH_O, ""},
+    {"getMemoryBudget", (PyCFunction)TritonContext_getMemoryBudget, METH_NOARGS,
+     ""},
+    {"getMemoryBudgetDepth", (PyCFunction)TritonContext_getMemoryBudgetDepth,
+     METH_NOARGS, ""},
+    {"getMemoryBudgetDrops", (PyCFunction)TritonContext_getMemoryBudgetDrops,
+     METH_NOARGS, ""},
+    {"getMemoryBudgetPolicy", (PyCFunction)TritonContext_getMemoryBudgetPolicy,
+     METH_NOARGS, ""},
+    {"getMemoryBudgetUsage", (PyCFunction)TritonContext_getMemoryBudgetUsage,
+     METH_NOARGS, ""},
+    {"getModel", (PyCFunction)TritonContext_getModel, METH_VARARGS, ""},
     {"getModels", (PyCFunction)TritonContext_getModels, METH_VARARGS, ""},
+    {"getNativeCount", (PyCFunction)TritonContext_getNativeCount, METH_NOARGS,
+     ""},
+    {"getNegatedPathConstraintsAst",
+     (PyCFunction)TritonContext_getNegatedPathConstraintsAst, METH_O, ""},
     {"getParentRegister", (PyCFunction)TritonContext_getParentRegister, METH_O,
      ""},
     {"getParentRegisters", (PyCFunction)TritonContext_getParentRegisters,
@@ -3196,8 +4273,12 @@ PyMethodDef TritonContext_callbacks[] = {
      METH_NOARGS, ""},
     {"getPathConstraintsAst", (PyCFunction)TritonContext_getPathConstraintsAst,
      METH_NOARGS, ""},
+    {"getPrefixPathConstraintsAst",
+     (PyCFunction)TritonContext_getPrefixPathConstraintsAst, METH_O, ""},
     {"getRegister", (PyCFunction)TritonContext_getRegister, METH_O, ""},
     {"getRegisterAst", (PyCFunction)TritonContext_getRegisterAst, METH_O, ""},
+    {"getSolverPoolWorkers", (PyCFunction)TritonContext_getSolverPoolWorkers,
+     METH_NOARGS, ""},
     {"getSymbolicExpressionFromId",
      (PyCFunction)TritonContext_getSymbolicExpressionFromId, METH_O, ""},
     {"getSymbolicExpressions",
@@ -3246,16 +4327,35 @@ PyMethodDef TritonContext_callbacks[] = {
      (PyCFunction)TritonContext_isSymbolicExpressionIdExists, METH_O, ""},
     {"isTaintEngineEnabled", (PyCFunction)TritonContext_isTaintEngineEnabled,
      METH_NOARGS, ""},
+#if defined(__unix__) || defined(__APPLE__)
+    {"loadElf", (PyCFunction)TritonContext_loadElf, METH_VARARGS, ""},
+#endif
+    {"loadState", (PyCFunction)TritonContext_loadState, METH_O, ""},
+#if defined(__unix__) || defined(__APPLE__)
+    {"newLibcSummaries", (PyCFunction)TritonContext_newLibcSummaries,
+     METH_NOARGS, ""},
+#endif
     {"newSymbolicExpression", (PyCFunction)TritonContext_newSymbolicExpression,
      METH_VARARGS, ""},
     {"newSymbolicVariable", (PyCFunction)TritonContext_newSymbolicVariable,
      METH_VARARGS, ""},
+#if defined(__unix__) || defined(__APPLE__)
+    {"newSyscallEmulator", (PyCFunction)TritonContext_newSyscallEmulator,
+     METH_NOARGS, ""},
+#endif
+    {"pollQuery", (PyCFunction)TritonContext_pollQuery, METH_O, ""},
     {"processing", (PyCFunction)TritonContext_processing, METH_O, ""},
     {"removeAllCallbacks", (PyCFunction)TritonContext_removeAllCallbacks,
      METH_NOARGS, ""},
     {"removeCallback", (PyCFunction)TritonContext_removeCallback, METH_VARARGS,
      ""},
+    {"removePathConstraintsCompression",
+     (PyCFunction)TritonContext_removePathConstraintsCompression, METH_O, ""},
+    {"removeSymbolicExpression",
+     (PyCFunction)TritonContext_removeSymbolicExpression, METH_O, ""},
     {"reset", (PyCFunction)TritonContext_reset, METH_NOARGS, ""},
+    {"runUntil", (PyCFunction)TritonContext_runUntil, METH_VARARGS, ""},
+    {"saveState", (PyCFunction)TritonContext_saveState, METH_VARARGS, ""},
     {"setArchitecture", (PyCFunction)TritonContext_setArchitecture, METH_O, ""},
     {"setAstRepresentationMode",
      (PyCFunction)TritonContext_setAstRepresentationMode, METH_O, ""},
@@ -3267,6 +4367,22 @@ PyMethodDef TritonContext_callbacks[] = {
      (PyCFunction)TritonContext_setConcreteRegisterValue, METH_VARARGS, ""},
     {"setConcreteVariableValue",
      (PyCFunction)TritonContext_setConcreteVariableValue, METH_VARARGS, ""},
+    {"setMemoryBudget", (PyCFunction)TritonContext_setMemoryBudget, METH_O, ""},
+    {"setMemoryBudgetDepth", (PyCFunction)TritonContext_setMemoryBudgetDepth,
+     METH_O, ""},
+    {"setMemoryBudgetPolicy", (PyCFunction)TritonContext_setMemoryBudgetPolicy,
+     METH_O, ""},
+    {"setPathConstraintsCompression",
+     (PyCFunction)TritonContext_setPathConstraintsCompression, METH_VARARGS,
+     ""},
+    {"setSolverMemoryLimit", (PyCFunction)TritonContext_setSolverMemoryLimit,
+     METH_O, ""},
+    {"setSolverPool", (PyCFunction)TritonContext_setSolverPool, METH_VARARGS,
+     ""},
+    {"setSolverResourceLimit",
+     (PyCFunction)TritonContext_setSolverResourceLimit, METH_O, ""},
+    {"setSolverTimeout", (PyCFunction)TritonContext_setSolverTimeout, METH_O,
+     ""},
     {"setTaintMemory", (PyCFunction)TritonContext_setTaintMemory, METH_VARARGS,
      ""},
     {"setTaintRegister", (PyCFunction)TritonContext_setTaintRegister,
@@ -3274,6 +4390,8 @@ PyMethodDef TritonContext_callbacks[] = {
     {"simplify", (PyCFunction)TritonContext_simplify, METH_VARARGS, ""},
     {"sliceExpressions", (PyCFunction)TritonContext_sliceExpressions, METH_O,
      ""},
+    {"sliceVariables", (PyCFunction)TritonContext_sliceVariables, METH_O, ""},
+    {"submitQuery", (PyCFunction)TritonContext_submitQuery, METH_VARARGS, ""},
     {"taintAssignmentMemoryImmediate",
      (PyCFunction)TritonContext_taintAssignmentMemoryImmediate, METH_O, ""},
     {"taintAssignmentMemoryMemory",
@@ -3306,6 +4424,7 @@ PyMethodDef TritonContext_callbacks[] = {
     {"unmapMemory", (PyCFunction)TritonContext_unmapMemory, METH_VARARGS, ""},
     {"untaintMemory", (PyCFunction)TritonContext_untaintMemory, METH_O, ""},
     {"untaintRegister", (PyCFunction)TritonContext_untaintRegister, METH_O, ""},
+    {"waitQuery", (PyCFunction)TritonContext_waitQuery, METH_O, ""},
     {"createSnapshot", (PyCFunction)TritonContext_createSnapshot, METH_NOARGS,
      ""},
     {"restoreSnapshot", (PyCFunction)TritonContext_restoreSnapshot, METH_O, ""},
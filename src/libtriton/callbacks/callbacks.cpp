@@ -15,7 +15,8 @@ namespace triton {
   namespace callbacks {
 
     Callbacks::Callbacks(triton::API& api) : api(api) {
-      this->isDefined = false;
+      this->isDefined     = false;
+      this->lastFinalizer = 0;
     }
 
 
@@ -50,11 +51,31 @@ namespace triton {
 
 
     void Callbacks::removeAllCallbacks(void) {
+      /* A finalizer is removed before it is called, it may remove callbacks and its own registration */
+      while (!this->finalizers.empty()) {
+        auto it = this->finalizers.begin();
+        std::function<void(void)> fn = it->second;
+        this->finalizers.erase(it);
+        fn();
+      }
+
       this->getConcreteMemoryValueCallbacks.clear();
       this->getConcreteRegisterValueCallbacks.clear();
       this->setConcreteMemoryValueCallbacks.clear();
       this->setConcreteRegisterValueCallbacks.clear();
       this->symbolicSimplificationCallbacks.clear();
+      this->isDefined = false;
+    }
+
+
+    triton::usize Callbacks::addFinalizer(const std::function<void(void)>& fn) {
+      this->finalizers[++this->lastFinalizer] = fn;
+      return this->lastFinalizer;
+    }
+
+
+    void Callbacks::removeFinalizer(triton::usize id) {
+      this->finalizers.erase(id);
     }
 
 
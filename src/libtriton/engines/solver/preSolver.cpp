@@ -0,0 +1,636 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <triton/astContext.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/preSolver.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/symbolicVariable.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      namespace {
+        /* An inclusive range of values */
+        typedef std::pair<triton::uint512, triton::uint512> Range;
+
+        /* A set of values, as sorted and disjoint ranges */
+        typedef std::vector<Range> Ranges;
+
+        /* The maximum number of values mapped one by one through bvxor and bvmul */
+        const triton::usize MAX_POINTS = 256;
+
+        /* The bits [high:low] of a symbolic variable */
+        struct Slice {
+          triton::usize id;
+          triton::uint32 low;
+          triton::uint32 high;
+
+          bool operator<(const Slice& other) const {
+            if (this->id != other.id)
+              return this->id < other.id;
+            if (this->low != other.low)
+              return this->low < other.low;
+            return this->high < other.high;
+          }
+        };
+
+        /* The constraints gathered from a formula */
+        struct State {
+          /* The constrained variables. **item**: id -> variable */
+          std::map<triton::usize, triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+          /* The allowed values of the slices */
+          std::map<Slice, Ranges> slices;
+
+          /* True if a member of the conjunction is unsatisfiable */
+          bool unsat = false;
+        };
+
+
+        /* Sorts the ranges and merges the adjacent ones */
+        Ranges normalize(Ranges ranges) {
+          Ranges ret;
+
+          std::sort(ranges.begin(), ranges.end());
+          for (const Range& range : ranges) {
+            if (!ret.empty() && range.first != 0 && range.first - 1 <= ret.back().second)
+              ret.back().second = std::max(ret.back().second, range.second);
+            else
+              ret.push_back(range);
+          }
+
+          return ret;
+        }
+
+
+        /* Adds the range [low, high] modulo mask + 1, which may wrap around */
+        void addWrapped(Ranges& ranges, const triton::uint512& low, const triton::uint512& high, const triton::uint512& mask) {
+          if (low <= high) {
+            ranges.push_back(Range(low, high));
+          }
+          else {
+            ranges.push_back(Range(0, high));
+            ranges.push_back(Range(low, mask));
+          }
+        }
+
+
+        bool contains(const Ranges& ranges, const triton::uint512& value) {
+          for (const Range& range : ranges) {
+            if (value < range.first)
+              return false;
+            if (value <= range.second)
+              return true;
+          }
+          return false;
+        }
+
+
+        Ranges intersect(const Ranges& a, const Ranges& b) {
+          Ranges ret;
+          triton::usize i = 0;
+          triton::usize j = 0;
+
+          while (i < a.size() && j < b.size()) {
+            triton::uint512 low  = std::max(a[i].first, b[j].first);
+            triton::uint512 high = std::min(a[i].second, b[j].second);
+
+            if (low <= high)
+              ret.push_back(Range(low, high));
+
+            if (a[i].second < b[j].second)
+              i++;
+            else
+              j++;
+          }
+
+          return ret;
+        }
+
+
+        Ranges complement(const Ranges& ranges, const triton::uint512& mask) {
+          Ranges ret;
+          triton::uint512 next = 0;
+          bool end = false;
+
+          for (const Range& range : ranges) {
+            if (range.first > next)
+              ret.push_back(Range(next, range.first - 1));
+            if (range.second == mask) {
+              end = true;
+              break;
+            }
+            next = range.second + 1;
+          }
+
+          if (!end)
+            ret.push_back(Range(next, mask));
+
+          return ret;
+        }
+
+
+        /* The values y such that y + value (mod mask + 1) is in the set */
+        Ranges shift(const Ranges& ranges, const triton::uint512& value, const triton::uint512& mask) {
+          triton::uint512 offset = (mask - value + 1) & mask;
+          Ranges ret;
+
+          for (const Range& range : ranges)
+            addWrapped(ret, (range.first + offset) & mask, (range.second + offset) & mask, mask);
+
+          return normalize(ret);
+        }
+
+
+        /* The values y such that value - y (mod mask + 1) is in the set */
+        Ranges reflect(const Ranges& ranges, const triton::uint512& value, const triton::uint512& mask) {
+          Ranges ret;
+
+          for (const Range& range : ranges)
+            addWrapped(ret, (value - range.second) & mask, (value - range.first) & mask, mask);
+
+          return normalize(ret);
+        }
+
+
+        /* Maps a set through a bijection, value by value. Returns false if the set or its complement is too large. */
+        template <typename F>
+        bool mapPoints(Ranges& ranges, const triton::uint512& mask, F function) {
+          for (bool inverted : {false, true}) {
+            Ranges points = inverted ? complement(ranges, mask) : ranges;
+
+            if (points.size() > MAX_POINTS)
+              continue;
+
+            bool single = std::all_of(points.begin(), points.end(), [](const Range& range) { return range.first == range.second; });
+            if (!single)
+              continue;
+
+            Ranges ret;
+            for (const Range& range : points) {
+              triton::uint512 value = function(range.first) & mask;
+              ret.push_back(Range(value, value));
+            }
+
+            ret    = normalize(ret);
+            ranges = inverted ? complement(ret, mask) : ret;
+            return true;
+          }
+
+          return false;
+        }
+
+
+        /* The inverse of an odd value modulo mask + 1 (Newton iteration, each step doubles the exact bits) */
+        triton::uint512 inverse(const triton::uint512& value, const triton::uint512& mask) {
+          triton::uint512 ret = value;
+
+          for (triton::uint32 i = 0; i < 9; i++)
+            ret = (ret * (2 - value * ret)) & mask;
+
+          return ret;
+        }
+
+
+        /* The values x such that (x kind value) holds */
+        Ranges compare(triton::ast::ast_e kind, const triton::uint512& value, const triton::uint512& mask) {
+          triton::uint512 bias = (mask >> 1) + 1;
+
+          switch (kind) {
+            case triton::ast::EQUAL_NODE:     return Ranges{Range(value, value)};
+            case triton::ast::DISTINCT_NODE:  return complement(Ranges{Range(value, value)}, mask);
+            case triton::ast::BVULT_NODE:     return value == 0 ? Ranges{} : Ranges{Range(0, value - 1)};
+            case triton::ast::BVULE_NODE:     return Ranges{Range(0, value)};
+            case triton::ast::BVUGT_NODE:     return value == mask ? Ranges{} : Ranges{Range(value + 1, mask)};
+            case triton::ast::BVUGE_NODE:     return Ranges{Range(value, mask)};
+
+            /* x <s v iff x + bias <u v + bias */
+            case triton::ast::BVSLT_NODE:     return shift(compare(triton::ast::BVULT_NODE, (value + bias) & mask, mask), bias, mask);
+            case triton::ast::BVSLE_NODE:     return shift(compare(triton::ast::BVULE_NODE, (value + bias) & mask, mask), bias, mask);
+            case triton::ast::BVSGT_NODE:     return shift(compare(triton::ast::BVUGT_NODE, (value + bias) & mask, mask), bias, mask);
+            case triton::ast::BVSGE_NODE:     return shift(compare(triton::ast::BVUGE_NODE, (value + bias) & mask, mask), bias, mask);
+
+            default:
+              throw triton::exceptions::SolverEngine("PreSolver::compare(): Invalid comparison.");
+          }
+        }
+
+
+        /* The comparison with swapped operands */
+        triton::ast::ast_e mirror(triton::ast::ast_e kind) {
+          switch (kind) {
+            case triton::ast::BVULT_NODE: return triton::ast::BVUGT_NODE;
+            case triton::ast::BVULE_NODE: return triton::ast::BVUGE_NODE;
+            case triton::ast::BVUGT_NODE: return triton::ast::BVULT_NODE;
+            case triton::ast::BVUGE_NODE: return triton::ast::BVULE_NODE;
+            case triton::ast::BVSLT_NODE: return triton::ast::BVSGT_NODE;
+            case triton::ast::BVSLE_NODE: return triton::ast::BVSGE_NODE;
+            case triton::ast::BVSGT_NODE: return triton::ast::BVSLT_NODE;
+            case triton::ast::BVSGE_NODE: return triton::ast::BVSLE_NODE;
+            default:                      return kind;
+          }
+        }
+
+
+        /* The value after `value` in the set, wrapping around */
+        triton::uint512 next(const Ranges& ranges, const triton::uint512& value) {
+          for (const Range& range : ranges) {
+            if (value < range.first)
+              return range.first;
+            if (value < range.second)
+              return value + 1;
+          }
+          return ranges.front().first;
+        }
+
+
+        triton::ast::SharedAbstractNode unroll(triton::ast::SharedAbstractNode node) {
+          while (node->getType() == triton::ast::REFERENCE_NODE)
+            node = reinterpret_cast<triton::ast::ReferenceNode*>(node.get())->getSymbolicExpression()->getAst();
+          return node;
+        }
+
+
+        triton::uint32 integer(const triton::ast::SharedAbstractNode& node) {
+          return static_cast<triton::uint32>(reinterpret_cast<triton::ast::IntegerNode*>(node.get())->getInteger());
+        }
+
+
+        bool constrain(State& state, const triton::ast::SharedAbstractNode& node, bool positive);
+
+
+        /* Restricts a slice of a variable */
+        void addSlice(State& state, const triton::ast::SharedAbstractNode& node, triton::uint32 high, triton::uint32 low, const Ranges& values) {
+          const auto& var = reinterpret_cast<triton::ast::VariableNode*>(node.get())->getSymbolicVariable();
+          Slice slice = {var->getId(), low, high};
+
+          state.variables[var->getId()] = var;
+
+          auto it = state.slices.find(slice);
+          if (it == state.slices.end())
+            it = state.slices.insert(std::make_pair(slice, values)).first;
+          else
+            it->second = intersect(it->second, values);
+
+          if (it->second.empty())
+            state.unsat = true;
+        }
+
+
+        /* Restricts the values of a bitvector expression. Returns false if the expression is out of reach. */
+        bool restrict(State& state, triton::ast::SharedAbstractNode node, Ranges values) {
+          while (true) {
+            node = unroll(node);
+
+            if (!node->isSymbolized()) {
+              if (!contains(values, node->evaluate()))
+                state.unsat = true;
+              return true;
+            }
+
+            if (values.empty()) {
+              state.unsat = true;
+              return true;
+            }
+
+            triton::uint512 mask = node->getBitvectorMask();
+            auto& children = node->getChildren();
+
+            switch (node->getType()) {
+              case triton::ast::VARIABLE_NODE:
+                addSlice(state, node, node->getBitvectorSize() - 1, 0, values);
+                return true;
+
+              case triton::ast::EXTRACT_NODE: {
+                /* Follows the window [high:low] down to a variable or to a whole operand */
+                triton::uint32 high = integer(children[0]);
+                triton::uint32 low  = integer(children[1]);
+                triton::ast::SharedAbstractNode child = unroll(children[2]);
+
+                while (low != 0 || high != child->getBitvectorSize() - 1) {
+                  auto& operands = child->getChildren();
+
+                  if (!child->isSymbolized()) {
+                    if (!contains(values, (child->evaluate() >> low) & mask))
+                      state.unsat = true;
+                    return true;
+                  }
+                  else if (child->getType() == triton::ast::VARIABLE_NODE) {
+                    addSlice(state, child, high, low, values);
+                    return true;
+                  }
+                  else if (child->getType() == triton::ast::EXTRACT_NODE) {
+                    high += integer(operands[1]);
+                    low  += integer(operands[1]);
+                    child = unroll(operands[2]);
+                  }
+                  else if (child->getType() == triton::ast::ZX_NODE && high < operands[1]->getBitvectorSize()) {
+                    child = unroll(operands[1]);
+                  }
+                  else if (child->getType() == triton::ast::CONCAT_NODE) {
+                    /* The window must lie in a single part */
+                    triton::uint32 offset = 0;
+                    triton::usize i = operands.size();
+                    while (i-- > 0 && offset + operands[i]->getBitvectorSize() <= low)
+                      offset += operands[i]->getBitvectorSize();
+                    if (high >= offset + operands[i]->getBitvectorSize())
+                      return false;
+                    high -= offset;
+                    low  -= offset;
+                    child = unroll(operands[i]);
+                  }
+                  else {
+                    return false;
+                  }
+                }
+
+                node = child;
+                break;
+              }
+
+              case triton::ast::ZX_NODE:
+                values = intersect(values, Ranges{Range(0, children[1]->getBitvectorMask())});
+                node   = children[1];
+                break;
+
+              case triton::ast::SX_NODE: {
+                /* The negative values of the operand are moved to the top of the extended range */
+                triton::uint512 half  = children[1]->getBitvectorMask() >> 1;
+                triton::uint512 delta = mask - children[1]->getBitvectorMask();
+                Ranges ret = intersect(values, Ranges{Range(0, half)});
+                for (const Range& range : intersect(values, Ranges{Range(mask - half, mask)}))
+                  ret.push_back(Range(range.first - delta, range.second - delta));
+                values = normalize(ret);
+                node   = children[1];
+                break;
+              }
+
+              case triton::ast::BVNOT_NODE:
+                values = reflect(values, mask, mask);
+                node   = children[0];
+                break;
+
+              case triton::ast::BVNEG_NODE:
+                values = reflect(values, 0, mask);
+                node   = children[0];
+                break;
+
+              case triton::ast::BVADD_NODE:
+              case triton::ast::BVSUB_NODE:
+              case triton::ast::BVXOR_NODE:
+              case triton::ast::BVMUL_NODE: {
+                if (children[0]->isSymbolized() == children[1]->isSymbolized())
+                  return false;
+
+                bool left = children[0]->isSymbolized();
+                triton::uint512 value = children[left ? 1 : 0]->evaluate();
+                triton::ast::ast_e kind = node->getType();
+                node = children[left ? 0 : 1];
+
+                if (kind == triton::ast::BVADD_NODE) {
+                  values = shift(values, value, mask);
+                }
+                else if (kind == triton::ast::BVSUB_NODE) {
+                  /* x - v is in the set iff x is in the set + v, v - x iff x is in v - the set */
+                  values = left ? shift(values, (mask - value + 1) & mask, mask) : reflect(values, value, mask);
+                }
+                else if (kind == triton::ast::BVXOR_NODE) {
+                  if (!mapPoints(values, mask, [&](const triton::uint512& x) { return x ^ value; }))
+                    return false;
+                }
+                else {
+                  /* Only an odd factor is invertible */
+                  if ((value & 1) == 0)
+                    return false;
+                  triton::uint512 factor = inverse(value, mask);
+                  if (!mapPoints(values, mask, [&](const triton::uint512& x) { return x * factor; }))
+                    return false;
+                }
+                break;
+              }
+
+              case triton::ast::CONCAT_NODE: {
+                triton::usize last = children.size() - 1;
+
+                /* An equality splits on every part */
+                if (values.size() == 1 && values[0].first == values[0].second) {
+                  triton::uint512 value = values[0].first;
+                  bool ret = true;
+                  for (triton::usize i = children.size(); i-- > 0;) {
+                    triton::uint512 part = value & children[i]->getBitvectorMask();
+                    ret   = restrict(state, children[i], Ranges{Range(part, part)}) && ret;
+                    value = value >> children[i]->getBitvectorSize();
+                  }
+                  return ret;
+                }
+
+                /* Otherwise only the lowest part may be symbolized */
+                for (triton::usize i = 0; i < last; i++) {
+                  if (children[i]->isSymbolized())
+                    return false;
+                }
+
+                triton::uint512 low  = children[last]->getBitvectorMask();
+                triton::uint512 base = node->evaluate() & ~low & mask;
+                Ranges ret;
+                for (const Range& range : intersect(values, Ranges{Range(base, base + low)}))
+                  ret.push_back(Range(range.first - base, range.second - base));
+                values = ret;
+                node   = children[last];
+                break;
+              }
+
+              case triton::ast::ITE_NODE: {
+                if (children[1]->isSymbolized() || children[2]->isSymbolized())
+                  return false;
+
+                bool inThen = contains(values, children[1]->evaluate());
+                bool inElse = contains(values, children[2]->evaluate());
+
+                if (inThen == inElse) {
+                  if (!inThen)
+                    state.unsat = true;
+                  return true;
+                }
+
+                return constrain(state, children[0], inThen);
+              }
+
+              default:
+                return false;
+            }
+          }
+        }
+
+
+        /* Constrains a logical expression to be true if `positive`, false otherwise. Returns false if the expression is out of reach. */
+        bool constrain(State& state, const triton::ast::SharedAbstractNode& expr, bool positive) {
+          triton::ast::SharedAbstractNode node = unroll(expr);
+
+          if (!node->isSymbolized()) {
+            if ((node->evaluate() != 0) != positive)
+              state.unsat = true;
+            return true;
+          }
+
+          auto& children = node->getChildren();
+
+          switch (node->getType()) {
+            case triton::ast::LNOT_NODE:
+              return constrain(state, children[0], !positive);
+
+            case triton::ast::LAND_NODE:
+            case triton::ast::LOR_NODE: {
+              /* Only a conjunction is handled. All its members are visited, so an unsatisfiable one is found even next to one out of reach. */
+              bool ret = (positive == (node->getType() == triton::ast::LAND_NODE));
+              if (!ret)
+                return false;
+              for (const auto& child : children)
+                ret = constrain(state, child, positive) && ret;
+              return ret;
+            }
+
+            case triton::ast::EQUAL_NODE:
+            case triton::ast::DISTINCT_NODE:
+            case triton::ast::BVULT_NODE:
+            case triton::ast::BVULE_NODE:
+            case triton::ast::BVUGT_NODE:
+            case triton::ast::BVUGE_NODE:
+            case triton::ast::BVSLT_NODE:
+            case triton::ast::BVSLE_NODE:
+            case triton::ast::BVSGT_NODE:
+            case triton::ast::BVSGE_NODE: {
+              triton::ast::ast_e kind = node->getType();
+              triton::ast::SharedAbstractNode lhs = children[0];
+              triton::ast::SharedAbstractNode rhs = children[1];
+
+              if (lhs->isSymbolized() && rhs->isSymbolized())
+                return false;
+
+              if (!lhs->isSymbolized()) {
+                std::swap(lhs, rhs);
+                kind = mirror(kind);
+              }
+
+              triton::uint512 mask = lhs->getBitvectorMask();
+              Ranges values = compare(kind, rhs->evaluate(), mask);
+              if (!positive)
+                values = complement(values, mask);
+
+              return restrict(state, lhs, values);
+            }
+
+            default:
+              return false;
+          }
+        }
+      };
+
+
+      bool PreSolver::solve(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::list<std::map<triton::uint32, SolverModel>>& models, status_e& status) const {
+        /* A slice of a variable with its allowed values, enumerated from `start` */
+        struct Dimension {
+          triton::usize id;
+          triton::uint32 low;
+          Ranges values;
+          triton::uint512 start;
+          triton::uint512 current;
+        };
+
+        std::vector<Dimension> dimensions;
+        std::vector<Dimension> unconstrained;
+        State state;
+
+        if (node == nullptr || !node->isLogical())
+          return false;
+
+        bool complete = constrain(state, node, true);
+
+        models.clear();
+        if (state.unsat) {
+          status = UNSAT;
+          return true;
+        }
+
+        if (!complete)
+          return false;
+
+        /* The slices of a variable are sorted by their low bit and must not overlap */
+        for (const auto& item : state.variables) {
+          const auto& var = item.second;
+          triton::uint512 concrete = 0;
+          triton::uint32 bit = 0;
+
+          try {
+            concrete = node->getContext().getVariableValue(var->getName());
+          }
+          catch (const triton::exceptions::Exception&) {
+          }
+
+          auto add = [&](std::vector<Dimension>& dims, triton::uint32 low, triton::uint32 high, const Ranges& values) {
+            triton::uint512 mask      = (((triton::uint512(1) << (high - low)) - 1) << 1) | 1;
+            triton::uint512 preferred = (concrete >> low) & mask;
+            triton::uint512 start     = contains(values, preferred) ? preferred : next(values, preferred);
+            dims.push_back(Dimension{var->getId(), low, values, start, start});
+          };
+
+          for (auto it = state.slices.lower_bound(Slice{var->getId(), 0, 0}); it != state.slices.end() && it->first.id == var->getId(); it++) {
+            if (it->first.low < bit)
+              return false;
+            if (it->first.low > bit)
+              add(unconstrained, bit, it->first.low - 1, Ranges{Range(0, (triton::uint512(1) << (it->first.low - bit)) - 1)});
+            add(dimensions, it->first.low, it->first.high, it->second);
+            bit = it->first.high + 1;
+          }
+
+          if (bit < var->getSize())
+            add(unconstrained, bit, var->getSize() - 1, Ranges{Range(0, (((triton::uint512(1) << (var->getSize() - 1 - bit)) - 1) << 1) | 1)});
+        }
+
+        /* The constrained slices vary first */
+        dimensions.insert(dimensions.end(), unconstrained.begin(), unconstrained.end());
+        status = SAT;
+
+        for (triton::uint32 n = 0; n < limit; n++) {
+          std::map<triton::uint32, triton::uint512> values;
+          std::map<triton::uint32, SolverModel> model;
+
+          for (const Dimension& dim : dimensions)
+            values[static_cast<triton::uint32>(dim.id)] |= dim.current << dim.low;
+
+          for (const auto& item : values)
+            model[item.first] = SolverModel(state.variables.at(item.first), item.second);
+
+          models.push_back(model);
+
+          /* Odometer over the dimensions, stops when every one wrapped around */
+          triton::usize i = 0;
+          for (; i < dimensions.size(); i++) {
+            Dimension& dim = dimensions[i];
+            dim.current = next(dim.values, dim.current);
+            if (dim.current != dim.start)
+              break;
+          }
+
+          if (i == dimensions.size())
+            break;
+        }
+
+        return true;
+      }
+
+    };
+  };
+};
@@ -5,8 +5,18 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <set>
+#include <sstream>
+
+#include <triton/astContext.hpp>
+#include <triton/astSerialization.hpp>
 #include <triton/exceptions.hpp>
+#include <triton/modes.hpp>
 #include <triton/solverEngine.hpp>
+#include <triton/symbolicVariable.hpp>
 
 
 
@@ -14,8 +24,71 @@ namespace triton {
   namespace engines {
     namespace solver {
 
-      SolverEngine::SolverEngine() {
-        this->kind = triton::engines::solver::SOLVER_INVALID;
+      struct SolverEngine::Query {
+        //! The modes of the copy of the constraint.
+        triton::modes::Modes modes;
+
+        //! The AST context of the copy of the constraint.
+        triton::ast::AstContext ctxt;
+
+        //! The copy of the constraint, solved by the thread.
+        triton::ast::SharedAbstractNode node;
+
+        //! The symbolic variables of the constraint. **item**: id -> variable
+        std::unordered_map<triton::uint32, triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+        //! The maximum number of models, 0 to only check the satisfiability.
+        triton::uint32 limit;
+
+        //! The time limit in milliseconds, 0 for the default one.
+        triton::uint32 timeout;
+
+        //! True if the thread is solving the query.
+        bool running;
+
+        //! True if the query is solved or cancelled.
+        bool done;
+
+        //! True if the query is cancelled.
+        bool cancelled;
+
+        //! The ticket of the query in the solver pool, 0 if it is solved by the thread.
+        triton::usize poolTicket;
+
+        //! The status of the query.
+        status_e status;
+
+        //! The error raised by the solver, if any.
+        std::string error;
+
+        //! The models of the copy of the constraint.
+        std::list<std::map<triton::uint32, SolverModel>> models;
+
+        //! Constructor.
+        Query() : ctxt(modes) {
+          this->limit     = 0;
+          this->timeout   = 0;
+          this->running   = false;
+          this->done      = false;
+          this->cancelled  = false;
+          this->poolTicket = 0;
+          this->status     = UNKNOWN;
+        }
+      };
+
+
+      SolverEngine::SolverEngine(const triton::modes::Modes& modes)
+        : modes(modes) {
+        this->timeout       = 0;
+        this->resourceLimit = 0;
+        this->memoryLimit   = 0;
+        this->stopping       = false;
+        this->lastTicket     = 0;
+        this->poolWorkers    = 0;
+        this->poolTimeout    = 0;
+        this->poolMaxQueries = 0;
+        this->poolWaiters    = 0;
+        this->kind          = triton::engines::solver::SOLVER_INVALID;
         #ifdef Z3_INTERFACE
         /* By default we initialized the z3 solver */
         this->setSolver(triton::engines::solver::SOLVER_Z3);
@@ -23,6 +96,11 @@ namespace triton {
       }
 
 
+      SolverEngine::~SolverEngine() {
+        this->stopQueries();
+      }
+
+
       triton::engines::solver::solver_e SolverEngine::getSolver(void) const {
         return this->kind;
       }
@@ -35,25 +113,101 @@ namespace triton {
       }
 
 
-      void SolverEngine::setSolver(triton::engines::solver::solver_e kind) {
-        /* Allocate and init the good solver */
+      triton::engines::solver::SolverInterface* SolverEngine::createSolver(triton::engines::solver::solver_e kind) const {
         switch (kind) {
           #ifdef Z3_INTERFACE
-          case triton::engines::solver::SOLVER_Z3:
+          case triton::engines::solver::SOLVER_Z3: {
             /* init the new instance */
-            this->solver.reset(new(std::nothrow) triton::engines::solver::Z3Solver());
-            if (this->solver == nullptr)
-              throw triton::exceptions::SolverEngine("SolverEngine::setSolver(): Not enough memory.");
-            break;
+            triton::engines::solver::Z3Solver* z3Solver = new(std::nothrow) triton::engines::solver::Z3Solver();
+            if (z3Solver == nullptr)
+              throw triton::exceptions::SolverEngine("SolverEngine::createSolver(): Not enough memory.");
+            z3Solver->setResourceLimit(this->resourceLimit);
+            if (this->memoryLimit)
+              z3Solver->setMemoryLimit(this->memoryLimit);
+            return z3Solver;
+          }
           #endif
 
           default:
-            throw triton::exceptions::SolverEngine("SolverEngine::setSolver(): Solver not supported.");
-            break;
+            throw triton::exceptions::SolverEngine("SolverEngine::createSolver(): Solver not supported.");
         }
+      }
+
+
+      void SolverEngine::setSolver(triton::engines::solver::solver_e kind) {
+        /* The thread must not use the old solver */
+        this->stopQueries();
+
+        /* Allocate and init the good solver */
+        this->solver.reset(this->createSolver(kind));
 
         /* Setup global variables */
         this->kind = kind;
+
+        /* The workers run the new solver */
+        this->initPool();
+      }
+
+
+      void SolverEngine::initPool(void) {
+        /* The queries of the old pool are cancelled */
+        this->stopQueries();
+
+        #if defined(__unix__) || defined(__APPLE__)
+        this->pool.reset();
+        if (this->poolWorkers == 0)
+          return;
+
+        triton::engines::solver::SolverInterface* instance = this->createSolver(this->kind);
+        triton::engines::solver::SolverPool* pool = new(std::nothrow) triton::engines::solver::SolverPool(instance, this->poolWorkers);
+        if (pool == nullptr) {
+          delete instance;
+          throw triton::exceptions::SolverEngine("SolverEngine::initPool(): Not enough memory.");
+        }
+
+        pool->setTimeout(this->poolTimeout);
+        pool->setMaxQueries(this->poolMaxQueries);
+        this->pool.reset(pool);
+        #else
+        if (this->poolWorkers)
+          throw triton::exceptions::SolverEngine("SolverEngine::initPool(): The solver pool is not supported on this platform.");
+        #endif
+      }
+
+
+      void SolverEngine::setSolverPool(triton::usize workers, triton::uint32 timeout, triton::usize maxQueries) {
+        if (workers && (this->kind == triton::engines::solver::SOLVER_CUSTOM || this->kind == triton::engines::solver::SOLVER_INVALID))
+          throw triton::exceptions::SolverEngine("SolverEngine::setSolverPool(): Only the predefined solvers can be pooled.");
+
+        this->stopQueries();
+
+        this->poolWorkers    = workers;
+        this->poolTimeout    = timeout;
+        this->poolMaxQueries = maxQueries;
+        this->initPool();
+      }
+
+
+      std::vector<triton::uint32> SolverEngine::getSolverPoolWorkers(void) const {
+        std::vector<triton::uint32> pids;
+
+        #if defined(__unix__) || defined(__APPLE__)
+        if (this->pool) {
+          for (pid_t pid : this->pool->getWorkers())
+            pids.push_back(static_cast<triton::uint32>(pid));
+        }
+        #endif
+
+        return pids;
+      }
+
+
+      const triton::engines::solver::SolverInterface* SolverEngine::getQuerySolver(void) const {
+        #if defined(__unix__) || defined(__APPLE__)
+        if (this->pool)
+          return this->pool.get();
+        #endif
+        return this->solver.get();
       }
 
 
@@ -61,11 +215,18 @@ namespace triton {
         if (customSolver == nullptr)
           throw triton::exceptions::SolverEngine("SolverEngine::setCustomSolver(): custom solver cannot be null.");
 
+        /* The thread must not use the old solver */
+        this->stopQueries();
+
         /* Define the custom solver as current solver */
         this->solver.reset(customSolver);
 
         /* Setup global variables */
         this->kind = triton::engines::solver::SOLVER_CUSTOM;
+
+        /* A custom solver cannot be duplicated for the workers */
+        this->poolWorkers = 0;
+        this->initPool();
       }
 
 
@@ -76,24 +237,413 @@ namespace triton {
       }
 
 
-      std::map<triton::uint32, SolverModel> SolverEngine::getModel(const triton::ast::SharedAbstractNode& node) const {
+      void SolverEngine::setTimeout(triton::uint32 ms) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->timeout = ms;
+      }
+
+
+      void SolverEngine::setResourceLimit(triton::uint32 rlimit) {
+        this->resourceLimit = rlimit;
+        #ifdef Z3_INTERFACE
+        if (this->kind == triton::engines::solver::SOLVER_Z3)
+          reinterpret_cast<triton::engines::solver::Z3Solver*>(this->solver.get())->setResourceLimit(rlimit);
+        #endif
+
+        /* The workers are replaced by ones with the new limit */
+        if (this->poolWorkers)
+          this->initPool();
+      }
+
+
+      void SolverEngine::setMemoryLimit(triton::uint32 mb) {
+        this->memoryLimit = mb;
+        #ifdef Z3_INTERFACE
+        if (this->kind == triton::engines::solver::SOLVER_Z3)
+          reinterpret_cast<triton::engines::solver::Z3Solver*>(this->solver.get())->setMemoryLimit(mb);
+        #endif
+
+        /* The workers are replaced by ones with the new limit */
+        if (this->poolWorkers)
+          this->initPool();
+      }
+
+
+      bool SolverEngine::preSolve(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::list<std::map<triton::uint32, SolverModel>>& models, triton::engines::solver::status_e* status) const {
+        triton::engines::solver::status_e st = UNKNOWN;
+
+        if (!this->modes.isModeEnabled(triton::modes::PRESOLVING))
+          return false;
+
+        if (!this->preSolver.solve(node, limit, models, st))
+          return false;
+
+        if (status)
+          *status = st;
+
+        return true;
+      }
+
+
+      std::map<triton::uint32, SolverModel> SolverEngine::getModel(const triton::ast::SharedAbstractNode& expr, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+        /* The chained conjunctions (e.g. the path constraints) are given flat to the solvers */
+        triton::ast::SharedAbstractNode node = triton::ast::flattenConjunction(expr);
+        std::list<std::map<triton::uint32, SolverModel>> models;
+
+        if (this->preSolve(node, 1, models, status))
+          return models.empty() ? std::map<triton::uint32, SolverModel>{} : models.front();
+
         if (!this->solver)
           return std::map<triton::uint32, SolverModel>{};
-        return this->solver->getModel(node);
+
+        return this->getQuerySolver()->getModel(node, status, timeout ? timeout : this->timeout);
       }
 
 
-      std::list<std::map<triton::uint32, SolverModel>> SolverEngine::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit) const {
+      std::list<std::map<triton::uint32, SolverModel>> SolverEngine::getModels(const triton::ast::SharedAbstractNode& expr, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+        triton::ast::SharedAbstractNode node = triton::ast::flattenConjunction(expr);
+        std::list<std::map<triton::uint32, SolverModel>> models;
+
+        if (this->preSolve(node, limit, models, status))
+          return models;
+
         if (!this->solver)
           return std::list<std::map<triton::uint32, SolverModel>>{};
-        return this->solver->getModels(node, limit);
+
+        return this->getQuerySolver()->getModels(node, limit, status, timeout ? timeout : this->timeout);
       }
 
 
-      bool SolverEngine::isSat(const triton::ast::SharedAbstractNode& node) const {
+      bool SolverEngine::isSat(const triton::ast::SharedAbstractNode& expr, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+        triton::ast::SharedAbstractNode node = triton::ast::flattenConjunction(expr);
+        std::list<std::map<triton::uint32, SolverModel>> models;
+        triton::engines::solver::status_e st = UNKNOWN;
+
+        if (this->preSolve(node, 0, models, &st)) {
+          if (status)
+            *status = st;
+          return st == SAT;
+        }
+
         if (!this->solver)
           return false;
-        return this->solver->isSat(node);
+
+        return this->getQuerySolver()->isSat(node, status, timeout ? timeout : this->timeout);
+      }
+
+
+      void SolverEngine::enumerateModels(const triton::ast::SharedAbstractNode& expr, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& projection, const ModelCallback& callback,
+                                         triton::uint32 limit, triton::uint32 threads, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+        triton::ast::SharedAbstractNode node = triton::ast::flattenConjunction(expr);
+        std::list<std::map<triton::uint32, SolverModel>> models;
+        std::set<std::vector<triton::uint512>> seen;
+
+        /* The pre-solver has no projection and needs a limit */
+        if (projection.empty() && limit && this->preSolve(node, limit, models, status)) {
+          for (const auto& model : models) {
+            if (!callback(model))
+              break;
+          }
+          return;
+        }
+
+        if (!this->solver)
+          return;
+
+        #ifdef Z3_INTERFACE
+        if (this->kind == triton::engines::solver::SOLVER_Z3) {
+          reinterpret_cast<const triton::engines::solver::Z3Solver*>(this->solver.get())->enumerateModels(node, projection, callback, limit, threads, status, timeout ? timeout : this->timeout);
+          return;
+        }
+        #endif
+
+        /* The models of the other solvers which repeat a projection are dropped */
+        models = this->solver->getModels(node, limit ? limit : std::numeric_limits<triton::uint32>::max(), status, timeout ? timeout : this->timeout);
+        for (const auto& model : models) {
+          if (!projection.empty()) {
+            std::vector<triton::uint512> values;
+            for (const auto& var : projection) {
+              auto it = model.find(static_cast<triton::uint32>(var->getId()));
+              values.push_back(it == model.end() ? 0 : it->second.getValue());
+            }
+            if (!seen.insert(values).second)
+              continue;
+          }
+          if (!callback(model))
+            break;
+        }
+      }
+
+
+      triton::usize SolverEngine::submitQuery(const triton::ast::SharedAbstractNode& expr, triton::uint32 limit, triton::uint32 timeout) {
+        if (expr == nullptr)
+          throw triton::exceptions::SolverEngine("SolverEngine::submitQuery(): node cannot be null.");
+
+        triton::ast::SharedAbstractNode node = triton::ast::flattenConjunction(expr);
+
+        std::shared_ptr<Query> query = std::make_shared<Query>();
+        std::ostringstream stream;
+
+        /* A trivial query is decided at once and never reaches the thread */
+        if (this->preSolve(node, limit, query->models, &query->status)) {
+          for (const auto& model : query->models) {
+            for (const auto& item : model)
+              query->variables[item.first] = item.second.getVariable();
+          }
+
+          std::lock_guard<std::mutex> lock(this->mutex);
+          triton::usize ticket = ++this->lastTicket;
+
+          query->done = true;
+          this->queries[ticket] = query;
+
+          return ticket;
+        }
+
+        if (!this->solver)
+          throw triton::exceptions::SolverEngine("SolverEngine::submitQuery(): Solver undefined.");
+
+        #if defined(__unix__) || defined(__APPLE__)
+        /* The workers of a pool must not be forked while the thread is running */
+        if (dynamic_cast<const triton::engines::solver::SolverPool*>(this->solver.get()))
+          throw triton::exceptions::SolverEngine("SolverEngine::submitQuery(): A solver pool must be set with setSolverPool().");
+
+        /* The pool solves the query in the background by itself, on the original constraint */
+        if (this->pool) {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          triton::usize ticket = ++this->lastTicket;
+
+          query->poolTicket = this->pool->submit(node, limit, timeout ? timeout : this->timeout);
+          this->queries[ticket] = query;
+
+          return ticket;
+        }
+        #endif
+
+        /* The thread works on a copy of the constraint, in its own AST context */
+        triton::ast::AstWriter writer(stream, node->getContext());
+        writer.writeAst(node);
+
+        std::string data = stream.str();
+        triton::ast::AstReader reader(reinterpret_cast<const triton::uint8*>(data.data()), data.size(), query->ctxt);
+        query->node    = reader.readAst();
+        query->limit   = limit;
+        query->timeout = timeout;
+
+        /* The models of the copy are given back with the variables of the constraint */
+        for (const auto& n : triton::ast::lookingForNodes(node, triton::ast::VARIABLE_NODE)) {
+          const auto& var = reinterpret_cast<triton::ast::VariableNode*>(n.get())->getSymbolicVariable();
+          query->variables[static_cast<triton::uint32>(var->getId())] = var;
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        triton::usize ticket = ++this->lastTicket;
+
+        this->queries[ticket] = query;
+        this->pending.push_back(ticket);
+
+        if (!this->worker.joinable())
+          this->worker = std::thread(&SolverEngine::run, this);
+
+        this->cond.notify_all();
+
+        return ticket;
+      }
+
+
+      bool SolverEngine::pollQuery(triton::usize ticket) const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        auto it = this->queries.find(ticket);
+        if (it == this->queries.end())
+          throw triton::exceptions::SolverEngine("SolverEngine::pollQuery(): Unknown ticket.");
+
+        #if defined(__unix__) || defined(__APPLE__)
+        if (it->second->poolTicket && !it->second->done)
+          return this->pool->poll(it->second->poolTicket);
+        #endif
+
+        return it->second->done;
+      }
+
+
+      triton::engines::solver::status_e SolverEngine::waitQuery(triton::usize ticket, std::list<std::map<triton::uint32, SolverModel>>* models) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        auto it = this->queries.find(ticket);
+        if (it == this->queries.end())
+          throw triton::exceptions::SolverEngine("SolverEngine::waitQuery(): Unknown ticket.");
+
+        std::shared_ptr<Query> query = it->second;
+
+        #if defined(__unix__) || defined(__APPLE__)
+        /* The pool is waited without the lock, stopQueries() waits for the waiters before removing the pool */
+        if (query->poolTicket && !query->done) {
+          std::list<std::map<triton::uint32, SolverModel>> result;
+          status_e status = UNKNOWN;
+          std::string error;
+
+          this->poolWaiters++;
+          lock.unlock();
+          try {
+            status = this->pool->wait(query->poolTicket, &result);
+          }
+          catch (const triton::exceptions::Exception& e) {
+            error = e.what();
+          }
+          lock.lock();
+          this->poolWaiters--;
+          this->queries.erase(ticket);
+          this->cond.notify_all();
+
+          if (!error.empty())
+            throw triton::exceptions::SolverEngine(error);
+
+          if (models)
+            *models = std::move(result);
+
+          return status;
+        }
+        #endif
+
+        this->cond.wait(lock, [&query] { return query->done; });
+        this->queries.erase(ticket);
+
+        if (!query->error.empty())
+          throw triton::exceptions::SolverEngine(query->error);
+
+        if (models) {
+          models->clear();
+          for (const auto& model : query->models) {
+            std::map<triton::uint32, SolverModel> smodel;
+            for (const auto& item : model)
+              smodel[item.first] = SolverModel(query->variables.at(item.first), item.second.getValue());
+            models->push_back(smodel);
+          }
+        }
+
+        return query->status;
+      }
+
+
+      bool SolverEngine::cancelQuery(triton::usize ticket) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        auto it = this->queries.find(ticket);
+        if (it == this->queries.end())
+          throw triton::exceptions::SolverEngine("SolverEngine::cancelQuery(): Unknown ticket.");
+
+        std::shared_ptr<Query> query = it->second;
+        if (query->done)
+          return false;
+
+        #if defined(__unix__) || defined(__APPLE__)
+        if (query->poolTicket)
+          return this->pool->cancel(query->poolTicket);
+        #endif
+
+        if (!query->running)
+          this->pending.erase(std::find(this->pending.begin(), this->pending.end(), ticket));
+
+        query->cancelled = true;
+        query->done      = true;
+        query->status    = UNKNOWN;
+        this->cond.notify_all();
+
+        /*
+         * A running query is interrupted and its result is dropped by the thread. As in
+         * stopQueries(), an interrupt sent before the solver starts is lost, so it is
+         * repeated until the query returns.
+         */
+        while (query->running) {
+          this->solver->interrupt();
+          this->cond.wait_for(lock, std::chrono::milliseconds(10));
+        }
+
+        return true;
+      }
+
+
+      void SolverEngine::run(void) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (true) {
+          this->cond.wait(lock, [this] { return this->stopping || !this->pending.empty(); });
+          if (this->stopping)
+            break;
+
+          std::shared_ptr<Query> query = this->queries.at(this->pending.front());
+          triton::uint32 timeout = query->timeout ? query->timeout : this->timeout;
+          std::list<std::map<triton::uint32, SolverModel>> models;
+          status_e status = UNKNOWN;
+          std::string error;
+
+          this->pending.pop_front();
+          query->running = true;
+          lock.unlock();
+
+          try {
+            if (query->limit == 0)
+              this->solver->isSat(query->node, &status, timeout);
+            else
+              models = this->solver->getModels(query->node, query->limit, &status, timeout);
+          }
+          catch (const triton::exceptions::Exception& e) {
+            error = e.what();
+          }
+
+          lock.lock();
+          query->running = false;
+          if (!query->cancelled) {
+            query->status = status;
+            query->error  = error;
+            query->models = std::move(models);
+            query->done   = true;
+          }
+
+          this->cond.notify_all();
+        }
+      }
+
+
+      void SolverEngine::stopQueries(void) {
+        {
+          std::unique_lock<std::mutex> lock(this->mutex);
+          std::shared_ptr<Query> running;
+
+          for (auto& item : this->queries) {
+            Query& query = *item.second;
+            if (query.done)
+              continue;
+            if (query.running)
+              running = item.second;
+            #if defined(__unix__) || defined(__APPLE__)
+            if (query.poolTicket)
+              this->pool->cancel(query.poolTicket);
+            #endif
+            query.cancelled = true;
+            query.done      = true;
+            query.status    = UNKNOWN;
+          }
+
+          this->pending.clear();
+          this->stopping = true;
+          this->cond.notify_all();
+
+          /* An interrupt sent before the solver starts is lost, so it is repeated until the query returns */
+          while (running && running->running) {
+            this->solver->interrupt();
+            this->cond.wait_for(lock, std::chrono::milliseconds(10));
+          }
+
+          /* The pool may be removed once nobody waits for it */
+          this->cond.wait(lock, [this] { return this->poolWaiters == 0; });
+        }
+
+        if (this->worker.joinable())
+          this->worker.join();
+
+        this->stopping = false;
       }
 
 
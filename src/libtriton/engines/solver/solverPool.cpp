@@ -0,0 +1,654 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <new>
+#include <sstream>
+
+#include <triton/astContext.hpp>
+#include <triton/astSerialization.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/modes.hpp>
+#include <triton/solverPool.hpp>
+#include <triton/symbolicVariable.hpp>
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0
+#endif
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      namespace {
+        /* Sends a frame: its size on 8 bytes then its content */
+        bool sendFrame(int fd, const std::string& frame) {
+          triton::uint8 header[8];
+          triton::uint64 size = frame.size();
+
+          for (triton::uint32 i = 0; i < sizeof(header); i++)
+            header[i] = static_cast<triton::uint8>(size >> (i * 8));
+
+          std::string buffer(reinterpret_cast<const char*>(header), sizeof(header));
+          buffer += frame;
+
+          for (triton::usize offset = 0; offset < buffer.size();) {
+            ssize_t n = send(fd, buffer.data() + offset, buffer.size() - offset, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR)
+              continue;
+            if (n <= 0)
+              return false;
+            offset += static_cast<triton::usize>(n);
+          }
+
+          return true;
+        }
+
+
+        /* Receives exactly `size` bytes */
+        bool recvAll(int fd, char* buffer, triton::usize size) {
+          for (triton::usize offset = 0; offset < size;) {
+            ssize_t n = recv(fd, buffer + offset, size - offset, 0);
+            if (n < 0 && errno == EINTR)
+              continue;
+            if (n <= 0)
+              return false;
+            offset += static_cast<triton::usize>(n);
+          }
+          return true;
+        }
+
+
+        /* Receives a frame sent by sendFrame() */
+        bool recvFrame(int fd, std::string& frame) {
+          triton::uint8 header[8];
+          triton::uint64 size = 0;
+
+          if (!recvAll(fd, reinterpret_cast<char*>(header), sizeof(header)))
+            return false;
+
+          for (triton::uint32 i = 0; i < sizeof(header); i++)
+            size |= static_cast<triton::uint64>(header[i]) << (i * 8);
+
+          frame.resize(static_cast<triton::usize>(size));
+          return size == 0 || recvAll(fd, &frame[0], frame.size());
+        }
+
+
+        /* Returns the size of the address space of the current process */
+        triton::uint64 getAddressSpaceSize(void) {
+          triton::uint64 pages = 0;
+
+          #if defined(__linux__)
+          FILE* fd = std::fopen("/proc/self/statm", "r");
+          if (fd != nullptr) {
+            unsigned long long value = 0;
+            if (std::fscanf(fd, "%llu", &value) == 1)
+              pages = value;
+            std::fclose(fd);
+          }
+          #endif
+
+          return pages * static_cast<triton::uint64>(sysconf(_SC_PAGESIZE));
+        }
+      };
+
+
+      SolverPool::SolverPool(SolverInterface* solver, triton::usize size)
+        : solver(solver) {
+        if (solver == nullptr)
+          throw triton::exceptions::SolverEngine("SolverPool::SolverPool(): The solver cannot be null.");
+
+        if (size == 0)
+          throw triton::exceptions::SolverEngine("SolverPool::SolverPool(): The pool needs at least one worker.");
+
+        if (pipe(this->wakeup) != 0)
+          throw triton::exceptions::SolverEngine("SolverPool::SolverPool(): Cannot create a pipe.");
+
+        /* interrupt() must never block */
+        fcntl(this->wakeup[0], F_SETFL, O_NONBLOCK);
+        fcntl(this->wakeup[1], F_SETFL, O_NONBLOCK);
+
+        this->workers.resize(size, Worker{0, -1, 0, 0, std::chrono::steady_clock::time_point()});
+        this->interrupts  = 0;
+        this->lastTicket  = 0;
+        this->polling     = false;
+        this->timeout     = 0;
+        this->memoryLimit = 0;
+        this->maxQueries  = 0;
+      }
+
+
+      SolverPool::~SolverPool() {
+        for (Worker& worker : this->workers)
+          this->stop(worker, true);
+
+        close(this->wakeup[0]);
+        close(this->wakeup[1]);
+      }
+
+
+      void SolverPool::setTimeout(triton::uint32 ms) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->timeout = ms;
+      }
+
+
+      void SolverPool::setMemoryLimit(triton::uint32 mb) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->memoryLimit = mb;
+      }
+
+
+      void SolverPool::setMaxQueries(triton::usize queries) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->maxQueries = queries;
+      }
+
+
+      std::vector<pid_t> SolverPool::getWorkers(void) const {
+        std::vector<pid_t> pids;
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        for (const Worker& worker : this->workers)
+          pids.push_back(worker.pid);
+
+        return pids;
+      }
+
+
+      void SolverPool::spawn(Worker& worker) const {
+        int fds[2];
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+          throw triton::exceptions::SolverEngine("SolverPool::spawn(): Cannot create a socket.");
+
+        pid_t pid = fork();
+        if (pid < 0) {
+          close(fds[0]);
+          close(fds[1]);
+          throw triton::exceptions::SolverEngine("SolverPool::spawn(): Cannot fork a worker.");
+        }
+
+        if (pid == 0) {
+          /* The worker only keeps its own socket */
+          close(fds[0]);
+          close(this->wakeup[0]);
+          close(this->wakeup[1]);
+          for (const Worker& other : this->workers) {
+            if (other.fd >= 0)
+              close(other.fd);
+          }
+
+          if (this->memoryLimit) {
+            struct rlimit limit;
+            limit.rlim_cur = static_cast<rlim_t>(getAddressSpaceSize() + (static_cast<triton::uint64>(this->memoryLimit) << 20));
+            limit.rlim_max = limit.rlim_cur;
+            setrlimit(RLIMIT_AS, &limit);
+          }
+
+          this->serve(fds[1]);
+          _exit(0);
+        }
+
+        close(fds[1]);
+        worker.pid     = pid;
+        worker.fd      = fds[0];
+        worker.ticket  = 0;
+        worker.queries = 0;
+      }
+
+
+      void SolverPool::stop(Worker& worker, bool kill) const {
+        if (worker.pid == 0)
+          return;
+
+        /* An idle worker exits when its socket is closed */
+        if (kill || worker.ticket)
+          ::kill(worker.pid, SIGKILL);
+
+        close(worker.fd);
+        while (waitpid(worker.pid, nullptr, 0) < 0 && errno == EINTR);
+
+        worker.pid    = 0;
+        worker.fd     = -1;
+        worker.ticket = 0;
+      }
+
+
+      void SolverPool::serve(int fd) const {
+        std::string request;
+
+        while (recvFrame(fd, request)) {
+          if (!sendFrame(fd, this->solve(request)))
+            break;
+        }
+
+        close(fd);
+      }
+
+
+      std::string SolverPool::solve(const std::string& request) const {
+        triton::modes::Modes modes;
+        triton::ast::AstContext ctxt(modes);
+        std::list<std::map<triton::uint32, SolverModel>> models;
+        std::string error;
+        status_e status = UNKNOWN;
+
+        try {
+          triton::ast::AstReader reader(reinterpret_cast<const triton::uint8*>(request.data()), request.size(), ctxt);
+          triton::uint32 limit = static_cast<triton::uint32>(reader.readInteger());
+          triton::uint32 timeout = static_cast<triton::uint32>(reader.readInteger());
+          triton::ast::SharedAbstractNode node = reader.readAst();
+
+          if (limit == 0)
+            this->solver->isSat(node, &status, timeout);
+          else
+            models = this->solver->getModels(node, limit, &status, timeout);
+        }
+        catch (const std::bad_alloc&) {
+          models.clear();
+          status = OUTOFMEM;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          models.clear();
+          status = UNKNOWN;
+          error = e.what();
+        }
+
+        /* The reply: status, error, then the models as (variable id, value) pairs */
+        std::ostringstream stream;
+        triton::ast::AstWriter writer(stream, ctxt);
+
+        writer.writeInteger(static_cast<triton::uint64>(status));
+        writer.writeString(error);
+        writer.writeInteger(static_cast<triton::uint64>(models.size()));
+        for (const auto& model : models) {
+          writer.writeInteger(static_cast<triton::uint64>(model.size()));
+          for (const auto& item : model) {
+            writer.writeInteger(static_cast<triton::uint64>(item.first));
+            writer.writeInteger(item.second.getValue());
+          }
+        }
+
+        return stream.str();
+      }
+
+
+      bool SolverPool::dispatch(Worker& worker, triton::usize ticket) const {
+        const Query& query = this->queries.at(ticket);
+        std::ostringstream stream;
+        triton::ast::AstWriter writer(stream, query.node->getContext());
+
+        writer.writeInteger(static_cast<triton::uint64>(query.limit));
+        writer.writeInteger(static_cast<triton::uint64>(query.timeout));
+        writer.writeAst(query.node);
+
+        /* A worker which died while idle is reaped here, and never gets the query */
+        if (waitpid(worker.pid, nullptr, WNOHANG) == worker.pid) {
+          close(worker.fd);
+          worker.pid = 0;
+          worker.fd  = -1;
+          return false;
+        }
+
+        if (!sendFrame(worker.fd, stream.str()))
+          return false;
+
+        triton::uint32 timeout = query.timeout ? query.timeout : this->timeout;
+
+        worker.ticket   = ticket;
+        worker.deadline = std::chrono::steady_clock::time_point::max();
+        if (timeout)
+          worker.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+        return true;
+      }
+
+
+      void SolverPool::receive(Worker& worker) const {
+        triton::usize ticket = worker.ticket;
+        Query& query = this->queries.at(ticket);
+        std::string reply;
+
+        if (!recvFrame(worker.fd, reply)) {
+          /* The worker died during the query */
+          this->stop(worker, true);
+          this->finish(ticket, UNKNOWN);
+          return;
+        }
+
+        worker.ticket = 0;
+        worker.queries++;
+
+        try {
+          triton::ast::AstReader reader(reinterpret_cast<const triton::uint8*>(reply.data()), reply.size(), query.node->getContext());
+          std::unordered_map<triton::uint32, triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+          for (const auto& node : triton::ast::lookingForNodes(query.node, triton::ast::VARIABLE_NODE)) {
+            const auto& var = reinterpret_cast<triton::ast::VariableNode*>(node.get())->getSymbolicVariable();
+            variables[static_cast<triton::uint32>(var->getId())] = var;
+          }
+
+          status_e status = static_cast<status_e>(reader.readInteger());
+          std::string error = reader.readString();
+
+          for (triton::uint64 n = reader.readInteger(); n > 0; n--) {
+            std::map<triton::uint32, SolverModel> model;
+            for (triton::uint64 size = reader.readInteger(); size > 0; size--) {
+              triton::uint32 id = static_cast<triton::uint32>(reader.readInteger());
+              auto it = variables.find(id);
+              if (it == variables.end())
+                throw triton::exceptions::SolverEngine("SolverPool::receive(): Unknown symbolic variable in a model.");
+              model[id] = SolverModel(it->second, reader.readBigInteger());
+            }
+            query.models.push_back(model);
+          }
+
+          this->finish(ticket, status, error);
+        }
+        catch (const triton::exceptions::Exception& e) {
+          query.models.clear();
+          this->finish(ticket, UNKNOWN, e.what());
+        }
+
+        if (this->maxQueries && worker.queries >= this->maxQueries)
+          this->stop(worker, false);
+      }
+
+
+      void SolverPool::finish(triton::usize ticket, status_e status, const std::string& error) const {
+        Query& query = this->queries.at(ticket);
+
+        query.done   = true;
+        query.status = status;
+        query.error  = error;
+      }
+
+
+      void SolverPool::wake(void) const {
+        if (write(this->wakeup[1], "", 1) < 0) {
+          /* The pipe is full, the pool is already woken up */
+        }
+      }
+
+
+      /*
+       * Only one thread polls the workers at a time, without holding the lock so that
+       * the other ones can submit or cancel queries meanwhile. The other threads wait
+       * for it, and wake it up through the pipe when they change the busy workers.
+       */
+      void SolverPool::progress(std::unique_lock<std::mutex>& lock, int ms) const {
+        std::vector<struct pollfd> fds;
+        std::vector<std::pair<Worker*, triton::usize>> busy;
+        bool dispatched = false;
+
+        /* Give the pending queries to the idle workers */
+        for (Worker& worker : this->workers) {
+          while (worker.ticket == 0 && !this->pending.empty()) {
+            triton::usize ticket = this->pending.front();
+            this->pending.pop_front();
+
+            /* A query submitted before an interrupt is abandoned */
+            if (this->queries.at(ticket).generation < this->interrupts) {
+              this->finish(ticket, UNKNOWN);
+              continue;
+            }
+
+            if (worker.pid == 0)
+              this->spawn(worker);
+
+            if (!this->dispatch(worker, ticket)) {
+              /* The worker died while idle, a fresh one gets the query */
+              this->stop(worker, true);
+              this->pending.push_front(ticket);
+              continue;
+            }
+
+            dispatched = true;
+          }
+        }
+
+        if (this->polling) {
+          if (dispatched)
+            this->wake();
+          if (ms < 0)
+            this->cond.wait(lock);
+          else if (ms > 0)
+            this->cond.wait_for(lock, std::chrono::milliseconds(ms));
+          return;
+        }
+
+        /* Wait for the replies, up to the nearest deadline */
+        auto now = std::chrono::steady_clock::now();
+        for (Worker& worker : this->workers) {
+          if (worker.ticket == 0)
+            continue;
+
+          if (worker.deadline != std::chrono::steady_clock::time_point::max()) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(worker.deadline - now).count();
+            left = (left < 0) ? 0 : left;
+            if (ms < 0 || left < ms)
+              ms = static_cast<int>(left);
+          }
+
+          struct pollfd pfd;
+          pfd.fd      = worker.fd;
+          pfd.events  = POLLIN;
+          pfd.revents = 0;
+          fds.push_back(pfd);
+          busy.push_back(std::make_pair(&worker, worker.ticket));
+        }
+
+        if (fds.empty())
+          return;
+
+        struct pollfd pfd;
+        pfd.fd      = this->wakeup[0];
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        fds.push_back(pfd);
+
+        this->polling = true;
+        lock.unlock();
+        int ret = ::poll(fds.data(), fds.size(), ms);
+        int err = errno;
+        lock.lock();
+        this->polling = false;
+        this->cond.notify_all();
+
+        if (ret < 0 && err != EINTR)
+          throw triton::exceptions::SolverEngine("SolverPool::progress(): Cannot poll the workers.");
+
+        if (fds.back().revents & POLLIN) {
+          char buffer[64];
+          while (read(this->wakeup[0], buffer, sizeof(buffer)) > 0);
+        }
+
+        now = std::chrono::steady_clock::now();
+        triton::usize interrupts = this->interrupts;
+        for (triton::usize i = 0; i < busy.size(); i++) {
+          Worker& worker = *busy[i].first;
+
+          /* The query may have been cancelled while the lock was released */
+          if (worker.ticket != busy[i].second)
+            continue;
+
+          if (this->queries.at(worker.ticket).generation < interrupts) {
+            triton::usize ticket = worker.ticket;
+            this->stop(worker, true);
+            this->finish(ticket, UNKNOWN);
+          }
+          else if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+            this->receive(worker);
+          }
+          else if (now >= worker.deadline) {
+            triton::usize ticket = worker.ticket;
+            this->stop(worker, true);
+            this->finish(ticket, TIMEOUT);
+          }
+        }
+      }
+
+
+      triton::usize SolverPool::submit(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::uint32 timeout) const {
+        if (node == nullptr)
+          throw triton::exceptions::SolverEngine("SolverPool::submit(): node cannot be null.");
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        triton::usize ticket = ++this->lastTicket;
+        Query& query = this->queries[ticket];
+
+        query.node       = node;
+        query.limit      = limit;
+        query.timeout    = timeout;
+        query.generation = this->interrupts;
+        query.done       = false;
+        query.status     = UNKNOWN;
+
+        this->pending.push_back(ticket);
+        this->progress(lock, 0);
+
+        return ticket;
+      }
+
+
+      bool SolverPool::poll(triton::usize ticket) const {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        auto it = this->queries.find(ticket);
+        if (it == this->queries.end())
+          throw triton::exceptions::SolverEngine("SolverPool::poll(): Unknown ticket.");
+
+        /* The references to the queries survive the insertions of the other threads */
+        const Query& query = it->second;
+        if (!query.done)
+          this->progress(lock, 0);
+
+        return query.done;
+      }
+
+
+      status_e SolverPool::wait(triton::usize ticket, std::list<std::map<triton::uint32, SolverModel>>* models) const {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        auto it = this->queries.find(ticket);
+        if (it == this->queries.end())
+          throw triton::exceptions::SolverEngine("SolverPool::wait(): Unknown ticket.");
+
+        Query& query = it->second;
+        while (!query.done)
+          this->progress(lock, -1);
+
+        status_e status = query.status;
+        std::string error = query.error;
+
+        if (models)
+          *models = std::move(query.models);
+
+        this->queries.erase(ticket);
+
+        if (!error.empty())
+          throw triton::exceptions::SolverEngine(error);
+
+        return status;
+      }
+
+
+      bool SolverPool::cancel(triton::usize ticket) const {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        auto it = this->queries.find(ticket);
+        if (it == this->queries.end() || it->second.done)
+          return false;
+
+        auto position = std::find(this->pending.begin(), this->pending.end(), ticket);
+        if (position != this->pending.end())
+          this->pending.erase(position);
+
+        /* The worker of a running query is killed, the thread polling it is woken up */
+        for (Worker& worker : this->workers) {
+          if (worker.ticket == ticket)
+            this->stop(worker, true);
+        }
+
+        this->finish(ticket, UNKNOWN);
+        this->wake();
+        this->cond.notify_all();
+
+        return true;
+      }
+
+
+      void SolverPool::interrupt(void) const {
+        this->interrupts++;
+        this->wake();
+      }
+
+
+      std::map<triton::uint32, SolverModel> SolverPool::getModel(const triton::ast::SharedAbstractNode& node, status_e* status, triton::uint32 timeout) const {
+        std::map<triton::uint32, SolverModel> ret;
+        std::list<std::map<triton::uint32, SolverModel>> allModels;
+
+        allModels = this->getModels(node, 1, status, timeout);
+        if (allModels.size() > 0)
+          ret = allModels.front();
+
+        return ret;
+      }
+
+
+      std::list<std::map<triton::uint32, SolverModel>> SolverPool::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, status_e* status, triton::uint32 timeout) const {
+        std::list<std::map<triton::uint32, SolverModel>> ret;
+        status_e result;
+
+        /* A limit of 0 only checks the satisfiability */
+        if (limit == 0)
+          result = this->wait(this->submit(node, 0, timeout));
+        else
+          result = this->wait(this->submit(node, limit, timeout), &ret);
+
+        if (status)
+          *status = result;
+
+        return ret;
+      }
+
+
+      bool SolverPool::isSat(const triton::ast::SharedAbstractNode& node, status_e* status, triton::uint32 timeout) const {
+        status_e result = this->wait(this->submit(node, 0, timeout));
+
+        if (status)
+          *status = result;
+
+        return result == SAT;
+      }
+
+
+      std::string SolverPool::getName(void) const {
+        return this->solver->getName() + " pool";
+      }
+
+    };
+  };
+};
+
+#endif
@@ -7,7 +7,12 @@
 
 #include <z3++.h>
 #include <z3_api.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <string>
+#include <thread>
 
 #include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
@@ -24,6 +29,13 @@ namespace triton {
   namespace engines {
     namespace solver {
 
+      //! The minimal number of cubes of each thread of an enumeration, so that a fast thread takes more of them.
+      const triton::uint32 CUBES_PER_THREAD = 4;
+
+      //! The number of models found by the threads of an enumeration that wait for the callback.
+      const triton::usize MAX_QUEUED_MODELS = 1024;
+
+
       //! Wrapper to handle variadict number of arguments or'd togethers
       z3::expr mk_or(z3::expr_vector args) {
         std::vector<Z3_ast> array;
@@ -35,94 +47,351 @@ namespace triton {
       }
 
 
+      //! Returns the status of a z3 check
+      static status_e getStatus(z3::solver& solver, z3::check_result result) {
+        switch (result) {
+          case z3::sat:
+            return triton::engines::solver::SAT;
+
+          case z3::unsat:
+            return triton::engines::solver::UNSAT;
+
+          default: {
+            std::string reason = solver.reason_unknown();
+            if (reason == "timeout")
+              return triton::engines::solver::TIMEOUT;
+            if (reason == "out of memory" || reason == "max. memory exceeded")
+              return triton::engines::solver::OUTOFMEM;
+            return triton::engines::solver::UNKNOWN;
+          }
+        }
+      }
+
+
+      Z3Solver::Running::Running(const Z3Solver& solver, z3::context& ctx)
+        : solver(solver),
+          ctx(ctx) {
+        std::lock_guard<std::mutex> lock(this->solver.mutex);
+        this->solver.contexts.insert(&this->ctx);
+      }
+
+
+      Z3Solver::Running::~Running() {
+        std::lock_guard<std::mutex> lock(this->solver.mutex);
+        this->solver.contexts.erase(&this->ctx);
+      }
+
+
       Z3Solver::Z3Solver() {
+        this->timeout       = 0;
+        this->resourceLimit = 0;
       }
 
 
-      std::list<std::map<triton::uint32, SolverModel>> Z3Solver::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit) const {
-        std::list<std::map<triton::uint32, SolverModel>> ret;
-        triton::ast::SharedAbstractNode onode = node;
-        triton::ast::TritonToZ3Ast z3Ast{false};
+      void Z3Solver::setTimeout(triton::uint32 ms) {
+        this->timeout = ms;
+      }
 
-        try {
-          if (onode == nullptr)
-            throw triton::exceptions::SolverEngine("Z3Solver::getModels(): node cannot be null.");
 
-          /* Z3 does not need an assert() as root node */
-          if (node->getType() == triton::ast::ASSERT_NODE)
-            onode = node->getChildren()[0];
+      void Z3Solver::setResourceLimit(triton::uint32 rlimit) {
+        this->resourceLimit = rlimit;
+      }
 
-          if (onode->isLogical() == false)
-            throw triton::exceptions::SolverEngine("Z3Solver::getModels(): Must be a logical node.");
 
-          z3::expr      expr = z3Ast.convert(onode);
-          z3::context&  ctx  = expr.ctx();
-          z3::solver    solver(ctx);
+      void Z3Solver::setMemoryLimit(triton::uint32 mb) {
+        Z3_global_param_set("memory_max_size", std::to_string(mb).c_str());
+      }
 
-          /* Create a solver and add the expression */
-          solver.add(expr);
 
-          /* Check if it is sat */
-          while (solver.check() == z3::sat && limit >= 1) {
+      void Z3Solver::setLimits(z3::solver& solver, triton::uint32 timeout) const {
+        z3::params params(solver.ctx());
+
+        if (timeout == 0)
+          timeout = this->timeout;
+
+        if (timeout)
+          params.set("timeout", timeout);
+
+        if (this->resourceLimit)
+          params.set("rlimit", this->resourceLimit);
+
+        solver.set(params);
+      }
+
+
+      void Z3Solver::interrupt(void) const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        for (z3::context* ctx : this->contexts)
+          ctx->interrupt();
+      }
+
+
+      status_e Z3Solver::enumerate(triton::ast::TritonToZ3Ast& z3Ast, const z3::expr& expr, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& projection,
+                                   std::atomic<triton::uint32>& nextCube, triton::uint32 cubes, const ModelCallback& emit, const std::atomic<bool>& stop, triton::uint32 timeout) const {
+        z3::context&          ctx = expr.ctx();
+        z3::solver            solver(ctx);
+        Running               running(*this, ctx);
+        std::vector<z3::expr> keys;
+        status_e              ret = triton::engines::solver::UNSAT;
+
+        /* The blocking clauses only keep the models apart on the projection */
+        for (const auto& var : projection) {
+          keys.push_back(ctx.bv_const(var->getName().c_str(), var->getSize()));
+          z3Ast.variables[var->getName()] = var;
+        }
+
+        /* The cubes split the values of the widest variable of the projection, or of the constraint. Every thread must pick the same one. */
+        triton::engines::symbolic::SharedSymbolicVariable widest = nullptr;
+        auto wider = [&widest](const triton::engines::symbolic::SharedSymbolicVariable& var) {
+          return widest == nullptr || var->getSize() > widest->getSize() || (var->getSize() == widest->getSize() && var->getId() < widest->getId());
+        };
+        for (const auto& var : projection) {
+          if (wider(var))
+            widest = var;
+        }
+        for (const auto& item : z3Ast.variables) {
+          if (projection.empty() && wider(item.second))
+            widest = item.second;
+        }
+        /* The cubes are the residues of its low bits, which keeps a bounded variable spread over all of them */
+        triton::uint32 bits = 0;
+        while (widest != nullptr && (triton::uint32(1) << bits) < cubes && bits < widest->getSize())
+          bits++;
+        cubes = (triton::uint32(1) << bits);
+
+        /* Without projection, the models of two cubes must still differ on the split variable */
+        if (cubes > 1 && keys.empty())
+          keys.push_back(ctx.bv_const(widest->getName().c_str(), widest->getSize()));
+
+        solver.add(expr);
+        this->setLimits(solver, timeout);
+
+        while (!stop) {
+          triton::uint32 cube = nextCube++;
+          if (cube >= cubes)
+            break;
+
+          /* A cube is enabled by an assumption, so the lemmas learned on a cube help the next ones */
+          z3::expr_vector assumptions(ctx);
+          if (cubes > 1) {
+            z3::expr var     = ctx.bv_const(widest->getName().c_str(), widest->getSize());
+            z3::expr residue = var.extract(bits - 1, 0) == ctx.bv_val(cube, bits);
+            z3::expr literal = ctx.bool_const(("cube!" + std::to_string(cube)).c_str());
+
+            solver.add(z3::implies(literal, residue));
+            assumptions.push_back(literal);
+          }
+
+          while (!stop) {
+            z3::check_result result = solver.check(assumptions);
+            if (result == z3::unsat)
+              break;
+
+            if (result != z3::sat)
+              return stop ? ret : getStatus(solver, result);
 
             /* Get model */
             z3::model m = solver.get_model();
-
-            /* Traversing the model */
             std::map<triton::uint32, SolverModel> smodel;
             z3::expr_vector args(ctx);
-            for (triton::uint32 i = 0; i < m.size(); i++) {
 
-              /* Get the z3 variable */
+            /* Traversing the model */
+            for (triton::uint32 i = 0; i < m.size(); i++) {
               z3::func_decl z3Variable = m[i];
-
-              /* Get the name as std::string from a z3 variable */
               std::string varName = z3Variable.name().str();
 
-              /* Get z3 expr */
+              /* The literals of the cubes are not variables */
+              auto it = z3Ast.variables.find(varName);
+              if (it == z3Ast.variables.end())
+                continue;
+
               z3::expr exp = m.get_const_interp(z3Variable);
+              SolverModel trionModel = SolverModel(it->second, triton::uint512(Z3_get_numeral_string(ctx, exp)));
+              smodel[trionModel.getId()] = trionModel;
+
+              /* Without projection, a model is escaped on all its variables */
+              if (projection.empty() && exp.get_sort().is_bv())
+                args.push_back(ctx.bv_const(varName.c_str(), exp.get_sort().bv_size()) != exp);
+            }
 
-              /* Get the size of a z3 expr */
-              triton::uint32 bvSize = exp.get_sort().bv_size();
+            /* The variables of the projection absent from the model are given a value */
+            for (const auto& key : keys) {
+              z3::expr exp = m.eval(key, true);
+              SolverModel trionModel = SolverModel(z3Ast.variables.at(key.decl().name().str()), triton::uint512(Z3_get_numeral_string(ctx, exp)));
+              smodel[trionModel.getId()] = trionModel;
+              args.push_back(key != exp);
+            }
 
-              /* Get the value of a z3 expr */
-              std::string svalue = Z3_get_numeral_string(ctx, exp);
+            ret = triton::engines::solver::SAT;
 
-              /* Convert a string value to a integer value */
-              triton::uint512 value = triton::uint512(svalue);
+            /* A model without variable is the only one */
+            if (args.empty())
+              return ret;
 
-              /* Create a triton model */
-              SolverModel trionModel = SolverModel(z3Ast.variables[varName], value);
+            /* Escape last models */
+            solver.add(triton::engines::solver::mk_or(args));
+
+            if (!emit(smodel))
+              return ret;
+          }
+        }
+
+        return ret;
+      }
 
-              /* Map the result */
-              smodel[trionModel.getId()] = trionModel;
 
-              /* Uniq result */
-              if (exp.get_sort().is_bv())
-                args.push_back(ctx.bv_const(varName.c_str(), bvSize) != ctx.bv_val(svalue.c_str(), bvSize));
+      void Z3Solver::enumerateModels(const triton::ast::SharedAbstractNode& node, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& projection, const ModelCallback& callback,
+                                     triton::uint32 limit, triton::uint32 threads, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+        triton::ast::SharedAbstractNode onode = node;
+        std::atomic<triton::uint32>     nextCube(0);
+        std::atomic<bool>               stop(false);
+        triton::uint32                  count = 0;
+        status_e                        ret   = triton::engines::solver::UNSAT;
+
+        if (onode == nullptr)
+          throw triton::exceptions::SolverEngine("Z3Solver::enumerateModels(): node cannot be null.");
+
+        /* Z3 does not need an assert() as root node */
+        if (node->getType() == triton::ast::ASSERT_NODE)
+          onode = node->getChildren()[0];
 
+        if (onode->isLogical() == false)
+          throw triton::exceptions::SolverEngine("Z3Solver::enumerateModels(): Must be a logical node.");
+
+        try {
+          if (threads <= 1) {
+            /* The models are given to the callback as they are found */
+            triton::ast::TritonToZ3Ast z3Ast{false};
+            z3::expr expr = z3Ast.convert(onode);
+
+            ret = this->enumerate(z3Ast, expr, projection, nextCube, 1, [&](const std::map<triton::uint32, SolverModel>& model) {
+              return callback(model) && ++count != limit;
+            }, stop, timeout);
+          }
+          else {
+            /* Each thread converts the constraint in its own context, the calling thread gives the models to the callback */
+            std::vector<std::unique_ptr<triton::ast::TritonToZ3Ast>> z3Asts;
+            std::vector<z3::expr> exprs;
+            std::vector<status_e> statuses(threads, triton::engines::solver::UNSAT);
+            std::vector<std::string> errors(threads);
+            std::deque<std::map<triton::uint32, SolverModel>> queue;
+            std::vector<std::thread> workers;
+            std::mutex mutex;
+            std::condition_variable cond;
+            triton::uint32 running = threads;
+
+            for (triton::uint32 i = 0; i < threads; i++) {
+              z3Asts.emplace_back(new triton::ast::TritonToZ3Ast(false));
+              exprs.push_back(z3Asts.back()->convert(onode));
             }
 
-            /* Escape last models */
-            solver.add(triton::engines::solver::mk_or(args));
+            auto emit = [&](const std::map<triton::uint32, SolverModel>& model) {
+              std::unique_lock<std::mutex> lock(mutex);
+              cond.wait(lock, [&] { return queue.size() < MAX_QUEUED_MODELS || stop; });
+              queue.push_back(model);
+              cond.notify_all();
+              return !stop;
+            };
+
+            for (triton::uint32 i = 0; i < threads; i++) {
+              workers.emplace_back([&, i] {
+                try {
+                  statuses[i] = this->enumerate(*z3Asts[i], exprs[i], projection, nextCube, threads * CUBES_PER_THREAD, emit, stop, timeout);
+                }
+                /* The interrupts of a stopped enumeration are not errors */
+                catch (const z3::exception& e) {
+                  if (!stop)
+                    errors[i] = e.msg();
+                }
+                catch (const triton::exceptions::Exception& e) {
+                  if (!stop)
+                    errors[i] = e.what();
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                running--;
+                cond.notify_all();
+              });
+            }
+
+            /* Stops the threads, an interrupt may be lost if it comes before a check so it is repeated */
+            auto join = [&] {
+              std::unique_lock<std::mutex> lock(mutex);
+              stop = true;
+              cond.notify_all();
+              while (running) {
+                for (auto& expr : exprs)
+                  expr.ctx().interrupt();
+                cond.wait_for(lock, std::chrono::milliseconds(10));
+              }
+              lock.unlock();
+              for (auto& worker : workers)
+                worker.join();
+            };
+
+            try {
+              std::unique_lock<std::mutex> lock(mutex);
+              while (true) {
+                cond.wait(lock, [&] { return !queue.empty() || running == 0; });
+                if (queue.empty())
+                  break;
+
+                std::map<triton::uint32, SolverModel> model = std::move(queue.front());
+                queue.pop_front();
+                cond.notify_all();
+
+                lock.unlock();
+                bool more = callback(model) && ++count != limit;
+                lock.lock();
+
+                if (!more)
+                  break;
+              }
+            }
+            catch (...) {
+              join();
+              throw;
+            }
 
-            /* If there is model available */
-            if (smodel.size() > 0)
-              ret.push_back(smodel);
+            join();
 
-            /* Decrement the limit */
-            limit--;
+            for (triton::uint32 i = 0; i < threads; i++) {
+              if (!errors[i].empty())
+                throw z3::exception(errors[i].c_str());
+              if (statuses[i] != triton::engines::solver::UNSAT)
+                ret = statuses[i];
+            }
           }
         }
         catch (const z3::exception& e) {
-          throw triton::exceptions::SolverEngine(std::string("Z3Solver::getModels(): ") + e.msg());
+          /* z3 reports the exhaustion of its memory as an error */
+          if (std::string(e.msg()) != "out of memory")
+            throw triton::exceptions::SolverEngine(std::string("Z3Solver::enumerateModels(): ") + e.msg());
+          ret = triton::engines::solver::OUTOFMEM;
         }
 
+        if (status)
+          *status = count ? triton::engines::solver::SAT : ret;
+      }
+
+
+      std::list<std::map<triton::uint32, SolverModel>> Z3Solver::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+        std::list<std::map<triton::uint32, SolverModel>> ret;
+
+        if (limit == 0) {
+          this->isSat(node, status, timeout);
+          return ret;
+        }
+
+        this->enumerateModels(node, {}, [&ret](const std::map<triton::uint32, SolverModel>& model) {
+          ret.push_back(model);
+          return true;
+        }, limit, 1, status, timeout);
+
         return ret;
       }
 
 
-      bool Z3Solver::isSat(const triton::ast::SharedAbstractNode& node) const {
+      bool Z3Solver::isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
         triton::ast::TritonToZ3Ast z3Ast{false};
 
         if (node == nullptr)
@@ -135,24 +404,35 @@ namespace triton {
           z3::expr      expr = z3Ast.convert(node);
           z3::context&  ctx  = expr.ctx();
           z3::solver    solver(ctx);
+          Running       running(*this, ctx);
 
           /* Create a solver and add the expression */
           solver.add(expr);
+          this->setLimits(solver, timeout);
 
           /* Check if it is sat */
-          return solver.check() == z3::sat;
+          z3::check_result result = solver.check();
+          if (status)
+            *status = getStatus(solver, result);
+
+          return result == z3::sat;
         }
         catch (const z3::exception& e) {
-          throw triton::exceptions::SolverEngine(std::string("Z3Solver::isSat(): ") + e.msg());
+          /* z3 reports the exhaustion of its memory as an error */
+          if (std::string(e.msg()) != "out of memory")
+            throw triton::exceptions::SolverEngine(std::string("Z3Solver::isSat(): ") + e.msg());
+          if (status)
+            *status = triton::engines::solver::OUTOFMEM;
+          return false;
         }
       }
 
 
-      std::map<triton::uint32, SolverModel> Z3Solver::getModel(const triton::ast::SharedAbstractNode& node) const {
+      std::map<triton::uint32, SolverModel> Z3Solver::getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
         std::map<triton::uint32, SolverModel> ret;
         std::list<std::map<triton::uint32, SolverModel>> allModels;
 
-        allModels = this->getModels(node, 1);
+        allModels = this->getModels(node, 1, status, timeout);
         if (allModels.size() > 0)
           ret = allModels.front();
 
@@ -5,6 +5,8 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <tuple>
+
 #include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/pathManager.hpp>
@@ -25,14 +27,28 @@ namespace triton {
       PathManager::PathManager(const PathManager& other)
         : modes(other.modes),
           astCtxt(other.astCtxt) {
-        this->pathConstraints = other.pathConstraints;
+        this->pathConstraints  = other.pathConstraints;
+        this->pathPrefixes     = other.pathPrefixes;
+        this->pathKeys         = other.pathKeys;
+        this->compressions     = other.compressions;
+        this->compressedCounts = other.compressedCounts;
+      }
+
+
+      PathManager::~PathManager() {
+        this->truncatePathPrefixes(0);
       }
 
 
       PathManager& PathManager::operator=(const PathManager& other) {
-        this->astCtxt         = other.astCtxt;
-        this->modes           = other.modes;
-        this->pathConstraints = other.pathConstraints;
+        this->astCtxt          = other.astCtxt;
+        this->modes            = other.modes;
+        this->pathConstraints  = other.pathConstraints;
+        this->truncatePathPrefixes(0);
+        this->pathPrefixes     = other.pathPrefixes;
+        this->pathKeys         = other.pathKeys;
+        this->compressions     = other.compressions;
+        this->compressedCounts = other.compressedCounts;
         return *this;
       }
 
@@ -43,24 +59,40 @@ namespace triton {
       }
 
 
+      /* Returns the top of the lattice */
+      triton::ast::SharedAbstractNode PathManager::getTopPathConstraintAst(void) const {
+        return this->astCtxt.equal(this->astCtxt.bvtrue(), this->astCtxt.bvtrue());
+      }
+
+
       /* Returns the logical conjunction AST of path constraint */
       triton::ast::SharedAbstractNode PathManager::getPathConstraintsAst(void) const {
-        // Every constraint should have the same context otherwise, we can't know
-        // which one to use for the current node computation.
-        std::vector<triton::engines::symbolic::PathConstraint>::const_iterator it;
+        return this->getPrefixPathConstraintsAst(this->pathPrefixes.size());
+      }
+
+
+      /* Returns the logical conjunction AST of the index first path constraints */
+      triton::ast::SharedAbstractNode PathManager::getPrefixPathConstraintsAst(triton::usize index) const {
+        if (index > this->pathPrefixes.size())
+          throw triton::exceptions::PathManager("PathManager::getPrefixPathConstraintsAst(): Index out of range.");
 
         /* by default PC is T (top) */
-        auto node = this->astCtxt.equal(
-                      this->astCtxt.bvtrue(),
-                      this->astCtxt.bvtrue()
-                    );
-
-        /* Then, we create a conjunction of pc */
-        for (it = this->pathConstraints.begin(); it != this->pathConstraints.end(); it++) {
-          node = this->astCtxt.land(node, it->getTakenPathConstraintAst());
-        }
+        if (index == 0)
+          return this->getTopPathConstraintAst();
+
+        return this->pathPrefixes[index - 1];
+      }
+
+
+      /* Returns the logical conjunction AST of the index first path constraints and of the negation of the index-th one */
+      triton::ast::SharedAbstractNode PathManager::getNegatedPathConstraintsAst(triton::usize index) const {
+        if (index >= this->pathConstraints.size())
+          throw triton::exceptions::PathManager("PathManager::getNegatedPathConstraintsAst(): Index out of range.");
 
-        return node;
+        return this->astCtxt.land(
+                 this->getPrefixPathConstraintsAst(index),
+                 this->astCtxt.lnot(this->pathConstraints[index].getTakenPathConstraintAst())
+               );
       }
 
 
@@ -113,20 +145,155 @@ namespace triton {
           pco.addBranchConstraint(bb1 == dstAddr, srcAddr, bb1, bb1pc);
           pco.addBranchConstraint(bb2 == dstAddr, srcAddr, bb2, bb2pc);
 
-          this->pathConstraints.push_back(pco);
         }
 
         /* Direct branch */
         else {
           pco.addBranchConstraint(true, srcAddr, dstAddr, this->astCtxt.equal(pc, this->astCtxt.bv(dstAddr, size)));
-          this->pathConstraints.push_back(pco);
         }
 
+        /* If PC_DEDUPLICATION is enabled, a branch already recorded with the same constraint is skipped (e.g. a loop guard on the same input) */
+        if (this->modes.isModeEnabled(triton::modes::PC_DEDUPLICATION) && this->isRecordedPathConstraint(pco))
+          return;
+
+        this->pushPathConstraint(pco);
+        this->compressPathConstraints();
+      }
+
+
+      triton::uint64 PathManager::getPathConstraintKey(const triton::engines::symbolic::PathConstraint& pco) const {
+        const auto& branch = pco.getBranchConstraints().front();
+        triton::uint64 key = pco.getTakenPathConstraintAst()->getUnrolledHash();
+
+        key ^= std::get<1>(branch) * 0x9e3779b97f4a7c15ULL;
+        key ^= pco.getTakenAddress() * 0xc2b2ae3d27d4eb4fULL;
+
+        return key;
+      }
+
+
+      /* The keys may collide, the constraints of a key are compared structurally */
+      bool PathManager::isRecordedPathConstraint(const triton::engines::symbolic::PathConstraint& pco) const {
+        auto it = this->pathKeys.find(this->getPathConstraintKey(pco));
+        if (it == this->pathKeys.end())
+          return false;
+
+        for (const auto& other : it->second) {
+          if (std::get<1>(other.getBranchConstraints().front()) == std::get<1>(pco.getBranchConstraints().front()) &&
+              other.getTakenAddress() == pco.getTakenAddress() &&
+              triton::ast::unrolledEqualTo(other.getTakenPathConstraintAst(), pco.getTakenPathConstraintAst()))
+            return true;
+        }
+
+        return false;
+      }
+
+
+      void PathManager::pushPathConstraint(const triton::engines::symbolic::PathConstraint& pco) {
+        /* The new prefix is the previous one and the new constraint */
+        this->pathPrefixes.push_back(this->astCtxt.land(this->getPrefixPathConstraintsAst(this->pathPrefixes.size()), pco.getTakenPathConstraintAst()));
+        this->pathConstraints.push_back(pco);
+        this->pathKeys[this->getPathConstraintKey(pco)].push_back(pco);
+
+        auto it = this->compressedCounts.find(std::get<1>(pco.getBranchConstraints().front()));
+        if (it != this->compressedCounts.end())
+          it->second++;
+      }
+
+
+      void PathManager::erasePathConstraint(triton::usize index) {
+        const PathConstraint& pco = this->pathConstraints[index];
+
+        /* The entry of a key is the one which shares the taken AST */
+        auto key = this->pathKeys.find(this->getPathConstraintKey(pco));
+        if (key != this->pathKeys.end()) {
+          auto& entries = key->second;
+          for (auto it = entries.begin(); it != entries.end(); it++) {
+            if (it->getTakenPathConstraintAst() == pco.getTakenPathConstraintAst()) {
+              entries.erase(it);
+              break;
+            }
+          }
+          if (entries.empty())
+            this->pathKeys.erase(key);
+        }
+
+        auto count = this->compressedCounts.find(std::get<1>(pco.getBranchConstraints().front()));
+        if (count != this->compressedCounts.end())
+          count->second--;
+
+        /* The prefixes which follow the removed constraint are rebuilt on the previous one */
+        this->pathConstraints.erase(this->pathConstraints.begin() + index);
+        this->truncatePathPrefixes(index);
+
+        for (triton::usize i = index; i < this->pathConstraints.size(); i++)
+          this->pathPrefixes.push_back(this->astCtxt.land(this->getPrefixPathConstraintsAst(i), this->pathConstraints[i].getTakenPathConstraintAst()));
+      }
+
+
+      /* Each prefix holds the previous one, they are released from the last so that the chain is not destroyed recursively */
+      void PathManager::truncatePathPrefixes(triton::usize size) {
+        while (this->pathPrefixes.size() > size)
+          this->pathPrefixes.pop_back();
+      }
+
+
+      /*
+       * Once a branch has more than `first + last` instances, the oldest of its last ones is
+       * removed. In a loop it is close to the end, so only a few prefixes are rebuilt.
+       */
+      void PathManager::compressPathConstraints(void) {
+        if (this->compressions.empty() || this->pathConstraints.empty())
+          return;
+
+        triton::uint64 addr = std::get<1>(this->pathConstraints.back().getBranchConstraints().front());
+        auto policy = this->compressions.find(addr);
+        if (policy == this->compressions.end())
+          return;
+
+        triton::usize first = policy->second.first;
+        triton::usize last  = policy->second.second;
+
+        /* The (last + 1)th instance from the end is the (first + 1)th from the start */
+        while (this->compressedCounts[addr] > first + last) {
+          triton::usize seen  = 0;
+          triton::usize index = this->pathConstraints.size();
+          while (index-- > 0) {
+            if (std::get<1>(this->pathConstraints[index].getBranchConstraints().front()) == addr && seen++ == last)
+              break;
+          }
+          this->erasePathConstraint(index);
+        }
+      }
+
+
+      void PathManager::setPathConstraintsCompression(triton::uint64 addr, triton::usize first, triton::usize last) {
+        triton::usize count = 0;
+
+        /* The instances already recorded are counted, the policy applies to the next ones */
+        for (const auto& pco : this->pathConstraints) {
+          if (std::get<1>(pco.getBranchConstraints().front()) == addr)
+            count++;
+        }
+
+        this->compressions[addr]     = std::make_pair(first, last);
+        this->compressedCounts[addr] = count;
+      }
+
+
+      void PathManager::removePathConstraintsCompression(triton::uint64 addr) {
+        this->compressions.erase(addr);
+        this->compressedCounts.erase(addr);
       }
 
 
       void PathManager::clearPathConstraints(void) {
         this->pathConstraints.clear();
+        this->truncatePathPrefixes(0);
+        this->pathKeys.clear();
+
+        for (auto& count : this->compressedCounts)
+          count.second = 0;
       }
 
     }; /* symbolic namespace */
@@ -5,6 +5,7 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
 #include <cstring>
 #include <new>
 
@@ -12,6 +13,7 @@
 #include <triton/coreUtils.hpp>
 #include <triton/symbolicEngine.hpp>
 #include <triton/astContext.hpp>
+#include <triton/astSerialization.hpp>
 
 
 
@@ -19,6 +21,12 @@ namespace triton {
   namespace engines {
     namespace symbolic {
 
+      namespace {
+        /* The first bytes of a saved symbolic state */
+        const char STATE_MAGIC[4] = {'T', 'R', 'T', 'N'};
+      };
+
+
       SymbolicEngine::SymbolicEngine(triton::arch::Architecture* architecture,
                                      triton::modes::Modes& modes,
                                      triton::ast::AstContext& astCtxt,
@@ -37,8 +45,13 @@ namespace triton {
         this->enableFlag        = true;
         this->uniqueSymExprId   = 0;
         this->uniqueSymVarId    = 0;
+        this->budgetMaxBytes    = 0;
+        this->budgetMaxDepth    = 0;
+        this->budgetPolicy      = BUDGET_LRU;
+        this->budgetClock       = 0;
 
         this->symbolicReg.resize(this->numberOfRegisters);
+        this->registerLastUse.resize(this->numberOfRegisters);
       }
 
 
@@ -50,12 +63,23 @@ namespace triton {
 
         this->alignedMemoryReference      = other.alignedMemoryReference;
         this->architecture                = other.architecture;
+        this->budgetClock                 = other.budgetClock;
+        this->budgetDirtyMemory           = other.budgetDirtyMemory;
+        this->budgetDirtyRegisters        = other.budgetDirtyRegisters;
+        this->budgetDrops                 = other.budgetDrops;
+        this->budgetMaxBytes              = other.budgetMaxBytes;
+        this->budgetMaxDepth              = other.budgetMaxDepth;
+        this->budgetPolicy                = other.budgetPolicy;
         this->callbacks                   = other.callbacks;
         this->enableFlag                  = other.enableFlag;
+        this->expressionLocations         = other.expressionLocations;
+        this->memoryLastUse               = other.memoryLastUse;
         this->memoryReference             = other.memoryReference;
         this->numberOfRegisters           = other.numberOfRegisters;
+        this->registerLastUse             = other.registerLastUse;
         this->symbolicExpressions         = other.symbolicExpressions;
         this->symbolicReg                 = other.symbolicReg;
+        this->symbolicVariableNames       = other.symbolicVariableNames;
         this->symbolicVariables           = other.symbolicVariables;
         this->uniqueSymExprId             = other.uniqueSymExprId;
         this->uniqueSymVarId              = other.uniqueSymVarId;
@@ -69,13 +93,24 @@ namespace triton {
         this->alignedMemoryReference      = other.alignedMemoryReference;
         this->architecture                = other.architecture;
         this->astCtxt                     = other.astCtxt;
+        this->budgetClock                 = other.budgetClock;
+        this->budgetDirtyMemory           = other.budgetDirtyMemory;
+        this->budgetDirtyRegisters        = other.budgetDirtyRegisters;
+        this->budgetDrops                 = other.budgetDrops;
+        this->budgetMaxBytes              = other.budgetMaxBytes;
+        this->budgetMaxDepth              = other.budgetMaxDepth;
+        this->budgetPolicy                = other.budgetPolicy;
         this->callbacks                   = other.callbacks;
         this->enableFlag                  = other.enableFlag;
+        this->expressionLocations         = other.expressionLocations;
+        this->memoryLastUse               = other.memoryLastUse;
         this->memoryReference             = other.memoryReference;
         this->modes                       = other.modes;
         this->numberOfRegisters           = other.numberOfRegisters;
+        this->registerLastUse             = other.registerLastUse;
         this->symbolicExpressions         = other.symbolicExpressions;
         this->symbolicReg                 = other.symbolicReg;
+        this->symbolicVariableNames       = other.symbolicVariableNames;
         this->symbolicVariables           = other.symbolicVariables;
         this->uniqueSymExprId             = other.uniqueSymExprId;
         this->uniqueSymVarId              = other.uniqueSymVarId;
@@ -95,14 +130,14 @@ namespace triton {
         if (!this->architecture->isRegisterValid(parentId))
           return;
 
-        this->symbolicReg[parentId] = nullptr;
+        this->setRegisterReference(parentId, nullptr);
       }
 
 
       /* Same as concretizeRegister but with all registers */
       void SymbolicEngine::concretizeAllRegister(void) {
         for (triton::uint32 i = 0; i < this->numberOfRegisters; i++)
-          this->symbolicReg[i] = nullptr;
+          this->setRegisterReference(static_cast<triton::arch::register_e>(i), nullptr);
       }
 
 
@@ -126,7 +161,8 @@ namespace triton {
        * before symbolic processing.
        */
       void SymbolicEngine::concretizeMemory(triton::uint64 addr) {
-        this->memoryReference.erase(addr);
+        this->setMemoryReference(addr, nullptr);
+        this->memoryLastUse.erase(addr);
         if (this->modes.isModeEnabled(triton::modes::ALIGNED_MEMORY))
           this->removeAlignedMemory(addr, BYTE_SIZE);
       }
@@ -135,7 +171,17 @@ namespace triton {
       /* Same as concretizeMemory but with all address memory */
       void SymbolicEngine::concretizeAllMemory(void) {
         this->memoryReference.clear();
+        this->memoryLastUse.clear();
         this->alignedMemoryReference.clear();
+
+        /* Keep only the register locations in the reverse index */
+        for (auto it = this->expressionLocations.begin(); it != this->expressionLocations.end();) {
+          it->second.memory.clear();
+          if (it->second.registers.empty())
+            it = this->expressionLocations.erase(it);
+          else
+            ++it;
+        }
       }
 
 
@@ -214,16 +260,10 @@ namespace triton {
 
       /* Returns the symbolic variable otherwise returns nullptr */
       const SharedSymbolicVariable& SymbolicEngine::getSymbolicVariableFromName(const std::string& symVarName) const {
-        /*
-         * FIXME: When there is a ton of symvar, this loop takes a while to go through.
-         *        What about adding two maps {id:symvar} and {string:symvar}? See #648.
-         */
-        for (auto& sv: this->symbolicVariables) {
-          if (sv.second->getName() == symVarName)
-            return sv.second;
-        }
-
-        throw triton::exceptions::SymbolicEngine("SymbolicEngine::getSymbolicVariableFromName(): Unregistred variable.");
+        auto it = this->symbolicVariableNames.find(symVarName);
+        if (it == this->symbolicVariableNames.end())
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::getSymbolicVariableFromName(): Unregistred variable.");
+        return it->second;
       }
 
 
@@ -305,32 +345,32 @@ namespace triton {
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::newSymbolicExpression(): not enough memory");
 
         /* Save and returns the new shared symbolic expression */
-        this->symbolicExpressions[id] = expr;
+        this->symbolicExpressions.insert(expr);
         return expr;
       }
 
 
       /* Removes the symbolic expression corresponding to the id */
       void SymbolicEngine::removeSymbolicExpression(triton::usize symExprId) {
-        if (this->symbolicExpressions.find(symExprId) != this->symbolicExpressions.end()) {
+        if (this->symbolicExpressions.contains(symExprId)) {
           /* Delete and remove the pointer */
           this->symbolicExpressions.erase(symExprId);
 
-          /* Concretize the register if it exists */
-          for (triton::uint32 i = 0; i < this->numberOfRegisters; i++) {
-            if (this->symbolicReg[i] != nullptr && this->symbolicReg[i]->getId() == symExprId) {
-              this->symbolicReg[i] = nullptr;
-              return;
-            }
-          }
+          auto it = this->expressionLocations.find(symExprId);
+          if (it == this->expressionLocations.end())
+            return;
+
+          /* The location is copied as the concretization updates the index */
+          SymbolicExpressionLocation location = it->second;
+
+          /* Concretize the registers assigned to the expression */
+          for (triton::arch::register_e regId : location.registers)
+            this->setRegisterReference(regId, nullptr);
+
+          /* Concretize the memory cells assigned to the expression */
+          for (triton::uint64 addr : location.memory)
+            this->concretizeMemory(addr);
 
-          /* Concretize the memory if it exists */
-          for (auto it = this->memoryReference.begin(); it != memoryReference.end(); it++) {
-            if (it->second && it->second->getId() == symExprId) {
-              this->concretizeMemory(it->first);
-              return;
-            }
-          }
           // FIXME: Also try to remove it from alignedMemory
           // FIXME: Remove it from ast context too
         }
@@ -339,55 +379,54 @@ namespace triton {
 
       /* Gets the shared symbolic expression from a symbolic id */
       SharedSymbolicExpression SymbolicEngine::getSymbolicExpressionFromId(triton::usize symExprId) const {
-        auto it = this->symbolicExpressions.find(symExprId);
-        if (it == this->symbolicExpressions.end())
+        if (symExprId >= this->uniqueSymExprId)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::getSymbolicExpressionFromId(): symbolic expression id not found");
 
-        if (auto sp = it->second.lock())
+        if (auto sp = this->symbolicExpressions.find(symExprId))
           return sp;
 
-        this->symbolicExpressions.erase(symExprId);
         throw triton::exceptions::SymbolicEngine("SymbolicEngine::getSymbolicExpressionFromId(): symbolic expression is not available anymore");
       }
 
 
       /* Returns all symbolic expressions */
       std::unordered_map<triton::usize, SharedSymbolicExpression> SymbolicEngine::getSymbolicExpressions(void) const {
-        // Copy and clean up dead weak ref
         std::unordered_map<triton::usize, SharedSymbolicExpression> ret;
-        std::vector<triton::usize> toRemove;
 
-        for (auto& kv : this->symbolicExpressions) {
-          if (auto sp = kv.second.lock()) {
-            ret[kv.first] = sp;
-          } else {
-            toRemove.push_back(kv.first);
-          }
-        }
-
-        for (auto id : toRemove)
-          this->symbolicExpressions.erase(id);
+        for (const auto& expr : this->symbolicExpressions)
+          ret[expr->getId()] = expr;
 
         return ret;
       }
 
 
+      /* Returns the table of symbolic expressions */
+      const triton::engines::symbolic::SymbolicExpressionTable& SymbolicEngine::getSymbolicExpressionTable(void) const {
+        return this->symbolicExpressions;
+      }
+
+
       /* Slices all expressions from a given one */
       std::map<triton::usize, SharedSymbolicExpression> SymbolicEngine::sliceExpressions(const SharedSymbolicExpression& expr) {
         std::map<triton::usize, SharedSymbolicExpression> exprs;
-        std::deque<triton::ast::SharedAbstractNode> worklist;
+        std::vector<const SymbolicExpression*> worklist;
 
         if (expr == nullptr)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::sliceExpressions(): expr cannot be null.");
 
+        /*
+         * Walks the dependency graph of the expressions instead of unrolling the AST. The
+         * references of an expression are computed once and shared by all slices.
+         */
         exprs[expr->getId()] = expr;
-        triton::ast::nodesExtraction(&worklist, expr->getAst(), true /* unroll */, false /* revert */);
-
-        for (auto&& n : worklist) {
-          if (n->getType() == triton::ast::REFERENCE_NODE) {
-            auto expr = reinterpret_cast<triton::ast::ReferenceNode*>(n.get())->getSymbolicExpression();
-            auto eid  = expr->getId();
-            exprs[eid] = expr;
+        worklist.push_back(expr.get());
+
+        while (!worklist.empty()) {
+          const SymbolicExpression* current = worklist.back();
+          worklist.pop_back();
+          for (const auto& ref : current->getReferences()) {
+            if (exprs.emplace(ref->getId(), ref).second)
+              worklist.push_back(ref.get());
           }
         }
 
@@ -395,24 +434,33 @@ namespace triton {
       }
 
 
+      /* Returns the symbolic variables which influence an expression */
+      std::map<triton::usize, SharedSymbolicVariable> SymbolicEngine::sliceVariables(const SharedSymbolicExpression& expr) const {
+        std::map<triton::usize, SharedSymbolicVariable> vars;
+
+        if (expr == nullptr)
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::sliceVariables(): expr cannot be null.");
+
+        /* The variables of a node already include the ones reached through references */
+        for (triton::usize id : expr->getAst()->getVariableIds()) {
+          auto it = this->symbolicVariables.find(id);
+          if (it != this->symbolicVariables.end())
+            vars[id] = it->second;
+        }
+
+        return vars;
+      }
+
+
       /* Returns a list which contains all tainted expressions */
       std::list<SharedSymbolicExpression> SymbolicEngine::getTaintedSymbolicExpressions(void) const {
         std::list<SharedSymbolicExpression> taintedExprs;
-        std::vector<triton::usize> invalidSymExpr;
 
-        for (auto it = this->symbolicExpressions.begin(); it != this->symbolicExpressions.end(); it++) {
-          if (auto sp = it->second.lock()) {
-            if (sp->isTainted) {
-              taintedExprs.push_back(sp);
-            }
-          } else {
-            invalidSymExpr.push_back(it->first);
-          }
+        for (const auto& expr : this->symbolicExpressions) {
+          if (expr->isTainted)
+            taintedExprs.push_back(expr);
         }
 
-        for (auto id : invalidSymExpr)
-          this->symbolicExpressions.erase(id);
-
         return taintedExprs;
       }
 
@@ -532,7 +580,7 @@ namespace triton {
           /* Create the symbolic expression */
           const SharedSymbolicExpression& se = this->newSymbolicExpression(tmp, REGISTER_EXPRESSION);
           se->setOriginRegister(reg);
-          this->symbolicReg[parent.getId()] = se;
+          this->setRegisterReference(parent.getId(), se);
         } else {
           /* Set the AST node */
           expression->setAst(tmp);
@@ -550,6 +598,7 @@ namespace triton {
         if (symVar == nullptr)
           throw triton::exceptions::SymbolicEngine("SymbolicEngine::newSymbolicVariable(): Cannot allocate a new symbolic variable");
 
+        this->symbolicVariableNames[symVar->getName()] = symVar;
         this->symbolicVariables[uniqueId] = symVar;
         return this->symbolicVariables[uniqueId];
       }
@@ -663,6 +712,10 @@ namespace triton {
 
         triton::utils::fromUintToBuffer(value, concreteValue);
 
+        /* Date the use of the memory cells for the memory budget */
+        if (this->isMemoryBudgetEnabled())
+          this->touchMemory(address, size);
+
         /*
          * Symbolic optimization
          * If the memory access is aligned, don't split the memory.
@@ -736,6 +789,8 @@ namespace triton {
         /* Check if the register is already symbolic */
         if (const SharedSymbolicExpression& symReg = this->getSymbolicRegister(reg)) {
           node = this->astCtxt.extract(high, low, this->astCtxt.reference(symReg));
+          if (this->isMemoryBudgetEnabled())
+            this->touchRegister(reg.getParent());
         }
         /* Otherwise, use the concerte value */
         else {
@@ -921,7 +976,67 @@ namespace triton {
 
       /* Adds and assign a new memory reference */
       void SymbolicEngine::addMemoryReference(triton::uint64 mem, const SharedSymbolicExpression& expr) {
-        this->memoryReference[mem] = expr;
+        this->setMemoryReference(mem, expr);
+        if (this->isMemoryBudgetEnabled()) {
+          this->touchMemory(mem, BYTE_SIZE);
+          if (this->budgetMaxDepth)
+            this->budgetDirtyMemory.insert(mem);
+        }
+      }
+
+
+      /* Assigns an expression to a parent register and keeps the reverse index up to date */
+      void SymbolicEngine::setRegisterReference(triton::arch::register_e parentId, const SharedSymbolicExpression& expr) {
+        SharedSymbolicExpression& slot = this->symbolicReg[parentId];
+
+        if (slot != nullptr) {
+          auto it = this->expressionLocations.find(slot->getId());
+          if (it != this->expressionLocations.end()) {
+            auto& registers = it->second.registers;
+            registers.erase(std::remove(registers.begin(), registers.end(), parentId), registers.end());
+            if (registers.empty() && it->second.memory.empty())
+              this->expressionLocations.erase(it);
+          }
+        }
+
+        slot = expr;
+
+        if (expr != nullptr) {
+          auto& registers = this->expressionLocations[expr->getId()].registers;
+          if (std::find(registers.begin(), registers.end(), parentId) == registers.end())
+            registers.push_back(parentId);
+        }
+      }
+
+
+      /* Assigns an expression to a memory cell and keeps the reverse index up to date */
+      void SymbolicEngine::setMemoryReference(triton::uint64 addr, const SharedSymbolicExpression& expr) {
+        auto ref = this->memoryReference.find(addr);
+
+        if (ref != this->memoryReference.end()) {
+          auto it = this->expressionLocations.find(ref->second->getId());
+          if (it != this->expressionLocations.end()) {
+            auto& memory = it->second.memory;
+            memory.erase(std::remove(memory.begin(), memory.end(), addr), memory.end());
+            if (memory.empty() && it->second.registers.empty())
+              this->expressionLocations.erase(it);
+          }
+          if (expr == nullptr) {
+            this->memoryReference.erase(ref);
+            return;
+          }
+          ref->second = expr;
+        }
+        else if (expr == nullptr) {
+          return;
+        }
+        else {
+          this->memoryReference[addr] = expr;
+        }
+
+        auto& memory = this->expressionLocations[expr->getId()].memory;
+        if (std::find(memory.begin(), memory.end(), addr) == memory.end())
+          memory.push_back(addr);
       }
 
 
@@ -945,7 +1060,12 @@ namespace triton {
 
         if (reg.isMutable()) {
           /* Assign if this register is mutable */
-          this->symbolicReg[id] = se;
+          this->setRegisterReference(reg.getParent(), se);
+          if (this->isMemoryBudgetEnabled()) {
+            this->touchRegister(reg.getParent());
+            if (this->budgetMaxDepth)
+              this->budgetDirtyRegisters.insert(reg.getParent());
+          }
           /* Synchronize the concrete state */
           this->architecture->setConcreteRegisterValue(reg, node->evaluate());
         }
@@ -995,12 +1115,7 @@ namespace triton {
 
       /* Returns true if the symbolic expression ID exists */
       bool SymbolicEngine::isSymbolicExpressionIdExists(triton::usize symExprId) const {
-        auto it = this->symbolicExpressions.find(symExprId);
-
-        if (it != this->symbolicExpressions.end())
-          return (it->second.use_count() > 0);
-
-        return false;
+        return this->symbolicExpressions.contains(symExprId);
       }
 
 
@@ -1107,13 +1222,384 @@ namespace triton {
         this->astCtxt.updateVariable(symVar->getName(), value);
       }
 
+      void SymbolicEngine::setMemoryBudget(triton::usize maxBytes) {
+        this->budgetMaxBytes = maxBytes;
+      }
+
+
+      triton::usize SymbolicEngine::getMemoryBudget(void) const {
+        return this->budgetMaxBytes;
+      }
+
+
+      void SymbolicEngine::setMemoryBudgetDepth(triton::uint32 maxDepth) {
+        this->budgetMaxDepth = maxDepth;
+      }
+
+
+      triton::uint32 SymbolicEngine::getMemoryBudgetDepth(void) const {
+        return this->budgetMaxDepth;
+      }
+
+
+      void SymbolicEngine::setMemoryBudgetPolicy(triton::engines::symbolic::budget_policy_e policy) {
+        switch (policy) {
+          case BUDGET_DEPTH:
+          case BUDGET_LRU:
+          case BUDGET_NOT_SYMBOLIZED:
+            this->budgetPolicy = policy;
+            break;
+          default:
+            throw triton::exceptions::SymbolicEngine("SymbolicEngine::setMemoryBudgetPolicy(): Invalid policy.");
+        }
+      }
+
+
+      triton::engines::symbolic::budget_policy_e SymbolicEngine::getMemoryBudgetPolicy(void) const {
+        return this->budgetPolicy;
+      }
+
+
+      bool SymbolicEngine::isMemoryBudgetEnabled(void) const {
+        return (this->budgetMaxBytes != 0 || this->budgetMaxDepth != 0);
+      }
+
+
+      void SymbolicEngine::touchMemory(triton::uint64 addr, triton::uint32 size) {
+        for (triton::uint32 index = 0; index < size; index++) {
+          if (this->memoryReference.find(addr + index) != this->memoryReference.end())
+            this->memoryLastUse[addr + index] = ++this->budgetClock;
+        }
+      }
+
+
+      void SymbolicEngine::touchRegister(triton::arch::register_e parentId) {
+        this->registerLastUse[parentId] = ++this->budgetClock;
+      }
+
+
+      void SymbolicEngine::summarizeMemory(triton::uint64 addr) {
+        BudgetDrop drop = {this->memoryReference[addr]->getId(), addr, triton::arch::ID_REG_INVALID, true};
+
+        this->budgetDrops.push_back(drop);
+        this->concretizeMemory(addr);
+        this->convertMemoryToSymbolicVariable(triton::arch::MemoryAccess(addr, BYTE_SIZE), "Memory budget summary");
+      }
+
+
+      void SymbolicEngine::summarizeRegister(triton::arch::register_e parentId) {
+        const triton::arch::Register& reg = this->architecture->getRegister(parentId);
+        BudgetDrop drop = {this->symbolicReg[parentId]->getId(), 0, parentId, true};
+
+        this->budgetDrops.push_back(drop);
+        this->concretizeRegister(reg);
+        this->convertRegisterToSymbolicVariable(reg, "Memory budget summary");
+        this->touchRegister(parentId);
+      }
+
+
+      triton::usize SymbolicEngine::getMemoryBudgetUsage(void) const {
+        triton::usize bytes = this->memoryReference.size();
+
+        for (triton::uint32 i = 0; i < this->numberOfRegisters; i++) {
+          if (this->symbolicReg[i] != nullptr)
+            bytes += (this->architecture->getRegister(static_cast<triton::arch::register_e>(i)).getBitSize() + 7) / BYTE_SIZE_BIT;
+        }
+
+        return bytes;
+      }
+
+
+      void SymbolicEngine::enforceMemoryBudget(void) {
+        if (!this->isMemoryBudgetEnabled())
+          return;
+
+        /* Summarize the new entries deeper than the threshold */
+        if (this->budgetMaxDepth) {
+          std::set<triton::uint64> dirtyMemory;
+          std::set<triton::arch::register_e> dirtyRegisters;
+
+          std::swap(dirtyMemory, this->budgetDirtyMemory);
+          std::swap(dirtyRegisters, this->budgetDirtyRegisters);
+
+          for (triton::uint64 addr : dirtyMemory) {
+            auto it = this->memoryReference.find(addr);
+            if (it != this->memoryReference.end() && it->second->getAst()->getDepth() > this->budgetMaxDepth)
+              this->summarizeMemory(addr);
+          }
+
+          for (triton::arch::register_e regId : dirtyRegisters) {
+            if (this->symbolicReg[regId] != nullptr && this->symbolicReg[regId]->getAst()->getDepth() > this->budgetMaxDepth)
+              this->summarizeRegister(regId);
+          }
+
+          /* Summaries are shallow, no need to measure them again */
+          this->budgetDirtyMemory.clear();
+          this->budgetDirtyRegisters.clear();
+        }
+
+        /* Concretize entries until a quarter of the budget is free */
+        triton::usize usage = this->getMemoryBudgetUsage();
+        if (this->budgetMaxBytes && usage > this->budgetMaxBytes) {
+          struct Candidate {
+            triton::uint64 rank;
+            triton::uint64 lastUse;
+            triton::uint64 address;
+            triton::arch::register_e regId;
+            triton::usize bytes;
+          };
+          std::vector<Candidate> candidates;
+          triton::usize target = this->budgetMaxBytes - (this->budgetMaxBytes / 4);
+
+          auto rank = [this](const SharedSymbolicExpression& expr) -> triton::uint64 {
+            switch (this->budgetPolicy) {
+              case BUDGET_DEPTH:          return 0xffffffff - expr->getAst()->getDepth();
+              case BUDGET_NOT_SYMBOLIZED: return expr->isSymbolized() ? 1 : 0;
+              default:                    return 0;
+            }
+          };
+
+          candidates.reserve(this->memoryReference.size());
+          for (const auto& item : this->memoryReference) {
+            auto it = this->memoryLastUse.find(item.first);
+            Candidate c = {rank(item.second), (it != this->memoryLastUse.end()) ? it->second : 0, item.first, triton::arch::ID_REG_INVALID, 1};
+            candidates.push_back(c);
+          }
+
+          for (triton::uint32 i = 0; i < this->numberOfRegisters; i++) {
+            if (this->symbolicReg[i] != nullptr) {
+              triton::arch::register_e regId = static_cast<triton::arch::register_e>(i);
+              Candidate c = {rank(this->symbolicReg[i]), this->registerLastUse[i], 0, regId, (this->architecture->getRegister(regId).getBitSize() + 7) / BYTE_SIZE_BIT};
+              candidates.push_back(c);
+            }
+          }
+
+          std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return (a.rank != b.rank) ? (a.rank < b.rank) : (a.lastUse < b.lastUse);
+          });
+
+          for (const auto& c : candidates) {
+            if (usage <= target)
+              break;
+            if (c.regId == triton::arch::ID_REG_INVALID) {
+              BudgetDrop drop = {this->memoryReference[c.address]->getId(), c.address, c.regId, false};
+              this->budgetDrops.push_back(drop);
+              this->concretizeMemory(c.address);
+            }
+            else {
+              BudgetDrop drop = {this->symbolicReg[c.regId]->getId(), 0, c.regId, false};
+              this->budgetDrops.push_back(drop);
+              this->concretizeRegister(this->architecture->getRegister(c.regId));
+            }
+            usage -= c.bytes;
+          }
+        }
+      }
+
+
+      const std::vector<triton::engines::symbolic::BudgetDrop>& SymbolicEngine::getMemoryBudgetDrops(void) const {
+        return this->budgetDrops;
+      }
+
+
+      void SymbolicEngine::clearMemoryBudgetDrops(void) {
+        this->budgetDrops.clear();
+      }
+
+
+      void SymbolicEngine::clearState(void) {
+        this->concretizeAllRegister();
+        this->concretizeAllMemory();
+        this->clearPathConstraints();
+        this->astCtxt.clearVariables();
+
+        this->budgetDirtyMemory.clear();
+        this->budgetDirtyRegisters.clear();
+        this->budgetDrops.clear();
+        this->expressionLocations.clear();
+        this->symbolicExpressions.clear();
+        this->symbolicVariableNames.clear();
+        this->symbolicVariables.clear();
+        this->registerLastUse.assign(this->numberOfRegisters, 0);
+        this->uniqueSymExprId = 0;
+        this->uniqueSymVarId = 0;
+      }
+
+
+      void SymbolicEngine::saveState(std::ostream& stream) const {
+        triton::ast::AstWriter writer(stream, this->astCtxt);
+        std::vector<triton::usize> ids;
+
+        stream.write(STATE_MAGIC, sizeof(STATE_MAGIC));
+        writer.writeInteger(static_cast<triton::uint64>(triton::ast::BINARY_FORMAT_VERSION));
+        writer.writeInteger(static_cast<triton::uint64>(this->architecture->getArchitecture()));
+        writer.writeInteger(static_cast<triton::uint64>(this->uniqueSymExprId));
+        writer.writeInteger(static_cast<triton::uint64>(this->uniqueSymVarId));
+
+        /* Variables, by id, including the ones which are not used yet */
+        for (const auto& kv : this->symbolicVariables)
+          ids.push_back(kv.first);
+        std::sort(ids.begin(), ids.end());
+        for (triton::usize id : ids)
+          writer.writeVariable(this->symbolicVariables.at(id));
+
+        /* Live expressions, with their ASTs and the expressions they refer to */
+        for (const auto& expr : this->symbolicExpressions)
+          writer.writeExpression(expr);
+
+        for (triton::uint32 regId = 0; regId < this->numberOfRegisters; regId++) {
+          const SharedSymbolicExpression& expr = this->symbolicReg[regId];
+          if (expr == nullptr)
+            continue;
+          writer.writeExpression(expr);
+          writer.writeInteger(static_cast<triton::uint64>(triton::ast::REGISTER_RECORD));
+          writer.writeInteger(static_cast<triton::uint64>(regId));
+          writer.writeInteger(static_cast<triton::uint64>(expr->getId()));
+        }
+
+        /* Memory cells are sorted, their addresses are written as deltas */
+        triton::uint64 previous = 0;
+        for (const auto& kv : this->memoryReference) {
+          writer.writeExpression(kv.second);
+          writer.writeInteger(static_cast<triton::uint64>(triton::ast::MEMORY_RECORD));
+          writer.writeInteger(kv.first - previous);
+          writer.writeInteger(static_cast<triton::uint64>(kv.second->getId()));
+          previous = kv.first;
+        }
+
+        for (const auto& pco : this->pathConstraints) {
+          const auto& branches = pco.getBranchConstraints();
+          for (const auto& branch : branches)
+            writer.writeNode(std::get<3>(branch));
+
+          writer.writeInteger(static_cast<triton::uint64>(triton::ast::PATH_CONSTRAINT_RECORD));
+          writer.writeInteger(static_cast<triton::uint64>(branches.size()));
+          for (const auto& branch : branches) {
+            writer.writeInteger(static_cast<triton::uint64>(std::get<0>(branch)));
+            writer.writeInteger(std::get<1>(branch));
+            writer.writeInteger(std::get<2>(branch));
+            writer.writeNodeIndex(std::get<3>(branch));
+          }
+        }
+
+        writer.writeInteger(static_cast<triton::uint64>(triton::ast::END_RECORD));
+
+        if (!stream)
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::saveState(): Cannot write the state.");
+      }
+
+
+      void SymbolicEngine::loadState(const triton::uint8* data, triton::usize size) {
+        triton::ast::AstReader reader(data, size, this->astCtxt, this->architecture);
+        triton::uint8 magic[sizeof(STATE_MAGIC)];
+
+        /* The header is checked before the current state is dropped */
+        reader.readBytes(magic, sizeof(magic));
+        if (std::memcmp(magic, STATE_MAGIC, sizeof(magic)) != 0)
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Invalid magic.");
+
+        if (reader.readInteger() != triton::ast::BINARY_FORMAT_VERSION)
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Unsupported version.");
+
+        if (reader.readInteger() != static_cast<triton::uint64>(this->architecture->getArchitecture()))
+          throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): The architecture does not match.");
+
+        triton::usize exprIds = static_cast<triton::usize>(reader.readInteger());
+        triton::usize varIds  = static_cast<triton::usize>(reader.readInteger());
+
+        this->clearState();
+
+        try {
+          bool end = false;
+          triton::uint64 address = 0;
+
+          while (!end) {
+            switch (reader.readInteger()) {
+              case triton::ast::VARIABLE_RECORD: {
+                const SharedSymbolicVariable& var = reader.readVariable();
+                if (var->getId() >= varIds)
+                  throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Invalid symbolic variable id.");
+                this->symbolicVariables[var->getId()] = var;
+                this->symbolicVariableNames[var->getName()] = var;
+                break;
+              }
+
+              case triton::ast::NODE_RECORD:
+                reader.readNode();
+                break;
+
+              case triton::ast::EXPRESSION_RECORD: {
+                const SharedSymbolicExpression& expr = reader.readExpression();
+                if (expr->getId() >= exprIds)
+                  throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Invalid symbolic expression id.");
+                this->symbolicExpressions.insert(expr);
+                break;
+              }
+
+              case triton::ast::REGISTER_RECORD: {
+                triton::arch::register_e regId = static_cast<triton::arch::register_e>(reader.readInteger());
+                const SharedSymbolicExpression& expr = reader.getExpression(static_cast<triton::usize>(reader.readInteger()));
+                if (regId >= this->numberOfRegisters || !this->architecture->isRegisterValid(regId))
+                  throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Invalid register.");
+                this->setRegisterReference(regId, expr);
+                break;
+              }
+
+              case triton::ast::MEMORY_RECORD: {
+                address += reader.readInteger();
+                this->setMemoryReference(address, reader.getExpression(static_cast<triton::usize>(reader.readInteger())));
+                break;
+              }
+
+              case triton::ast::PATH_CONSTRAINT_RECORD: {
+                PathConstraint pco;
+                triton::uint64 n = reader.readInteger();
+                for (triton::uint64 index = 0; index < n; index++) {
+                  bool taken = (reader.readInteger() != 0);
+                  triton::uint64 src = reader.readInteger();
+                  triton::uint64 dst = reader.readInteger();
+                  pco.addBranchConstraint(taken, src, dst, reader.readNodeIndex());
+                }
+                this->pushPathConstraint(pco);
+                break;
+              }
+
+              case triton::ast::END_RECORD:
+                end = true;
+                break;
+
+              default:
+                throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Invalid record.");
+            }
+          }
+
+          if (!reader.isEnd())
+            throw triton::exceptions::SymbolicEngine("SymbolicEngine::loadState(): Unexpected data after the end of the state.");
+
+          this->uniqueSymExprId = exprIds;
+          this->uniqueSymVarId  = varIds;
+        }
+        catch (const triton::exceptions::Exception&) {
+          /* Do not keep a partial state */
+          this->clearState();
+          throw;
+        }
+      }
+
+
       void SymbolicEngine::restoreInstance(const triton::engines::symbolic::SymbolicEngine& other) {
         this->alignedMemoryReference = other.alignedMemoryReference;
+        this->budgetDirtyMemory.clear();
+        this->budgetDirtyRegisters.clear();
         this->enableFlag = other.enableFlag;
+        this->expressionLocations = other.expressionLocations;
+        this->memoryLastUse = other.memoryLastUse;
         this->memoryReference = other.memoryReference;
         this->numberOfRegisters = other.numberOfRegisters;
+        this->registerLastUse = other.registerLastUse;
         this->symbolicExpressions = other.symbolicExpressions;
         this->symbolicReg = other.symbolicReg;
+        this->symbolicVariableNames = other.symbolicVariableNames;
         this->symbolicVariables = other.symbolicVariables;
         this->uniqueSymExprId = other.uniqueSymExprId;
         this->uniqueSymVarId = other.uniqueSymVarId;
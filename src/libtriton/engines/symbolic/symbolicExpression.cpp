@@ -5,6 +5,8 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>                      // for sort
+#include <deque>                          // for deque
 #include <iosfwd>                         // for ostream
 #include <string>                         // for string
 #include <sstream>                        // for sstream
@@ -15,6 +17,7 @@
 #include <triton/symbolicEnums.hpp>       // for expression_e, variable_e
 #include <triton/symbolicExpression.hpp>  // for SymbolicExpression
 #include <triton/tritonTypes.hpp>         // for usize
+#include <unordered_set>                  // for unordered_set
 
 
 namespace triton {
@@ -24,33 +27,38 @@ namespace triton {
       SymbolicExpression::SymbolicExpression(const triton::ast::SharedAbstractNode& node, triton::usize id, triton::engines::symbolic::expression_e type, const std::string& comment)
         : originMemory(),
           originRegister() {
-        this->ast           = node;
-        this->comment       = comment;
-        this->id            = id;
-        this->isTainted     = false;
-        this->type          = type;
+        this->ast                = node;
+        this->comment            = comment;
+        this->id                 = id;
+        this->isTainted          = false;
+        this->referencesComputed = false;
+        this->type               = type;
       }
 
 
       SymbolicExpression::SymbolicExpression(const SymbolicExpression& other) {
-        this->ast            = other.ast;
-        this->comment        = other.comment;
-        this->id             = other.id;
-        this->isTainted      = other.isTainted;
-        this->originMemory   = other.originMemory;
-        this->originRegister = other.originRegister;
-        this->type           = other.type;
+        this->ast                = other.ast;
+        this->comment            = other.comment;
+        this->id                 = other.id;
+        this->isTainted          = other.isTainted;
+        this->originMemory       = other.originMemory;
+        this->originRegister     = other.originRegister;
+        this->references         = other.references;
+        this->referencesComputed = other.referencesComputed;
+        this->type               = other.type;
       }
 
 
       SymbolicExpression& SymbolicExpression::operator=(const SymbolicExpression& other) {
-        this->ast            = other.ast;
-        this->comment        = other.comment;
-        this->id             = other.id;
-        this->isTainted      = other.isTainted;
-        this->originMemory   = other.originMemory;
-        this->originRegister = other.originRegister;
-        this->type           = other.type;
+        this->ast                = other.ast;
+        this->comment            = other.comment;
+        this->id                 = other.id;
+        this->isTainted          = other.isTainted;
+        this->originMemory       = other.originMemory;
+        this->originRegister     = other.originRegister;
+        this->references         = other.references;
+        this->referencesComputed = other.referencesComputed;
+        this->type               = other.type;
         return *this;
       }
 
@@ -152,12 +160,41 @@ namespace triton {
       }
 
 
+      const std::vector<SharedSymbolicExpression>& SymbolicExpression::getReferences(void) const {
+        if (this->referencesComputed)
+          return this->references;
+
+        std::deque<triton::ast::SharedAbstractNode> nodes;
+        std::unordered_set<triton::usize> ids;
+
+        /* References are not unrolled, so only the AST of this expression is visited */
+        this->references.clear();
+        triton::ast::nodesExtraction(&nodes, this->getAst(), false /* unroll */, false /* revert */);
+        for (const auto& node : nodes) {
+          if (node->getType() == triton::ast::REFERENCE_NODE) {
+            const SharedSymbolicExpression& expr = reinterpret_cast<triton::ast::ReferenceNode*>(node.get())->getSymbolicExpression();
+            if (ids.insert(expr->getId()).second)
+              this->references.push_back(expr);
+          }
+        }
+
+        std::sort(this->references.begin(), this->references.end(), [](const SharedSymbolicExpression& a, const SharedSymbolicExpression& b) {
+          return a->getId() < b->getId();
+        });
+
+        this->referencesComputed = true;
+        return this->references;
+      }
+
+
       void SymbolicExpression::setAst(const triton::ast::SharedAbstractNode& node) {
         for(auto sp : this->ast->getParents()) {
           node->setParent(sp.get());
         }
         this->ast = node;
         this->ast->init();
+        this->references.clear();
+        this->referencesComputed = false;
       }
 
 
@@ -166,6 +203,8 @@ namespace triton {
           node->setParent(sp.get());
         }
         this->ast = node;
+        this->references.clear();
+        this->referencesComputed = false;
         // this->ast->init();
       }
 
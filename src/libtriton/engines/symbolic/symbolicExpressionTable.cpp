@@ -0,0 +1,165 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+
+#include <triton/symbolicExpressionTable.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace symbolic {
+
+      SymbolicExpressionTable::SymbolicExpressionTable() {
+        this->base       = 0;
+        this->insertions = 0;
+      }
+
+
+      void SymbolicExpressionTable::compact(void) {
+        while (!this->slots.empty() && this->slots.front().expired()) {
+          this->slots.pop_front();
+          this->base++;
+        }
+      }
+
+
+      void SymbolicExpressionTable::sweep(void) {
+        for (auto& slot : this->slots) {
+          if (slot.expired())
+            slot.reset();
+        }
+        this->insertions = 0;
+        this->compact();
+      }
+
+
+      void SymbolicExpressionTable::insert(const SharedSymbolicExpression& expr) {
+        triton::usize id = expr->getId();
+
+        if (this->slots.empty()) {
+          this->base = id;
+        }
+
+        /*
+         * An id may be inserted after greater ones (e.g. expressions created by a
+         * simplification callback), and its tombstone may already be released.
+         */
+        else if (id < this->base) {
+          this->slots.insert(this->slots.begin(), this->base - id, WeakSymbolicExpression());
+          this->base = id;
+        }
+
+        if (id - this->base >= this->slots.size())
+          this->slots.resize(id - this->base + 1);
+
+        this->slots[id - this->base] = expr;
+        this->compact();
+
+        /* The sweeps are amortized over half of the slots */
+        if (++this->insertions >= std::max<triton::usize>(1024, this->slots.size() / 2))
+          this->sweep();
+      }
+
+
+      SharedSymbolicExpression SymbolicExpressionTable::find(triton::usize id) const {
+        if (id < this->base || id - this->base >= this->slots.size())
+          return nullptr;
+
+        auto& slot = this->slots[id - this->base];
+        SharedSymbolicExpression expr = slot.lock();
+        if (expr == nullptr)
+          slot.reset();
+
+        return expr;
+      }
+
+
+      bool SymbolicExpressionTable::contains(triton::usize id) const {
+        if (id < this->base || id - this->base >= this->slots.size())
+          return false;
+
+        auto& slot = this->slots[id - this->base];
+        if (!slot.expired())
+          return true;
+
+        slot.reset();
+        return false;
+      }
+
+
+      void SymbolicExpressionTable::erase(triton::usize id) {
+        if (id < this->base || id - this->base >= this->slots.size())
+          return;
+
+        this->slots[id - this->base].reset();
+        this->compact();
+      }
+
+
+      void SymbolicExpressionTable::clear(void) {
+        this->slots.clear();
+        this->base       = 0;
+        this->insertions = 0;
+      }
+
+
+      triton::usize SymbolicExpressionTable::capacity(void) const {
+        return this->slots.size();
+      }
+
+
+      SymbolicExpressionTable::const_iterator SymbolicExpressionTable::begin(void) const {
+        return const_iterator(this, 0);
+      }
+
+
+      SymbolicExpressionTable::const_iterator SymbolicExpressionTable::end(void) const {
+        return const_iterator(this, this->slots.size());
+      }
+
+
+      SymbolicExpressionTable::const_iterator::const_iterator(const SymbolicExpressionTable* table, triton::usize index)
+        : table(table),
+          index(index) {
+        this->skip();
+      }
+
+
+      void SymbolicExpressionTable::const_iterator::skip(void) {
+        while (this->index < this->table->slots.size() && this->table->slots[this->index].expired()) {
+          this->table->slots[this->index].reset();
+          this->index++;
+        }
+      }
+
+
+      SharedSymbolicExpression SymbolicExpressionTable::const_iterator::operator*(void) const {
+        return this->table->slots[this->index].lock();
+      }
+
+
+      SymbolicExpressionTable::const_iterator& SymbolicExpressionTable::const_iterator::operator++(void) {
+        this->index++;
+        this->skip();
+        return *this;
+      }
+
+
+      bool SymbolicExpressionTable::const_iterator::operator==(const const_iterator& other) const {
+        return (this->table == other.table && this->index == other.index);
+      }
+
+
+      bool SymbolicExpressionTable::const_iterator::operator!=(const const_iterator& other) const {
+        return !(*this == other);
+      }
+
+    }; /* symbolic namespace */
+  }; /* engines namespace */
+}; /*triton namespace */
@@ -13,6 +13,7 @@
 #include <triton/astContext.hpp>
 #include <triton/astRepresentation.hpp>
 #include <triton/callbacks.hpp>
+#include <triton/concreteInterpreter.hpp>
 #include <triton/dllexport.hpp>
 #include <triton/immediate.hpp>
 #include <triton/instruction.hpp>
@@ -62,6 +63,9 @@ class API {
   //! The IR builder.
   triton::arch::IrBuilder* irBuilder = nullptr;
 
+  //! The concrete interpreter.
+  triton::arch::ConcreteInterpreter* interpreter = nullptr;
+
  public:
   //! Constructor of the API.
   TRITON_EXPORT API();
@@ -203,6 +207,13 @@ class API {
       triton::uint64 baseAddr, triton::usize size,
       bool execCallbacks = true) const;
 
+  //! [**architecture api**] - Fills `area` with the concrete value of a memory
+  //! area. `area` must be able to hold `size` bytes.
+  TRITON_EXPORT void getConcreteMemoryAreaValue(triton::uint64 baseAddr,
+                                                triton::uint8* area,
+                                                triton::usize size,
+                                                bool execCallbacks = true) const;
+
   //! [**architecture api**] - Returns the concrete value of a register.
   TRITON_EXPORT triton::uint512 getConcreteRegisterValue(
       const triton::arch::Register& reg, bool execCallbacks = true) const;
@@ -282,6 +293,26 @@ class API {
   //! supported.
   TRITON_EXPORT bool processing(triton::arch::Instruction& inst);
 
+  //! [**proccesing api**] - Executes instructions from the program counter
+  //! until it reaches `addr` or `count` instructions have been executed (0
+  //! for no limit). When the symbolic and taint engines are disabled, the
+  //! common instructions are executed natively on the concrete state. Returns
+  //! the number of executed instructions.
+  TRITON_EXPORT triton::usize runUntil(triton::uint64 addr,
+                                       triton::usize count = 0);
+
+  //! [**proccesing api**] - Executes instructions from the program counter
+  //! until `stop` returns true for the program counter or `count`
+  //! instructions have been executed (0 for no limit). Returns the number of
+  //! executed instructions. \sa runUntil().
+  TRITON_EXPORT triton::usize
+  runUntil(const std::function<bool(triton::uint64)>& stop,
+           triton::usize count = 0);
+
+  //! [**proccesing api**] - Returns the number of instructions executed
+  //! natively by processing() and runUntil().
+  TRITON_EXPORT triton::usize getNativeCount(void) const;
+
   //! [**proccesing api**] - Initializes everything.
   TRITON_EXPORT void initEngines(void);
 
@@ -341,9 +372,20 @@ class API {
   TRITON_EXPORT void addCallback(
       triton::callbacks::symbolicSimplificationCallback cb);
 
-  //! [**callbacks api**] - Removes all recorded callbacks.
+  //! [**callbacks api**] - Removes all recorded callbacks, once the finalizers
+  //! are called.
   TRITON_EXPORT void removeAllCallbacks(void);
 
+  //! [**callbacks api**] - Adds a function called once before all the
+  //! callbacks are removed (removeAllCallbacks(), reset()), e.g. to complete
+  //! the work of some callbacks like the lazy mapping of an ELF loader. Returns
+  //! its id.
+  TRITON_EXPORT triton::usize
+  addCallbacksFinalizer(const std::function<void(void)>& fn);
+
+  //! [**callbacks api**] - Removes a finalizer which is not called yet.
+  TRITON_EXPORT void removeCallbacksFinalizer(triton::usize id);
+
   //! [**callbacks api**] - Deletes a GET_CONCRETE_MEMORY_VALUE callback (LOAD).
   TRITON_EXPORT void removeCallback(
       triton::callbacks::getConcreteMemoryValueCallback cb);
@@ -593,6 +635,16 @@ class API {
   //! constraints.
   TRITON_EXPORT triton::ast::SharedAbstractNode getPathConstraintsAst(void);
 
+  //! [**symbolic api**] - Returns the logical conjunction AST of the `index`
+  //! first path constraints.
+  TRITON_EXPORT triton::ast::SharedAbstractNode
+  getPrefixPathConstraintsAst(triton::usize index);
+
+  //! [**symbolic api**] - Returns the conjunction of the `index` first path
+  //! constraints and of the negation of the `index`th one.
+  TRITON_EXPORT triton::ast::SharedAbstractNode
+  getNegatedPathConstraintsAst(triton::usize index);
+
   //! [**symbolic api**] - Adds a path constraint.
   TRITON_EXPORT void addPathConstraint(
       const triton::arch::Instruction& inst,
@@ -602,6 +654,16 @@ class API {
   //! constraints.
   TRITON_EXPORT void clearPathConstraints(void);
 
+  //! [**symbolic api**] - Keeps only the `first` and the `last` path
+  //! constraints of the branch at `addr`.
+  TRITON_EXPORT void setPathConstraintsCompression(triton::uint64 addr,
+                                                   triton::usize first,
+                                                   triton::usize last);
+
+  //! [**symbolic api**] - Removes the compression policy of the branch at
+  //! `addr`.
+  TRITON_EXPORT void removePathConstraintsCompression(triton::uint64 addr);
+
   //! [**symbolic api**] - Enables or disables the symbolic execution engine.
   TRITON_EXPORT void enableSymbolicEngine(bool flag);
 
@@ -643,12 +705,61 @@ class API {
   //! [**symbolic api**] - Concretizes a specific symbolic register reference.
   TRITON_EXPORT void concretizeRegister(const triton::arch::Register& reg);
 
+  //! [**symbolic api**] - Sets the maximum number of symbolic bytes (memory
+  //! cells and registers). 0 means unlimited.
+  TRITON_EXPORT void setMemoryBudget(triton::usize maxBytes);
+
+  //! [**symbolic api**] - Returns the maximum number of symbolic bytes. 0 means
+  //! unlimited.
+  TRITON_EXPORT triton::usize getMemoryBudget(void) const;
+
+  //! [**symbolic api**] - Sets the maximum depth of the AST of an entry before
+  //! being summarized by a fresh symbolic variable. 0 means unlimited.
+  TRITON_EXPORT void setMemoryBudgetDepth(triton::uint32 maxDepth);
+
+  //! [**symbolic api**] - Returns the maximum depth of the AST of an entry
+  //! before being summarized. 0 means unlimited.
+  TRITON_EXPORT triton::uint32 getMemoryBudgetDepth(void) const;
+
+  //! [**symbolic api**] - Sets the policy used to select the entries dropped
+  //! when the memory budget is exceeded.
+  TRITON_EXPORT void
+  setMemoryBudgetPolicy(triton::engines::symbolic::budget_policy_e policy);
+
+  //! [**symbolic api**] - Returns the policy used to select the entries
+  //! dropped when the memory budget is exceeded.
+  TRITON_EXPORT triton::engines::symbolic::budget_policy_e
+  getMemoryBudgetPolicy(void) const;
+
+  //! [**symbolic api**] - Returns the number of symbolic bytes (memory cells
+  //! and registers).
+  TRITON_EXPORT triton::usize getMemoryBudgetUsage(void) const;
+
+  //! [**symbolic api**] - Enforces the memory budget. Automatically called
+  //! after each instruction.
+  TRITON_EXPORT void enforceMemoryBudget(void);
+
+  //! [**symbolic api**] - Returns the entries dropped by the memory budget.
+  TRITON_EXPORT const std::vector<triton::engines::symbolic::BudgetDrop>&
+  getMemoryBudgetDrops(void) const;
+
+  //! [**symbolic api**] - Clears the record of the entries dropped by the
+  //! memory budget.
+  TRITON_EXPORT void clearMemoryBudgetDrops(void);
+
   //! [**symbolic api**] - Slices all expressions from a given one.
   TRITON_EXPORT std::map<triton::usize,
                          triton::engines::symbolic::SharedSymbolicExpression>
   sliceExpressions(
       const triton::engines::symbolic::SharedSymbolicExpression& expr);
 
+  //! [**symbolic api**] - Returns the symbolic variables which influence an
+  //! expression.
+  TRITON_EXPORT std::map<triton::usize,
+                         triton::engines::symbolic::SharedSymbolicVariable>
+  sliceVariables(
+      const triton::engines::symbolic::SharedSymbolicExpression& expr) const;
+
   //! [**symbolic api**] - Returns the list of the tainted symbolic expressions.
   TRITON_EXPORT std::list<triton::engines::symbolic::SharedSymbolicExpression>
   getTaintedSymbolicExpressions(void) const;
@@ -659,6 +770,11 @@ class API {
       triton::usize, triton::engines::symbolic::SharedSymbolicExpression>
   getSymbolicExpressions(void) const;
 
+  //! [**symbolic api**] - Returns the table of symbolic expressions indexed by
+  //! id. Iterating it does not copy the expressions.
+  TRITON_EXPORT const triton::engines::symbolic::SymbolicExpressionTable&
+  getSymbolicExpressionTable(void) const;
+
   //! [**symbolic api**] - Returns all symbolic variables as a map of <SymVarId
   //! : SymVar>
   TRITON_EXPORT const std::unordered_map<
@@ -674,6 +790,21 @@ class API {
       const triton::engines::symbolic::SharedSymbolicVariable& symVar,
       const triton::uint512& value);
 
+  //! [**symbolic api**] - Writes the symbolic state (variables, expressions,
+  //! register and memory bindings, path constraints) in a binary format.
+  TRITON_EXPORT void saveState(std::ostream& stream) const;
+
+  //! [**symbolic api**] - Writes the symbolic state to a file.
+  TRITON_EXPORT void saveState(const std::string& path) const;
+
+  //! [**symbolic api**] - Replaces the symbolic state by the one read from a
+  //! buffer written by saveState().
+  TRITON_EXPORT void loadState(const triton::uint8* data, triton::usize size);
+
+  //! [**symbolic api**] - Replaces the symbolic state by the one read from a
+  //! file. The file is mapped in memory, not read.
+  TRITON_EXPORT void loadState(const std::string& path);
+
   /* Solver engine API
    * =============================================================================
    */
@@ -684,14 +815,17 @@ class API {
 
   /*!
    * \brief [**solver api**] - Computes and returns a model from a symbolic
-   * constraint.
+   * constraint. If `status` is not null, it receives the status of the query.
+   * The `timeout` in milliseconds overrides the default one.
    *
    * \details
    * **item1**: symbolic variable id<br>
    * **item2**: model
    */
   TRITON_EXPORT std::map<triton::uint32, triton::engines::solver::SolverModel>
-  getModel(const triton::ast::SharedAbstractNode& node) const;
+  getModel(const triton::ast::SharedAbstractNode& node,
+           triton::engines::solver::status_e* status = nullptr,
+           triton::uint32 timeout = 0) const;
 
   /*!
    * \brief [**solver api**] - Computes and returns several models from a
@@ -703,11 +837,82 @@ class API {
    */
   TRITON_EXPORT
   std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>>
-  getModels(const triton::ast::SharedAbstractNode& node,
-            triton::uint32 limit) const;
+  getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit,
+            triton::engines::solver::status_e* status = nullptr,
+            triton::uint32 timeout = 0) const;
 
   //! Returns true if an expression is satisfiable.
-  TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node) const;
+  TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node,
+                           triton::engines::solver::status_e* status = nullptr,
+                           triton::uint32 timeout = 0) const;
+
+  /*!
+   * \brief [**solver api**] - Enumerates the models of a symbolic constraint
+   * and gives each of them to `callback` as soon as it is found.
+   *
+   * \details The models are distinct on the variables of `projection`, or on
+   * all the variables if it is empty. The enumeration stops after `limit`
+   * models (0 for no limit) or when `callback` returns false. With
+   * `threads` > 1, the value space is split between several solvers.
+   */
+  TRITON_EXPORT void enumerateModels(
+      const triton::ast::SharedAbstractNode& node,
+      const std::vector<triton::engines::symbolic::SharedSymbolicVariable>&
+          projection,
+      const triton::engines::solver::ModelCallback& callback,
+      triton::uint32 limit = 0, triton::uint32 threads = 1,
+      triton::engines::solver::status_e* status = nullptr,
+      triton::uint32 timeout = 0) const;
+
+  //! [**solver api**] - Sets the default time limit of a query in
+  //! milliseconds, 0 for no limit.
+  TRITON_EXPORT void setSolverTimeout(triton::uint32 ms);
+
+  //! [**solver api**] - Sets the resource limit of a query, 0 for no limit.
+  TRITON_EXPORT void setSolverResourceLimit(triton::uint32 rlimit);
+
+  //! [**solver api**] - Sets the memory limit of the solver in megabytes, 0
+  //! for no limit.
+  TRITON_EXPORT void setSolverMemoryLimit(triton::uint32 mb);
+
+  //! [**solver api**] - Solves the queries in a pool of `workers` processes,
+  //! or in the process if `workers` is 0. A worker is killed after `timeout`
+  //! milliseconds on a query without time limit and replaced after
+  //! `maxQueries` queries (0 for no limit).
+  TRITON_EXPORT void setSolverPool(triton::usize workers,
+                                   triton::uint32 timeout = 0,
+                                   triton::usize maxQueries = 0);
+
+  //! [**solver api**] - Returns the pids of the workers of the solver pool, 0
+  //! for a worker not started.
+  TRITON_EXPORT std::vector<triton::uint32> getSolverPoolWorkers(void) const;
+
+  //! [**solver api**] - Submits a query to solve in the background and
+  //! returns its ticket. If `limit` is 0, only the satisfiability is checked.
+  TRITON_EXPORT triton::usize
+  submitQuery(const triton::ast::SharedAbstractNode& node,
+              triton::uint32 limit = 1, triton::uint32 timeout = 0);
+
+  //! [**solver api**] - Returns true if the query of a ticket is solved.
+  TRITON_EXPORT bool pollQuery(triton::usize ticket) const;
+
+  /*!
+   * \brief [**solver api**] - Waits until the query of a ticket is solved,
+   * returns its status and its models and forgets the ticket.
+   *
+   * \details
+   * **item1**: symbolic variable id<br>
+   * **item2**: model
+   */
+  TRITON_EXPORT triton::engines::solver::status_e waitQuery(
+      triton::usize ticket,
+      std::list<std::map<triton::uint32,
+                         triton::engines::solver::SolverModel>>* models =
+          nullptr);
+
+  //! [**solver api**] - Cancels the query of a ticket. Returns false if the
+  //! query was already solved.
+  TRITON_EXPORT bool cancelQuery(triton::usize ticket);
 
   //! Returns the kind of solver as triton::engines::solver::solver_e.
   TRITON_EXPORT triton::engines::solver::solver_e getSolver(void) const;
@@ -88,6 +88,33 @@ namespace triton {
         //! Contect use to create this node
         AstContext& ctxt;
 
+        //! The depth of the DAG from this root node. References are unrolled.
+        triton::uint32 depth;
+
+        //! The approximate size of the tree from this root node once shared nodes and references are unrolled.
+        triton::uint64 unrolledSize;
+
+        //! The sorted ids of the symbolic variables reachable from this root node. May be shared with a child.
+        mutable std::shared_ptr<const std::vector<triton::usize>> variableIds;
+
+        //! True if the variable ids must be merged from the operands on the first getVariableIds().
+        mutable bool variableIdsPending;
+
+        //! The structural hash of the tree from this root node. References are unrolled.
+        triton::uint64 unrolledHash;
+
+        //! Computes the depth, the unrolled size, the variable ids and the structural hash from the children.
+        void initMetrics(void);
+
+        //! Copies the depth, the unrolled size, the variable ids and the structural hash of the node unrolled by a reference.
+        void initMetrics(const AbstractNode& unrolled);
+
+        //! Mixes a value into the structural hash, for the operands which are not children.
+        void mixUnrolledHash(triton::uint64 value);
+
+        //! Merges the pending variable ids of this node and of its pending operands, bottom-up.
+        void resolveVariableIds(void) const;
+
       public:
         //! Constructor.
         TRITON_EXPORT AbstractNode(triton::ast::ast_e type, AstContext& ctxt);
@@ -116,6 +143,18 @@ namespace triton {
         //! Returns true if it's a logical node.
         TRITON_EXPORT bool isLogical(void) const;
 
+        //! Returns the depth of the DAG from this root node. References are unrolled.
+        TRITON_EXPORT triton::uint32 getDepth(void) const;
+
+        //! Returns the approximate size of the tree once shared nodes and references are unrolled (saturated).
+        TRITON_EXPORT triton::uint64 getUnrolledSize(void) const;
+
+        //! Returns a structural hash of the tree once references are unrolled, in O(1). Two trees with the same operations on the same variables and constants have the same hash.
+        TRITON_EXPORT triton::uint64 getUnrolledHash(void) const;
+
+        //! Returns the sorted ids of the symbolic variables reachable from this root node. The set is merged on the first call.
+        TRITON_EXPORT const std::vector<triton::usize>& getVariableIds(void) const;
+
         //! Returns true if the current tree is equal to the second one.
         TRITON_EXPORT bool equalTo(const SharedAbstractNode&) const;
 
@@ -666,6 +705,12 @@ namespace triton {
     //! Returns a deque of collected matched nodes via a depth-first pre order traversal.
     TRITON_EXPORT std::deque<SharedAbstractNode> lookingForNodes(const SharedAbstractNode& node, triton::ast::ast_e match=ANY_NODE);
 
+    //! Returns true if both ASTs are structurally identical once their references are unrolled.
+    TRITON_EXPORT bool unrolledEqualTo(const SharedAbstractNode& node1, const SharedAbstractNode& node2);
+
+    //! Returns a flat conjunction of the nested conjunctions of an AST (e.g. the chained path constraints), or the AST itself if it has none. References are not unrolled.
+    TRITON_EXPORT SharedAbstractNode flattenConjunction(const SharedAbstractNode& node);
+
   /*! @} End of ast namespace */
   };
 /*! @} End of triton namespace */
@@ -0,0 +1,208 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_ASTBYTECODE_H
+#define TRITON_ASTBYTECODE_H
+
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    /*! \class AstBytecode
+     *  \brief An AST compiled into a linear register-based bytecode.
+     *
+     * \details The DAG of an AST (references included) is flattened once into a sequence of
+     * instructions where each node writes its own register. Shared nodes are compiled once and
+     * constants are loaded at compile time. Nodes up to 64 bits are evaluated with native integer
+     * operations, wider nodes with 512-bit integers, with the same semantics as `AbstractNode::evaluate()`.
+     * The evaluation takes the values of the variables in the order of `getVariables()` and does not
+     * allocate, so the same AST can be evaluated under many assignments without touching the AST context.
+     *
+     * `evaluateBatch()` runs the bytecode over many assignments at once. The registers are then laid
+     * out lane by lane and the common 64-bit operations (arithmetic, logic, shifts, comparisons, `ite`)
+     * are performed with SSE2 or AVX2 instructions when the library is compiled for them, the other
+     * operations fall back to the scalar path.
+     *
+     * The bytecode is a snapshot: it is not updated if the AST is modified after the compilation.
+     */
+    class AstBytecode {
+      private:
+        //! The operations of the bytecode.
+        enum opcode_e {
+          OP_BVADD,
+          OP_BVAND,
+          OP_BVASHR,
+          OP_BVLSHR,
+          OP_BVMUL,
+          OP_BVNAND,
+          OP_BVNEG,
+          OP_BVNOR,
+          OP_BVNOT,
+          OP_BVOR,
+          OP_BVROL,
+          OP_BVROR,
+          OP_BVSDIV,
+          OP_BVSGE,
+          OP_BVSGT,
+          OP_BVSHL,
+          OP_BVSLE,
+          OP_BVSLT,
+          OP_BVSMOD,
+          OP_BVSREM,
+          OP_BVSUB,
+          OP_BVUDIV,
+          OP_BVUGE,
+          OP_BVUGT,
+          OP_BVULE,
+          OP_BVULT,
+          OP_BVUREM,
+          OP_BVXNOR,
+          OP_BVXOR,
+          OP_CONCAT,
+          OP_DISTINCT,
+          OP_EQUAL,
+          OP_EXTRACT,
+          OP_IFF,
+          OP_ITE,
+          OP_LAND,
+          OP_LNOT,
+          OP_LOR,
+          OP_SX,
+          OP_ZX,
+        };
+
+        //! A register of the bytecode.
+        struct Operand {
+          //! The index of the register in its file.
+          triton::uint32 index;
+
+          //! True if the register is in the 512-bit file, false if it is in the 64-bit file.
+          bool wide;
+        };
+
+        //! An instruction of the bytecode.
+        struct Instruction {
+          //! The operation.
+          opcode_e opcode;
+
+          //! True if the operation must be performed on 512-bit integers.
+          bool wide;
+
+          //! The size of the operands (the size of the result for the extensions and the concatenation).
+          triton::uint32 size;
+
+          //! The immediate of the operation (the low bit of an extraction or the rotation).
+          triton::uint32 imm;
+
+          //! The index of the first operand in `operands`.
+          triton::uint32 first;
+
+          //! The number of operands.
+          triton::uint32 count;
+
+          //! The destination register.
+          Operand dst;
+        };
+
+        //! The instructions in execution order.
+        std::vector<Instruction> code;
+
+        //! The operands of the instructions.
+        std::vector<Operand> operands;
+
+        //! The sizes of the operands of the instructions.
+        std::vector<triton::uint32> operandSizes;
+
+        //! The 64-bit registers. Constants are loaded at compile time.
+        std::vector<triton::uint64> narrow;
+
+        //! The 512-bit registers. Constants are loaded at compile time.
+        std::vector<triton::uint512> wide;
+
+        //! The variables of the AST, sorted by id.
+        std::vector<triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+        //! The registers of the variables, in the order of `variables`.
+        std::vector<Operand> inputs;
+
+        //! The lanes of the 64-bit registers during a batch evaluation. **item**: register * BATCH_LANES + lane
+        std::vector<triton::uint64> narrowLanes;
+
+        //! The lanes of the 512-bit registers during a batch evaluation. **item**: register * BATCH_LANES + lane
+        std::vector<triton::uint512> wideLanes;
+
+        //! The register of the root node.
+        Operand result;
+
+        //! The size of the root node.
+        triton::uint32 size;
+
+        //! Allocates a register for a node of `size` bits.
+        Operand allocate(triton::uint32 size);
+
+        //! Returns the children of a node which are compiled as operands.
+        static std::vector<AbstractNode*> getOperandNodes(AbstractNode* node);
+
+        //! Emits the instruction of a node whose operands are already compiled.
+        void emit(AbstractNode* node, const std::vector<AbstractNode*>& args, const std::vector<Operand>& regs, Operand dst);
+
+        //! Executes an instruction on `T` integers. `load(i)` returns the value of the i-th operand.
+        template <typename T, typename Load>
+        T execute(const Instruction& ins, const Load& load) const;
+
+        //! Executes an instruction on the first `count` lanes of the registers.
+        void executeLanes(const Instruction& ins, triton::uint32 count);
+
+      public:
+        //! The number of assignments evaluated together by `evaluateBatch()`.
+        static const triton::uint32 BATCH_LANES = 64;
+
+        //! Constructor. Compiles the AST.
+        TRITON_EXPORT AstBytecode(const SharedAbstractNode& node);
+
+        //! Returns the variables of the AST, in the order expected by `evaluate()`.
+        TRITON_EXPORT const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& getVariables(void) const;
+
+        //! Returns the size of the root node.
+        TRITON_EXPORT triton::uint32 getBitvectorSize(void) const;
+
+        //! Returns the number of instructions.
+        TRITON_EXPORT triton::usize getInstructionCount(void) const;
+
+        //! Evaluates the AST with the values of the variables given in the order of `getVariables()`.
+        TRITON_EXPORT triton::uint512 evaluate(const std::vector<triton::uint512>& values);
+
+        //! Evaluates the AST under several assignments. Each assignment gives the values of the variables in the order of `getVariables()`.
+        TRITON_EXPORT std::vector<triton::uint512> evaluateBatch(const std::vector<std::vector<triton::uint512>>& assignments);
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_ASTBYTECODE_H */
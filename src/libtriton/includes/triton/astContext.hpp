@@ -58,6 +58,18 @@ namespace triton {
         //! Map a concrete value and ast node for a variable name.
         std::map<std::string, std::pair<triton::ast::SharedAbstractNode, triton::uint512>> valueMapping;
 
+        //! Returns true if the CONSTANT_FOLDING mode is enabled and the operand is not symbolized. The builder then returns a bitvector of its value without allocating its node.
+        bool isFoldable(const SharedAbstractNode& expr) const;
+
+        //! Returns true if both operands are foldable and of the same size.
+        bool isFoldable(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) const;
+
+        //! Returns the bitvector of a folded value, masked to `size` bits.
+        SharedAbstractNode folded(const triton::uint512& value, triton::uint32 size);
+
+        //! Merges the adjacent extracts of a same node and the adjacent bitvectors of a concat. The nodes are given and returned from the most significant one.
+        TRITON_EXPORT std::vector<SharedAbstractNode> mergeConcat(const std::vector<SharedAbstractNode>& exprs);
+
       public:
         //! Constructor
         TRITON_EXPORT AstContext(triton::modes::Modes& modes);
@@ -190,6 +202,36 @@ namespace triton {
 
         //! AST C++ API - concat node builder
         template <typename T> SharedAbstractNode concat(const T& exprs) {
+          /* Constant folding: the concatenation of the operands */
+          if (this->modes.isModeEnabled(triton::modes::CONSTANT_FOLDING) && exprs.size() >= 2) {
+            triton::uint512 value = 0;
+            triton::uint32 size   = 0;
+            bool foldable         = true;
+
+            for (const auto& expr : exprs) {
+              if (!this->isFoldable(expr)) {
+                foldable = false;
+                break;
+              }
+              value = (value << expr->getBitvectorSize()) | expr->evaluate();
+              size += expr->getBitvectorSize();
+            }
+
+            if (foldable && size <= MAX_BITS_SUPPORTED)
+              return this->folded(value, size);
+          }
+
+          if (this->modes.isModeEnabled(triton::modes::AST_OPTIMIZATIONS)) {
+            std::vector<SharedAbstractNode> merged = this->mergeConcat(std::vector<SharedAbstractNode>(exprs.begin(), exprs.end()));
+            if (merged.size() == 1)
+              return merged[0];
+            SharedAbstractNode node = std::make_shared<ConcatNode>(merged, *this);
+            if (node == nullptr)
+              throw triton::exceptions::Ast("Node builders - Not enough memory");
+            node->init();
+            return node;
+          }
+
           SharedAbstractNode node = std::make_shared<ConcatNode>(exprs, *this);
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
@@ -275,6 +317,9 @@ namespace triton {
         //! Gets a variable value from its name.
         TRITON_EXPORT const triton::uint512& getVariableValue(const std::string& varName) const;
 
+        //! Forgets all variables of the context.
+        TRITON_EXPORT void clearVariables(void);
+
         //! Sets the representation mode for this astContext
         TRITON_EXPORT void setRepresentationMode(triton::uint32 mode);
 
@@ -0,0 +1,201 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_ASTSERIALIZATION_H
+#define TRITON_ASTSERIALIZATION_H
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <triton/architecture.hpp>
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    //! The version of the binary format.
+    const triton::uint32 BINARY_FORMAT_VERSION = 1;
+
+    //! The kinds of record of the binary format.
+    enum record_e {
+      END_RECORD = 0,         //!< End of the stream
+      VARIABLE_RECORD,        //!< A symbolic variable and its concrete value
+      NODE_RECORD,            //!< An AST node
+      EXPRESSION_RECORD,      //!< A symbolic expression
+      REGISTER_RECORD,        //!< A symbolic register binding
+      MEMORY_RECORD,          //!< A symbolic memory binding
+      PATH_CONSTRAINT_RECORD, //!< A path constraint
+    };
+
+    /*! \class AstWriter
+     *  \brief Writes ASTs, symbolic variables and symbolic expressions in a compact binary format.
+     *
+     * \details The output is a stream of records, each one starting with its kind (see record_e).
+     * Integers are LEB128 varints and strings are prefixed by their length. The nodes are written
+     * once each, in topological order, and are numbered in this order. A node refers to its
+     * children by the difference between its number and theirs, so the operands of a tree built
+     * locally take a single byte. A reference node is preceded by the record of its symbolic
+     * expression and a variable node by the record of its symbolic variable. The DAG is walked
+     * iteratively, references included, so the size of the output and the time to produce it are
+     * linear in the number of nodes.
+     */
+    class AstWriter {
+      private:
+        //! The output stream.
+        std::ostream& stream;
+
+        //! The AST context holding the concrete values of the variables.
+        const AstContext& ctxt;
+
+        //! The numbers of the written nodes. **item**: node -> number
+        std::unordered_map<AbstractNode*, triton::usize> indexes;
+
+        //! The ids of the written symbolic expressions.
+        std::unordered_set<triton::usize> expressions;
+
+        //! The ids of the written symbolic variables.
+        std::unordered_set<triton::usize> variables;
+
+        //! The number of written nodes.
+        triton::usize count;
+
+        //! Writes the record of a node whose operands are all written.
+        void emit(const SharedAbstractNode& node);
+
+        //! Writes the record of a symbolic expression whose AST is written.
+        void emit(const triton::engines::symbolic::SharedSymbolicExpression& expr);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT AstWriter(std::ostream& stream, const AstContext& ctxt);
+
+        //! Writes an unsigned integer as a varint.
+        TRITON_EXPORT void writeInteger(triton::uint64 value);
+
+        //! Writes a big unsigned integer as a varint.
+        TRITON_EXPORT void writeInteger(const triton::uint512& value);
+
+        //! Writes a string.
+        TRITON_EXPORT void writeString(const std::string& value);
+
+        //! Writes the reference of a written node, relative to the next node.
+        TRITON_EXPORT void writeNodeIndex(const SharedAbstractNode& node);
+
+        //! Writes the records of a node and of its operands which are not written yet.
+        TRITON_EXPORT void writeNode(const SharedAbstractNode& node);
+
+        //! Writes the records of a symbolic expression and of its AST if they are not written yet.
+        TRITON_EXPORT void writeExpression(const triton::engines::symbolic::SharedSymbolicExpression& expr);
+
+        //! Writes the record of a symbolic variable if it is not written yet.
+        TRITON_EXPORT void writeVariable(const triton::engines::symbolic::SharedSymbolicVariable& var);
+
+        //! Writes the records of a node and of its operands followed by an END_RECORD.
+        TRITON_EXPORT void writeAst(const SharedAbstractNode& node);
+    };
+
+    /*! \class AstReader
+     *  \brief Reads the records written by an AstWriter from a memory buffer.
+     *
+     * \details The buffer is only read, so it may be a file mapped in memory. Every read is bounds
+     * checked and a truncated or malformed buffer raises an exception. The kind of each record is
+     * read by the caller, which then reads the record with the matching method.
+     */
+    class AstReader {
+      private:
+        //! The buffer.
+        const triton::uint8* data;
+
+        //! The size of the buffer.
+        triton::usize size;
+
+        //! The offset of the next byte to read.
+        triton::usize offset;
+
+        //! The AST context of the built nodes.
+        AstContext& ctxt;
+
+        //! The architecture of the origin registers, or nullptr to drop them.
+        const triton::arch::Architecture* architecture;
+
+        //! The read nodes, by number.
+        std::vector<SharedAbstractNode> nodes;
+
+        //! The read symbolic expressions. **item**: id -> expression
+        std::unordered_map<triton::usize, triton::engines::symbolic::SharedSymbolicExpression> expressions;
+
+        //! The read symbolic variables. **item**: id -> variable
+        std::unordered_map<triton::usize, triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+        //! Builds a node from its kind and its children.
+        SharedAbstractNode build(triton::ast::ast_e type, const std::vector<SharedAbstractNode>& children);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT AstReader(const triton::uint8* data, triton::usize size, AstContext& ctxt, const triton::arch::Architecture* architecture=nullptr);
+
+        //! Returns true if the whole buffer is read.
+        TRITON_EXPORT bool isEnd(void) const;
+
+        //! Reads raw bytes.
+        TRITON_EXPORT void readBytes(triton::uint8* buffer, triton::usize length);
+
+        //! Reads a varint which must fit in 64 bits.
+        TRITON_EXPORT triton::uint64 readInteger(void);
+
+        //! Reads a varint which must fit in 512 bits.
+        TRITON_EXPORT triton::uint512 readBigInteger(void);
+
+        //! Reads a string.
+        TRITON_EXPORT std::string readString(void);
+
+        //! Reads the reference of a read node.
+        TRITON_EXPORT const SharedAbstractNode& readNodeIndex(void);
+
+        //! Reads the record of a node.
+        TRITON_EXPORT const SharedAbstractNode& readNode(void);
+
+        //! Reads the record of a symbolic expression.
+        TRITON_EXPORT const triton::engines::symbolic::SharedSymbolicExpression& readExpression(void);
+
+        //! Reads the record of a symbolic variable and sets its concrete value in the AST context.
+        TRITON_EXPORT const triton::engines::symbolic::SharedSymbolicVariable& readVariable(void);
+
+        //! Reads the records written by AstWriter::writeAst() and returns the node.
+        TRITON_EXPORT SharedAbstractNode readAst(void);
+
+        //! Returns a read symbolic expression.
+        TRITON_EXPORT const triton::engines::symbolic::SharedSymbolicExpression& getExpression(triton::usize id) const;
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_ASTSERIALIZATION_H */
@@ -0,0 +1,108 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_ASTSMTEXPORTER_H
+#define TRITON_ASTSMTEXPORTER_H
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    /*! \class AstSmtExporter
+     *  \brief Streams ASTs as a self-contained SMT-LIB2 script.
+     *
+     * \details The DAG of an AST is walked once, references included, without being unrolled.
+     * Each symbolic variable is declared once with `declare-fun`. Each shared subterm and the AST of
+     * each referenced symbolic expression are emitted once with `define-fun`, in topological order,
+     * and are then used by name. The other nodes are printed inline. The output is written to the
+     * stream as it is produced, so its size and the time to produce it are linear in the number of
+     * nodes of the DAG.
+     *
+     * The declarations and definitions are remembered across calls, so several constraints
+     * exported with the same exporter share them.
+     */
+    class AstSmtExporter {
+      private:
+        //! The output stream.
+        std::ostream& stream;
+
+        //! The defined subterms. **item**: node -> name
+        std::unordered_map<SharedAbstractNode, std::string> names;
+
+        //! The declared variables and the defined names.
+        std::unordered_set<std::string> symbols;
+
+        //! The number of definitions which are not the AST of a symbolic expression.
+        triton::usize count;
+
+        //! Returns the nodes which are used as operands of a node. References are followed, integer operands are not returned.
+        std::vector<SharedAbstractNode> getOperands(const SharedAbstractNode& node) const;
+
+        //! Declares the variables and defines the shared subterms of a node which are not emitted yet.
+        void prepare(const SharedAbstractNode& node);
+
+        //! Emits the definition of a node whose operands are all emitted and returns its name.
+        std::string emit(const SharedAbstractNode& node);
+
+        //! Returns the term of a leaf, the name of a variable or a bitvector literal.
+        std::string getLeaf(const SharedAbstractNode& node) const;
+
+        //! Prints a term. If `body` is true, the node itself is printed inline even if it is defined.
+        void printTerm(const SharedAbstractNode& node, bool body);
+
+        //! Prints the opening of an application, e.g. `(bvadd` or `((_ extract 7 0)`.
+        void printOperator(const SharedAbstractNode& node);
+
+        //! Prints the sort of a node.
+        void printSort(const SharedAbstractNode& node);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT AstSmtExporter(std::ostream& stream);
+
+        //! Emits the `set-logic` command.
+        TRITON_EXPORT void setLogic(const std::string& logic="QF_BV");
+
+        //! Defines a node as a named function and returns its name.
+        TRITON_EXPORT std::string define(const SharedAbstractNode& node);
+
+        //! Asserts a logical node.
+        TRITON_EXPORT void assert_(const SharedAbstractNode& node);
+
+        //! Emits the `check-sat` command.
+        TRITON_EXPORT void checkSat(void);
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_ASTSMTEXPORTER_H */
@@ -8,7 +8,9 @@
 #ifndef TRITON_CALLBACKS_H
 #define TRITON_CALLBACKS_H
 
+#include <functional>
 #include <list>
+#include <map>
 
 #include <triton/ast.hpp>
 #include <triton/callbacksEnums.hpp>
@@ -96,6 +98,12 @@ namespace triton {
         //! [c++] Callbacks for all symbolic simplifications.
         std::list<triton::callbacks::symbolicSimplificationCallback> symbolicSimplificationCallbacks;
 
+        //! The functions called before all the callbacks are removed, by id (see addFinalizer()).
+        std::map<triton::usize, std::function<void(void)>> finalizers;
+
+        //! The id of the last finalizer.
+        triton::usize lastFinalizer;
+
         //! Returns the number of callbacks recorded.
         triton::usize countCallbacks(void) const;
 
@@ -121,9 +129,15 @@ namespace triton {
         //! Adds a SYMBOLIC_SIMPLIFICATION callback.
         TRITON_EXPORT void addCallback(triton::callbacks::symbolicSimplificationCallback cb);
 
-        //! Removes all recorded callbacks.
+        //! Removes all recorded callbacks, once the finalizers are called.
         TRITON_EXPORT void removeAllCallbacks(void);
 
+        //! Adds a function called once before all the callbacks are removed, e.g. to complete the work of some callbacks. Returns its id.
+        TRITON_EXPORT triton::usize addFinalizer(const std::function<void(void)>& fn);
+
+        //! Removes a finalizer which is not called yet.
+        TRITON_EXPORT void removeFinalizer(triton::usize id);
+
         //! Deletes a GET_CONCRETE_MEMORY_VALUE callback.
         TRITON_EXPORT void removeCallback(triton::callbacks::getConcreteMemoryValueCallback cb);
 
@@ -0,0 +1,213 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_CONCRETEINTERPRETER_H
+#define TRITON_CONCRETEINTERPRETER_H
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <triton/architecture.hpp>
+#include <triton/callbacks.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/instruction.hpp>
+#include <triton/irBuilder.hpp>
+#include <triton/modes.hpp>
+#include <triton/symbolicEngine.hpp>
+#include <triton/taintEngine.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    /*! \class ConcreteInterpreter
+     *  \brief Fast-forwards the concrete state from the program counter.
+     *
+     * \details Instructions are fetched at the program counter and decoded once, the decoded
+     * instructions are cached by address and revalidated against the memory before each
+     * execution. When both the symbolic and the taint engines are disabled, the common integer
+     * instructions of x86, x86-64 and AArch64 (moves, arithmetic and logic, shifts, stack and
+     * branches) are executed natively on the concrete state without building any AST. Every other
+     * instruction, or every instruction when an engine is enabled, goes through the IR builder
+     * so the resulting state is the one `processing()` would have produced.
+     *
+     * With the ONLY_ON_SYMBOLIZED mode, the symbolic engine would build and then discard the
+     * expressions of every instruction which reads no symbolized register nor memory. Such an
+     * instruction is executed natively while its accesses are recorded, the recorded reads are
+     * checked against the symbolic registers and memory (and against the taint when the taint
+     * engine is enabled) and, if none of them is symbolized nor tainted, the written locations
+     * are concretized and untainted as the semantics would have done. Otherwise the execution
+     * is undone and the instruction goes through the IR builder. This first execution does not
+     * execute the callbacks, it is run again with them when it is kept, so that the callbacks see
+     * the accesses of the instruction once.
+     */
+    class ConcreteInterpreter {
+      private:
+        //! The accesses of a native execution.
+        struct Journal {
+          //! True if the accesses are recorded.
+          bool enabled;
+
+          //! True if the accesses execute the callbacks.
+          bool execCallbacks;
+
+          //! True if the condition of a conditional instruction is taken.
+          bool conditionTaken;
+
+          //! The effective addresses of the memory operands.
+          std::vector<triton::uint64> addresses;
+
+          //! The read registers.
+          std::vector<triton::arch::Register> readRegisters;
+
+          //! The loaded memory.
+          std::vector<triton::arch::MemoryAccess> loadAccess;
+
+          //! The written registers with their previous value.
+          std::vector<std::pair<triton::arch::Register, triton::uint512>> writtenRegisters;
+
+          //! The stored memory with its previous value.
+          std::vector<std::pair<triton::arch::MemoryAccess, triton::uint512>> storeAccess;
+
+          //! The registers tagged as undefined by the semantics.
+          std::vector<triton::arch::Register> undefinedRegisters;
+        };
+
+        //! Modes API
+        triton::modes::Modes& modes;
+
+        //! Architecture API
+        triton::arch::Architecture* architecture;
+
+        //! IR builder API
+        triton::arch::IrBuilder* irBuilder;
+
+        //! Symbolic engine API
+        triton::engines::symbolic::SymbolicEngine* symbolicEngine;
+
+        //! Taint engine API
+        triton::engines::taint::TaintEngine* taintEngine;
+
+        //! Callbacks API
+        triton::callbacks::Callbacks* callbacks;
+
+        //! The decoded instructions. **item**: address -> instruction
+        std::unordered_map<triton::uint64, triton::arch::Instruction> cache;
+
+        //! The number of instructions executed natively.
+        triton::usize nativeCount;
+
+        //! The number of instructions executed through the IR builder.
+        triton::usize fallbackCount;
+
+        //! The accesses of the last native execution.
+        Journal journal;
+
+        //! Returns the decoded instruction at an address.
+        const triton::arch::Instruction& fetch(triton::uint64 addr);
+
+        //! Executes an instruction on the concrete state. Returns false, without any side effect, if the instruction is not supported.
+        bool execute(const triton::arch::Instruction& inst);
+
+        //! Executes an x86 or x86-64 instruction. \sa execute().
+        bool executeX86(const triton::arch::Instruction& inst);
+
+        //! Executes an AArch64 instruction. \sa execute().
+        bool executeAArch64(const triton::arch::Instruction& inst);
+
+        //! Returns true if an operand can be handled natively.
+        bool isSupported(const triton::arch::OperandWrapper& op) const;
+
+        //! Returns the effective address of a memory operand.
+        triton::uint64 getEffectiveAddress(const triton::arch::MemoryAccess& mem);
+
+        //! Returns the value of a register.
+        triton::uint64 getRegister(const triton::arch::Register& reg);
+
+        //! Writes a register with the same partial and extended write rules as the symbolic engine.
+        void setRegister(const triton::arch::Register& reg, triton::uint64 value);
+
+        //! Returns the value of an operand. `addr` is the effective address of memory operands.
+        triton::uint64 read(const triton::arch::OperandWrapper& op, triton::uint64 addr);
+
+        //! Writes an operand. `addr` is the effective address of memory operands.
+        void write(const triton::arch::OperandWrapper& op, triton::uint64 addr, triton::uint64 value);
+
+        //! Returns the value of a memory area.
+        triton::uint64 load(triton::uint64 addr, triton::uint32 size);
+
+        //! Writes a memory area.
+        void store(triton::uint64 addr, triton::uint32 size, triton::uint64 value);
+
+        //! Returns the value of a flag.
+        bool getFlag(triton::arch::register_e flag);
+
+        //! Sets the value of a flag.
+        void setFlag(triton::arch::register_e flag, bool value);
+
+        //! Tags a flag as undefined, it keeps its value.
+        void undefineFlag(triton::arch::register_e flag);
+
+        //! Restores the locations written by the last native execution, without executing the callbacks.
+        void undo(void);
+
+        //! Executes an instruction natively while its accesses are recorded. Returns false, without any side effect, if it is not supported or if it reads a symbolized or tainted location.
+        bool executeJournaled(const triton::arch::Instruction& inst, bool execCallbacks);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT ConcreteInterpreter(triton::arch::Architecture* architecture,
+                                          triton::modes::Modes& modes,
+                                          triton::arch::IrBuilder* irBuilder,
+                                          triton::engines::symbolic::SymbolicEngine* symbolicEngine,
+                                          triton::engines::taint::TaintEngine* taintEngine,
+                                          triton::callbacks::Callbacks* callbacks=nullptr);
+
+        //! Executes the instruction at the program counter. Returns true if it has been executed natively.
+        TRITON_EXPORT bool step(void);
+
+        //! Executes a disassembled instruction natively if the ONLY_ON_SYMBOLIZED mode would discard all its expressions. Returns false, without any side effect, otherwise.
+        TRITON_EXPORT bool processConcrete(triton::arch::Instruction& inst);
+
+        //! Executes instructions until the program counter reaches `addr` or `count` instructions have been executed (0 for no limit). Returns the number of executed instructions.
+        TRITON_EXPORT triton::usize run(triton::uint64 addr, triton::usize count=0);
+
+        //! Executes instructions until `stop` returns true for the program counter or `count` instructions have been executed (0 for no limit). Returns the number of executed instructions.
+        TRITON_EXPORT triton::usize run(const std::function<bool(triton::uint64)>& stop, triton::usize count=0);
+
+        //! Returns the number of instructions executed natively, by step() or processConcrete().
+        TRITON_EXPORT triton::usize getNativeCount(void) const;
+
+        //! Returns the number of instructions executed through the IR builder.
+        TRITON_EXPORT triton::usize getFallbackCount(void) const;
+
+        //! Clears the decoded instructions.
+        TRITON_EXPORT void clearCache(void);
+    };
+
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_CONCRETEINTERPRETER_H */
@@ -0,0 +1,264 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_ELFLOADER_H
+#define TRITON_ELFLOADER_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <triton/callbacks.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/memoryAccess.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  class API;
+
+  //! The Operating System namespace
+  namespace os {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup os
+   *  @{
+   */
+
+    //! The Unix namespace
+    namespace unix {
+    /*!
+     *  \ingroup os
+     *  \addtogroup unix
+     *  @{
+     */
+
+      //! The page granularity used to lazily map segments.
+      const triton::uint64 ELF_PAGE_SIZE = 0x1000;
+
+      /*! \class ElfSegment
+          \brief A PT_LOAD segment of an ELF image. */
+      class ElfSegment {
+        public:
+          //! The virtual address of the segment (base address included).
+          triton::uint64 vaddr;
+
+          //! The size of the segment in memory.
+          triton::uint64 memsz;
+
+          //! The offset of the segment in the file.
+          triton::uint64 offset;
+
+          //! The size of the segment in the file.
+          triton::uint64 filesz;
+
+          //! The segment flags (PF_R, PF_W, PF_X).
+          triton::uint32 flags;
+      };
+
+      /*! \class ElfRelocation
+          \brief A dynamic relocation of an ELF image. */
+      class ElfRelocation {
+        public:
+          //! The address patched by the relocation (base address included).
+          triton::uint64 address;
+
+          //! The relocation type (architecture dependent).
+          triton::uint32 type;
+
+          //! The addend of the relocation.
+          triton::sint64 addend;
+
+          //! The name of the referenced symbol (empty if none).
+          std::string symbol;
+      };
+
+      /*! \class ElfLoader
+       *  \brief An ELF32/ELF64 loader for the x86, x86-64 and AArch64 architectures.
+       *
+       * \details The file is mmap'ed and its PT_LOAD segments are mapped into the
+       * concrete memory of the API. In lazy mode, a page is only copied when it is
+       * accessed for the first time (through the GET/SET_CONCRETE_MEMORY_VALUE
+       * callbacks). The pending pages are mapped before the callbacks are removed,
+       * either by mapAll(), by API::removeAllCallbacks() and API::reset() or when
+       * the loader is destroyed, so that no page reads 0. Dynamic relocations
+       * are applied at load time and imported symbols can be bound to arbitrary
+       * addresses (e.g. hooking stubs).
+       */
+      class ElfLoader {
+        private:
+          //! Reference to the API handling the concrete memory.
+          triton::API& api;
+
+          //! The mmap'ed content of the file.
+          const triton::uint8* image;
+
+          //! The size of the mmap'ed file.
+          triton::usize imageSize;
+
+          //! True if the image is an ELF64.
+          bool is64;
+
+          //! The ELF machine (e_machine).
+          triton::uint16 machine;
+
+          //! The ELF type (e_type).
+          triton::uint16 type;
+
+          //! The base address where the image is loaded.
+          triton::uint64 baseAddress;
+
+          //! The entry point (base address included).
+          triton::uint64 entryPoint;
+
+          //! True if the segments are lazily mapped.
+          bool lazy;
+
+          //! The PT_LOAD segments.
+          std::vector<triton::os::unix::ElfSegment> segments;
+
+          //! The dynamic relocations.
+          std::vector<triton::os::unix::ElfRelocation> relocations;
+
+          //! Pages already resolved (page number): copied into the concrete memory, or without segment.
+          std::set<triton::uint64> resolvedPages;
+
+          //! The first page overlapping a segment.
+          triton::uint64 firstPage;
+
+          //! The last page overlapping a segment.
+          triton::uint64 lastPage;
+
+          //! The number of pages overlapping a segment and not mapped yet.
+          triton::usize pendingPages;
+
+          //! The names of the undefined symbols referenced by relocations.
+          std::set<std::string> imports;
+
+          //! Resolved symbols (defined by the image or bound by the user). **item1**: name<br>**item2**: address
+          std::map<std::string, triton::uint64> bindings;
+
+          //! Reverse map of bindings. **item1**: address<br>**item2**: name
+          std::map<triton::uint64, std::string> stubs;
+
+          //! The callback used to lazily map pages on loads.
+          triton::callbacks::getConcreteMemoryValueCallback loadCallback;
+
+          //! The callback used to lazily map pages on stores.
+          triton::callbacks::setConcreteMemoryValueCallback storeCallback;
+
+          //! True if the callbacks are registered.
+          bool callbacksRegistered;
+
+          //! The id of the finalizer mapping the pending pages (see API::addCallbacksFinalizer()).
+          triton::usize finalizer;
+
+          //! Reads an unsigned integer of `size` bytes at a file offset.
+          triton::uint64 read(triton::uint64 offset, triton::uint32 size) const;
+
+          //! Converts a virtual address (without base) to a file offset. Returns false if not backed by the file.
+          bool vaddrToOffset(triton::uint64 vaddr, triton::uint64& offset) const;
+
+          //! Returns the size in bytes of a pointer.
+          triton::uint32 pointerSize(void) const;
+
+          //! Checks the ELF header and the architecture.
+          void parseHeader(void);
+
+          //! Parses the program headers.
+          void parseSegments(void);
+
+          //! Parses the dynamic section and its relocation tables.
+          void parseDynamic(void);
+
+          //! Parses a relocation table.
+          void parseRelocations(triton::uint64 offset, triton::uint64 size, triton::uint64 entsize, bool rela, triton::uint64 symtab, triton::uint64 syment, triton::uint64 strtab);
+
+          //! Applies a relocation if its symbol can be resolved.
+          void applyRelocation(const triton::os::unix::ElfRelocation& reloc);
+
+          //! Writes a pointer into the concrete memory.
+          void writePointer(triton::uint64 addr, triton::uint64 value);
+
+          //! Maps all pages overlapping `[addr:size]`.
+          void mapRange(triton::uint64 addr, triton::usize size);
+
+          //! Copies a page from the file into the concrete memory.
+          void mapPage(triton::uint64 page);
+
+          //! Counts the pages overlapping the segments.
+          void initPages(void);
+
+          //! Removes the callbacks and their finalizer.
+          void removeCallbacks(void);
+
+          //! Releases the file mapping and the callbacks.
+          void release(void);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT ElfLoader(triton::API& api);
+
+          //! Destructor. Maps the pages still pending.
+          TRITON_EXPORT ~ElfLoader();
+
+          //! Loads an ELF file. `base` is added to every address (useful for PIE and shared objects).
+          TRITON_EXPORT void load(const std::string& path, triton::uint64 base=0, bool lazy=true);
+
+          //! Maps every page not mapped yet into the concrete memory and removes the callbacks.
+          TRITON_EXPORT void mapAll(void);
+
+          //! Returns the base address.
+          TRITON_EXPORT triton::uint64 getBaseAddress(void) const;
+
+          //! Returns the entry point.
+          TRITON_EXPORT triton::uint64 getEntryPoint(void) const;
+
+          //! Returns the PT_LOAD segments.
+          TRITON_EXPORT const std::vector<triton::os::unix::ElfSegment>& getSegments(void) const;
+
+          //! Returns the dynamic relocations.
+          TRITON_EXPORT const std::vector<triton::os::unix::ElfRelocation>& getRelocations(void) const;
+
+          //! Returns the names of the imported symbols (undefined symbols referenced by relocations).
+          TRITON_EXPORT const std::set<std::string>& getImportedSymbols(void) const;
+
+          //! Binds an imported symbol to an address and patches every relocation referencing it.
+          TRITON_EXPORT void bindImport(const std::string& name, triton::uint64 addr);
+
+          //! Binds every imported symbol to a unique stub address starting at `stubBase` (one stub every `stubSize` bytes).
+          TRITON_EXPORT void bindImports(triton::uint64 stubBase, triton::uint64 stubSize=1);
+
+          //! Returns the bound imported symbols. **item1**: address<br>**item2**: name
+          TRITON_EXPORT const std::map<triton::uint64, std::string>& getImportStubs(void) const;
+
+          //! Returns true if `addr` is the address of a bound imported symbol.
+          TRITON_EXPORT bool isImportStub(triton::uint64 addr) const;
+
+          //! Returns the name of the imported symbol bound to `addr`.
+          TRITON_EXPORT const std::string& getImportName(triton::uint64 addr) const;
+      };
+
+    /*! @} End of unix namespace */
+    };
+  /*! @} End of os namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* __unix__ || __APPLE__ */
+#endif /* TRITON_ELFLOADER_H */
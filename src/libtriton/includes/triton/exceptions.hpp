@@ -312,6 +312,18 @@ namespace triton {
     };
 
 
+    /*! \class ConcreteInterpreter
+     *  \brief The exception class used by the concrete interpreter. */
+    class ConcreteInterpreter : public triton::exceptions::Architecture {
+      public:
+        //! Constructor.
+        TRITON_EXPORT ConcreteInterpreter(const char* message) : triton::exceptions::Architecture(message) {};
+
+        //! Constructor.
+        TRITON_EXPORT ConcreteInterpreter(const std::string& message) : triton::exceptions::Architecture(message) {};
+    };
+
+
     /*! \class Disassembly
      *  \brief The exception class used by the disassembler. */
     class Disassembly : public triton::exceptions::Cpu {
@@ -384,6 +396,18 @@ namespace triton {
     };
 
 
+    /*! \class Os
+     *  \brief The exception class used by the operating system models (loaders, syscalls, ...). */
+    class Os : public triton::exceptions::Exception {
+      public:
+        //! Constructor.
+        TRITON_EXPORT Os(const char* message) : triton::exceptions::Exception(message) {};
+
+        //! Constructor.
+        TRITON_EXPORT Os(const std::string& message) : triton::exceptions::Exception(message) {};
+    };
+
+
     /*! \class Callbacks
      *  \brief The exception class used by callbacks. */
     class Callbacks : public triton::exceptions::Exception {
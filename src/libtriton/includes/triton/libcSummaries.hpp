@@ -0,0 +1,205 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_LIBCSUMMARIES_H
+#define TRITON_LIBCSUMMARIES_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/elfLoader.hpp>
+#include <triton/register.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  class API;
+
+  //! The Operating System namespace
+  namespace os {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup os
+   *  @{
+   */
+
+    //! The Unix namespace
+    namespace unix {
+    /*!
+     *  \ingroup os
+     *  \addtogroup unix
+     *  @{
+     */
+
+      //! The default base address of the heap used by malloc().
+      const triton::uint64 LIBC_HEAP_BASE = 0x7fe000000000;
+
+      //! The maximum length of the strings scanned by the summaries.
+      const triton::uint64 LIBC_MAX_STRING_LENGTH = 0x10000;
+
+      //! The supported libc routines.
+      enum libc_e {
+        LIBC_INVALID = 0, //!< Invalid routine
+        LIBC_CALLOC,      //!< calloc
+        LIBC_FREE,        //!< free
+        LIBC_MALLOC,      //!< malloc
+        LIBC_MEMCPY,      //!< memcpy
+        LIBC_MEMMOVE,     //!< memmove
+        LIBC_MEMSET,      //!< memset
+        LIBC_PRINTF,      //!< printf
+        LIBC_PUTCHAR,     //!< putchar
+        LIBC_PUTS,        //!< puts
+        LIBC_STRCMP,      //!< strcmp
+        LIBC_STRLEN,      //!< strlen
+      };
+
+      /*! \class LibcSummaries
+       *  \brief Native summaries of common libc routines for the x86-64 and AArch64 ABIs.
+       *
+       * \details Routines are bound to addresses (e.g. the import stubs of an ElfLoader). When the
+       * program counter reaches a bound address, emulate() performs the whole routine in bulk on
+       * the concrete memory, propagates the symbolic and taint states of the bytes it touches,
+       * sets the return register and returns to the caller. Results depending on symbolic bytes
+       * are expressed compactly: strlen() and strcmp() return an `ite` chain with one level per
+       * symbolic byte of the scanned strings.
+       */
+      class LibcSummaries {
+        private:
+          //! Reference to the API handling the concrete and symbolic states.
+          triton::API& api;
+
+          //! The bound routines. **item1**: address<br>**item2**: routine
+          std::map<triton::uint64, triton::os::unix::libc_e> bindings;
+
+          //! The live allocations. **item1**: address<br>**item2**: size
+          std::map<triton::uint64, triton::uint64> allocations;
+
+          //! The next address returned by malloc().
+          triton::uint64 heapCurrent;
+
+          //! The characters written by printf(), puts() and putchar().
+          std::string output;
+
+          //! Returns true if the symbolic engine must be used.
+          bool isSymbolic(void) const;
+
+          //! Returns the register of the `index`th integer argument.
+          const triton::arch::Register& getArgumentRegister(triton::uint32 index) const;
+
+          //! Returns the concrete value of the `index`th integer argument (registers, then stack).
+          triton::uint64 getArgument(triton::uint32 index) const;
+
+          //! Returns the concrete length of the string at `addr`.
+          triton::uint64 getStringLength(triton::uint64 addr) const;
+
+          //! Reads a string from the concrete memory.
+          std::string getString(triton::uint64 addr) const;
+
+          //! Returns the AST of a memory byte.
+          triton::ast::SharedAbstractNode getByteAst(triton::uint64 addr);
+
+          //! Sets the return value and returns to the caller. `node` is used if not null.
+          void setReturn(triton::uint64 value, const triton::ast::SharedAbstractNode& node, const std::string& comment);
+
+          //! Copies `size` bytes with their symbolic and taint states (memmove semantics).
+          void copy(triton::uint64 dst, triton::uint64 src, triton::uint64 size);
+
+          //! Formats a printf string. `arg` is the index of the first variadic argument.
+          std::string format(triton::uint64 fmt, triton::uint32 arg) const;
+
+          //! Allocates a chunk on the heap.
+          triton::uint64 allocate(triton::uint64 size);
+
+          //! The calloc summary.
+          void libcCalloc(void);
+
+          //! The free summary.
+          void libcFree(void);
+
+          //! The malloc summary.
+          void libcMalloc(void);
+
+          //! The memcpy and memmove summary.
+          void libcMemcpy(void);
+
+          //! The memset summary.
+          void libcMemset(void);
+
+          //! The printf summary.
+          void libcPrintf(void);
+
+          //! The putchar summary.
+          void libcPutchar(void);
+
+          //! The puts summary.
+          void libcPuts(void);
+
+          //! The strcmp summary.
+          void libcStrcmp(void);
+
+          //! The strlen summary.
+          void libcStrlen(void);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT LibcSummaries(triton::API& api);
+
+          //! Returns the routine corresponding to a symbol name (LIBC_INVALID if not supported).
+          TRITON_EXPORT static triton::os::unix::libc_e getRoutine(const std::string& name);
+
+          //! Returns the symbol name of a routine.
+          TRITON_EXPORT static std::string getRoutineName(triton::os::unix::libc_e routine);
+
+          //! Binds a routine to an address.
+          TRITON_EXPORT void bind(triton::uint64 addr, triton::os::unix::libc_e routine);
+
+          //! Binds a routine to an address by name. Throws if the routine is not supported.
+          TRITON_EXPORT void bind(triton::uint64 addr, const std::string& name);
+
+          //! Binds every supported import stub of a loader. Returns the number of bound routines.
+          TRITON_EXPORT triton::usize bindImports(const triton::os::unix::ElfLoader& loader);
+
+          //! Unbinds an address.
+          TRITON_EXPORT void unbind(triton::uint64 addr);
+
+          //! Returns true if a routine is bound to `addr`.
+          TRITON_EXPORT bool isBound(triton::uint64 addr) const;
+
+          //! Returns the bound routines. **item1**: address<br>**item2**: routine
+          TRITON_EXPORT const std::map<triton::uint64, triton::os::unix::libc_e>& getBindings(void) const;
+
+          //! Sets the base address of the heap used by malloc().
+          TRITON_EXPORT void setHeapBase(triton::uint64 addr);
+
+          //! Returns the characters written by printf(), puts() and putchar().
+          TRITON_EXPORT const std::string& getOutput(void) const;
+
+          //! If the program counter is on a bound routine, performs it and returns to the caller. Returns false otherwise.
+          TRITON_EXPORT bool emulate(void);
+      };
+
+    /*! @} End of unix namespace */
+    };
+  /*! @} End of os namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* __unix__ || __APPLE__ */
+#endif /* TRITON_LIBCSUMMARIES_H */
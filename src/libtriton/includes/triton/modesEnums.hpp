@@ -29,10 +29,14 @@ namespace triton {
     enum mode_e {
       ALIGNED_MEMORY,                 //!< [symbolic] Keep a map of aligned memory.
       AST_OPTIMIZATIONS,              //!< [AST] Classical arithmetic optimisations to reduce the depth of the trees.
+      BULK_REP_STRINGS,               //!< [semantics] Perform every iteration of a REP MOVS/STOS at once if the counter is concrete.
       CONCRETIZE_UNDEFINED_REGISTERS, //!< [symbolic] Concretize every registers tagged as undefined (see #750).
+      CONSTANT_FOLDING,               //!< [AST] Fold every bitvector node without symbolized children into a single bitvector.
       ONLY_ON_SYMBOLIZED,             //!< [symbolic] Perform symbolic execution only on symbolized expressions.
       ONLY_ON_TAINTED,                //!< [symbolic] Perform symbolic execution only on tainted instructions.
+      PC_DEDUPLICATION,               //!< [symbolic] Skip a path constraint if the same branch is already recorded with the same constraint.
       PC_TRACKING_SYMBOLIC,           //!< [symbolic] Track path constraints only if they are symbolized.
+      PRESOLVING,                     //!< [solver] Decide the trivial constraints without the solver (see triton::engines::solver::PreSolver).
       SYMBOLIZE_INDEX_ROTATION,       //!< [symbolic] Symbolize index rotation for bvrol and bvror (see #751). This mode increases the complexity of solving.
       TAINT_THROUGH_POINTERS,         //!< [taint] Spread the taint if an index pointer is already tainted (see #725).
     };
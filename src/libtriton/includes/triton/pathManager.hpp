@@ -8,6 +8,7 @@
 #ifndef TRITON_PATHMANAGER_H
 #define TRITON_PATHMANAGER_H
 
+#include <unordered_map>
 #include <vector>
 
 #include <triton/dllexport.hpp>
@@ -56,6 +57,39 @@ namespace triton {
           //! \brief The logical conjunction vector of path constraints.
           std::vector<triton::engines::symbolic::PathConstraint> pathConstraints;
 
+          //! \brief The prefix conjunctions. `pathPrefixes[i]` is the land of `pathPrefixes[i - 1]` and of the `i + 1`th taken constraint, so the prefixes share their nodes.
+          std::vector<triton::ast::SharedAbstractNode> pathPrefixes;
+
+          //! \brief The recorded path constraints by key (see getPathConstraintKey()), for the PC_DEDUPLICATION mode.
+          std::unordered_map<triton::uint64, std::vector<triton::engines::symbolic::PathConstraint>> pathKeys;
+
+          //! \brief The compression policies by branch address: the number of first and of last instances kept.
+          std::unordered_map<triton::uint64, std::pair<triton::usize, triton::usize>> compressions;
+
+          //! \brief The number of recorded path constraints by branch address with a compression policy.
+          std::unordered_map<triton::uint64, triton::usize> compressedCounts;
+
+          //! Returns the top of the lattice `(= true true)`.
+          triton::ast::SharedAbstractNode getTopPathConstraintAst(void) const;
+
+          //! Returns the key of a path constraint: its branch address, its taken address and the structural hash of its taken AST.
+          triton::uint64 getPathConstraintKey(const triton::engines::symbolic::PathConstraint& pco) const;
+
+          //! Returns true if the branch of a path constraint is already recorded with a structurally identical constraint.
+          bool isRecordedPathConstraint(const triton::engines::symbolic::PathConstraint& pco) const;
+
+          //! Appends a path constraint and extends the prefix conjunctions.
+          void pushPathConstraint(const triton::engines::symbolic::PathConstraint& pco);
+
+          //! Removes the path constraint at `index` and rebuilds the prefix conjunctions which follow it.
+          void erasePathConstraint(triton::usize index);
+
+          //! Keeps the `size` first prefix conjunctions.
+          void truncatePathPrefixes(triton::usize size);
+
+          //! Applies the compression policy of the branch of the last path constraint.
+          void compressPathConstraints(void);
+
         public:
           //! Constructor.
           TRITON_EXPORT PathManager(triton::modes::Modes& modes, triton::ast::AstContext& astCtxt);
@@ -63,15 +97,24 @@ namespace triton {
           //! Constructor by copy.
           TRITON_EXPORT PathManager(const PathManager& other);
 
+          //! Destructor.
+          TRITON_EXPORT ~PathManager();
+
           //! Copies a PathManager.
           TRITON_EXPORT PathManager& operator=(const PathManager& other);
 
           //! Returns the logical conjunction vector of path constraints.
           TRITON_EXPORT const std::vector<triton::engines::symbolic::PathConstraint>& getPathConstraints(void) const;
 
-          //! Returns the logical conjunction AST of path constraints.
+          //! Returns the logical conjunction AST of path constraints in O(1). It is a chain of land nodes, flattened by the solver engine.
           TRITON_EXPORT triton::ast::SharedAbstractNode getPathConstraintsAst(void) const;
 
+          //! Returns the logical conjunction AST of the `index` first path constraints in O(1). The prefixes share their nodes.
+          TRITON_EXPORT triton::ast::SharedAbstractNode getPrefixPathConstraintsAst(triton::usize index) const;
+
+          //! Returns the conjunction of the `index` first path constraints and of the negation of the `index`th one in O(1).
+          TRITON_EXPORT triton::ast::SharedAbstractNode getNegatedPathConstraintsAst(triton::usize index) const;
+
           //! Returns the number of constraints.
           TRITON_EXPORT triton::usize getNumberOfPathConstraints(void) const;
 
@@ -80,6 +123,17 @@ namespace triton {
 
           //! Clears the logical conjunction vector of path constraints.
           TRITON_EXPORT void clearPathConstraints(void);
+
+          //! Keeps only the `first` and the `last` path constraints of the branch at `addr`, so that a loop does not grow the path constraints with its trip count.
+          /*!
+           * \details The instances between them are removed as new ones are added. The path
+           * constraints are then an over-approximation of the path, and a model may follow
+           * another number of iterations.
+           */
+          TRITON_EXPORT void setPathConstraintsCompression(triton::uint64 addr, triton::usize first, triton::usize last);
+
+          //! Removes the compression policy of the branch at `addr`. The path constraints already removed are lost.
+          TRITON_EXPORT void removePathConstraintsCompression(triton::uint64 addr);
       };
 
     /*! @} End of symbolic namespace */
@@ -0,0 +1,75 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_PRESOLVER_H
+#define TRITON_PRESOLVER_H
+
+#include <list>
+#include <map>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class PreSolver
+      /*! \brief Solves the trivial constraints without a solver.
+       *
+       * \details The pre-solver decides the conjunctions of comparisons between a constant and a
+       * chain of invertible operations over a single symbolic variable, like
+       * `(= (bvxor (bvadd ((_ extract 7 0) SymVar_0) 0x10) 0x55) 0x41)` or `(bvult SymVar_1 0x20)`.
+       * Each comparison becomes a set of intervals on a slice of a variable, by inverting `bvadd`,
+       * `bvsub`, `bvneg`, `bvnot`, `zx`, `sx` and the constant parts of `concat`, and, for a small
+       * set of values, `bvxor` and `bvmul` by an odd constant. The flags of the form
+       * `(ite cond 1 0)` are looked through. The sets of a slice are intersected and a model picks
+       * the concrete value of a variable when it is allowed.
+       *
+       * The pre-solver is complete on this fragment. Anything else is left to the solver, except
+       * a conjunction which has an unsatisfiable member.
+       */
+      class PreSolver {
+        public:
+          //! Solves a constraint if it is trivial.
+          /*!
+           * \details Returns false if the constraint is out of reach. Otherwise sets `status` to
+           * SAT or UNSAT and `models` to at most `limit` distinct models.
+           */
+          TRITON_EXPORT bool solve(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::list<std::map<triton::uint32, SolverModel>>& models, status_e& status) const;
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_PRESOLVER_H */
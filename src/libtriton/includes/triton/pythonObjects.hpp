@@ -11,15 +11,19 @@
 
 #include <triton/pythonBindings.hpp>
 #include <triton/ast.hpp>
+#include <triton/astBytecode.hpp>
 #include <triton/bitsVector.hpp>
+#include <triton/elfLoader.hpp>
 #include <triton/immediate.hpp>
 #include <triton/instruction.hpp>
+#include <triton/libcSummaries.hpp>
 #include <triton/memoryAccess.hpp>
 #include <triton/pathConstraint.hpp>
 #include <triton/register.hpp>
 #include <triton/solverModel.hpp>
 #include <triton/symbolicExpression.hpp>
 #include <triton/symbolicVariable.hpp>
+#include <triton/syscallEmulator.hpp>
 #include <triton/snapshotEngine.hpp>
 
 
@@ -48,12 +52,20 @@ namespace triton {
      *  @{
      */
 
+      //! Creates the AstBytecode python class. The bytecode is owned by the python object.
+      PyObject* PyAstBytecode(triton::ast::AstBytecode* bytecode);
+
       //! Creates the AstNode python class.
       PyObject* PyAstNode(const triton::ast::SharedAbstractNode& node);
 
       //! Creates the BitsVector python class.
       template <typename T> PyObject* PyBitsVector(const T& op);
 
+      #if defined(__unix__) || defined(__APPLE__)
+      //! Creates the ElfLoader python class. The loader is owned by the python object which keeps a reference on `context`.
+      PyObject* PyElfLoader(PyObject* context, triton::os::unix::ElfLoader* loader);
+      #endif
+
       //! Creates the Immediate python class.
       PyObject* PyImmediate(const triton::arch::Immediate& imm);
 
@@ -66,6 +78,11 @@ namespace triton {
       //! Creates the Instruction python class.
       PyObject* PyInstruction(const triton::uint8* opcodes, triton::uint32 opSize);
 
+      #if defined(__unix__) || defined(__APPLE__)
+      //! Creates the LibcSummaries python class. The summaries are owned by the python object which keeps a reference on `context`.
+      PyObject* PyLibcSummaries(PyObject* context, triton::os::unix::LibcSummaries* summaries);
+      #endif
+
       //! Creates the Memory python class.
       PyObject* PyMemoryAccess(const triton::arch::MemoryAccess& mem);
 
@@ -93,9 +110,25 @@ namespace triton {
       //! Creates the SymbolicVariable python class.
       PyObject* PySymbolicVariable(const triton::engines::symbolic::SharedSymbolicVariable& symVar);
 
+      #if defined(__unix__) || defined(__APPLE__)
+      //! Creates the SyscallEmulator python class. The emulator is owned by the python object which keeps a reference on `context`.
+      PyObject* PySyscallEmulator(PyObject* context, triton::os::unix::SyscallEmulator* emulator);
+      #endif
+
       //! Creates the ContextSnapshot python class.
       PyObject* PyContextSnapshot(const triton::engines::snapshot::SnapshotEngine& snapshot);
 
+      /* AstBytecode ==================================================== */
+
+      //! pyAstBytecode object.
+      typedef struct {
+        PyObject_HEAD
+        triton::ast::AstBytecode* bytecode; //! Pointer to the cpp bytecode
+      } AstBytecode_Object;
+
+      //! pyAstBytecode type.
+      extern PyTypeObject AstBytecode_Type;
+
       /* AstNode ======================================================== */
 
       //! pyAstNode object.
@@ -240,6 +273,44 @@ namespace triton {
 
       extern PyTypeObject ContextSnapshot_Type;
 
+      #if defined(__unix__) || defined(__APPLE__)
+      /* ElfLoader ====================================================== */
+
+      //! pyElfLoader object.
+      typedef struct {
+        PyObject_HEAD
+        triton::os::unix::ElfLoader* loader; //! Pointer to the cpp ELF loader
+        PyObject* context;                   //! The TritonContext owning the memory the loader maps into
+      } ElfLoader_Object;
+
+      //! pyElfLoader type.
+      extern PyTypeObject ElfLoader_Type;
+
+      /* LibcSummaries ================================================== */
+
+      //! pyLibcSummaries object.
+      typedef struct {
+        PyObject_HEAD
+        triton::os::unix::LibcSummaries* summaries; //! Pointer to the cpp libc summaries
+        PyObject* context;                          //! The TritonContext the summaries work on
+      } LibcSummaries_Object;
+
+      //! pyLibcSummaries type.
+      extern PyTypeObject LibcSummaries_Type;
+
+      /* SyscallEmulator ================================================ */
+
+      //! pySyscallEmulator object.
+      typedef struct {
+        PyObject_HEAD
+        triton::os::unix::SyscallEmulator* emulator; //! Pointer to the cpp syscall emulator
+        PyObject* context;                           //! The TritonContext the emulator works on
+      } SyscallEmulator_Object;
+
+      //! pySyscallEmulator type.
+      extern PyTypeObject SyscallEmulator_Type;
+      #endif
+
     /*! @} End of python namespace */
     };
   /*! @} End of bindings namespace */
@@ -248,6 +319,12 @@ namespace triton {
 };
 
 
+/*! Checks if the pyObject is a triton::ast::AstBytecode. */
+#define PyAstBytecode_Check(v) ((v)->ob_type == &triton::bindings::python::AstBytecode_Type)
+
+/*! Returns the triton::ast::AstBytecode. */
+#define PyAstBytecode_AsAstBytecode(v) (((triton::bindings::python::AstBytecode_Object*)(v))->bytecode)
+
 /*! Returns the triton::ast::SharedAbstractNode. */
 #define PyAstNode_AsAstNode(v) (((triton::bindings::python::AstNode_Object*)(v))->node)
 
@@ -311,6 +388,24 @@ namespace triton {
 /*! Returns the triton::engines::snapshot::SnapshotEngine. */
 #define PyContextSnapshot_AsSnapshotEngine(v) (((triton::bindings::python::ContextSnapshot_Object*)(v))->snapshot)
 
+/*! Checks if the pyObject is a triton::os::unix::ElfLoader. */
+#define PyElfLoader_Check(v) ((v)->ob_type == &triton::bindings::python::ElfLoader_Type)
+
+/*! Returns the triton::os::unix::ElfLoader. */
+#define PyElfLoader_AsElfLoader(v) (((triton::bindings::python::ElfLoader_Object*)(v))->loader)
+
+/*! Checks if the pyObject is a triton::os::unix::LibcSummaries. */
+#define PyLibcSummaries_Check(v) ((v)->ob_type == &triton::bindings::python::LibcSummaries_Type)
+
+/*! Returns the triton::os::unix::LibcSummaries. */
+#define PyLibcSummaries_AsLibcSummaries(v) (((triton::bindings::python::LibcSummaries_Object*)(v))->summaries)
+
+/*! Checks if the pyObject is a triton::os::unix::SyscallEmulator. */
+#define PySyscallEmulator_Check(v) ((v)->ob_type == &triton::bindings::python::SyscallEmulator_Type)
+
+/*! Returns the triton::os::unix::SyscallEmulator. */
+#define PySyscallEmulator_AsSyscallEmulator(v) (((triton::bindings::python::SyscallEmulator_Object*)(v))->emulator)
+
 /*! Checks if the pyObject is a triton::ast::AbstractNode. */
 #define PyAstNode_Check(v) ((v)->ob_type == &triton::bindings::python::AstNode_Type)
 
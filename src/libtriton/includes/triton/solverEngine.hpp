@@ -8,16 +8,26 @@
 #ifndef TRITON_SOLVERENGINE_HPP
 #define TRITON_SOLVERENGINE_HPP
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <triton/ast.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/modes.hpp>
+#include <triton/preSolver.hpp>
 #include <triton/solverEnums.hpp>
 #include <triton/solverInterface.hpp>
 #include <triton/solverModel.hpp>
+#include <triton/solverPool.hpp>
+#include <triton/symbolicVariable.hpp>
 #include <triton/tritonTypes.hpp>
 #ifdef Z3_INTERFACE
   #include <triton/z3Solver.hpp>
@@ -47,8 +57,97 @@ namespace triton {
      */
 
       /*! \interface SolverEngine
-          \brief This class is used to interface with solvers */
+          \brief This class is used to interface with solvers
+
+          \details The queries are solved synchronously by getModel(), getModels() and isSat(), or in
+          the background by submitQuery(). The background queries are solved one at a time, in the order
+          of their submission, by a thread of the engine. Each one works on its own copy of the constraint
+          so the caller can go on building ASTs meanwhile. The ticket returned by submitQuery() is given
+          to pollQuery(), waitQuery() and cancelQuery().
+
+          When the triton::modes::PRESOLVING mode is enabled, the trivial constraints are decided by
+          the PreSolver and only the others reach the solver.
+
+          With setSolverPool(), the queries of getModel(), getModels() and isSat() are solved by a
+          SolverPool of worker processes running their own instance of the solver, so a query which
+          hangs or exhausts the memory only costs a worker. The submitted queries are then solved by
+          the pool instead of the thread, so that no worker is forked while the thread runs. */
       class SolverEngine {
+        private:
+          //! A query submitted to the background thread.
+          struct Query;
+
+          //! Reference to the modes.
+          const triton::modes::Modes& modes;
+
+          //! The pre-solver of the trivial constraints.
+          PreSolver preSolver;
+
+          //! The default time limit of a query in milliseconds, 0 for no limit.
+          triton::uint32 timeout;
+
+          //! The resource limit of a query, 0 for no limit.
+          triton::uint32 resourceLimit;
+
+          //! The memory limit of the solver in megabytes, 0 for no limit.
+          triton::uint32 memoryLimit;
+
+          //! Protects the queries.
+          mutable std::mutex mutex;
+
+          //! Signals the end of a query or the submission of a new one.
+          std::condition_variable cond;
+
+          //! The thread solving the submitted queries.
+          std::thread worker;
+
+          //! True if the thread must stop.
+          bool stopping;
+
+          //! The submitted queries. **item**: ticket -> query
+          std::unordered_map<triton::usize, std::shared_ptr<Query>> queries;
+
+          //! The tickets of the queries waiting for the thread.
+          std::deque<triton::usize> pending;
+
+          //! The last ticket delivered.
+          triton::usize lastTicket;
+
+          //! Solves the submitted queries. Runs in the thread.
+          void run(void);
+
+          //! Cancels the submitted queries and stops the thread.
+          void stopQueries(void);
+
+          //! The number of workers of the solver pool, 0 if the queries are solved in the process.
+          triton::usize poolWorkers;
+
+          //! The time limit after which a worker of the pool is killed, for the queries without time limit.
+          triton::uint32 poolTimeout;
+
+          //! The number of queries served by a worker of the pool before it is replaced, 0 for no limit.
+          triton::usize poolMaxQueries;
+
+          //! The number of threads waiting for a query of the pool.
+          triton::usize poolWaiters;
+
+          #if defined(__unix__) || defined(__APPLE__)
+          //! The pool of worker processes, if any.
+          std::unique_ptr<triton::engines::solver::SolverPool> pool;
+          #endif
+
+          //! Allocates a new instance of a predefined solver with the limits of the engine.
+          triton::engines::solver::SolverInterface* createSolver(triton::engines::solver::solver_e kind) const;
+
+          //! Creates the pool of worker processes with a new instance of the current solver, or removes it if it has no worker.
+          void initPool(void);
+
+          //! Returns the solver of the queries: the pool if any, the solver otherwise.
+          const triton::engines::solver::SolverInterface* getQuerySolver(void) const;
+
+          //! Decides a query with the pre-solver if the PRESOLVING mode is enabled. Returns false if the query is left to the solver.
+          bool preSolve(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::list<std::map<triton::uint32, SolverModel>>& models, triton::engines::solver::status_e* status) const;
+
         protected:
           //! The kind of the current solver used.
           triton::engines::solver::solver_e kind;
@@ -58,7 +157,10 @@ namespace triton {
 
         public:
           //! Constructor.
-          TRITON_EXPORT SolverEngine();
+          TRITON_EXPORT SolverEngine(const triton::modes::Modes& modes);
+
+          //! Destructor. Cancels the submitted queries.
+          TRITON_EXPORT ~SolverEngine();
 
           //! Returns the kind of solver as triton::engines::solver::solver_e.
           TRITON_EXPORT triton::engines::solver::solver_e getSolver(void) const;
@@ -66,23 +168,38 @@ namespace triton {
           //! Returns the instance of the initialized solver
           TRITON_EXPORT const triton::engines::solver::SolverInterface* getSolverInstance(void) const;
 
-          //! Initializes a predefined solver.
+          //! Initializes a predefined solver. The submitted queries are cancelled.
           TRITON_EXPORT void setSolver(triton::engines::solver::solver_e kind);
 
-          //! Initializes a custom solver.
+          //! Initializes a custom solver and removes the solver pool. The submitted queries are cancelled.
           TRITON_EXPORT void setCustomSolver(triton::engines::solver::SolverInterface* customSolver);
 
           //! Returns true if the solver is valid.
           TRITON_EXPORT bool isValid(void) const;
 
-          //! Computes and returns a model from a symbolic constraint.
+          //! Solves the queries in a pool of `workers` processes, or in the process if `workers` is 0. A worker is killed after `timeout` milliseconds on a query without time limit (0 for no limit) and replaced after `maxQueries` queries (0 for no limit). Only the predefined solvers can be pooled. The submitted queries are cancelled.
+          TRITON_EXPORT void setSolverPool(triton::usize workers, triton::uint32 timeout=0, triton::usize maxQueries=0);
+
+          //! Returns the pids of the workers of the solver pool, 0 for a worker not started.
+          TRITON_EXPORT std::vector<triton::uint32> getSolverPoolWorkers(void) const;
+
+          //! Sets the default time limit of a query in milliseconds, 0 for no limit.
+          TRITON_EXPORT void setTimeout(triton::uint32 ms);
+
+          //! Sets the resource limit of a query, 0 for no limit. Only applies to z3 (rlimit).
+          TRITON_EXPORT void setResourceLimit(triton::uint32 rlimit);
+
+          //! Sets the memory limit of the solver in megabytes, 0 for no limit. Only applies to z3.
+          TRITON_EXPORT void setMemoryLimit(triton::uint32 mb);
+
+          //! Computes and returns a model from a symbolic constraint. The `timeout` in milliseconds overrides the default one.
           /*! \brief map of symbolic variable id -> model
            *
            * \details
            * **item1**: symbolic variable id<br>
            * **item2**: model
            */
-          TRITON_EXPORT std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node) const;
+          TRITON_EXPORT std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
 
           //! Computes and returns several models from a symbolic constraint. The `limit` is the max number of models returned.
           /*! \brief list of map of symbolic variable id -> model
@@ -91,10 +208,26 @@ namespace triton {
            * **item1**: symbolic variable id<br>
            * **item2**: model
            */
-          TRITON_EXPORT std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit) const;
+          TRITON_EXPORT std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
 
           //! Returns true if an expression is satisfiable.
-          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node) const;
+          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Enumerates the models of a symbolic constraint, distinct on the variables of `projection`, and gives them to `callback` as they are found. See Z3Solver::enumerateModels(). The other solvers compute the list of models first.
+          TRITON_EXPORT void enumerateModels(const triton::ast::SharedAbstractNode& node, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& projection, const ModelCallback& callback,
+                                             triton::uint32 limit=0, triton::uint32 threads=1, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Submits a query to solve in the background and returns its ticket. If `limit` is 0, only the satisfiability is checked, otherwise at most `limit` models are computed.
+          TRITON_EXPORT triton::usize submitQuery(const triton::ast::SharedAbstractNode& node, triton::uint32 limit=1, triton::uint32 timeout=0);
+
+          //! Returns true if the query of a ticket is solved.
+          TRITON_EXPORT bool pollQuery(triton::usize ticket) const;
+
+          //! Waits until the query of a ticket is solved, returns its status and its models and forgets the ticket.
+          TRITON_EXPORT triton::engines::solver::status_e waitQuery(triton::usize ticket, std::list<std::map<triton::uint32, SolverModel>>* models=nullptr);
+
+          //! Cancels the query of a ticket, whose status becomes UNKNOWN. Returns false if the query was already solved.
+          TRITON_EXPORT bool cancelQuery(triton::usize ticket);
 
           //! Returns the name of the solver.
           TRITON_EXPORT std::string getName(void) const;
@@ -42,6 +42,15 @@ namespace triton {
         #endif
       };
 
+      /*! The different status of a query */
+      enum status_e {
+        UNSAT = 0,  /*!< the constraint is not satisfiable. */
+        SAT,        /*!< the constraint is satisfiable. */
+        TIMEOUT,    /*!< the time limit has been reached. */
+        OUTOFMEM,   /*!< the memory limit has been reached. */
+        UNKNOWN,    /*!< the solver could not decide. */
+      };
+
     /*! @} End of solver namespace */
     };
   /*! @} End of engines namespace */
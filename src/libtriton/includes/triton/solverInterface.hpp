@@ -13,6 +13,7 @@
 
 #include <triton/ast.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
 #include <triton/solverModel.hpp>
 #include <triton/tritonTypes.hpp>
 
@@ -40,7 +41,11 @@ namespace triton {
      */
 
       /*! \interface SolverInterface
-          \brief This interface is used to interface with solvers */
+          \brief This interface is used to interface with solvers
+
+          \details The queries take an optional `status` which receives the status_e of the query, and an
+          optional `timeout` in milliseconds, 0 for the default limit of the solver. A query which hits a
+          limit returns no model. */
       class SolverInterface {
         public:
           //! Destructor.
@@ -53,7 +58,7 @@ namespace triton {
            * **item1**: symbolic variable id<br>
            * **item2**: model
            */
-          TRITON_EXPORT virtual std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node) const = 0;
+          TRITON_EXPORT virtual std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const = 0;
 
           //! Computes and returns several models from a symbolic constraint. The `limit` is the max number of models returned.
           /*! \brief list of map of symbolic variable id -> model
@@ -62,10 +67,13 @@ namespace triton {
            * **item1**: symbolic variable id<br>
            * **item2**: model
            */
-          TRITON_EXPORT virtual std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit) const = 0;
+          TRITON_EXPORT virtual std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const = 0;
 
           //! Returns true if an expression is satisfiable.
-          TRITON_EXPORT virtual bool isSat(const triton::ast::SharedAbstractNode& node) const = 0;
+          TRITON_EXPORT virtual bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const = 0;
+
+          //! Interrupts the queries being solved, from any thread. Their status is UNKNOWN. Does nothing by default.
+          TRITON_EXPORT virtual void interrupt(void) const {};
 
           //! Returns the name of the solver.
           TRITON_EXPORT virtual std::string getName(void) const = 0;
@@ -8,6 +8,8 @@
 #ifndef TRITON_SOLVERMODEL_H
 #define TRITON_SOLVERMODEL_H
 
+#include <functional>
+#include <map>
 #include <string>
 
 #include <triton/dllexport.hpp>
@@ -74,6 +76,9 @@ namespace triton {
           TRITON_EXPORT const triton::engines::symbolic::SharedSymbolicVariable& getVariable(void) const;
       };
 
+    //! Receives the models of an enumeration one at a time, returns false to stop the enumeration. **item**: symbolic variable id -> model
+    using ModelCallback = std::function<bool(const std::map<triton::uint32, SolverModel>& model)>;
+
     //! Display a solver model.
     TRITON_EXPORT std::ostream& operator<<(std::ostream& stream, const SolverModel& model);
 
@@ -0,0 +1,253 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SOLVERPOOL_H
+#define TRITON_SOLVERPOOL_H
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverInterface.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      #if defined(__unix__) || defined(__APPLE__)
+
+      //! \class SolverPool
+      /*! \brief Solves queries in a pool of forked worker processes.
+       *
+       * \details Each worker is a child process which solves the queries with its copy of the solver
+       * given to the pool. A query is sent to a worker through a socket in the binary format of
+       * triton::ast::AstWriter and its models come back as variable ids and values. A worker which
+       * exceeds the time limit is killed and replaced, a worker which exceeds its memory limit reports
+       * it, and a worker which has served `maxQueries` queries is replaced by a fresh one. So a query
+       * which hangs or exhausts the memory only costs a worker and not the analysis.
+       *
+       * Queries are submitted with submit() and return a ticket. poll() makes the pool progress without
+       * blocking and wait() blocks until the query is solved and returns its status and its models.
+       * The methods of SolverInterface submit a query and wait for it. The pool may be used by several
+       * threads, but its workers are forked so the solver must not be used by another thread.
+       */
+      class SolverPool : public SolverInterface {
+        private:
+          //! A worker process.
+          struct Worker {
+            //! The pid of the process, 0 if the worker is not started.
+            pid_t pid;
+
+            //! The socket of the parent side.
+            int fd;
+
+            //! The ticket of the query being solved, 0 if the worker is idle.
+            triton::usize ticket;
+
+            //! The number of queries served.
+            triton::usize queries;
+
+            //! The time after which the query is abandoned, or the maximum time point if there is no limit.
+            std::chrono::steady_clock::time_point deadline;
+          };
+
+          //! A submitted query.
+          struct Query {
+            //! The constraint.
+            triton::ast::SharedAbstractNode node;
+
+            //! The maximum number of models, 0 to only check the satisfiability.
+            triton::uint32 limit;
+
+            //! The time limit in milliseconds, 0 for the limit of the pool.
+            triton::uint32 timeout;
+
+            //! The number of interrupts when the query was submitted.
+            triton::usize generation;
+
+            //! True if the query is solved.
+            bool done;
+
+            //! The status of the query.
+            status_e status;
+
+            //! The error raised by the solver, if any.
+            std::string error;
+
+            //! The models of the query.
+            std::list<std::map<triton::uint32, SolverModel>> models;
+          };
+
+          //! The solver used by the workers.
+          std::unique_ptr<SolverInterface> solver;
+
+          //! The workers.
+          mutable std::vector<Worker> workers;
+
+          //! The submitted queries. **item**: ticket -> query
+          mutable std::unordered_map<triton::usize, Query> queries;
+
+          //! The tickets of the queries waiting for a worker.
+          mutable std::deque<triton::usize> pending;
+
+          //! The last ticket delivered.
+          mutable triton::usize lastTicket;
+
+          //! The number of interrupts. The queries submitted before the last interrupt are abandoned.
+          mutable std::atomic<triton::usize> interrupts;
+
+          //! The pipe which wakes up the thread polling the workers when it is interrupted or when the busy workers change.
+          int wakeup[2];
+
+          //! Protects the workers and the queries.
+          mutable std::mutex mutex;
+
+          //! Signals the end of a poll of the workers.
+          mutable std::condition_variable cond;
+
+          //! True if a thread is polling the workers.
+          mutable bool polling;
+
+          //! The time limit of a query in milliseconds, 0 for no limit.
+          triton::uint32 timeout;
+
+          //! The memory limit of a worker in megabytes, 0 for no limit.
+          triton::uint32 memoryLimit;
+
+          //! The number of queries served by a worker before it is replaced, 0 for no limit.
+          triton::usize maxQueries;
+
+          //! Starts a worker.
+          void spawn(Worker& worker) const;
+
+          //! Stops a worker. If `kill` is true, the worker is killed even if it is busy.
+          void stop(Worker& worker, bool kill) const;
+
+          //! Serves the queries received on a socket. Runs in the worker.
+          void serve(int fd) const;
+
+          //! Solves a serialized query and returns the serialized reply. Runs in the worker.
+          std::string solve(const std::string& request) const;
+
+          //! Sends the query of a ticket to an idle worker. Returns false if the worker is dead.
+          bool dispatch(Worker& worker, triton::usize ticket) const;
+
+          //! Reads the reply of a busy worker.
+          void receive(Worker& worker) const;
+
+          //! Marks a query as solved.
+          void finish(triton::usize ticket, status_e status, const std::string& error="") const;
+
+          //! Wakes up the thread polling the workers.
+          void wake(void) const;
+
+          //! Dispatches the pending queries and waits at most `ms` milliseconds for replies, or forever if `ms` is negative. The lock is released while waiting.
+          void progress(std::unique_lock<std::mutex>& lock, int ms) const;
+
+        public:
+          //! Constructor. The pool takes the ownership of the solver and runs `size` workers.
+          TRITON_EXPORT SolverPool(SolverInterface* solver, triton::usize size);
+
+          //! Destructor. Kills the workers.
+          TRITON_EXPORT ~SolverPool();
+
+          //! Sets the time limit of a query in milliseconds, 0 for no limit.
+          TRITON_EXPORT void setTimeout(triton::uint32 ms);
+
+          //! Sets the memory limit of a worker in megabytes, 0 for no limit. The limit applies to the workers started afterwards.
+          TRITON_EXPORT void setMemoryLimit(triton::uint32 mb);
+
+          //! Sets the number of queries served by a worker before it is replaced, 0 for no limit.
+          TRITON_EXPORT void setMaxQueries(triton::usize queries);
+
+          //! Returns the pids of the workers, 0 for a worker not started.
+          TRITON_EXPORT std::vector<pid_t> getWorkers(void) const;
+
+          //! Submits a query and returns its ticket. If `limit` is 0, only the satisfiability is checked, otherwise at most `limit` models are computed. The `timeout` in milliseconds overrides the limit of the pool.
+          TRITON_EXPORT triton::usize submit(const triton::ast::SharedAbstractNode& node, triton::uint32 limit=1, triton::uint32 timeout=0) const;
+
+          //! Makes the pool progress without blocking and returns true if the query of a ticket is solved.
+          TRITON_EXPORT bool poll(triton::usize ticket) const;
+
+          //! Waits until the query of a ticket is solved, returns its status and its models and forgets the ticket.
+          TRITON_EXPORT status_e wait(triton::usize ticket, std::list<std::map<triton::uint32, SolverModel>>* models=nullptr) const;
+
+          //! Cancels the query of a ticket, whose status becomes UNKNOWN, and kills its worker if it is running. Returns false if the ticket is unknown or its query already solved.
+          TRITON_EXPORT bool cancel(triton::usize ticket) const;
+
+          //! Interrupts the queries being solved, their status is UNKNOWN. May be called from another thread.
+          TRITON_EXPORT void interrupt(void) const;
+
+          //! Computes and returns a model from a symbolic constraint.
+          /*! \brief map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
+          /*! \brief list of map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Returns true if an expression is satisfiable.
+          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Returns the name of this solver.
+          TRITON_EXPORT std::string getName(void) const;
+      };
+
+      #endif
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SOLVERPOOL_H */
@@ -11,8 +11,11 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <ostream>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <triton/architecture.hpp>
 #include <triton/ast.hpp>
@@ -24,6 +27,7 @@
 #include <triton/register.hpp>
 #include <triton/symbolicEnums.hpp>
 #include <triton/symbolicExpression.hpp>
+#include <triton/symbolicExpressionTable.hpp>
 #include <triton/symbolicSimplification.hpp>
 #include <triton/symbolicVariable.hpp>
 #include <triton/tritonTypes.hpp>
@@ -53,6 +57,34 @@ namespace triton {
      *  @{
      */
 
+      //! \struct BudgetDrop
+      /*! \brief An entry dropped by the memory budget. */
+      struct BudgetDrop {
+        //! The id of the dropped symbolic expression.
+        triton::usize id;
+
+        //! The address of the memory cell (if `regId` is ID_REG_INVALID).
+        triton::uint64 address;
+
+        //! The parent register (ID_REG_INVALID for a memory cell).
+        triton::arch::register_e regId;
+
+        //! True if the entry has been summarized by a fresh symbolic variable, false if it has been concretized.
+        bool summarized;
+      };
+
+
+      //! \struct SymbolicExpressionLocation
+      /*! \brief The places where a symbolic expression is assigned in the symbolic state. */
+      struct SymbolicExpressionLocation {
+        //! The parent registers assigned to the expression.
+        std::vector<triton::arch::register_e> registers;
+
+        //! The memory cells assigned to the expression.
+        std::vector<triton::uint64> memory;
+      };
+
+
       //! \class SymbolicEngine
       /*! \brief The symbolic engine class. */
       class SymbolicEngine
@@ -80,13 +112,16 @@ namespace triton {
            */
           std::unordered_map<triton::usize, SharedSymbolicVariable> symbolicVariables;
 
-          /*! \brief The map of symbolic expressions
+          /*! \brief The map of symbolic variables by name
            *
            * \details
-           * **item1**: symbolic reference id<br>
-           * **item2**: symbolic expression
+           * **item1**: variable name<br>
+           * **item2**: symbolic variable
            */
-          mutable std::unordered_map<triton::usize, WeakSymbolicExpression> symbolicExpressions;
+          std::unordered_map<std::string, SharedSymbolicVariable> symbolicVariableNames;
+
+          //! The table of symbolic expressions, indexed by id.
+          triton::engines::symbolic::SymbolicExpressionTable symbolicExpressions;
 
           /*! \brief map of address -> symbolic expression
            *
@@ -107,6 +142,14 @@ namespace triton {
           //! Symbolic register state.
           std::vector<SharedSymbolicExpression> symbolicReg;
 
+          /*! \brief The reverse index of `symbolicReg` and `memoryReference`.
+           *
+           * \details
+           * **item1**: symbolic expression id<br>
+           * **item2**: the registers and memory cells assigned to the expression
+           */
+          std::unordered_map<triton::usize, SymbolicExpressionLocation> expressionLocations;
+
         private:
           //! Reference to the context managing ast nodes.
           triton::ast::AstContext& astCtxt;
@@ -120,6 +163,33 @@ namespace triton {
           //! Modes API.
           triton::modes::Modes& modes;
 
+          //! The maximum number of symbolic bytes (memory cells and registers). 0 means unlimited.
+          triton::usize budgetMaxBytes;
+
+          //! The maximum depth of the AST of an entry before being summarized. 0 means unlimited.
+          triton::uint32 budgetMaxDepth;
+
+          //! The policy used to select the entries dropped when the memory budget is exceeded.
+          triton::engines::symbolic::budget_policy_e budgetPolicy;
+
+          //! The logical clock dating the uses of the symbolic entries.
+          triton::uint64 budgetClock;
+
+          //! The last use of the symbolic memory cells. **item1**: address<br>**item2**: clock
+          std::unordered_map<triton::uint64, triton::uint64> memoryLastUse;
+
+          //! The last use of the symbolic registers, indexed by parent register id.
+          std::vector<triton::uint64> registerLastUse;
+
+          //! The memory cells assigned since the last enforcement of the memory budget.
+          std::set<triton::uint64> budgetDirtyMemory;
+
+          //! The registers assigned since the last enforcement of the memory budget.
+          std::set<triton::arch::register_e> budgetDirtyRegisters;
+
+          //! The entries dropped by the memory budget.
+          std::vector<triton::engines::symbolic::BudgetDrop> budgetDrops;
+
           //! Returns an unique symbolic expression id.
           triton::usize getUniqueSymExprId(void);
 
@@ -141,12 +211,36 @@ namespace triton {
           //! Adds a symbolic memory reference.
           void addMemoryReference(triton::uint64 mem, const SharedSymbolicExpression& expr);
 
+          //! Assigns a symbolic expression (or nullptr) to a parent register and updates the reverse index.
+          void setRegisterReference(triton::arch::register_e parentId, const SharedSymbolicExpression& expr);
+
+          //! Assigns a symbolic expression (or nullptr) to a memory cell and updates the reverse index.
+          void setMemoryReference(triton::uint64 addr, const SharedSymbolicExpression& expr);
+
           //! Returns the AST corresponding to the shift operation. Mainly used for AArch64 operands.
           triton::ast::SharedAbstractNode getShiftAst(triton::arch::aarch64::shift_e type, triton::uint32 value, const triton::ast::SharedAbstractNode& node);
 
           //! Returns the AST corresponding to the extend operation. Mainly used for AArch64 operands.
           triton::ast::SharedAbstractNode getExtendAst(triton::arch::aarch64::extend_e type, triton::uint32 size, const triton::ast::SharedAbstractNode& node);
 
+          //! Returns true if a memory budget is defined.
+          bool isMemoryBudgetEnabled(void) const;
+
+          //! Dates the use of the symbolic memory cells of an area.
+          void touchMemory(triton::uint64 addr, triton::uint32 size);
+
+          //! Dates the use of a symbolic register.
+          void touchRegister(triton::arch::register_e parentId);
+
+          //! Replaces a memory cell by a fresh symbolic variable.
+          void summarizeMemory(triton::uint64 addr);
+
+          //! Replaces a register by a fresh symbolic variable.
+          void summarizeRegister(triton::arch::register_e parentId);
+
+          //! Removes all symbolic variables, expressions, bindings and path constraints.
+          void clearState(void);
+
         public:
           //! Constructor.
           TRITON_EXPORT SymbolicEngine(triton::arch::Architecture* architecture,
@@ -259,12 +353,18 @@ namespace triton {
           //! Slices all expressions from a given one.
           TRITON_EXPORT std::map<triton::usize, SharedSymbolicExpression> sliceExpressions(const SharedSymbolicExpression& expr);
 
+          //! Returns the symbolic variables which influence an expression. **item1**: variable id<br>**item2**: symbolic variable
+          TRITON_EXPORT std::map<triton::usize, SharedSymbolicVariable> sliceVariables(const SharedSymbolicExpression& expr) const;
+
           //! Returns the list of the tainted symbolic expressions.
           TRITON_EXPORT std::list<SharedSymbolicExpression> getTaintedSymbolicExpressions(void) const;
 
           //! Returns all symbolic expressions.
           TRITON_EXPORT std::unordered_map<triton::usize, SharedSymbolicExpression> getSymbolicExpressions(void) const;
 
+          //! Returns the table of symbolic expressions. Iterating it does not copy the expressions.
+          TRITON_EXPORT const triton::engines::symbolic::SymbolicExpressionTable& getSymbolicExpressionTable(void) const;
+
           //! Returns all symbolic variables.
           TRITON_EXPORT const std::unordered_map<triton::usize, SharedSymbolicVariable>& getSymbolicVariables(void) const;
 
@@ -310,6 +410,55 @@ namespace triton {
           //! Sets the concrete value of a symbolic variable.
           TRITON_EXPORT void setConcreteVariableValue(const SharedSymbolicVariable& symVar, const triton::uint512& value);
 
+          //! Sets the maximum number of symbolic bytes (memory cells and registers). 0 means unlimited.
+          TRITON_EXPORT void setMemoryBudget(triton::usize maxBytes);
+
+          //! Returns the maximum number of symbolic bytes. 0 means unlimited.
+          TRITON_EXPORT triton::usize getMemoryBudget(void) const;
+
+          //! Sets the maximum depth of the AST of an entry before being summarized. 0 means unlimited.
+          TRITON_EXPORT void setMemoryBudgetDepth(triton::uint32 maxDepth);
+
+          //! Returns the maximum depth of the AST of an entry before being summarized. 0 means unlimited.
+          TRITON_EXPORT triton::uint32 getMemoryBudgetDepth(void) const;
+
+          //! Sets the policy used to select the entries dropped when the memory budget is exceeded.
+          TRITON_EXPORT void setMemoryBudgetPolicy(triton::engines::symbolic::budget_policy_e policy);
+
+          //! Returns the policy used to select the entries dropped when the memory budget is exceeded.
+          TRITON_EXPORT triton::engines::symbolic::budget_policy_e getMemoryBudgetPolicy(void) const;
+
+          //! Returns the number of symbolic bytes (memory cells and registers).
+          TRITON_EXPORT triton::usize getMemoryBudgetUsage(void) const;
+
+          /*!
+           * \brief Enforces the memory budget. Called after each instruction.
+           *
+           * \details Entries assigned since the last call and whose AST is deeper than the depth
+           * threshold are summarized by a fresh symbolic variable holding their concrete value. Then,
+           * if the number of symbolic bytes exceeds the budget, entries are concretized in the order
+           * of the policy until a quarter of the budget is free again.
+           */
+          TRITON_EXPORT void enforceMemoryBudget(void);
+
+          //! Returns the entries dropped by the memory budget.
+          TRITON_EXPORT const std::vector<triton::engines::symbolic::BudgetDrop>& getMemoryBudgetDrops(void) const;
+
+          //! Clears the record of the entries dropped by the memory budget.
+          TRITON_EXPORT void clearMemoryBudgetDrops(void);
+
+          /*!
+           * \brief Writes the symbolic state in a compact binary format.
+           *
+           * \details The state is made of the symbolic variables with their concrete values, the
+           * live symbolic expressions with their ASTs, the symbolic registers and memory cells, the
+           * path constraints and the id counters. See triton::ast::AstWriter for the encoding.
+           */
+          TRITON_EXPORT void saveState(std::ostream& stream) const;
+
+          //! Replaces the symbolic state by the one read from a buffer written by saveState(). The buffer is not retained.
+          TRITON_EXPORT void loadState(const triton::uint8* data, triton::usize size);
+
           //! Restore the symbolic engine instance from a snapshot.
 		      TRITON_EXPORT void restoreInstance(const triton::engines::symbolic::SymbolicEngine& other);
       };
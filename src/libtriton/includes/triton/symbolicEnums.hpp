@@ -36,6 +36,13 @@ namespace triton {
      *  @{
      */
 
+      //! Policy used to select the entries dropped when the memory budget is exceeded.
+      enum budget_policy_e {
+        BUDGET_DEPTH,          //!< Deepest ASTs first, then least recently used.
+        BUDGET_LRU,            //!< Least recently used first.
+        BUDGET_NOT_SYMBOLIZED, //!< Entries without symbolic variable first, then least recently used.
+      };
+
       //! Type of symbolic expressions.
       enum expression_e {
         MEMORY_EXPRESSION,     //!< Assigned to a memory expression.
@@ -10,6 +10,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <triton/ast.hpp>
 #include <triton/dllexport.hpp>
@@ -66,6 +67,16 @@ namespace triton {
           //! The origin register if `kind` is equal to `triton::engines::symbolic::REG`, `REG_INVALID` otherwise.
           triton::arch::Register originRegister;
 
+          /*! \brief The symbolic expressions directly referenced by the AST.
+           *
+           * \details These are the edges of the dependency graph of the symbolic expressions. They are
+           * computed on demand and dropped when the AST is set or replaced.
+           */
+          mutable std::vector<SharedSymbolicExpression> references;
+
+          //! True if `references` corresponds to the current AST.
+          mutable bool referencesComputed;
+
         public:
           //! True if the symbolic expression is tainted.
           bool isTainted;
@@ -121,6 +132,9 @@ namespace triton {
           //! Returns the origin register if `kind` is equal to `triton::engines::symbolic::REG`, `REG_INVALID` otherwise.
           TRITON_EXPORT const triton::arch::Register& getOriginRegister(void) const;
 
+          //! Returns the symbolic expressions directly referenced by the AST, sorted by id.
+          TRITON_EXPORT const std::vector<SharedSymbolicExpression>& getReferences(void) const;
+
           //! Sets a root node.
           TRITON_EXPORT void setAst(const triton::ast::SharedAbstractNode& node);
 
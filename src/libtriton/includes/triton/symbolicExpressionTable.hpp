@@ -0,0 +1,145 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SYMBOLICEXPRESSIONTABLE_H
+#define TRITON_SYMBOLICEXPRESSIONTABLE_H
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+
+#include <triton/dllexport.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Symbolic Execution namespace
+    namespace symbolic {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup symbolic
+     *  @{
+     */
+
+      /*! \class SymbolicExpressionTable
+       *  \brief The table of the symbolic expressions, indexed by id.
+       *
+       * \details Expression ids are dense and monotonic, so the table is a deque of weak references
+       * where the slot of an expression is its id minus the id of the first slot. Removed or dead
+       * expressions leave a tombstone (an empty weak reference) and the tombstones at the front of
+       * the table are released as soon as they are met, so the table only spans the ids between
+       * the oldest live expression and the newest one. A dead expression keeps its memory while a
+       * weak reference remains, so the expired slots are reset when a lookup or an iteration meets
+       * them, and by a sweep once the table has grown by half since the previous one. Lookups and
+       * insertions are amortized O(1) and the iteration does not copy the table.
+       */
+      class SymbolicExpressionTable {
+        private:
+          //! The slots. **item**: weak reference on the expression whose id is `base + index`
+          mutable std::deque<WeakSymbolicExpression> slots;
+
+          //! The id of the first slot.
+          triton::usize base;
+
+          //! The number of insertions since the last sweep.
+          triton::usize insertions;
+
+          //! Releases the tombstones at the front of the table.
+          void compact(void);
+
+          //! Resets the expired slots of the table.
+          void sweep(void);
+
+        public:
+          //! Iterator on the live expressions of the table.
+          class const_iterator {
+            private:
+              //! The iterated table.
+              const SymbolicExpressionTable* table;
+
+              //! The current slot.
+              triton::usize index;
+
+              //! Skips the tombstones.
+              void skip(void);
+
+            public:
+              //! Iterator traits.
+              using iterator_category = std::forward_iterator_tag;
+              using value_type        = SharedSymbolicExpression;
+              using difference_type   = std::ptrdiff_t;
+              using pointer           = const SharedSymbolicExpression*;
+              using reference         = SharedSymbolicExpression;
+
+              //! Constructor.
+              TRITON_EXPORT const_iterator(const SymbolicExpressionTable* table, triton::usize index);
+
+              //! Returns the current expression.
+              TRITON_EXPORT SharedSymbolicExpression operator*(void) const;
+
+              //! Moves to the next live expression.
+              TRITON_EXPORT const_iterator& operator++(void);
+
+              //! Returns true if both iterators are on the same slot.
+              TRITON_EXPORT bool operator==(const const_iterator& other) const;
+
+              //! Returns true if the iterators are on different slots.
+              TRITON_EXPORT bool operator!=(const const_iterator& other) const;
+          };
+
+          //! Constructor.
+          TRITON_EXPORT SymbolicExpressionTable();
+
+          //! Records an expression at the slot of its id.
+          TRITON_EXPORT void insert(const SharedSymbolicExpression& expr);
+
+          //! Returns the expression corresponding to an id, or nullptr if it has been removed or is not alive anymore.
+          TRITON_EXPORT SharedSymbolicExpression find(triton::usize id) const;
+
+          //! Returns true if the expression corresponding to an id is recorded and still alive.
+          TRITON_EXPORT bool contains(triton::usize id) const;
+
+          //! Removes the expression corresponding to an id.
+          TRITON_EXPORT void erase(triton::usize id);
+
+          //! Removes all expressions.
+          TRITON_EXPORT void clear(void);
+
+          //! Returns the number of slots (live expressions and tombstones).
+          TRITON_EXPORT triton::usize capacity(void) const;
+
+          //! Returns an iterator on the first live expression.
+          TRITON_EXPORT const_iterator begin(void) const;
+
+          //! Returns the end iterator.
+          TRITON_EXPORT const_iterator end(void) const;
+      };
+
+    /*! @} End of symbolic namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SYMBOLICEXPRESSIONTABLE_H */
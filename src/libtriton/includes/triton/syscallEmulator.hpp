@@ -0,0 +1,231 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SYSCALLEMULATOR_H
+#define TRITON_SYSCALLEMULATOR_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/instruction.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  class API;
+
+  //! The Operating System namespace
+  namespace os {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup os
+   *  @{
+   */
+
+    //! The Unix namespace
+    namespace unix {
+    /*!
+     *  \ingroup os
+     *  \addtogroup unix
+     *  @{
+     */
+
+      //! The default base address of the anonymous mappings.
+      const triton::uint64 SYSCALL_MMAP_BASE = 0x7ff000000000;
+
+      /*! \class VirtualFile
+          \brief A file of the virtual file system. */
+      class VirtualFile {
+        public:
+          //! The content of the file.
+          std::vector<triton::uint8> content;
+
+          //! True if the bytes returned by read() must be symbolized.
+          bool symbolize;
+
+          //! True if the bytes returned by read() must be tainted.
+          bool taint;
+
+          //! True if the file is a character device (stdin, stdout, stderr).
+          bool device;
+      };
+
+      /*! \class FileDescriptor
+          \brief An opened file. */
+      class FileDescriptor {
+        public:
+          //! The path of the opened file.
+          std::string path;
+
+          //! The opened file.
+          std::shared_ptr<triton::os::unix::VirtualFile> file;
+
+          //! The current offset.
+          triton::uint64 offset;
+
+          //! True if the file has been opened with O_APPEND.
+          bool append;
+      };
+
+      /*! \class SyscallEmulator
+       *  \brief Emulates the Linux system calls of the x86-64 and AArch64 ABIs.
+       *
+       * \details The syscall number and its arguments are read from the registers, the
+       * syscall is performed on a virtual file system and on the concrete memory, and the
+       * result is written into the return register. `/dev/stdin`, `/dev/stdout` and
+       * `/dev/stderr` are opened as fd 0, 1 and 2. The heap is modeled by a brk pointer
+       * and a bump allocator for anonymous mappings. Bytes returned by read() may be
+       * automatically symbolized and/or tainted according to the file they come from.
+       */
+      class SyscallEmulator {
+        private:
+          //! Reference to the API handling the concrete state.
+          triton::API& api;
+
+          //! The virtual file system. **item1**: path<br>**item2**: file
+          std::map<std::string, std::shared_ptr<triton::os::unix::VirtualFile>> files;
+
+          //! The file descriptors table.
+          std::map<triton::sint64, triton::os::unix::FileDescriptor> fds;
+
+          //! The initial program break.
+          triton::uint64 brkBase;
+
+          //! The current program break.
+          triton::uint64 brkCurrent;
+
+          //! The next address returned by an anonymous mmap.
+          triton::uint64 mmapCurrent;
+
+          //! True if exit() or exit_group() has been called.
+          bool exited;
+
+          //! The exit code.
+          triton::sint32 exitCode;
+
+          //! Returns the concrete value of a register.
+          triton::uint64 getRegisterValue(triton::arch::register_e id) const;
+
+          //! Reads a NUL terminated string from the concrete memory.
+          std::string readString(triton::uint64 addr) const;
+
+          //! Returns a new file descriptor number.
+          triton::sint64 allocateFd(void) const;
+
+          //! Writes up to `size` bytes of a file into the memory by chunks of one page and applies the read policy of the file.
+          triton::sint64 readFile(triton::os::unix::FileDescriptor& fd, triton::uint64 addr, triton::uint64 size);
+
+          //! Writes up to `size` bytes of memory into a file by chunks of one page.
+          triton::sint64 writeFile(triton::os::unix::FileDescriptor& fd, triton::uint64 addr, triton::uint64 size);
+
+          //! Fills a `struct stat` in memory.
+          triton::sint64 writeStat(const std::shared_ptr<triton::os::unix::VirtualFile>& file, triton::uint64 addr);
+
+          //! The read syscall.
+          triton::sint64 sysRead(triton::sint64 fd, triton::uint64 addr, triton::uint64 size);
+
+          //! The write syscall.
+          triton::sint64 sysWrite(triton::sint64 fd, triton::uint64 addr, triton::uint64 size);
+
+          //! The readv and writev syscalls.
+          triton::sint64 sysVector(triton::sint64 fd, triton::uint64 iov, triton::uint64 count, bool write);
+
+          //! The openat syscall.
+          triton::sint64 sysOpen(triton::uint64 path, triton::uint64 flags);
+
+          //! The close syscall.
+          triton::sint64 sysClose(triton::sint64 fd);
+
+          //! The lseek syscall.
+          triton::sint64 sysLseek(triton::sint64 fd, triton::sint64 offset, triton::uint64 whence);
+
+          //! The fstat syscall.
+          triton::sint64 sysFstat(triton::sint64 fd, triton::uint64 addr);
+
+          //! The newfstatat syscall.
+          triton::sint64 sysFstatat(triton::sint64 dirfd, triton::uint64 path, triton::uint64 addr, triton::uint64 flags);
+
+          //! The brk syscall.
+          triton::sint64 sysBrk(triton::uint64 addr);
+
+          //! The mmap syscall.
+          triton::sint64 sysMmap(triton::uint64 addr, triton::uint64 size, triton::uint64 flags, triton::sint64 fd, triton::uint64 offset);
+
+          //! The munmap syscall.
+          triton::sint64 sysMunmap(triton::uint64 addr, triton::uint64 size);
+
+          //! The arch_prctl syscall (x86-64 only).
+          triton::sint64 sysArchPrctl(triton::uint64 code, triton::uint64 addr);
+
+          //! The exit and exit_group syscalls.
+          triton::sint64 sysExit(triton::sint64 code);
+
+          //! Dispatches a x86-64 syscall. Returns false if the syscall is not supported.
+          bool dispatchX8664(triton::uint64 number, const triton::uint64* args, triton::sint64& ret);
+
+          //! Dispatches an AArch64 syscall. Returns false if the syscall is not supported.
+          bool dispatchAArch64(triton::uint64 number, const triton::uint64* args, triton::sint64& ret);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT SyscallEmulator(triton::API& api);
+
+          //! Adds (or replaces the content of) a file of the virtual file system.
+          TRITON_EXPORT void addFile(const std::string& path, const std::vector<triton::uint8>& content, bool symbolize=false, bool taint=false);
+
+          //! Sets the content of the standard input.
+          TRITON_EXPORT void setStdin(const std::vector<triton::uint8>& content, bool symbolize=false, bool taint=false);
+
+          //! Returns the content of a file of the virtual file system (e.g. `/dev/stdout`).
+          TRITON_EXPORT const std::vector<triton::uint8>& getFileContent(const std::string& path) const;
+
+          //! Returns true if the path exists in the virtual file system.
+          TRITON_EXPORT bool isFile(const std::string& path) const;
+
+          //! Sets the initial program break (e.g. the end of the loaded image).
+          TRITON_EXPORT void setBrk(triton::uint64 addr);
+
+          //! Returns the current program break.
+          TRITON_EXPORT triton::uint64 getBrk(void) const;
+
+          //! Sets the base address of the anonymous mappings.
+          TRITON_EXPORT void setMmapBase(triton::uint64 addr);
+
+          //! Returns true if the instruction is a system call for the current architecture.
+          TRITON_EXPORT bool isSyscall(const triton::arch::Instruction& inst) const;
+
+          //! Emulates the system call described by the registers. Returns false if it is not supported (-ENOSYS is returned to the program).
+          TRITON_EXPORT bool emulate(void);
+
+          //! Returns true if the program called exit() or exit_group().
+          TRITON_EXPORT bool hasExited(void) const;
+
+          //! Returns the exit code of the program.
+          TRITON_EXPORT triton::sint32 getExitCode(void) const;
+      };
+
+    /*! @} End of unix namespace */
+    };
+  /*! @} End of os namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* __unix__ || __APPLE__ */
+#endif /* TRITON_SYSCALLEMULATOR_H */
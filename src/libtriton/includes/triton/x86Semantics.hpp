@@ -90,6 +90,9 @@ namespace triton {
           //! Control flow semantics. Used to represent IP.
           void controlFlow_s(triton::arch::Instruction& inst);
 
+          //! Performs the iterations of a REP MOVS/STOS at once, up to one page. Returns false if the iterations must be performed one by one.
+          bool repString_s(triton::arch::Instruction& inst, triton::uint32 size, const std::string& comment);
+
           //! The AF semantics.
           void af_s(triton::arch::Instruction& inst,
                     const triton::engines::symbolic::SharedSymbolicExpression& parent,
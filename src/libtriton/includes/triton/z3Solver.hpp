@@ -8,18 +8,36 @@
 #ifndef TRITON_Z3SOLVER_H
 #define TRITON_Z3SOLVER_H
 
+#include <atomic>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <triton/ast.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
 #include <triton/solverInterface.hpp>
 #include <triton/solverModel.hpp>
+#include <triton/symbolicVariable.hpp>
 #include <triton/tritonTypes.hpp>
 
 
 
+namespace z3 {
+  class context;
+  class expr;
+  class solver;
+};
+
+namespace triton {
+  namespace ast {
+    class TritonToZ3Ast;
+  };
+};
+
 //! The Triton namespace
 namespace triton {
 /*!
@@ -44,10 +62,56 @@ namespace triton {
       //! \class Z3Solver
       /*! \brief Solver engine using z3. */
       class Z3Solver : public SolverInterface {
+        private:
+          //! Marks a z3 context as solving a query while it lives, so that interrupt() reaches it.
+          class Running {
+            private:
+              //! The solver.
+              const Z3Solver& solver;
+
+              //! The context of the query.
+              z3::context& ctx;
+
+            public:
+              //! Constructor.
+              Running(const Z3Solver& solver, z3::context& ctx);
+
+              //! Destructor.
+              ~Running();
+          };
+
+          //! The default time limit of a query in milliseconds, 0 for no limit.
+          triton::uint32 timeout;
+
+          //! The resource limit of a query (the z3 rlimit), 0 for no limit.
+          triton::uint32 resourceLimit;
+
+          //! Protects `contexts`.
+          mutable std::mutex mutex;
+
+          //! The z3 contexts of the queries being solved.
+          mutable std::unordered_set<z3::context*> contexts;
+
+          //! Applies the limits of a query to a z3 solver.
+          void setLimits(z3::solver& solver, triton::uint32 timeout) const;
+
+          //! Enumerates the models of a converted constraint, cube by cube, and gives them to `emit` until it returns false. Returns the status of the enumeration.
+          status_e enumerate(triton::ast::TritonToZ3Ast& z3Ast, const z3::expr& expr, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& projection,
+                             std::atomic<triton::uint32>& nextCube, triton::uint32 cubes, const ModelCallback& emit, const std::atomic<bool>& stop, triton::uint32 timeout) const;
+
         public:
           //! Constructor.
           TRITON_EXPORT Z3Solver();
 
+          //! Sets the default time limit of a query in milliseconds, 0 for no limit. The limit applies to each check done by the query.
+          TRITON_EXPORT void setTimeout(triton::uint32 ms);
+
+          //! Sets the resource limit of a query (the z3 rlimit), 0 for no limit. Unlike a time limit, it gives the same result on every run.
+          TRITON_EXPORT void setResourceLimit(triton::uint32 rlimit);
+
+          //! Sets the memory limit of z3 in megabytes, 0 for no limit. This limit is global to the process.
+          TRITON_EXPORT void setMemoryLimit(triton::uint32 mb);
+
           //! Computes and returns a model from a symbolic constraint.
           /*! \brief map of symbolic variable id -> model
            *
@@ -55,7 +119,7 @@ namespace triton {
            * **item1**: symbolic variable id<br>
            * **item2**: model
            */
-          TRITON_EXPORT std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node) const;
+          TRITON_EXPORT std::map<triton::uint32, SolverModel> getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
 
           //! Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
           /*! \brief list of map of symbolic variable id -> model
@@ -64,10 +128,25 @@ namespace triton {
            * **item1**: symbolic variable id<br>
            * **item2**: model
            */
-          TRITON_EXPORT std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit) const;
+          TRITON_EXPORT std::list<std::map<triton::uint32, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Enumerates the models of a symbolic constraint and gives them to `callback` as they are found.
+          /*!
+           * \details Two models differ on the variables of `projection`, or on the variables of the
+           * model if `projection` is empty. The enumeration stops when `callback` returns false,
+           * after `limit` models if `limit` is not 0, or when there is no model left. With several
+           * `threads`, the values of the widest variable of the projection are split on their low
+           * bits into cubes which the threads solve in their own z3 context. `callback` is always called by the calling
+           * thread. The status is SAT if a model was found, otherwise the status of the failed check.
+           */
+          TRITON_EXPORT void enumerateModels(const triton::ast::SharedAbstractNode& node, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& projection, const ModelCallback& callback,
+                                             triton::uint32 limit=0, triton::uint32 threads=1, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
 
           //! Returns true if an expression is satisfiable.
-          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node) const;
+          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+          //! Interrupts the queries being solved.
+          TRITON_EXPORT void interrupt(void) const;
 
           //! Converts a Triton's AST to a Z3's AST, perform a Z3 simplification and returns a Triton's AST.
           TRITON_EXPORT triton::ast::SharedAbstractNode simplify(const triton::ast::SharedAbstractNode& node) const;
@@ -8,6 +8,7 @@
 #ifndef TRITON_Z3TOTRITONAST_H
 #define TRITON_Z3TOTRITONAST_H
 
+#include <unordered_map>
 #include <z3++.h>
 
 #include <triton/ast.hpp>
@@ -38,11 +39,14 @@ namespace triton {
         //! The Triton's AST context
         triton::ast::AstContext& astCtxt;
 
+        //! Converts a Z3's application whose arguments are already converted. **results**: Z3's AST id -> Triton's node
+        triton::ast::SharedAbstractNode do_convert(const z3::expr& expr, const std::unordered_map<triton::uint32, triton::ast::SharedAbstractNode>& results);
+
       public:
         //! Constructor.
         TRITON_EXPORT Z3ToTritonAst(triton::ast::AstContext& ctxt);
 
-        //! Converts to Triton's AST
+        //! Converts to Triton's AST. Shared Z3's subterms are converted once.
         TRITON_EXPORT triton::ast::SharedAbstractNode convert(const z3::expr& expr);
     };
 
@@ -0,0 +1,632 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <triton/api.hpp>
+#include <triton/elfLoader.hpp>
+#include <triton/exceptions.hpp>
+
+
+
+namespace triton {
+  namespace os {
+    namespace unix {
+
+      /* ELF constants used by the loader */
+      enum elf_e {
+        ELFCLASS32          = 1,
+        ELFCLASS64          = 2,
+        ELFDATA2LSB         = 1,
+        ET_EXEC             = 2,
+        ET_DYN              = 3,
+        EM_386              = 3,
+        EM_X86_64           = 62,
+        EM_AARCH64          = 183,
+        PT_LOAD             = 1,
+        PT_DYNAMIC          = 2,
+        DT_NULL             = 0,
+        DT_PLTRELSZ         = 2,
+        DT_STRTAB           = 5,
+        DT_SYMTAB           = 6,
+        DT_RELA             = 7,
+        DT_RELASZ           = 8,
+        DT_RELAENT          = 9,
+        DT_SYMENT           = 11,
+        DT_REL              = 17,
+        DT_RELSZ            = 18,
+        DT_RELENT           = 19,
+        DT_PLTREL           = 20,
+        DT_JMPREL           = 23,
+        R_386_32            = 1,
+        R_386_GLOB_DAT      = 6,
+        R_386_JMP_SLOT      = 7,
+        R_386_RELATIVE      = 8,
+        R_X86_64_64         = 1,
+        R_X86_64_GLOB_DAT   = 6,
+        R_X86_64_JUMP_SLOT  = 7,
+        R_X86_64_RELATIVE   = 8,
+        R_AARCH64_ABS64     = 257,
+        R_AARCH64_GLOB_DAT  = 1025,
+        R_AARCH64_JUMP_SLOT = 1026,
+        R_AARCH64_RELATIVE  = 1027,
+      };
+
+
+      ElfLoader::ElfLoader(triton::API& api)
+        : api(api),
+          loadCallback(std::function<void(triton::API&, const triton::arch::MemoryAccess&)>(
+            [this](triton::API&, const triton::arch::MemoryAccess& mem) {
+              this->mapRange(mem.getAddress(), mem.getSize());
+            }), this),
+          storeCallback(std::function<void(triton::API&, const triton::arch::MemoryAccess&, const triton::uint512&)>(
+            [this](triton::API&, const triton::arch::MemoryAccess& mem, const triton::uint512&) {
+              this->mapRange(mem.getAddress(), mem.getSize());
+            }), this) {
+        this->image               = nullptr;
+        this->imageSize           = 0;
+        this->is64                = false;
+        this->machine             = 0;
+        this->type                = 0;
+        this->baseAddress         = 0;
+        this->entryPoint          = 0;
+        this->lazy                = false;
+        this->firstPage           = 0;
+        this->lastPage            = 0;
+        this->pendingPages        = 0;
+        this->callbacksRegistered = false;
+        this->finalizer           = 0;
+      }
+
+
+      /* The pages still pending are mapped, the image is gone once the loader is dropped */
+      ElfLoader::~ElfLoader() {
+        if (this->callbacksRegistered) {
+          try {
+            this->mapAll();
+          }
+          catch (const triton::exceptions::Exception&) {
+          }
+        }
+        this->release();
+      }
+
+
+      void ElfLoader::removeCallbacks(void) {
+        if (this->callbacksRegistered) {
+          this->api.removeCallback(this->loadCallback);
+          this->api.removeCallback(this->storeCallback);
+          this->api.removeCallbacksFinalizer(this->finalizer);
+          this->callbacksRegistered = false;
+        }
+      }
+
+
+      void ElfLoader::release(void) {
+        this->removeCallbacks();
+
+        if (this->image) {
+          munmap(const_cast<triton::uint8*>(this->image), this->imageSize);
+          this->image     = nullptr;
+          this->imageSize = 0;
+        }
+
+        this->segments.clear();
+        this->relocations.clear();
+        this->imports.clear();
+        this->resolvedPages.clear();
+        this->pendingPages = 0;
+        this->bindings.clear();
+        this->stubs.clear();
+      }
+
+
+      triton::uint64 ElfLoader::read(triton::uint64 offset, triton::uint32 size) const {
+        triton::uint64 value = 0;
+
+        if (offset > this->imageSize || size > this->imageSize - offset)
+          throw triton::exceptions::Os("ElfLoader::read(): Out of bounds access, the file is truncated or corrupted.");
+
+        /* Only little endian images are supported */
+        for (triton::sint32 i = size-1; i >= 0; i--)
+          value = (value << 8) | this->image[offset + i];
+
+        return value;
+      }
+
+
+      bool ElfLoader::vaddrToOffset(triton::uint64 vaddr, triton::uint64& offset) const {
+        for (const auto& seg : this->segments) {
+          triton::uint64 start = seg.vaddr - this->baseAddress;
+          if (vaddr >= start && vaddr < start + seg.filesz) {
+            offset = seg.offset + (vaddr - start);
+            return true;
+          }
+        }
+        return false;
+      }
+
+
+      triton::uint32 ElfLoader::pointerSize(void) const {
+        return (this->is64 ? QWORD_SIZE : DWORD_SIZE);
+      }
+
+
+      void ElfLoader::parseHeader(void) {
+        if (this->imageSize < 0x34 || std::memcmp(this->image, "\x7f" "ELF", 4) != 0)
+          throw triton::exceptions::Os("ElfLoader::parseHeader(): Not an ELF file.");
+
+        if (this->image[4] != ELFCLASS32 && this->image[4] != ELFCLASS64)
+          throw triton::exceptions::Os("ElfLoader::parseHeader(): Invalid ELF class.");
+
+        if (this->image[5] != ELFDATA2LSB)
+          throw triton::exceptions::Os("ElfLoader::parseHeader(): Only little endian ELF files are supported.");
+
+        this->is64    = (this->image[4] == ELFCLASS64);
+        this->type    = static_cast<triton::uint16>(this->read(16, WORD_SIZE));
+        this->machine = static_cast<triton::uint16>(this->read(18, WORD_SIZE));
+
+        if (this->type != ET_EXEC && this->type != ET_DYN)
+          throw triton::exceptions::Os("ElfLoader::parseHeader(): Only executables and shared objects can be loaded.");
+
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86:
+            if (this->machine != EM_386 || this->is64)
+              throw triton::exceptions::Os("ElfLoader::parseHeader(): The ELF file does not match the x86 architecture.");
+            break;
+
+          case triton::arch::ARCH_X86_64:
+            if (this->machine != EM_X86_64 || !this->is64)
+              throw triton::exceptions::Os("ElfLoader::parseHeader(): The ELF file does not match the x86-64 architecture.");
+            break;
+
+          case triton::arch::ARCH_AARCH64:
+            if (this->machine != EM_AARCH64 || !this->is64)
+              throw triton::exceptions::Os("ElfLoader::parseHeader(): The ELF file does not match the AArch64 architecture.");
+            break;
+
+          default:
+            throw triton::exceptions::Os("ElfLoader::parseHeader(): You must define an architecture.");
+        }
+
+        this->entryPoint = this->read(24, this->pointerSize()) + this->baseAddress;
+      }
+
+
+      void ElfLoader::parseSegments(void) {
+        triton::uint64 phoff     = this->is64 ? this->read(32, QWORD_SIZE) : this->read(28, DWORD_SIZE);
+        triton::uint64 phentsize = this->is64 ? this->read(54, WORD_SIZE)  : this->read(42, WORD_SIZE);
+        triton::uint64 phnum     = this->is64 ? this->read(56, WORD_SIZE)  : this->read(44, WORD_SIZE);
+
+        for (triton::uint64 i = 0; i < phnum; i++) {
+          triton::uint64 phdr = phoff + i * phentsize;
+
+          if (this->read(phdr, DWORD_SIZE) != PT_LOAD)
+            continue;
+
+          ElfSegment seg;
+          if (this->is64) {
+            seg.flags  = static_cast<triton::uint32>(this->read(phdr + 4, DWORD_SIZE));
+            seg.offset = this->read(phdr + 8,  QWORD_SIZE);
+            seg.vaddr  = this->read(phdr + 16, QWORD_SIZE);
+            seg.filesz = this->read(phdr + 32, QWORD_SIZE);
+            seg.memsz  = this->read(phdr + 40, QWORD_SIZE);
+          }
+          else {
+            seg.offset = this->read(phdr + 4,  DWORD_SIZE);
+            seg.vaddr  = this->read(phdr + 8,  DWORD_SIZE);
+            seg.filesz = this->read(phdr + 16, DWORD_SIZE);
+            seg.memsz  = this->read(phdr + 20, DWORD_SIZE);
+            seg.flags  = static_cast<triton::uint32>(this->read(phdr + 24, DWORD_SIZE));
+          }
+
+          if (seg.offset > this->imageSize || seg.filesz > this->imageSize - seg.offset || seg.filesz > seg.memsz)
+            throw triton::exceptions::Os("ElfLoader::parseSegments(): Invalid PT_LOAD segment.");
+
+          seg.vaddr += this->baseAddress;
+          this->segments.push_back(seg);
+        }
+      }
+
+
+      void ElfLoader::parseDynamic(void) {
+        triton::uint64 phoff     = this->is64 ? this->read(32, QWORD_SIZE) : this->read(28, DWORD_SIZE);
+        triton::uint64 phentsize = this->is64 ? this->read(54, WORD_SIZE)  : this->read(42, WORD_SIZE);
+        triton::uint64 phnum     = this->is64 ? this->read(56, WORD_SIZE)  : this->read(44, WORD_SIZE);
+        triton::uint32 psize     = this->pointerSize();
+        triton::uint64 dynoff    = 0;
+        triton::uint64 dynsz     = 0;
+
+        for (triton::uint64 i = 0; i < phnum; i++) {
+          triton::uint64 phdr = phoff + i * phentsize;
+          if (this->read(phdr, DWORD_SIZE) == PT_DYNAMIC) {
+            dynoff = this->is64 ? this->read(phdr + 8,  QWORD_SIZE) : this->read(phdr + 4,  DWORD_SIZE);
+            dynsz  = this->is64 ? this->read(phdr + 32, QWORD_SIZE) : this->read(phdr + 16, DWORD_SIZE);
+            break;
+          }
+        }
+
+        /* Statically linked */
+        if (dynsz == 0)
+          return;
+
+        std::map<triton::uint64, triton::uint64> tags;
+        for (triton::uint64 entry = dynoff; entry + 2 * psize <= dynoff + dynsz; entry += 2 * psize) {
+          triton::uint64 tag = this->read(entry, psize);
+          if (tag == DT_NULL)
+            break;
+          tags[tag] = this->read(entry + psize, psize);
+        }
+
+        triton::uint64 symtab = 0;
+        triton::uint64 strtab = 0;
+        triton::uint64 syment = tags.count(DT_SYMENT) ? tags[DT_SYMENT] : (this->is64 ? 24 : 16);
+
+        if (tags.count(DT_SYMTAB) == 0 || !this->vaddrToOffset(tags[DT_SYMTAB], symtab))
+          return;
+
+        if (tags.count(DT_STRTAB) == 0 || !this->vaddrToOffset(tags[DT_STRTAB], strtab))
+          return;
+
+        triton::uint64 offset = 0;
+        if (tags.count(DT_RELA) && this->vaddrToOffset(tags[DT_RELA], offset))
+          this->parseRelocations(offset, tags[DT_RELASZ], tags.count(DT_RELAENT) ? tags[DT_RELAENT] : 3 * psize, true, symtab, syment, strtab);
+
+        if (tags.count(DT_REL) && this->vaddrToOffset(tags[DT_REL], offset))
+          this->parseRelocations(offset, tags[DT_RELSZ], tags.count(DT_RELENT) ? tags[DT_RELENT] : 2 * psize, false, symtab, syment, strtab);
+
+        if (tags.count(DT_JMPREL) && this->vaddrToOffset(tags[DT_JMPREL], offset)) {
+          bool rela = (tags.count(DT_PLTREL) ? tags[DT_PLTREL] == DT_RELA : this->is64);
+          this->parseRelocations(offset, tags[DT_PLTRELSZ], (rela ? 3 : 2) * psize, rela, symtab, syment, strtab);
+        }
+      }
+
+
+      void ElfLoader::parseRelocations(triton::uint64 offset, triton::uint64 size, triton::uint64 entsize, bool rela, triton::uint64 symtab, triton::uint64 syment, triton::uint64 strtab) {
+        triton::uint32 psize = this->pointerSize();
+
+        if (entsize == 0)
+          throw triton::exceptions::Os("ElfLoader::parseRelocations(): Invalid relocation entry size.");
+
+        for (triton::uint64 entry = offset; entry + entsize <= offset + size; entry += entsize) {
+          triton::uint64 info = this->read(entry + psize, psize);
+          triton::uint64 sym  = this->is64 ? (info >> 32) : (info >> 8);
+          ElfRelocation reloc;
+
+          reloc.address = this->read(entry, psize);
+          reloc.type    = static_cast<triton::uint32>(this->is64 ? (info & 0xffffffff) : (info & 0xff));
+          reloc.addend  = 0;
+
+          if (rela) {
+            reloc.addend = static_cast<triton::sint64>(this->read(entry + 2 * psize, psize));
+            if (!this->is64)
+              reloc.addend = static_cast<triton::sint32>(reloc.addend);
+          }
+          else {
+            /* Implicit addend stored at the relocated address */
+            triton::uint64 slot = 0;
+            if (this->vaddrToOffset(reloc.address, slot)) {
+              reloc.addend = static_cast<triton::sint64>(this->read(slot, psize));
+              if (!this->is64)
+                reloc.addend = static_cast<triton::sint32>(reloc.addend);
+            }
+          }
+
+          triton::uint64 value = 0;
+          bool defined = false;
+          if (sym != 0) {
+            triton::uint64 symbol = symtab + sym * syment;
+            triton::uint64 name   = strtab + this->read(symbol, DWORD_SIZE);
+            triton::uint64 shndx  = this->is64 ? this->read(symbol + 6, WORD_SIZE) : this->read(symbol + 14, WORD_SIZE);
+            value                 = this->is64 ? this->read(symbol + 8, QWORD_SIZE) : this->read(symbol + 4, DWORD_SIZE);
+            defined               = (shndx != 0);
+
+            if (name >= this->imageSize)
+              throw triton::exceptions::Os("ElfLoader::parseRelocations(): Invalid symbol name.");
+
+            const char* str = reinterpret_cast<const char*>(this->image + name);
+            reloc.symbol = std::string(str, strnlen(str, this->imageSize - name));
+          }
+
+          reloc.address += this->baseAddress;
+
+          /* Symbols defined by the image itself are resolved right now */
+          if (defined)
+            this->bindings[reloc.symbol] = value + this->baseAddress;
+          else if (!reloc.symbol.empty())
+            this->imports.insert(reloc.symbol);
+
+          this->relocations.push_back(reloc);
+        }
+      }
+
+
+      void ElfLoader::applyRelocation(const ElfRelocation& reloc) {
+        triton::uint64 symbol = 0;
+        bool relative = false;
+        bool absolute = false;
+
+        switch (this->machine) {
+          case EM_386:
+            relative = (reloc.type == R_386_RELATIVE);
+            absolute = (reloc.type == R_386_32);
+            if (!relative && !absolute && reloc.type != R_386_GLOB_DAT && reloc.type != R_386_JMP_SLOT)
+              return;
+            break;
+
+          case EM_X86_64:
+            relative = (reloc.type == R_X86_64_RELATIVE);
+            absolute = (reloc.type == R_X86_64_64);
+            if (!relative && !absolute && reloc.type != R_X86_64_GLOB_DAT && reloc.type != R_X86_64_JUMP_SLOT)
+              return;
+            break;
+
+          case EM_AARCH64:
+            relative = (reloc.type == R_AARCH64_RELATIVE);
+            absolute = (reloc.type == R_AARCH64_ABS64);
+            if (!relative && !absolute && reloc.type != R_AARCH64_GLOB_DAT && reloc.type != R_AARCH64_JUMP_SLOT)
+              return;
+            break;
+
+          default:
+            return;
+        }
+
+        if (relative) {
+          this->writePointer(reloc.address, this->baseAddress + reloc.addend);
+          return;
+        }
+
+        auto it = this->bindings.find(reloc.symbol);
+        if (it == this->bindings.end())
+          return;
+        symbol = it->second;
+
+        /* GLOB_DAT and JUMP_SLOT ignore the addend */
+        this->writePointer(reloc.address, absolute ? symbol + reloc.addend : symbol);
+      }
+
+
+      void ElfLoader::writePointer(triton::uint64 addr, triton::uint64 value) {
+        triton::uint32 psize = this->pointerSize();
+
+        if (psize == DWORD_SIZE)
+          value &= 0xffffffff;
+
+        this->mapRange(addr, psize);
+        this->api.setConcreteMemoryValue(triton::arch::MemoryAccess(addr, psize), value);
+      }
+
+
+      /* The accesses outside of the pages of the segments (e.g. the stack) return at once */
+      void ElfLoader::mapRange(triton::uint64 addr, triton::usize size) {
+        if (!this->lazy || size == 0 || this->pendingPages == 0)
+          return;
+
+        triton::uint64 first = std::max(addr / ELF_PAGE_SIZE, this->firstPage);
+        triton::uint64 last  = std::min((addr + size - 1) / ELF_PAGE_SIZE, this->lastPage);
+
+        for (triton::uint64 page = first; page <= last; page++) {
+          if (this->resolvedPages.find(page) == this->resolvedPages.end())
+            this->mapPage(page);
+        }
+      }
+
+
+      void ElfLoader::mapPage(triton::uint64 page) {
+        triton::uint64 start = page * ELF_PAGE_SIZE;
+        triton::uint64 end   = start + ELF_PAGE_SIZE;
+        bool found = false;
+
+        /* Resolve the page first, the writes below go through the store callback. A page without segment is not scanned again */
+        this->resolvedPages.insert(page);
+
+        for (const auto& seg : this->segments) {
+          triton::uint64 lo = std::max(start, seg.vaddr);
+          triton::uint64 hi = std::min(end, seg.vaddr + seg.memsz);
+          if (lo >= hi)
+            continue;
+
+          if (!found) {
+            this->pendingPages--;
+            found = true;
+          }
+
+          /* File backed part of the page */
+          triton::uint64 fileEnd = seg.vaddr + seg.filesz;
+          if (lo < fileEnd) {
+            triton::uint64 n = std::min(hi, fileEnd) - lo;
+            this->api.setConcreteMemoryAreaValue(lo, this->image + seg.offset + (lo - seg.vaddr), n);
+            lo += n;
+          }
+
+          /* Zero-filled part of the page (.bss) */
+          if (lo < hi)
+            this->api.setConcreteMemoryAreaValue(lo, std::vector<triton::uint8>(hi - lo, 0));
+        }
+      }
+
+
+      void ElfLoader::load(const std::string& path, triton::uint64 base, bool lazy) {
+        struct stat st;
+        int fd = -1;
+        void* addr = nullptr;
+
+        this->release();
+
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+          throw triton::exceptions::Os("ElfLoader::load(): Cannot open " + path + ".");
+
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+          close(fd);
+          throw triton::exceptions::Os("ElfLoader::load(): Cannot stat " + path + " or the file is empty.");
+        }
+
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (addr == MAP_FAILED)
+          throw triton::exceptions::Os("ElfLoader::load(): Cannot mmap " + path + ".");
+
+        this->image       = reinterpret_cast<const triton::uint8*>(addr);
+        this->imageSize   = static_cast<triton::usize>(st.st_size);
+        this->baseAddress = base;
+        this->lazy        = lazy;
+
+        try {
+          this->parseHeader();
+          this->parseSegments();
+          this->parseDynamic();
+          this->initPages();
+
+          if (this->lazy && this->pendingPages) {
+            this->api.addCallback(this->loadCallback);
+            this->api.addCallback(this->storeCallback);
+            this->finalizer = this->api.addCallbacksFinalizer([this]() { this->mapAll(); });
+            this->callbacksRegistered = true;
+          }
+          else {
+            for (const auto& seg : this->segments) {
+              this->api.setConcreteMemoryAreaValue(seg.vaddr, this->image + seg.offset, seg.filesz);
+              if (seg.memsz > seg.filesz)
+                this->api.setConcreteMemoryAreaValue(seg.vaddr + seg.filesz, std::vector<triton::uint8>(seg.memsz - seg.filesz, 0));
+            }
+          }
+
+          for (const auto& reloc : this->relocations)
+            this->applyRelocation(reloc);
+
+          if (this->pendingPages == 0)
+            this->removeCallbacks();
+        }
+        catch (const triton::exceptions::Exception&) {
+          this->release();
+          throw;
+        }
+      }
+
+
+      void ElfLoader::mapAll(void) {
+        for (const auto& seg : this->segments) {
+          if (seg.memsz)
+            this->mapRange(seg.vaddr, seg.memsz);
+        }
+
+        /* Back to the fast path of the concrete memory once nothing is pending */
+        this->removeCallbacks();
+      }
+
+
+      /* The segments may share pages, the page ranges are merged */
+      void ElfLoader::initPages(void) {
+        std::vector<std::pair<triton::uint64, triton::uint64>> ranges;
+        triton::uint64 next = 0;
+
+        for (const auto& seg : this->segments) {
+          if (seg.memsz)
+            ranges.push_back(std::make_pair(seg.vaddr / ELF_PAGE_SIZE, (seg.vaddr + seg.memsz - 1) / ELF_PAGE_SIZE));
+        }
+        std::sort(ranges.begin(), ranges.end());
+
+        this->pendingPages = 0;
+        this->firstPage    = ranges.empty() ? 0 : ranges.front().first;
+        this->lastPage     = 0;
+
+        for (const auto& range : ranges) {
+          triton::uint64 first = std::max(range.first, next);
+          if (first <= range.second) {
+            this->pendingPages += range.second - first + 1;
+            next = range.second + 1;
+          }
+          this->lastPage = std::max(this->lastPage, range.second);
+        }
+      }
+
+
+      triton::uint64 ElfLoader::getBaseAddress(void) const {
+        return this->baseAddress;
+      }
+
+
+      triton::uint64 ElfLoader::getEntryPoint(void) const {
+        return this->entryPoint;
+      }
+
+
+      const std::vector<ElfSegment>& ElfLoader::getSegments(void) const {
+        return this->segments;
+      }
+
+
+      const std::vector<ElfRelocation>& ElfLoader::getRelocations(void) const {
+        return this->relocations;
+      }
+
+
+      const std::set<std::string>& ElfLoader::getImportedSymbols(void) const {
+        return this->imports;
+      }
+
+
+      void ElfLoader::bindImport(const std::string& name, triton::uint64 addr) {
+        auto it = this->bindings.find(name);
+        if (it != this->bindings.end())
+          this->stubs.erase(it->second);
+
+        this->bindings[name] = addr;
+        this->stubs[addr]    = name;
+
+        for (const auto& reloc : this->relocations) {
+          if (reloc.symbol == name)
+            this->applyRelocation(reloc);
+        }
+      }
+
+
+      void ElfLoader::bindImports(triton::uint64 stubBase, triton::uint64 stubSize) {
+        triton::uint64 addr = stubBase;
+
+        for (const auto& name : this->imports) {
+          if (this->bindings.find(name) != this->bindings.end())
+            continue;
+          this->bindImport(name, addr);
+          addr += stubSize;
+        }
+      }
+
+
+      const std::map<triton::uint64, std::string>& ElfLoader::getImportStubs(void) const {
+        return this->stubs;
+      }
+
+
+      bool ElfLoader::isImportStub(triton::uint64 addr) const {
+        return (this->stubs.find(addr) != this->stubs.end());
+      }
+
+
+      const std::string& ElfLoader::getImportName(triton::uint64 addr) const {
+        auto it = this->stubs.find(addr);
+        if (it == this->stubs.end())
+          throw triton::exceptions::Os("ElfLoader::getImportName(): No imported symbol is bound to this address.");
+        return it->second;
+      }
+
+    }; /* unix namespace */
+  }; /* os namespace */
+}; /* triton namespace */
+
+#endif /* __unix__ || __APPLE__ */
@@ -0,0 +1,606 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+
+#include <triton/api.hpp>
+#include <triton/cpuSize.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/libcSummaries.hpp>
+
+
+
+namespace triton {
+  namespace os {
+    namespace unix {
+
+      /* Routine names */
+      static const std::map<std::string, triton::os::unix::libc_e> libcRoutines = {
+        {"calloc",  LIBC_CALLOC},
+        {"free",    LIBC_FREE},
+        {"malloc",  LIBC_MALLOC},
+        {"memcpy",  LIBC_MEMCPY},
+        {"memmove", LIBC_MEMMOVE},
+        {"memset",  LIBC_MEMSET},
+        {"printf",  LIBC_PRINTF},
+        {"putchar", LIBC_PUTCHAR},
+        {"puts",    LIBC_PUTS},
+        {"strcmp",  LIBC_STRCMP},
+        {"strlen",  LIBC_STRLEN},
+      };
+
+
+      LibcSummaries::LibcSummaries(triton::API& api)
+        : api(api) {
+        this->heapCurrent = triton::os::unix::LIBC_HEAP_BASE;
+      }
+
+
+      triton::os::unix::libc_e LibcSummaries::getRoutine(const std::string& name) {
+        auto it = libcRoutines.find(name);
+        if (it == libcRoutines.end())
+          return LIBC_INVALID;
+        return it->second;
+      }
+
+
+      std::string LibcSummaries::getRoutineName(triton::os::unix::libc_e routine) {
+        for (const auto& it : libcRoutines) {
+          if (it.second == routine)
+            return it.first;
+        }
+        throw triton::exceptions::Os("LibcSummaries::getRoutineName(): Invalid routine.");
+      }
+
+
+      void LibcSummaries::bind(triton::uint64 addr, triton::os::unix::libc_e routine) {
+        if (routine == LIBC_INVALID)
+          throw triton::exceptions::Os("LibcSummaries::bind(): Invalid routine.");
+        this->bindings[addr] = routine;
+      }
+
+
+      void LibcSummaries::bind(triton::uint64 addr, const std::string& name) {
+        triton::os::unix::libc_e routine = LibcSummaries::getRoutine(name);
+        if (routine == LIBC_INVALID)
+          throw triton::exceptions::Os("LibcSummaries::bind(): Routine not supported.");
+        this->bind(addr, routine);
+      }
+
+
+      triton::usize LibcSummaries::bindImports(const triton::os::unix::ElfLoader& loader) {
+        triton::usize count = 0;
+
+        for (const auto& stub : loader.getImportStubs()) {
+          triton::os::unix::libc_e routine = LibcSummaries::getRoutine(stub.second);
+          if (routine != LIBC_INVALID) {
+            this->bind(stub.first, routine);
+            count++;
+          }
+        }
+
+        return count;
+      }
+
+
+      void LibcSummaries::unbind(triton::uint64 addr) {
+        this->bindings.erase(addr);
+      }
+
+
+      bool LibcSummaries::isBound(triton::uint64 addr) const {
+        return (this->bindings.find(addr) != this->bindings.end());
+      }
+
+
+      const std::map<triton::uint64, triton::os::unix::libc_e>& LibcSummaries::getBindings(void) const {
+        return this->bindings;
+      }
+
+
+      void LibcSummaries::setHeapBase(triton::uint64 addr) {
+        this->heapCurrent = addr;
+      }
+
+
+      const std::string& LibcSummaries::getOutput(void) const {
+        return this->output;
+      }
+
+
+      bool LibcSummaries::isSymbolic(void) const {
+        return this->api.isSymbolicEngineEnabled();
+      }
+
+
+      const triton::arch::Register& LibcSummaries::getArgumentRegister(triton::uint32 index) const {
+        static const triton::arch::register_e x8664[] = {
+          triton::arch::ID_REG_X86_RDI, triton::arch::ID_REG_X86_RSI, triton::arch::ID_REG_X86_RDX,
+          triton::arch::ID_REG_X86_RCX, triton::arch::ID_REG_X86_R8,  triton::arch::ID_REG_X86_R9
+        };
+        static const triton::arch::register_e aarch64[] = {
+          triton::arch::ID_REG_AARCH64_X0, triton::arch::ID_REG_AARCH64_X1, triton::arch::ID_REG_AARCH64_X2, triton::arch::ID_REG_AARCH64_X3,
+          triton::arch::ID_REG_AARCH64_X4, triton::arch::ID_REG_AARCH64_X5, triton::arch::ID_REG_AARCH64_X6, triton::arch::ID_REG_AARCH64_X7
+        };
+
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86_64:
+            if (index < 6)
+              return this->api.getRegister(x8664[index]);
+            break;
+          case triton::arch::ARCH_AARCH64:
+            if (index < 8)
+              return this->api.getRegister(aarch64[index]);
+            break;
+          default:
+            throw triton::exceptions::Os("LibcSummaries::getArgumentRegister(): Only the x86-64 and AArch64 ABIs are supported.");
+        }
+
+        throw triton::exceptions::Os("LibcSummaries::getArgumentRegister(): The argument is not passed by register.");
+      }
+
+
+      triton::uint64 LibcSummaries::getArgument(triton::uint32 index) const {
+        triton::uint64 sp = 0;
+
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86_64:
+            if (index < 6)
+              break;
+            /* Skip the return address */
+            sp = this->api.getConcreteRegisterValue(this->api.getRegister(triton::arch::ID_REG_X86_RSP)).convert_to<triton::uint64>();
+            return this->api.getConcreteMemoryValue(triton::arch::MemoryAccess(sp + (index - 6 + 1) * QWORD_SIZE, QWORD_SIZE)).convert_to<triton::uint64>();
+          case triton::arch::ARCH_AARCH64:
+            if (index < 8)
+              break;
+            sp = this->api.getConcreteRegisterValue(this->api.getRegister(triton::arch::ID_REG_AARCH64_SP)).convert_to<triton::uint64>();
+            return this->api.getConcreteMemoryValue(triton::arch::MemoryAccess(sp + (index - 8) * QWORD_SIZE, QWORD_SIZE)).convert_to<triton::uint64>();
+          default:
+            break;
+        }
+
+        return this->api.getConcreteRegisterValue(this->getArgumentRegister(index)).convert_to<triton::uint64>();
+      }
+
+
+      triton::uint64 LibcSummaries::getStringLength(triton::uint64 addr) const {
+        triton::uint64 length = 0;
+
+        while (length < triton::os::unix::LIBC_MAX_STRING_LENGTH && this->api.getConcreteMemoryValue(addr + length) != 0)
+          length++;
+
+        return length;
+      }
+
+
+      std::string LibcSummaries::getString(triton::uint64 addr) const {
+        std::vector<triton::uint8> area = this->api.getConcreteMemoryAreaValue(addr, this->getStringLength(addr));
+        return std::string(area.begin(), area.end());
+      }
+
+
+      triton::ast::SharedAbstractNode LibcSummaries::getByteAst(triton::uint64 addr) {
+        return this->api.getMemoryAst(triton::arch::MemoryAccess(addr, BYTE_SIZE));
+      }
+
+
+      void LibcSummaries::setReturn(triton::uint64 value, const triton::ast::SharedAbstractNode& node, const std::string& comment) {
+        const triton::arch::Register* retReg = nullptr;
+        const triton::arch::Register* pcReg  = nullptr;
+        triton::uint64 retAddr               = 0;
+
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86_64: {
+            const triton::arch::Register& sp = this->api.getRegister(triton::arch::ID_REG_X86_RSP);
+            triton::uint64 rsp = this->api.getConcreteRegisterValue(sp).convert_to<triton::uint64>();
+
+            /* Simulate the ret */
+            retAddr = this->api.getConcreteMemoryValue(triton::arch::MemoryAccess(rsp, QWORD_SIZE)).convert_to<triton::uint64>();
+            this->api.concretizeRegister(sp);
+            this->api.setConcreteRegisterValue(sp, rsp + QWORD_SIZE);
+
+            retReg = &this->api.getRegister(triton::arch::ID_REG_X86_RAX);
+            pcReg  = &this->api.getRegister(triton::arch::ID_REG_X86_RIP);
+            break;
+          }
+
+          case triton::arch::ARCH_AARCH64:
+            retAddr = this->api.getConcreteRegisterValue(this->api.getRegister(triton::arch::ID_REG_AARCH64_X30)).convert_to<triton::uint64>();
+            retReg  = &this->api.getRegister(triton::arch::ID_REG_AARCH64_X0);
+            pcReg   = &this->api.getRegister(triton::arch::ID_REG_AARCH64_PC);
+            break;
+
+          default:
+            throw triton::exceptions::Os("LibcSummaries::setReturn(): Only the x86-64 and AArch64 ABIs are supported.");
+        }
+
+        this->api.setTaintRegister(*retReg, false);
+        if (node != nullptr) {
+          /* The concrete value is synchronized with the evaluation of the node */
+          triton::ast::AstContext& astCtxt = this->api.getAstContext();
+          triton::ast::SharedAbstractNode ret = node;
+          if (ret->getBitvectorSize() < retReg->getBitSize())
+            ret = astCtxt.zx(retReg->getBitSize() - ret->getBitvectorSize(), ret);
+          this->api.assignSymbolicExpressionToRegister(this->api.newSymbolicExpression(ret, comment), *retReg);
+        }
+        else {
+          this->api.concretizeRegister(*retReg);
+          this->api.setConcreteRegisterValue(*retReg, value);
+        }
+
+        this->api.concretizeRegister(*pcReg);
+        this->api.setConcreteRegisterValue(*pcReg, retAddr);
+      }
+
+
+      void LibcSummaries::copy(triton::uint64 dst, triton::uint64 src, triton::uint64 size) {
+        std::vector<triton::ast::SharedAbstractNode> nodes;
+        std::vector<bool> taints;
+
+        if (size == 0)
+          return;
+
+        /* Read everything first, the areas may overlap */
+        std::vector<triton::uint8> area = this->api.getConcreteMemoryAreaValue(src, size);
+
+        if (this->isSymbolic()) {
+          nodes.resize(size);
+          for (triton::uint64 i = 0; i < size; i++) {
+            if (this->api.isMemorySymbolized(src + i))
+              nodes[i] = this->getByteAst(src + i);
+          }
+        }
+
+        if (this->api.isTaintEngineEnabled()) {
+          taints.resize(size);
+          for (triton::uint64 i = 0; i < size; i++)
+            taints[i] = this->api.isMemoryTainted(src + i);
+        }
+
+        this->api.setConcreteMemoryAreaValue(dst, area);
+
+        for (triton::uint64 i = 0; i < size; i++) {
+          if (!nodes.empty()) {
+            if (nodes[i] != nullptr)
+              this->api.assignSymbolicExpressionToMemory(this->api.newSymbolicExpression(nodes[i], "memcpy"), triton::arch::MemoryAccess(dst + i, BYTE_SIZE));
+            else
+              this->api.concretizeMemory(dst + i);
+          }
+          if (!taints.empty())
+            this->api.setTaintMemory(triton::arch::MemoryAccess(dst + i, BYTE_SIZE), taints[i]);
+        }
+      }
+
+
+      triton::uint64 LibcSummaries::allocate(triton::uint64 size) {
+        triton::uint64 addr = this->heapCurrent;
+
+        /* The heap is never reused, fresh chunks are unmapped and thus zero filled */
+        size = (size + 0xf) & ~static_cast<triton::uint64>(0xf);
+        this->heapCurrent += (size ? size : 0x10);
+        this->allocations[addr] = size;
+
+        return addr;
+      }
+
+
+      std::string LibcSummaries::format(triton::uint64 fmt, triton::uint32 arg) const {
+        std::string str = this->getString(fmt);
+        std::string out;
+
+        for (triton::usize i = 0; i < str.size(); i++) {
+          if (str[i] != '%') {
+            out += str[i];
+            continue;
+          }
+
+          /* %[flags][width][.precision][length]conversion */
+          triton::usize start = i++;
+          std::string spec = "%";
+          while (i < str.size() && std::string("-+ #0").find(str[i]) != std::string::npos)
+            spec += str[i++];
+          while (i < str.size() && ((str[i] >= '0' && str[i] <= '9') || str[i] == '.'))
+            spec += str[i++];
+
+          triton::uint32 length = 32;
+          while (i < str.size() && std::string("hlzjt").find(str[i]) != std::string::npos) {
+            if (str[i] == 'h')
+              length = (length == 16) ? 8 : 16;
+            else
+              length = 64;
+            i++;
+          }
+
+          if (i >= str.size()) {
+            out += str.substr(start);
+            break;
+          }
+
+          char buffer[128] = {0};
+          char conv = str[i];
+          switch (conv) {
+            case '%':
+              out += '%';
+              break;
+
+            case 'd':
+            case 'i': {
+              triton::uint64 value = this->getArgument(arg++);
+              triton::sint64 svalue = static_cast<triton::sint64>(value << (64 - length)) >> (64 - length);
+              snprintf(buffer, sizeof(buffer), (spec + "lld").c_str(), static_cast<long long>(svalue));
+              out += buffer;
+              break;
+            }
+
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o': {
+              triton::uint64 value = this->getArgument(arg++);
+              if (length < 64)
+                value &= ((1ULL << length) - 1);
+              snprintf(buffer, sizeof(buffer), (spec + "ll" + conv).c_str(), static_cast<unsigned long long>(value));
+              out += buffer;
+              break;
+            }
+
+            case 'p':
+              snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(this->getArgument(arg++)));
+              out += buffer;
+              break;
+
+            case 'c':
+              snprintf(buffer, sizeof(buffer), (spec + "c").c_str(), static_cast<int>(this->getArgument(arg++) & 0xff));
+              out += buffer;
+              break;
+
+            case 's': {
+              std::string value = this->getString(this->getArgument(arg++));
+              std::vector<char> sbuffer(value.size() + sizeof(buffer));
+              snprintf(sbuffer.data(), sbuffer.size(), (spec + "s").c_str(), value.c_str());
+              out += sbuffer.data();
+              break;
+            }
+
+            /* Floating points are passed by vector registers and are not supported */
+            default:
+              out += str.substr(start, i - start + 1);
+              break;
+          }
+        }
+
+        return out;
+      }
+
+
+      void LibcSummaries::libcCalloc(void) {
+        triton::uint64 size = this->getArgument(0) * this->getArgument(1);
+        this->setReturn(this->allocate(size), nullptr, "calloc");
+      }
+
+
+      void LibcSummaries::libcFree(void) {
+        this->allocations.erase(this->getArgument(0));
+        this->setReturn(0, nullptr, "free");
+      }
+
+
+      void LibcSummaries::libcMalloc(void) {
+        this->setReturn(this->allocate(this->getArgument(0)), nullptr, "malloc");
+      }
+
+
+      void LibcSummaries::libcMemcpy(void) {
+        triton::uint64 dst = this->getArgument(0);
+        this->copy(dst, this->getArgument(1), this->getArgument(2));
+        this->setReturn(dst, nullptr, "memcpy");
+      }
+
+
+      void LibcSummaries::libcMemset(void) {
+        const triton::arch::Register& reg = this->getArgumentRegister(1);
+        triton::uint64 dst                = this->getArgument(0);
+        triton::uint64 size               = this->getArgument(2);
+        triton::uint8 value               = this->getArgument(1) & 0xff;
+
+        this->api.setConcreteMemoryAreaValue(dst, std::vector<triton::uint8>(size, value));
+
+        if (this->isSymbolic()) {
+          triton::ast::SharedAbstractNode node = nullptr;
+          if (this->api.isRegisterSymbolized(reg))
+            node = this->api.getAstContext().extract(7, 0, this->api.getRegisterAst(reg));
+
+          for (triton::uint64 i = 0; i < size; i++) {
+            if (node != nullptr)
+              this->api.assignSymbolicExpressionToMemory(this->api.newSymbolicExpression(node, "memset"), triton::arch::MemoryAccess(dst + i, BYTE_SIZE));
+            else
+              this->api.concretizeMemory(dst + i);
+          }
+        }
+
+        if (this->api.isTaintEngineEnabled()) {
+          bool taint = this->api.isRegisterTainted(reg);
+          for (triton::uint64 i = 0; i < size; i++)
+            this->api.setTaintMemory(triton::arch::MemoryAccess(dst + i, BYTE_SIZE), taint);
+        }
+
+        this->setReturn(dst, nullptr, "memset");
+      }
+
+
+      void LibcSummaries::libcPrintf(void) {
+        std::string str = this->format(this->getArgument(0), 1);
+        this->output += str;
+        this->setReturn(str.size(), nullptr, "printf");
+      }
+
+
+      void LibcSummaries::libcPutchar(void) {
+        triton::uint8 c = this->getArgument(0) & 0xff;
+        this->output += static_cast<char>(c);
+        this->setReturn(c, nullptr, "putchar");
+      }
+
+
+      void LibcSummaries::libcPuts(void) {
+        std::string str = this->getString(this->getArgument(0));
+        this->output += str + "\n";
+        this->setReturn(str.size() + 1, nullptr, "puts");
+      }
+
+
+      void LibcSummaries::libcStrcmp(void) {
+        triton::ast::AstContext& astCtxt     = this->api.getAstContext();
+        triton::ast::SharedAbstractNode node = nullptr;
+        triton::uint64 s1                    = this->getArgument(0);
+        triton::uint64 s2                    = this->getArgument(1);
+        triton::uint64 index                 = 0;
+        triton::uint8 c1                     = 0;
+        triton::uint8 c2                     = 0;
+
+        /* Concrete comparison */
+        while (true) {
+          c1 = this->api.getConcreteMemoryValue(s1 + index);
+          c2 = this->api.getConcreteMemoryValue(s2 + index);
+          if (c1 != c2 || c1 == 0 || index >= triton::os::unix::LIBC_MAX_STRING_LENGTH)
+            break;
+          index++;
+        }
+
+        triton::sint32 result = static_cast<triton::sint32>(c1) - static_cast<triton::sint32>(c2);
+
+        /*
+         * res = ite(a[0] != b[0] || a[0] == 0, a[0] - b[0], ite(a[1] != b[1] || a[1] == 0, a[1] - b[1], ...))
+         * One level per position involving a symbolic byte. If the concrete stop position is symbolic, the
+         * comparison may go on past it, so the chain is extended up to the first concrete mismatch or terminator.
+         */
+        if (this->isSymbolic()) {
+          bool symbolized     = false;
+          triton::uint64 end  = index;
+          triton::sint32 last = result;
+
+          if (this->api.isMemorySymbolized(s1 + index) || this->api.isMemorySymbolized(s2 + index)) {
+            last = 0;
+            while (end < triton::os::unix::LIBC_MAX_STRING_LENGTH) {
+              end++;
+              if (this->api.isMemorySymbolized(s1 + end) || this->api.isMemorySymbolized(s2 + end))
+                continue;
+              c1 = this->api.getConcreteMemoryValue(s1 + end);
+              c2 = this->api.getConcreteMemoryValue(s2 + end);
+              if (c1 != c2 || c1 == 0) {
+                last = static_cast<triton::sint32>(c1) - static_cast<triton::sint32>(c2);
+                break;
+              }
+            }
+          }
+
+          for (triton::sint64 i = end; i >= 0; i--) {
+            if (!this->api.isMemorySymbolized(s1 + i) && !this->api.isMemorySymbolized(s2 + i)) {
+              if (node == nullptr)
+                node = astCtxt.bv(static_cast<triton::uint32>(last), DWORD_SIZE_BIT);
+              continue;
+            }
+
+            triton::ast::SharedAbstractNode a    = this->getByteAst(s1 + i);
+            triton::ast::SharedAbstractNode b    = this->getByteAst(s2 + i);
+            triton::ast::SharedAbstractNode diff = astCtxt.bvsub(astCtxt.zx(24, a), astCtxt.zx(24, b));
+            triton::ast::SharedAbstractNode cond = astCtxt.lor(astCtxt.distinct(a, b), astCtxt.equal(a, astCtxt.bv(0, BYTE_SIZE_BIT)));
+
+            node       = astCtxt.ite(cond, diff, (node != nullptr) ? node : astCtxt.bv(static_cast<triton::uint32>(last), DWORD_SIZE_BIT));
+            symbolized = true;
+          }
+
+          if (!symbolized)
+            node = nullptr;
+        }
+
+        this->setReturn(static_cast<triton::uint32>(result), node, "strcmp");
+      }
+
+
+      void LibcSummaries::libcStrlen(void) {
+        triton::ast::AstContext& astCtxt     = this->api.getAstContext();
+        triton::ast::SharedAbstractNode node = nullptr;
+        triton::uint64 str                   = this->getArgument(0);
+        triton::uint64 length                = this->getStringLength(str);
+
+        /*
+         * len = ite(s[0] == 0, 0, ite(s[1] == 0, 1, ... n))
+         * One level per symbolic byte. If the concrete terminator is symbolic, the string may go on
+         * past it, so the chain is extended up to the first concrete terminator.
+         */
+        if (this->isSymbolic()) {
+          triton::uint64 end = length;
+
+          if (length < triton::os::unix::LIBC_MAX_STRING_LENGTH && this->api.isMemorySymbolized(str + length)) {
+            while (end < triton::os::unix::LIBC_MAX_STRING_LENGTH) {
+              end++;
+              if (!this->api.isMemorySymbolized(str + end) && this->api.getConcreteMemoryValue(str + end) == 0)
+                break;
+            }
+          }
+
+          for (triton::uint64 i = end; i > 0; i--) {
+            if (!this->api.isMemorySymbolized(str + i - 1))
+              continue;
+
+            if (node == nullptr)
+              node = astCtxt.bv(end, QWORD_SIZE_BIT);
+
+            triton::ast::SharedAbstractNode cond = astCtxt.equal(this->getByteAst(str + i - 1), astCtxt.bv(0, BYTE_SIZE_BIT));
+            node = astCtxt.ite(cond, astCtxt.bv(i - 1, QWORD_SIZE_BIT), node);
+          }
+        }
+
+        this->setReturn(length, node, "strlen");
+      }
+
+
+      bool LibcSummaries::emulate(void) {
+        triton::uint64 pc = 0;
+
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86_64:
+            pc = this->api.getConcreteRegisterValue(this->api.getRegister(triton::arch::ID_REG_X86_RIP)).convert_to<triton::uint64>();
+            break;
+          case triton::arch::ARCH_AARCH64:
+            pc = this->api.getConcreteRegisterValue(this->api.getRegister(triton::arch::ID_REG_AARCH64_PC)).convert_to<triton::uint64>();
+            break;
+          default:
+            throw triton::exceptions::Os("LibcSummaries::emulate(): Only the x86-64 and AArch64 ABIs are supported.");
+        }
+
+        auto it = this->bindings.find(pc);
+        if (it == this->bindings.end())
+          return false;
+
+        switch (it->second) {
+          case LIBC_CALLOC:   this->libcCalloc();   break;
+          case LIBC_FREE:     this->libcFree();     break;
+          case LIBC_MALLOC:   this->libcMalloc();   break;
+          case LIBC_MEMCPY:   this->libcMemcpy();   break;
+          case LIBC_MEMMOVE:  this->libcMemcpy();   break;
+          case LIBC_MEMSET:   this->libcMemset();   break;
+          case LIBC_PRINTF:   this->libcPrintf();   break;
+          case LIBC_PUTCHAR:  this->libcPutchar();  break;
+          case LIBC_PUTS:     this->libcPuts();     break;
+          case LIBC_STRCMP:   this->libcStrcmp();   break;
+          case LIBC_STRLEN:   this->libcStrlen();   break;
+          default:
+            throw triton::exceptions::Os("LibcSummaries::emulate(): Invalid routine.");
+        }
+
+        return true;
+      }
+
+    }; /* unix namespace */
+  }; /* os namespace */
+}; /* triton namespace */
+
+#endif /* __unix__ || __APPLE__ */
@@ -0,0 +1,647 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+
+#include <triton/aarch64Specifications.hpp>
+#include <triton/api.hpp>
+#include <triton/cpuSize.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/syscallEmulator.hpp>
+#include <triton/x86Specifications.hpp>
+
+
+
+namespace triton {
+  namespace os {
+    namespace unix {
+
+      /* Linux constants of the emulated ABIs. They are prefixed to not collide with the host headers. */
+      enum linux_e {
+        LINUX_ENOENT            = 2,
+        LINUX_EBADF             = 9,
+        LINUX_EINVAL            = 22,
+        LINUX_ENOTTY            = 25,
+        LINUX_ENOSYS            = 38,
+        LINUX_O_ACCMODE         = 0x3,
+        LINUX_O_CREAT           = 0x40,
+        LINUX_O_TRUNC           = 0x200,
+        LINUX_O_APPEND          = 0x400,
+        LINUX_SEEK_SET          = 0,
+        LINUX_SEEK_CUR          = 1,
+        LINUX_SEEK_END          = 2,
+        LINUX_MAP_FIXED         = 0x10,
+        LINUX_MAP_ANONYMOUS     = 0x20,
+        LINUX_AT_EMPTY_PATH     = 0x1000,
+        LINUX_S_IFCHR           = 0020000,
+        LINUX_S_IFREG           = 0100000,
+        LINUX_ARCH_SET_FS       = 0x1002,
+        LINUX_ARCH_GET_FS       = 0x1003,
+        LINUX_PAGE_SIZE         = 0x1000,
+        LINUX_MAX_RW_COUNT      = 0x7ffff000,
+        LINUX_PID               = 1000,
+        LINUX_UID               = 1000,
+      };
+
+      /* x86-64 syscall numbers */
+      enum x8664_syscall_e {
+        X8664_SYS_READ            = 0,
+        X8664_SYS_WRITE           = 1,
+        X8664_SYS_OPEN            = 2,
+        X8664_SYS_CLOSE           = 3,
+        X8664_SYS_FSTAT           = 5,
+        X8664_SYS_LSEEK           = 8,
+        X8664_SYS_MMAP            = 9,
+        X8664_SYS_MPROTECT        = 10,
+        X8664_SYS_MUNMAP          = 11,
+        X8664_SYS_BRK             = 12,
+        X8664_SYS_IOCTL           = 16,
+        X8664_SYS_READV           = 19,
+        X8664_SYS_WRITEV          = 20,
+        X8664_SYS_GETPID          = 39,
+        X8664_SYS_EXIT            = 60,
+        X8664_SYS_GETUID          = 102,
+        X8664_SYS_GETGID          = 104,
+        X8664_SYS_GETEUID         = 107,
+        X8664_SYS_GETEGID         = 108,
+        X8664_SYS_ARCH_PRCTL      = 158,
+        X8664_SYS_GETTID          = 186,
+        X8664_SYS_SET_TID_ADDRESS = 218,
+        X8664_SYS_EXIT_GROUP      = 231,
+        X8664_SYS_OPENAT          = 257,
+        X8664_SYS_NEWFSTATAT      = 262,
+      };
+
+      /* AArch64 syscall numbers (asm-generic) */
+      enum aarch64_syscall_e {
+        AARCH64_SYS_IOCTL           = 29,
+        AARCH64_SYS_OPENAT          = 56,
+        AARCH64_SYS_CLOSE           = 57,
+        AARCH64_SYS_LSEEK           = 62,
+        AARCH64_SYS_READ            = 63,
+        AARCH64_SYS_WRITE           = 64,
+        AARCH64_SYS_READV           = 65,
+        AARCH64_SYS_WRITEV          = 66,
+        AARCH64_SYS_NEWFSTATAT      = 79,
+        AARCH64_SYS_FSTAT           = 80,
+        AARCH64_SYS_EXIT            = 93,
+        AARCH64_SYS_EXIT_GROUP      = 94,
+        AARCH64_SYS_SET_TID_ADDRESS = 96,
+        AARCH64_SYS_GETPID          = 172,
+        AARCH64_SYS_GETUID          = 174,
+        AARCH64_SYS_GETEUID         = 175,
+        AARCH64_SYS_GETGID          = 176,
+        AARCH64_SYS_GETEGID         = 177,
+        AARCH64_SYS_GETTID          = 178,
+        AARCH64_SYS_BRK             = 214,
+        AARCH64_SYS_MUNMAP          = 215,
+        AARCH64_SYS_MMAP            = 222,
+        AARCH64_SYS_MPROTECT        = 226,
+      };
+
+
+      SyscallEmulator::SyscallEmulator(triton::API& api)
+        : api(api) {
+        this->brkBase     = 0;
+        this->brkCurrent  = 0;
+        this->mmapCurrent = triton::os::unix::SYSCALL_MMAP_BASE;
+        this->exited      = false;
+        this->exitCode    = 0;
+
+        const char* devices[] = {"/dev/stdin", "/dev/stdout", "/dev/stderr"};
+        for (triton::sint64 fd = 0; fd < 3; fd++) {
+          std::shared_ptr<triton::os::unix::VirtualFile> file = std::make_shared<triton::os::unix::VirtualFile>();
+          file->symbolize = false;
+          file->taint     = false;
+          file->device    = true;
+          this->files[devices[fd]] = file;
+
+          triton::os::unix::FileDescriptor& desc = this->fds[fd];
+          desc.path   = devices[fd];
+          desc.file   = file;
+          desc.offset = 0;
+          desc.append = (fd != 0);
+        }
+      }
+
+
+      void SyscallEmulator::addFile(const std::string& path, const std::vector<triton::uint8>& content, bool symbolize, bool taint) {
+        auto it = this->files.find(path);
+
+        /* Update in place so that the opened descriptors see the new content */
+        if (it == this->files.end()) {
+          it = this->files.insert(std::make_pair(path, std::make_shared<triton::os::unix::VirtualFile>())).first;
+          it->second->device = false;
+        }
+
+        it->second->content   = content;
+        it->second->symbolize = symbolize;
+        it->second->taint     = taint;
+      }
+
+
+      void SyscallEmulator::setStdin(const std::vector<triton::uint8>& content, bool symbolize, bool taint) {
+        this->addFile("/dev/stdin", content, symbolize, taint);
+
+        auto it = this->fds.find(0);
+        if (it != this->fds.end() && it->second.path == "/dev/stdin")
+          it->second.offset = 0;
+      }
+
+
+      const std::vector<triton::uint8>& SyscallEmulator::getFileContent(const std::string& path) const {
+        auto it = this->files.find(path);
+        if (it == this->files.end())
+          throw triton::exceptions::Os("SyscallEmulator::getFileContent(): No such file.");
+        return it->second->content;
+      }
+
+
+      bool SyscallEmulator::isFile(const std::string& path) const {
+        return (this->files.find(path) != this->files.end());
+      }
+
+
+      void SyscallEmulator::setBrk(triton::uint64 addr) {
+        this->brkBase    = addr;
+        this->brkCurrent = addr;
+      }
+
+
+      triton::uint64 SyscallEmulator::getBrk(void) const {
+        return this->brkCurrent;
+      }
+
+
+      void SyscallEmulator::setMmapBase(triton::uint64 addr) {
+        this->mmapCurrent = addr;
+      }
+
+
+      bool SyscallEmulator::hasExited(void) const {
+        return this->exited;
+      }
+
+
+      triton::sint32 SyscallEmulator::getExitCode(void) const {
+        return this->exitCode;
+      }
+
+
+      bool SyscallEmulator::isSyscall(const triton::arch::Instruction& inst) const {
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86_64:
+            return (inst.getType() == triton::arch::x86::ID_INS_SYSCALL);
+          case triton::arch::ARCH_AARCH64:
+            return (inst.getType() == triton::arch::aarch64::ID_INS_SVC);
+          default:
+            return false;
+        }
+      }
+
+
+      triton::uint64 SyscallEmulator::getRegisterValue(triton::arch::register_e id) const {
+        return this->api.getConcreteRegisterValue(this->api.getRegister(id)).convert_to<triton::uint64>();
+      }
+
+
+      std::string SyscallEmulator::readString(triton::uint64 addr) const {
+        std::string str;
+
+        /* Bounded by PATH_MAX */
+        for (triton::uint32 i = 0; i < 4096; i++) {
+          triton::uint8 c = this->api.getConcreteMemoryValue(addr + i);
+          if (c == 0)
+            break;
+          str += static_cast<char>(c);
+        }
+
+        return str;
+      }
+
+
+      triton::sint64 SyscallEmulator::allocateFd(void) const {
+        triton::sint64 fd = 0;
+
+        /* The lowest available descriptor, as the kernel does */
+        for (const auto& it : this->fds) {
+          if (it.first != fd)
+            break;
+          fd++;
+        }
+
+        return fd;
+      }
+
+
+      /* The guest controls the size, the data is copied by chunks of one page and a call transfers at most MAX_RW_COUNT bytes like Linux */
+      triton::sint64 SyscallEmulator::readFile(triton::os::unix::FileDescriptor& fd, triton::uint64 addr, triton::uint64 size) {
+        const std::vector<triton::uint8>& content = fd.file->content;
+
+        if (fd.offset >= content.size())
+          return 0;
+
+        triton::uint64 total = std::min<triton::uint64>(std::min<triton::uint64>(size, LINUX_MAX_RW_COUNT), content.size() - fd.offset);
+
+        for (triton::uint64 done = 0; done < total;) {
+          triton::uint64 n = std::min<triton::uint64>(total - done, LINUX_PAGE_SIZE);
+          this->api.setConcreteMemoryAreaValue(addr + done, content.data() + fd.offset, n);
+
+          /* The previous symbolic and taint states of the buffer are overwritten */
+          for (triton::uint64 i = done; i < done + n; i++) {
+            this->api.concretizeMemory(addr + i);
+
+            if (fd.file->symbolize)
+              this->api.convertMemoryToSymbolicVariable(triton::arch::MemoryAccess(addr + i, BYTE_SIZE), fd.path + "[" + std::to_string(fd.offset + i - done) + "]");
+
+            if (fd.file->taint)
+              this->api.taintMemory(addr + i);
+            else
+              this->api.untaintMemory(addr + i);
+          }
+
+          fd.offset += n;
+          done += n;
+        }
+
+        return total;
+      }
+
+
+      triton::sint64 SyscallEmulator::writeFile(triton::os::unix::FileDescriptor& fd, triton::uint64 addr, triton::uint64 size) {
+        std::vector<triton::uint8>& content = fd.file->content;
+        triton::uint64 total = std::min<triton::uint64>(size, LINUX_MAX_RW_COUNT);
+
+        if (total == 0)
+          return 0;
+
+        if (fd.append)
+          fd.offset = content.size();
+
+        for (triton::uint64 done = 0; done < total;) {
+          triton::uint64 n = std::min<triton::uint64>(total - done, LINUX_PAGE_SIZE);
+          std::vector<triton::uint8> buffer = this->api.getConcreteMemoryAreaValue(addr + done, n);
+
+          if (fd.offset + n > content.size())
+            content.resize(fd.offset + n);
+
+          std::copy(buffer.begin(), buffer.end(), content.begin() + fd.offset);
+          fd.offset += n;
+          done += n;
+        }
+
+        return total;
+      }
+
+
+      triton::sint64 SyscallEmulator::writeStat(const std::shared_ptr<triton::os::unix::VirtualFile>& file, triton::uint64 addr) {
+        triton::uint64 modeOffset = 0;
+        triton::usize  statSize   = 0;
+
+        /* struct stat differs between the two ABIs, only st_mode, st_size and st_blksize are filled */
+        if (this->api.getArchitecture() == triton::arch::ARCH_X86_64) {
+          modeOffset = 24;
+          statSize   = 144;
+        }
+        else {
+          modeOffset = 16;
+          statSize   = 128;
+        }
+
+        std::vector<triton::uint8> stat(statSize, 0);
+        triton::uint32 mode = file->device ? (LINUX_S_IFCHR | 0620) : (LINUX_S_IFREG | 0644);
+        triton::uint64 size = file->device ? 0 : file->content.size();
+
+        for (triton::uint32 i = 0; i < 4; i++)
+          stat[modeOffset + i] = (mode >> (i * 8)) & 0xff;
+
+        for (triton::uint32 i = 0; i < 8; i++) {
+          stat[48 + i] = (size >> (i * 8)) & 0xff;
+          stat[56 + i] = (static_cast<triton::uint64>(LINUX_PAGE_SIZE) >> (i * 8)) & 0xff;
+        }
+
+        this->api.setConcreteMemoryAreaValue(addr, stat);
+        for (triton::uint64 i = 0; i < statSize; i++)
+          this->api.concretizeMemory(addr + i);
+
+        return 0;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysRead(triton::sint64 fd, triton::uint64 addr, triton::uint64 size) {
+        auto it = this->fds.find(fd);
+        if (it == this->fds.end())
+          return -LINUX_EBADF;
+        return this->readFile(it->second, addr, size);
+      }
+
+
+      triton::sint64 SyscallEmulator::sysWrite(triton::sint64 fd, triton::uint64 addr, triton::uint64 size) {
+        auto it = this->fds.find(fd);
+        if (it == this->fds.end())
+          return -LINUX_EBADF;
+        return this->writeFile(it->second, addr, size);
+      }
+
+
+      triton::sint64 SyscallEmulator::sysVector(triton::sint64 fd, triton::uint64 iov, triton::uint64 count, bool write) {
+        triton::sint64 total = 0;
+
+        auto it = this->fds.find(fd);
+        if (it == this->fds.end())
+          return -LINUX_EBADF;
+
+        for (triton::uint64 i = 0; i < count; i++) {
+          triton::uint64 base = this->api.getConcreteMemoryValue(triton::arch::MemoryAccess(iov + i * 16, QWORD_SIZE)).convert_to<triton::uint64>();
+          triton::uint64 len  = this->api.getConcreteMemoryValue(triton::arch::MemoryAccess(iov + i * 16 + 8, QWORD_SIZE)).convert_to<triton::uint64>();
+          triton::sint64 n    = write ? this->writeFile(it->second, base, len) : this->readFile(it->second, base, len);
+
+          total += n;
+          if (static_cast<triton::uint64>(n) < len)
+            break;
+        }
+
+        return total;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysOpen(triton::uint64 path, triton::uint64 flags) {
+        std::string name = this->readString(path);
+
+        auto it = this->files.find(name);
+        if (it == this->files.end()) {
+          if ((flags & LINUX_O_CREAT) == 0)
+            return -LINUX_ENOENT;
+          this->addFile(name, std::vector<triton::uint8>());
+          it = this->files.find(name);
+        }
+
+        if ((flags & LINUX_O_TRUNC) && (flags & LINUX_O_ACCMODE) && !it->second->device)
+          it->second->content.clear();
+
+        triton::sint64 fd = this->allocateFd();
+        triton::os::unix::FileDescriptor& desc = this->fds[fd];
+        desc.path   = name;
+        desc.file   = it->second;
+        desc.offset = 0;
+        desc.append = (flags & LINUX_O_APPEND) != 0;
+
+        return fd;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysClose(triton::sint64 fd) {
+        if (this->fds.erase(fd) == 0)
+          return -LINUX_EBADF;
+        return 0;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysLseek(triton::sint64 fd, triton::sint64 offset, triton::uint64 whence) {
+        triton::sint64 base = 0;
+
+        auto it = this->fds.find(fd);
+        if (it == this->fds.end())
+          return -LINUX_EBADF;
+
+        switch (whence) {
+          case LINUX_SEEK_SET: base = 0; break;
+          case LINUX_SEEK_CUR: base = it->second.offset; break;
+          case LINUX_SEEK_END: base = it->second.file->content.size(); break;
+          default:
+            return -LINUX_EINVAL;
+        }
+
+        if (base + offset < 0)
+          return -LINUX_EINVAL;
+
+        it->second.offset = base + offset;
+        return it->second.offset;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysFstat(triton::sint64 fd, triton::uint64 addr) {
+        auto it = this->fds.find(fd);
+        if (it == this->fds.end())
+          return -LINUX_EBADF;
+        return this->writeStat(it->second.file, addr);
+      }
+
+
+      triton::sint64 SyscallEmulator::sysFstatat(triton::sint64 dirfd, triton::uint64 path, triton::uint64 addr, triton::uint64 flags) {
+        std::string name = this->readString(path);
+
+        if (name.empty() && (flags & LINUX_AT_EMPTY_PATH))
+          return this->sysFstat(dirfd, addr);
+
+        auto it = this->files.find(name);
+        if (it == this->files.end())
+          return -LINUX_ENOENT;
+
+        return this->writeStat(it->second, addr);
+      }
+
+
+      triton::sint64 SyscallEmulator::sysBrk(triton::uint64 addr) {
+        /* On failure, the kernel returns the current break. Without setBrk(), the libc falls back on mmap */
+        if (this->brkBase != 0 && addr >= this->brkBase)
+          this->brkCurrent = addr;
+        return this->brkCurrent;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysMmap(triton::uint64 addr, triton::uint64 size, triton::uint64 flags, triton::sint64 fd, triton::uint64 offset) {
+        std::shared_ptr<triton::os::unix::VirtualFile> file = nullptr;
+
+        if (size == 0)
+          return -LINUX_EINVAL;
+
+        if ((flags & LINUX_MAP_ANONYMOUS) == 0) {
+          auto it = this->fds.find(fd);
+          if (it == this->fds.end())
+            return -LINUX_EBADF;
+          file = it->second.file;
+        }
+
+        size = (size + LINUX_PAGE_SIZE - 1) & ~static_cast<triton::uint64>(LINUX_PAGE_SIZE - 1);
+
+        if ((flags & LINUX_MAP_FIXED) == 0) {
+          addr = this->mmapCurrent;
+          this->mmapCurrent += size;
+        }
+        else {
+          /* A fixed mapping replaces what was there */
+          this->api.unmapMemory(addr, size);
+          for (triton::uint64 i = 0; i < size; i++)
+            this->api.concretizeMemory(addr + i);
+        }
+
+        /* Anonymous pages are zero which is the default value of the unmapped memory */
+        if (file != nullptr && offset < file->content.size()) {
+          triton::uint64 n = std::min<triton::uint64>(size, file->content.size() - offset);
+          this->api.setConcreteMemoryAreaValue(addr, file->content.data() + offset, n);
+        }
+
+        return addr;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysMunmap(triton::uint64 addr, triton::uint64 size) {
+        if (addr & (LINUX_PAGE_SIZE - 1))
+          return -LINUX_EINVAL;
+
+        this->api.unmapMemory(addr, size);
+        return 0;
+      }
+
+
+      triton::sint64 SyscallEmulator::sysArchPrctl(triton::uint64 code, triton::uint64 addr) {
+        const triton::arch::Register& fs = this->api.getRegister(triton::arch::ID_REG_X86_FS);
+
+        switch (code) {
+          case LINUX_ARCH_SET_FS:
+            this->api.setConcreteRegisterValue(fs, addr);
+            this->api.concretizeRegister(fs);
+            return 0;
+
+          case LINUX_ARCH_GET_FS:
+            this->api.setConcreteMemoryValue(triton::arch::MemoryAccess(addr, QWORD_SIZE), this->api.getConcreteRegisterValue(fs));
+            return 0;
+
+          default:
+            return -LINUX_EINVAL;
+        }
+      }
+
+
+      triton::sint64 SyscallEmulator::sysExit(triton::sint64 code) {
+        this->exited   = true;
+        this->exitCode = static_cast<triton::sint32>(code & 0xff);
+        return 0;
+      }
+
+
+      bool SyscallEmulator::dispatchX8664(triton::uint64 number, const triton::uint64* args, triton::sint64& ret) {
+        switch (number) {
+          case X8664_SYS_READ:            ret = this->sysRead(args[0], args[1], args[2]); break;
+          case X8664_SYS_WRITE:           ret = this->sysWrite(args[0], args[1], args[2]); break;
+          case X8664_SYS_OPEN:            ret = this->sysOpen(args[0], args[1]); break;
+          case X8664_SYS_OPENAT:          ret = this->sysOpen(args[1], args[2]); break;
+          case X8664_SYS_CLOSE:           ret = this->sysClose(args[0]); break;
+          case X8664_SYS_FSTAT:           ret = this->sysFstat(args[0], args[1]); break;
+          case X8664_SYS_NEWFSTATAT:      ret = this->sysFstatat(args[0], args[1], args[2], args[3]); break;
+          case X8664_SYS_LSEEK:           ret = this->sysLseek(args[0], args[1], args[2]); break;
+          case X8664_SYS_MMAP:            ret = this->sysMmap(args[0], args[1], args[3], args[4], args[5]); break;
+          case X8664_SYS_MPROTECT:        ret = 0; break;
+          case X8664_SYS_MUNMAP:          ret = this->sysMunmap(args[0], args[1]); break;
+          case X8664_SYS_BRK:             ret = this->sysBrk(args[0]); break;
+          case X8664_SYS_IOCTL:           ret = -LINUX_ENOTTY; break;
+          case X8664_SYS_READV:           ret = this->sysVector(args[0], args[1], args[2], false); break;
+          case X8664_SYS_WRITEV:          ret = this->sysVector(args[0], args[1], args[2], true); break;
+          case X8664_SYS_ARCH_PRCTL:      ret = this->sysArchPrctl(args[0], args[1]); break;
+          case X8664_SYS_GETPID:          ret = LINUX_PID; break;
+          case X8664_SYS_GETTID:          ret = LINUX_PID; break;
+          case X8664_SYS_SET_TID_ADDRESS: ret = LINUX_PID; break;
+          case X8664_SYS_GETUID:          ret = LINUX_UID; break;
+          case X8664_SYS_GETEUID:         ret = LINUX_UID; break;
+          case X8664_SYS_GETGID:          ret = LINUX_UID; break;
+          case X8664_SYS_GETEGID:         ret = LINUX_UID; break;
+          case X8664_SYS_EXIT:            ret = this->sysExit(args[0]); break;
+          case X8664_SYS_EXIT_GROUP:      ret = this->sysExit(args[0]); break;
+          default:
+            ret = -LINUX_ENOSYS;
+            return false;
+        }
+        return true;
+      }
+
+
+      bool SyscallEmulator::dispatchAArch64(triton::uint64 number, const triton::uint64* args, triton::sint64& ret) {
+        switch (number) {
+          case AARCH64_SYS_READ:            ret = this->sysRead(args[0], args[1], args[2]); break;
+          case AARCH64_SYS_WRITE:           ret = this->sysWrite(args[0], args[1], args[2]); break;
+          case AARCH64_SYS_OPENAT:          ret = this->sysOpen(args[1], args[2]); break;
+          case AARCH64_SYS_CLOSE:           ret = this->sysClose(args[0]); break;
+          case AARCH64_SYS_FSTAT:           ret = this->sysFstat(args[0], args[1]); break;
+          case AARCH64_SYS_NEWFSTATAT:      ret = this->sysFstatat(args[0], args[1], args[2], args[3]); break;
+          case AARCH64_SYS_LSEEK:           ret = this->sysLseek(args[0], args[1], args[2]); break;
+          case AARCH64_SYS_MMAP:            ret = this->sysMmap(args[0], args[1], args[3], args[4], args[5]); break;
+          case AARCH64_SYS_MPROTECT:        ret = 0; break;
+          case AARCH64_SYS_MUNMAP:          ret = this->sysMunmap(args[0], args[1]); break;
+          case AARCH64_SYS_BRK:             ret = this->sysBrk(args[0]); break;
+          case AARCH64_SYS_IOCTL:           ret = -LINUX_ENOTTY; break;
+          case AARCH64_SYS_READV:           ret = this->sysVector(args[0], args[1], args[2], false); break;
+          case AARCH64_SYS_WRITEV:          ret = this->sysVector(args[0], args[1], args[2], true); break;
+          case AARCH64_SYS_GETPID:          ret = LINUX_PID; break;
+          case AARCH64_SYS_GETTID:          ret = LINUX_PID; break;
+          case AARCH64_SYS_SET_TID_ADDRESS: ret = LINUX_PID; break;
+          case AARCH64_SYS_GETUID:          ret = LINUX_UID; break;
+          case AARCH64_SYS_GETEUID:         ret = LINUX_UID; break;
+          case AARCH64_SYS_GETGID:          ret = LINUX_UID; break;
+          case AARCH64_SYS_GETEGID:         ret = LINUX_UID; break;
+          case AARCH64_SYS_EXIT:            ret = this->sysExit(args[0]); break;
+          case AARCH64_SYS_EXIT_GROUP:      ret = this->sysExit(args[0]); break;
+          default:
+            ret = -LINUX_ENOSYS;
+            return false;
+        }
+        return true;
+      }
+
+
+      bool SyscallEmulator::emulate(void) {
+        triton::arch::register_e retReg = triton::arch::ID_REG_INVALID;
+        triton::uint64 args[6]          = {0};
+        triton::uint64 number           = 0;
+        triton::sint64 ret              = 0;
+        bool handled                    = false;
+
+        switch (this->api.getArchitecture()) {
+          case triton::arch::ARCH_X86_64: {
+            const triton::arch::register_e regs[] = {
+              triton::arch::ID_REG_X86_RDI, triton::arch::ID_REG_X86_RSI, triton::arch::ID_REG_X86_RDX,
+              triton::arch::ID_REG_X86_R10, triton::arch::ID_REG_X86_R8,  triton::arch::ID_REG_X86_R9
+            };
+            for (triton::uint32 i = 0; i < 6; i++)
+              args[i] = this->getRegisterValue(regs[i]);
+            number  = this->getRegisterValue(triton::arch::ID_REG_X86_RAX);
+            retReg  = triton::arch::ID_REG_X86_RAX;
+            handled = this->dispatchX8664(number, args, ret);
+            break;
+          }
+
+          case triton::arch::ARCH_AARCH64: {
+            const triton::arch::register_e regs[] = {
+              triton::arch::ID_REG_AARCH64_X0, triton::arch::ID_REG_AARCH64_X1, triton::arch::ID_REG_AARCH64_X2,
+              triton::arch::ID_REG_AARCH64_X3, triton::arch::ID_REG_AARCH64_X4, triton::arch::ID_REG_AARCH64_X5
+            };
+            for (triton::uint32 i = 0; i < 6; i++)
+              args[i] = this->getRegisterValue(regs[i]);
+            number  = this->getRegisterValue(triton::arch::ID_REG_AARCH64_X8);
+            retReg  = triton::arch::ID_REG_AARCH64_X0;
+            handled = this->dispatchAArch64(number, args, ret);
+            break;
+          }
+
+          default:
+            throw triton::exceptions::Os("SyscallEmulator::emulate(): Only the x86-64 and AArch64 Linux ABIs are supported.");
+        }
+
+        const triton::arch::Register& reg = this->api.getRegister(retReg);
+        this->api.setConcreteRegisterValue(reg, static_cast<triton::uint64>(ret));
+        this->api.concretizeRegister(reg);
+
+        return handled;
+      }
+
+    }; /* unix namespace */
+  }; /* os namespace */
+}; /* triton namespace */
+
+#endif /* __unix__ || __APPLE__ */
@@ -0,0 +1,115 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the AST bytecode."""
+
+import random
+import unittest
+
+from triton import ARCH, TritonContext
+
+
+class TestAstBytecode(unittest.TestCase):
+
+    """Testing the AST bytecode."""
+
+    def setUp(self):
+        """Define the arch and the variables."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.Triton.getAstContext()
+        self.v8  = self.Triton.newSymbolicVariable(8)
+        self.v32 = self.Triton.newSymbolicVariable(32)
+        self.v64 = self.Triton.newSymbolicVariable(64)
+        self.x8  = self.astCtxt.variable(self.v8)
+        self.x32 = self.astCtxt.variable(self.v32)
+        self.x64 = self.astCtxt.variable(self.v64)
+
+    def check(self, node, rounds=64):
+        """Check that the bytecode and the AST agree on random assignments."""
+        bc = self.astCtxt.compile(node)
+        variables = bc.getVariables()
+        self.assertEqual(bc.getBitvectorSize(), node.getBitvectorSize())
+        for _ in range(rounds):
+            values = [random.getrandbits(v.getBitSize()) for v in variables]
+            for var, value in zip(variables, values):
+                self.Triton.setConcreteVariableValue(var, value)
+            self.assertEqual(bc.evaluate(values), node.evaluate())
+
+    def check_batch(self, node, count=200):
+        """Check that the batch evaluation agrees with the scalar one."""
+        bc = self.astCtxt.compile(node)
+        variables = bc.getVariables()
+        assignments = [[random.getrandbits(v.getBitSize()) for v in variables] for _ in range(count)]
+        self.assertEqual(bc.evaluateBatch(assignments), [bc.evaluate(values) for values in assignments])
+
+    def test_variables(self):
+        """Check the variables are sorted by id and deduplicated."""
+        node = self.astCtxt.bvadd(self.astCtxt.zx(24, self.x8), self.astCtxt.bvmul(self.x32, self.x32))
+        bc = self.astCtxt.compile(node)
+        self.assertEqual([v.getId() for v in bc.getVariables()], [self.v8.getId(), self.v32.getId()])
+
+    def test_arithmetic(self):
+        """Check arithmetic and logic operations."""
+        a = self.x32
+        b = self.astCtxt.extract(31, 0, self.x64)
+        self.check(self.astCtxt.bvadd(self.astCtxt.bvmul(a, b), self.astCtxt.bvsub(a, b)))
+        self.check(self.astCtxt.bvxor(self.astCtxt.bvand(a, b), self.astCtxt.bvor(self.astCtxt.bvnot(a), b)))
+        self.check(self.astCtxt.bvudiv(a, b))
+        self.check(self.astCtxt.bvurem(a, b))
+        self.check(self.astCtxt.bvsdiv(a, b))
+        self.check(self.astCtxt.bvsrem(a, b))
+        self.check(self.astCtxt.bvsmod(a, b))
+        self.check(self.astCtxt.bvshl(a, self.astCtxt.zx(24, self.x8)))
+        self.check(self.astCtxt.bvlshr(a, self.astCtxt.zx(24, self.x8)))
+        self.check(self.astCtxt.bvashr(a, self.astCtxt.zx(24, self.x8)))
+        self.check(self.astCtxt.bvrol(a, self.astCtxt.bv(7, 32)))
+        self.check(self.astCtxt.bvror(a, self.astCtxt.bv(7, 32)))
+
+    def test_wide(self):
+        """Check nodes wider than 64 bits."""
+        wide = self.astCtxt.concat([self.x64, self.x32, self.x8])
+        self.check(wide)
+        self.check(self.astCtxt.bvmul(wide, self.astCtxt.sx(32, self.astCtxt.concat([self.x32, self.x64]))))
+        self.check(self.astCtxt.extract(71, 8, self.astCtxt.bvadd(wide, wide)))
+
+    def test_conditions(self):
+        """Check comparisons and ite."""
+        cond = self.astCtxt.lor([
+            self.astCtxt.bvslt(self.x32, self.astCtxt.bv(0, 32)),
+            self.astCtxt.land([self.astCtxt.bvuge(self.x8, self.astCtxt.bv(0x40, 8)), self.astCtxt.lnot(self.astCtxt.equal(self.x8, self.astCtxt.bv(0x41, 8)))]),
+        ])
+        self.check(cond)
+        self.check(self.astCtxt.ite(cond, self.x64, self.astCtxt.sx(32, self.x32)))
+
+    def test_references(self):
+        """Check that references are compiled through."""
+        expr = self.Triton.newSymbolicExpression(self.astCtxt.bvadd(self.x32, self.astCtxt.bv(1, 32)))
+        ref = self.astCtxt.reference(expr)
+        self.check(self.astCtxt.bvmul(ref, ref))
+
+    def test_batch(self):
+        """Check the batch evaluation, including lanes which are not a multiple of the vector width."""
+        a = self.x32
+        b = self.astCtxt.extract(31, 0, self.x64)
+        s = self.astCtxt.zx(24, self.x8)
+        cond = self.astCtxt.land([self.astCtxt.bvslt(a, b), self.astCtxt.lnot(self.astCtxt.equal(self.x8, self.astCtxt.bv(0, 8)))])
+        self.check_batch(self.astCtxt.ite(cond, self.astCtxt.bvadd(a, b), self.astCtxt.bvxor(a, self.astCtxt.bvshl(b, s))))
+        self.check_batch(self.astCtxt.lor([self.astCtxt.bvuge(a, b), self.astCtxt.bvsgt(self.x8, self.astCtxt.bv(0x10, 8))]), 67)
+        self.check_batch(self.astCtxt.concat([self.astCtxt.bvrol(self.x8, self.astCtxt.bv(3, 8)), self.astCtxt.sx(24, self.x8)]), 5)
+        self.check_batch(self.astCtxt.bvmul(self.astCtxt.concat([self.x64, self.x32]), self.astCtxt.zx(64, a)))
+        self.check_batch(self.astCtxt.bvsdiv(a, b))
+
+    def test_batch_empty(self):
+        """Check the batch evaluation without assignment."""
+        bc = self.astCtxt.compile(self.astCtxt.bvadd(self.x32, self.x32))
+        self.assertEqual(bc.evaluateBatch([]), [])
+        with self.assertRaises(TypeError):
+            bc.evaluateBatch([[1, 2]])
+
+    def test_bad_arguments(self):
+        """Check the errors."""
+        bc = self.astCtxt.compile(self.x32)
+        with self.assertRaises(TypeError):
+            bc.evaluate([1, 2])
+        with self.assertRaises(TypeError):
+            bc.evaluate(1)
@@ -244,6 +244,15 @@ class TestAstConversion(unittest.TestCase):
             self.assertEqual(n.evaluate(), self.Triton.evaluateAstViaZ3(n))
             self.assertEqual(n.evaluate(), self.Triton.simplify(n, True).evaluate())
 
+    def test_shared(self):
+        """Check that the shared subterms are converted once."""
+        self.Triton.setConcreteVariableValue(self.sv1, 3)
+        n = self.v1
+        for _ in xrange(100):
+            n = n * n + self.v1
+        self.assertEqual(n.evaluate(), self.Triton.evaluateAstViaZ3(n))
+        self.assertEqual(n.evaluate(), self.Triton.simplify(n, True).evaluate())
+
     @utils.xfail
     def test_integer(self):
         # Decimal node is not exported in the python interface
@@ -2,6 +2,7 @@
 # coding: utf-8
 """Testing AST simplification."""
 
+import random
 import unittest
 
 from triton import *
@@ -524,3 +525,115 @@ class TestAstSimplification4(unittest.TestCase):
         a = self.ast.variable(self.ctx.newSymbolicVariable(32))
         n = self.ast.bvxor(a, a)
         self.assertTrue(self.proof(n == 0))
+
+
+class TestAstNormalization(unittest.TestCase):
+
+    """Testing the normalization of extract, concat, zx and sx."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86)
+        self.ast = self.ctx.getAstContext()
+        self.ctx.enableMode(MODE.AST_OPTIMIZATIONS, True)
+        self.vars = [self.ast.variable(self.ctx.newSymbolicVariable(size)) for size in [8, 16, 32]]
+
+    def proof(self, n):
+        if self.ctx.isSat(self.ast.lnot(n)) == True:
+            return False
+        return True
+
+    def test_extract_extract(self):
+        a = self.vars[2]
+        n = self.ast.extract(7, 4, self.ast.extract(23, 8, a))
+        self.assertEqual(n.getType(), AST_NODE.EXTRACT)
+        self.assertTrue(n.getChildren()[2].equalTo(a))
+        self.assertTrue(self.proof(n == self.ast.extract(15, 12, a)))
+
+    def test_extract_concat(self):
+        a, b, c = self.vars
+        n = self.ast.extract(7, 0, self.ast.concat([a, b, c]))
+        self.assertEqual(n.getType(), AST_NODE.EXTRACT)
+        self.assertTrue(n.getChildren()[2].equalTo(c))
+        n = self.ast.extract(39, 24, self.ast.concat([a, b, c]))
+        self.assertEqual(n.getType(), AST_NODE.CONCAT)
+        self.assertTrue(self.proof(n == self.ast.concat([self.ast.extract(7, 0, b), self.ast.extract(31, 24, c)])))
+
+    def test_extract_extend(self):
+        a = self.vars[1]
+        self.assertEqual(self.ast.extract(7, 0, self.ast.zx(16, a)).getType(), AST_NODE.EXTRACT)
+        self.assertEqual(self.ast.extract(31, 16, self.ast.zx(16, a)).getType(), AST_NODE.BV)
+        self.assertTrue(self.ast.extract(15, 0, self.ast.sx(16, a)).equalTo(a))
+        n = self.ast.extract(31, 20, self.ast.sx(16, a))
+        self.assertTrue(self.proof(n == self.ast.sx(11, self.ast.extract(15, 15, a))))
+
+    def test_concat_extracts(self):
+        a = self.vars[2]
+        n = self.ast.concat([self.ast.extract(31, 16, a), self.ast.extract(15, 8, a), self.ast.extract(7, 0, a)])
+        self.assertTrue(n.equalTo(a))
+        n = self.ast.concat([self.ast.bv(0x12, 8), self.ast.bv(0x34, 8)])
+        self.assertEqual(n.getType(), AST_NODE.BV)
+        self.assertEqual(n.evaluate(), 0x1234)
+
+    def test_extend_extend(self):
+        a = self.vars[0]
+        n = self.ast.zx(8, self.ast.zx(8, a))
+        self.assertTrue(n.getChildren()[1].equalTo(a))
+        n = self.ast.sx(8, self.ast.sx(8, a))
+        self.assertTrue(n.getChildren()[1].equalTo(a))
+        n = self.ast.sx(8, self.ast.zx(8, a))
+        self.assertEqual(n.getType(), AST_NODE.ZX)
+        self.assertTrue(n.getChildren()[1].equalTo(a))
+        self.assertEqual(self.ast.sx(8, self.ast.bv(0x80, 8)).evaluate(), 0xff80)
+
+    def gen(self, rnd, depth):
+        """Returns a random tree of extract, concat, zx and sx nodes."""
+        if depth == 0 or rnd.randint(0, 5) == 0:
+            if rnd.randint(0, 3) == 0:
+                size = rnd.randint(1, 24)
+                return self.ast.bv(rnd.getrandbits(size), size)
+            return rnd.choice(self.vars)
+
+        op = rnd.randint(0, 3)
+        a = self.gen(rnd, depth - 1)
+        size = a.getBitvectorSize()
+        if op == 0:
+            low = rnd.randint(0, size - 1)
+            return self.ast.extract(rnd.randint(low, size - 1), low, a)
+        if size > 100:
+            return a
+        if op == 1:
+            b = self.gen(rnd, depth - 1)
+            if size + b.getBitvectorSize() > 128:
+                return a
+            return self.ast.concat([self.ast.extract(size - 1, size // 2, a), self.ast.extract(size // 2 - 1, 0, a), b] if size > 1 else [a, b])
+        if op == 2:
+            return self.ast.zx(rnd.randint(0, 12), a)
+        return self.ast.sx(rnd.randint(0, 12), a)
+
+    def assertMasked(self, node):
+        """Check that the bv leaves of a tree are the same as a bv of their value."""
+        if node.getType() == AST_NODE.BV:
+            leaf = self.ast.bv(node.evaluate(), node.getBitvectorSize())
+            self.assertEqual(str(node), str(leaf))
+            self.assertTrue(node.equalTo(leaf))
+            return
+        for child in node.getChildren():
+            self.assertMasked(child)
+
+    def test_extract_bv(self):
+        n = self.ast.extract(3, 0, self.ast.bv(0xff, 8))
+        self.assertEqual(str(n), str(self.ast.bv(15, 4)))
+        self.assertTrue(n.equalTo(self.ast.bv(15, 4)))
+
+    def test_random(self):
+        """Check that the normalized trees are equivalent to the original ones."""
+        for seed in range(100):
+            self.ctx.enableMode(MODE.AST_OPTIMIZATIONS, False)
+            a = self.gen(random.Random(seed), 5)
+            self.ctx.enableMode(MODE.AST_OPTIMIZATIONS, True)
+            b = self.gen(random.Random(seed), 5)
+            self.assertEqual(a.getBitvectorSize(), b.getBitvectorSize())
+            self.assertEqual(a.evaluate(), b.evaluate())
+            self.assertMasked(b)
+            self.assertTrue(self.proof(a == b))
@@ -0,0 +1,77 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the SMT-LIB2 export."""
+
+import os
+import tempfile
+import unittest
+
+from triton import ARCH, Instruction, TritonContext
+
+
+class TestAstSmtExporter(unittest.TestCase):
+
+    """Testing the SMT-LIB2 export."""
+
+    def setUp(self):
+        """Define the arch and the variables."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.Triton.getAstContext()
+        self.v1 = self.astCtxt.variable(self.Triton.newSymbolicVariable(32))
+        self.v2 = self.astCtxt.variable(self.Triton.newSymbolicVariable(32))
+
+    def test_script(self):
+        """Check the commands of the script."""
+        node = self.astCtxt.equal(self.v1 + self.v2, self.astCtxt.bv(10, 32))
+        script = self.astCtxt.exportSmt(node).splitlines()
+        self.assertEqual(script[0], "(set-logic QF_BV)")
+        self.assertEqual(script[1], "(declare-fun SymVar_0 () (_ BitVec 32))")
+        self.assertEqual(script[2], "(declare-fun SymVar_1 () (_ BitVec 32))")
+        self.assertEqual(script[3], "(assert (= (bvadd SymVar_0 SymVar_1) (_ bv10 32)))")
+        self.assertEqual(script[4], "(check-sat)")
+
+    def test_shared(self):
+        """Check that the shared subterms are defined once."""
+        node = self.v1
+        for _ in range(100):
+            node = node * node + self.v2
+        script = self.astCtxt.exportSmt([node == 0, node != 1])
+        self.assertEqual(script.count("declare-fun"), 2)
+        self.assertEqual(script.count("define-fun"), 99)
+        self.assertEqual(script.count("assert"), 2)
+        self.assertLess(len(script), 10000)
+
+    def test_references(self):
+        """Check that the symbolic expressions are defined by their id."""
+        self.Triton.convertRegisterToSymbolicVariable(self.Triton.registers.rax)
+        for opcode in [b"\x48\x01\xc0", b"\x48\x01\xc0", b"\x48\x01\xc0"]:  # add rax, rax
+            self.Triton.processing(Instruction(opcode))
+        rax = self.Triton.getSymbolicRegister(self.Triton.registers.rax)
+        script = self.astCtxt.exportSmt(self.astCtxt.reference(rax) == 8)
+        self.assertIn("(define-fun ref!%d () (_ BitVec 64)" % (rax.getId()), script)
+        self.assertIn("(assert (= ref!%d (_ bv8 64)))" % (rax.getId()), script)
+        self.assertEqual(script.count("(define-fun ref!"), 3)
+
+    def test_leaf_references(self):
+        """Check the references to a symbolic variable and to a constant."""
+        var = self.Triton.newSymbolicVariable(8)
+        expr = self.Triton.newSymbolicExpression(self.astCtxt.variable(var))
+        cst = self.Triton.newSymbolicExpression(self.astCtxt.bv(5, 8))
+        ref = self.astCtxt.reference(expr)
+
+        script = self.astCtxt.exportSmt([ref, ref + self.astCtxt.reference(cst) == 1])
+        self.assertIn("(declare-fun %s () (_ BitVec 8))" % (var.getName()), script)
+        self.assertIn("(assert (= (bvadd %s (_ bv5 8)) (_ bv1 8)))" % (var.getName()), script)
+
+    def test_file(self):
+        """Check the export to a file."""
+        node = self.astCtxt.bvult(self.v1, self.v2)
+        fd, path = tempfile.mkstemp(suffix=".smt2")
+        os.close(fd)
+        try:
+            self.assertIsNone(self.astCtxt.exportSmt(node, path))
+            with open(path) as f:
+                self.assertEqual(f.read(), self.astCtxt.exportSmt(node))
+        finally:
+            os.remove(path)
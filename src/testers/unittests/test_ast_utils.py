@@ -23,6 +23,26 @@ class TestAstUtils(unittest.TestCase):
         self.v1 = self.astCtxt.variable(self.sv1)
         self.v2 = self.astCtxt.variable(self.sv2)
 
+    def test_metrics(self):
+        n = (((self.v1 + self.v2 * 3) + self.v2) - 1)
+
+        self.assertEqual(n.getDepth(), 6)
+        self.assertEqual(n.getUnrolledSize(), 13)
+        self.assertEqual(n.getVariableIds(), sorted([self.sv1.getId(), self.sv2.getId()]))
+
+        self.assertEqual(self.v1.getDepth(), 1)
+        self.assertEqual(self.v1.getVariableIds(), [self.sv1.getId()])
+        self.assertEqual(self.astCtxt.bv(1, 8).getVariableIds(), [])
+
+        # References are unrolled
+        ref = self.astCtxt.reference(self.ctx.newSymbolicExpression(n))
+        m = ref + self.v1
+        self.assertEqual(ref.getDepth(), n.getDepth())
+        self.assertEqual(ref.getUnrolledSize(), n.getUnrolledSize())
+        self.assertEqual(m.getDepth(), n.getDepth() + 1)
+        self.assertEqual(m.getUnrolledSize(), n.getUnrolledSize() + 2)
+        self.assertEqual(m.getVariableIds(), n.getVariableIds())
+
     def test_lookingForNodes(self):
         n = (((self.v1 + self.v2 * 3) + self.v2) - 1)
 
@@ -0,0 +1,99 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the BULK_REP_STRINGS mode."""
+
+import unittest
+
+from triton import ARCH, CPUSIZE, MODE, Instruction, MemoryAccess, TritonContext
+
+
+class TestBulkRepStringsMode(unittest.TestCase):
+
+    """Testing REP MOVS/STOS performed at once."""
+
+    CODE = {
+        "rep movsb": b"\xf3\xa4",
+        "rep movsq": b"\xf3\x48\xa5",
+        "rep stosb": b"\xf3\xaa",
+        "rep stosd": b"\xf3\xab",
+    }
+
+    def context(self, bulk):
+        """Returns a context with a symbolic and tainted source buffer."""
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.BULK_REP_STRINGS, bulk)
+        ctx.setConcreteMemoryAreaValue(0x1000, bytearray(range(64)))
+        ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x1005, CPUSIZE.BYTE))
+        ctx.taintMemory(0x1006)
+        return ctx
+
+    def run_rep(self, ctx, code, rcx, rsi=0x1000, rdi=0x2000, rax=0, df=0):
+        """Runs a REP instruction until it falls through and returns the number of processing()."""
+        ctx.setConcreteRegisterValue(ctx.registers.rcx, rcx)
+        ctx.setConcreteRegisterValue(ctx.registers.rsi, rsi)
+        ctx.setConcreteRegisterValue(ctx.registers.rdi, rdi)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, rax)
+        ctx.setConcreteRegisterValue(ctx.registers.df, df)
+        ctx.setConcreteRegisterValue(ctx.registers.rip, 0x400000)
+
+        count = 0
+        while ctx.getConcreteRegisterValue(ctx.registers.rip) == 0x400000:
+            ctx.processing(Instruction(0x400000, code))
+            count += 1
+        return count
+
+    def compare(self, code, rcx, **kwargs):
+        """Checks that both modes give the same state."""
+        bulk = self.context(True)
+        iterative = self.context(False)
+        self.assertEqual(self.run_rep(bulk, code, rcx, **kwargs), 1)
+        self.run_rep(iterative, code, rcx, **kwargs)
+
+        for reg in [bulk.registers.rcx, bulk.registers.rsi, bulk.registers.rdi, bulk.registers.rip]:
+            self.assertEqual(bulk.getConcreteRegisterValue(reg), iterative.getConcreteRegisterValue(reg))
+
+        self.assertEqual(bulk.getConcreteMemoryAreaValue(0x0f00, 0x1200), iterative.getConcreteMemoryAreaValue(0x0f00, 0x1200))
+        for addr in range(0x0f00, 0x2100):
+            self.assertEqual(bulk.isMemorySymbolized(addr), iterative.isMemorySymbolized(addr))
+            self.assertEqual(bulk.isMemoryTainted(addr), iterative.isMemoryTainted(addr))
+        return bulk
+
+    def test_movsb(self):
+        """rep movsb forward, backward and overlapping."""
+        bulk = self.compare(self.CODE["rep movsb"], 16)
+        self.assertTrue(bulk.isMemorySymbolized(0x2005))
+        self.assertTrue(bulk.isMemoryTainted(0x2006))
+        self.assertEqual(len(bulk.getSymbolicExpressions()), len(bulk.getSymbolicVariables()) + 5)
+
+        self.compare(self.CODE["rep movsb"], 16, rsi=0x100f, rdi=0x200f, df=1)
+        self.compare(self.CODE["rep movsb"], 16, rsi=0x1000, rdi=0x1001)
+
+    def test_movsq(self):
+        """rep movsq."""
+        self.compare(self.CODE["rep movsq"], 4)
+        self.compare(self.CODE["rep movsq"], 4, rsi=0x1018, rdi=0x2018, df=1)
+
+    def test_stos(self):
+        """rep stosb/stosd."""
+        self.compare(self.CODE["rep stosb"], 32, rax=0x41)
+        self.compare(self.CODE["rep stosd"], 8, rax=0xdeadbeef, rdi=0x1000)
+
+    def test_symbolic_counter(self):
+        """A symbolic counter falls back on the iterative semantics."""
+        ctx = self.context(True)
+        ctx.setConcreteRegisterValue(ctx.registers.rcx, 4)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rcx)
+        ctx.setConcreteRegisterValue(ctx.registers.rip, 0x400000)
+        ctx.processing(Instruction(0x400000, self.CODE["rep movsb"]))
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rcx), 3)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rip), 0x400000)
+
+    def test_page_limit(self):
+        """A counter larger than one page takes one processing() per page."""
+        ctx = self.context(True)
+        self.assertEqual(self.run_rep(ctx, self.CODE["rep stosd"], 0x600, rax=0x41424344, rdi=0x10000), 2)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rcx), 0)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rdi), 0x11800)
+        self.assertEqual(ctx.getConcreteMemoryAreaValue(0x117fc, 4), b"\x44\x43\x42\x41")
+        self.assertEqual(ctx.getConcreteMemoryValue(0x11800), 0)
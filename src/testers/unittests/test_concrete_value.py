@@ -176,3 +176,15 @@ class TestX8664ConcreteMemoryValue(unittest.TestCase):
         self.Triton.setConcreteMemoryAreaValue(0x1000, "\x11\x22\x33\x44\x55\x66")
         self.Triton.setConcreteMemoryAreaValue(0x1006, [0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc])
         self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x1000, 12), "\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc")
+
+    def test_set_get_concrete_area_buffer(self):
+        self.Triton.setConcreteMemoryAreaValue(0x3000, bytearray("\x11\x22\x33\x44"))
+        self.Triton.setConcreteMemoryAreaValue(0x3004, memoryview("\x55\x66\x77\x88"))
+        self.Triton.setConcreteMemoryAreaValue(0x3002, "\xaa")
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x3000, 8), "\x11\x22\xaa\x44\x55\x66\x77\x88")
+
+        # Unmapped cells are read as zero
+        area = bytearray(10)
+        view = self.Triton.getConcreteMemoryAreaValue(0x2fff, area)
+        self.assertEqual(area, bytearray("\x00\x11\x22\xaa\x44\x55\x66\x77\x88\x00"))
+        self.assertEqual(len(view), 10)
@@ -0,0 +1,103 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the CONSTANT_FOLDING mode."""
+
+import unittest
+
+from triton import ARCH, AST_NODE, MODE, Instruction, TritonContext
+
+
+class TestConstantFoldingMode(unittest.TestCase):
+
+    """Testing the folding of unsymbolized nodes."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ctx.enableMode(MODE.CONSTANT_FOLDING, True)
+        self.ast = self.ctx.getAstContext()
+
+    def test_concrete(self):
+        """Check that unsymbolized nodes are folded."""
+        ast = self.ast
+        nodes = [
+            (ast.bvadd(ast.bv(0xff, 8), ast.bv(2, 8)), 1),
+            (ast.bvxor(ast.bv(0x0f, 8), ast.bv(0xff, 8)), 0xf0),
+            (ast.extract(15, 8, ast.bv(0x1234, 16)), 0x12),
+            (ast.concat([ast.bv(0x12, 8), ast.bv(0x34, 8), ast.bv(0x56, 8)]), 0x123456),
+            (ast.sx(8, ast.bv(0x80, 8)), 0xff80),
+            (ast.ite(ast.equal(ast.bv(1, 8), ast.bv(1, 8)), ast.bv(1, 8), ast.bv(2, 8)), 1),
+        ]
+        for node, value in nodes:
+            self.assertEqual(node.getType(), AST_NODE.BV)
+            self.assertEqual(node.evaluate(), value)
+
+    def test_logical(self):
+        """Check that logical nodes are kept."""
+        ast = self.ast
+        self.assertEqual(ast.equal(ast.bv(1, 8), ast.bv(1, 8)).getType(), AST_NODE.EQUAL)
+        self.assertEqual(ast.bvult(ast.bv(1, 8), ast.bv(2, 8)).getType(), AST_NODE.BVULT)
+
+    def test_symbolized(self):
+        """Check that only the unsymbolized subtrees are folded."""
+        ast = self.ast
+        x = ast.variable(self.ctx.newSymbolicVariable(8))
+        node = ast.bvadd(x, ast.bvmul(ast.bv(3, 8), ast.bv(4, 8)))
+        self.assertEqual(node.getType(), AST_NODE.BVADD)
+        self.assertEqual(node.getChildren()[1].getType(), AST_NODE.BV)
+        self.assertEqual(node.getChildren()[1].evaluate(), 12)
+
+        self.ctx.enableMode(MODE.CONSTANT_FOLDING, False)
+        node = ast.bvmul(ast.bv(3, 8), ast.bv(4, 8))
+        self.assertEqual(node.getType(), AST_NODE.BVMUL)
+
+    def test_processing(self):
+        """Check that the folded semantics give the same model."""
+        code = [
+            b"\x48\xc7\xc3\x10\x00\x00\x00",  # mov rbx, 0x10
+            b"\x48\x83\xc3\x20",              # add rbx, 0x20
+            b"\x48\x31\xd8",                  # xor rax, rbx
+            b"\x48\x3d\x34\x12\x00\x00",      # cmp rax, 0x1234
+        ]
+        for folding in [True, False]:
+            ctx = TritonContext()
+            ctx.setArchitecture(ARCH.X86_64)
+            ctx.enableMode(MODE.CONSTANT_FOLDING, folding)
+            var = ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+            for opcode in code:
+                ctx.processing(Instruction(opcode))
+
+            zf = ctx.getSymbolicRegister(ctx.registers.zf).getAst()
+            model = ctx.getModel(zf == 1)
+            self.assertEqual(model[var.getId()].getValue(), 0x1234 ^ 0x30)
+
+    def test_references(self):
+        """Check that a node on concrete references is folded, but not the references."""
+        expr = self.ctx.newSymbolicExpression(self.ast.bv(5, 8))
+        ref = self.ast.reference(expr)
+        self.assertEqual(ref.getType(), AST_NODE.REFERENCE)
+        node = ref + self.ast.bv(1, 8)
+        self.assertEqual(node.getType(), AST_NODE.BV)
+        self.assertEqual(node.evaluate(), 6)
+
+    def test_masked(self):
+        """Check that a folded node is the same leaf as a bv of its value."""
+        ast = self.ast
+        nodes = [
+            (ast.bvnot(ast.bv(5, 8)), 250),
+            (ast.bvadd(ast.bv(0xff, 8), ast.bv(2, 8)), 1),
+            (ast.bvsub(ast.bv(1, 8), ast.bv(2, 8)), 0xff),
+            (ast.bvmul(ast.bv(0x80, 8), ast.bv(3, 8)), 0x80),
+            (ast.bvneg(ast.bv(1, 8)), 0xff),
+            (ast.bvnand(ast.bv(0, 8), ast.bv(0, 8)), 0xff),
+            (ast.bvnor(ast.bv(0, 8), ast.bv(0, 8)), 0xff),
+            (ast.bvxnor(ast.bv(0, 8), ast.bv(0, 8)), 0xff),
+            (ast.bvshl(ast.bv(0xff, 8), ast.bv(4, 8)), 0xf0),
+            (ast.bvrol(ast.bv(0x81, 8), 1), 0x03),
+            (ast.bvror(ast.bv(0x81, 8), 1), 0xc0),
+            (ast.extract(3, 0, ast.bv(0xff, 8)), 0xf),
+        ]
+        for node, value in nodes:
+            leaf = ast.bv(value, node.getBitvectorSize())
+            self.assertEqual(str(node), str(leaf))
+            self.assertTrue(node.equalTo(leaf))
@@ -0,0 +1,114 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the native ELF loader."""
+
+import unittest
+import os
+
+from triton import ARCH, CPUSIZE, MemoryAccess, TritonContext
+
+
+BINARY_FILE = os.path.join(os.path.dirname(__file__), "misc", "defcamp-2015-r100.bin")
+
+
+class TestElfLoader(unittest.TestCase):
+
+    """Testing the ELF loader."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+
+    def test_header(self):
+        """Check the entry point and the segments."""
+        elf = self.Triton.loadElf(BINARY_FILE)
+        self.assertEqual(elf.getBaseAddress(), 0)
+        self.assertEqual(elf.getEntryPoint(), 0x400610)
+
+        segments = elf.getSegments()
+        self.assertEqual(len(segments), 2)
+        self.assertEqual(segments[0]['vaddr'], 0x400000)
+        self.assertEqual(segments[1]['vaddr'], 0x600e08)
+        self.assertEqual(segments[1]['memsz'] - segments[1]['filesz'], 0x10)
+
+    def test_lazy_mapping(self):
+        """Pages are only copied on first access."""
+        elf = self.Triton.loadElf(BINARY_FILE)
+        entry = elf.getEntryPoint()
+        self.assertFalse(self.Triton.isMemoryMapped(entry))
+
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(entry, 6), b"\x31\xed\x49\x89\xd1\x5e")
+        self.assertTrue(self.Triton.isMemoryMapped(entry))
+        self.assertFalse(self.Triton.isMemoryMapped(0x600e08))
+
+        # The .bss is zero filled
+        self.assertEqual(self.Triton.getConcreteMemoryValue(MemoryAccess(0x601070, CPUSIZE.QWORD)), 0)
+
+    def test_eager_mapping(self):
+        """All pages are copied at load time."""
+        elf = self.Triton.loadElf(BINARY_FILE, 0, False)
+        self.assertTrue(self.Triton.isMemoryMapped(elf.getEntryPoint()))
+        self.assertTrue(self.Triton.isMemoryMapped(0x600e08, 0x260))
+
+    def test_writes_before_reads(self):
+        """A write into an unmapped page must not be overwritten by the file content."""
+        elf = self.Triton.loadElf(BINARY_FILE)
+        entry = elf.getEntryPoint()
+        self.Triton.setConcreteMemoryValue(entry, 0x90)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(entry, 2), b"\x90\xed")
+
+    def test_imports(self):
+        """Bind imported symbols to stubs."""
+        elf = self.Triton.loadElf(BINARY_FILE)
+        imports = elf.getImportedSymbols()
+        for name in ["fgets", "printf", "ptrace", "puts"]:
+            self.assertIn(name, imports)
+
+        stubs = elf.bindImports(0x10000000, 0x10)
+        self.assertEqual(len(stubs), len(imports))
+
+        puts = self.Triton.getConcreteMemoryValue(MemoryAccess(0x601020, CPUSIZE.QWORD))
+        self.assertTrue(elf.isImportStub(puts))
+        self.assertEqual(elf.getImportName(puts), "puts")
+        self.assertEqual(stubs[puts], "puts")
+
+        elf.bindImport("puts", 0x20000000)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(MemoryAccess(0x601020, CPUSIZE.QWORD)), 0x20000000)
+        self.assertFalse(elf.isImportStub(puts))
+
+        with self.assertRaises(TypeError):
+            elf.getImportName(0x1234)
+
+    def test_relocated_base(self):
+        """The base address is added to every address."""
+        elf = self.Triton.loadElf(BINARY_FILE, 0x10000)
+        self.assertEqual(elf.getEntryPoint(), 0x410610)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x410610, 2), b"\x31\xed")
+
+    def test_reset(self):
+        """The pending pages are mapped before the callbacks are removed."""
+        elf = self.Triton.loadElf(BINARY_FILE)
+
+        # Accesses outside of the segments do not map anything
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x500000), 0)
+        self.assertFalse(self.Triton.isMemoryMapped(0x500000))
+
+        self.assertFalse(self.Triton.isMemoryMapped(0x600e08, 0x260))
+        self.Triton.removeAllCallbacks()
+        self.assertTrue(self.Triton.isMemoryMapped(0x600e08, 0x260))
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x400610, 2), b"\x31\xed")
+
+        elf = self.Triton.loadElf(BINARY_FILE)
+        self.Triton.reset()
+        elf.mapAll()
+
+    def test_drop(self):
+        """Dropping a lazy loader maps the pages never touched."""
+        self.Triton.loadElf(BINARY_FILE)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x400610, 2), b"\x31\xed")
+
+        elf = self.Triton.loadElf(BINARY_FILE, 0x10000)
+        self.assertFalse(self.Triton.isMemoryMapped(0x410610))
+        del elf
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x410610, 2), b"\x31\xed")
@@ -0,0 +1,143 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the native libc summaries."""
+
+import unittest
+
+from triton import ARCH, CPUSIZE, MemoryAccess, TritonContext
+
+
+class TestX8664LibcSummaries(unittest.TestCase):
+
+    """Testing the x86-64 System V ABI."""
+
+    ROUTINES = ["calloc", "free", "malloc", "memcpy", "memmove", "memset",
+                "printf", "putchar", "puts", "strcmp", "strlen"]
+
+    def setUp(self):
+        """Define the arch and bind every routine."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.libc = self.Triton.newLibcSummaries()
+        for i, name in enumerate(self.ROUTINES):
+            self.libc.bind(0x100 + i, name)
+
+    def call(self, name, *args):
+        """Call a routine with a return address on the stack and return rax."""
+        regs = [self.Triton.registers.rdi, self.Triton.registers.rsi, self.Triton.registers.rdx,
+                self.Triton.registers.rcx, self.Triton.registers.r8, self.Triton.registers.r9]
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rsp, 0x9000)
+        self.Triton.setConcreteMemoryValue(MemoryAccess(0x9000, CPUSIZE.QWORD), 0x401234)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rip, 0x100 + self.ROUTINES.index(name))
+        for reg, arg in zip(regs, args):
+            self.Triton.setConcreteRegisterValue(reg, arg)
+        self.assertTrue(self.libc.emulate())
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.rip), 0x401234)
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.rsp), 0x9008)
+        return self.Triton.getConcreteRegisterValue(self.Triton.registers.rax)
+
+    def test_bindings(self):
+        """Check the bindings."""
+        self.assertTrue(self.libc.isBound(0x100))
+        self.assertEqual(self.libc.getBindings()[0x100 + self.ROUTINES.index("strlen")], "strlen")
+        self.libc.unbind(0x100)
+        self.assertFalse(self.libc.isBound(0x100))
+        self.assertRaises(TypeError, self.libc.bind, 0x200, "system")
+
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rip, 0x200)
+        self.assertFalse(self.libc.emulate())
+
+    def test_strlen(self):
+        """strlen returns an ite chain over the symbolic bytes."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"abcd\x00")
+        self.assertEqual(self.call("strlen", 0x1000), 4)
+        self.assertFalse(self.Triton.isRegisterSymbolized(self.Triton.registers.rax))
+
+        for i in range(4):
+            self.Triton.convertMemoryToSymbolicVariable(MemoryAccess(0x1000 + i, CPUSIZE.BYTE))
+        self.assertEqual(self.call("strlen", 0x1000), 4)
+        self.assertTrue(self.Triton.isRegisterSymbolized(self.Triton.registers.rax))
+
+        rax = self.Triton.getRegisterAst(self.Triton.registers.rax)
+        self.assertEqual(rax.evaluate(), 4)
+
+        model = self.Triton.getModel(rax == 2)
+        self.assertEqual(model[2].getValue(), 0)
+        self.assertNotEqual(model[0].getValue(), 0)
+        self.assertNotEqual(model[1].getValue(), 0)
+
+    def test_strlen_terminator(self):
+        """strlen goes on past a symbolic terminator up to the next concrete one."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"abcd\x00ef\x00")
+        for i in range(5):
+            self.Triton.convertMemoryToSymbolicVariable(MemoryAccess(0x1000 + i, CPUSIZE.BYTE))
+        self.assertEqual(self.call("strlen", 0x1000), 4)
+
+        rax = self.Triton.getRegisterAst(self.Triton.registers.rax)
+        self.assertEqual(rax.evaluate(), 4)
+
+        # With a non-null terminator, the string ends at the next concrete one
+        model = self.Triton.getModel(rax == 7)
+        self.assertEqual(len(model), 5)
+        self.assertTrue(all(model[i].getValue() != 0 for i in range(5)))
+        self.assertFalse(self.Triton.isSat(rax == 6))
+
+    def test_strcmp(self):
+        """strcmp returns the difference of the first mismatching bytes."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"help\x00")
+        self.Triton.setConcreteMemoryAreaValue(0x1100, b"hello\x00")
+        self.assertEqual(self.call("strcmp", 0x1000, 0x1100), (ord('p') - ord('l')) & 0xffffffff)
+        self.assertEqual(self.call("strcmp", 0x1100, 0x1000), (ord('l') - ord('p')) & 0xffffffff)
+        self.assertEqual(self.call("strcmp", 0x1000, 0x1000), 0)
+
+        for i in range(4):
+            self.Triton.convertMemoryToSymbolicVariable(MemoryAccess(0x1000 + i, CPUSIZE.BYTE))
+        self.call("strcmp", 0x1000, 0x1100)
+        rax = self.Triton.getRegisterAst(self.Triton.registers.rax)
+        self.assertEqual(rax.evaluate(), ord('p') - ord('l'))
+
+        # s1 keeps its concrete terminator, so it can not be equal to "hello"
+        self.assertFalse(self.Triton.isSat(rax == 0))
+
+        # With s1 = "hell", the comparison goes on up to the terminator of s1
+        model = self.Triton.getModel(rax == ((0 - ord('o')) & 0xffffffff))
+        self.assertEqual([model[i].getValue() for i in range(4)], [ord(c) for c in "hell"])
+
+    def test_memcpy_memset(self):
+        """memcpy copies the symbolic and taint states, memset fills."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"ABCDEF")
+        self.Triton.convertMemoryToSymbolicVariable(MemoryAccess(0x1002, CPUSIZE.BYTE))
+        self.Triton.taintMemory(0x1003)
+
+        self.assertEqual(self.call("memcpy", 0x2000, 0x1000, 6), 0x2000)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x2000, 6), b"ABCDEF")
+        self.assertTrue(self.Triton.isMemorySymbolized(0x2002))
+        self.assertFalse(self.Triton.isMemorySymbolized(0x2003))
+        self.assertTrue(self.Triton.isMemoryTainted(0x2003))
+        self.assertFalse(self.Triton.isMemoryTainted(0x2002))
+
+        self.assertEqual(self.call("memmove", 0x1001, 0x1000, 5), 0x1001)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x1000, 6), b"AABCDE")
+
+        self.assertEqual(self.call("memset", 0x2000, 0x41, 4), 0x2000)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x2000, 6), b"AAAAEF")
+        self.assertFalse(self.Triton.isMemorySymbolized(0x2002))
+        self.assertFalse(self.Triton.isMemoryTainted(0x2003))
+
+    def test_heap(self):
+        """malloc/calloc/free."""
+        self.libc.setHeapBase(0x600000)
+        self.assertEqual(self.call("malloc", 10), 0x600000)
+        self.assertEqual(self.call("calloc", 4, 8), 0x600010)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x600010, 32), b"\x00" * 32)
+        self.assertEqual(self.call("free", 0x600000), 0)
+        self.assertEqual(self.call("malloc", 0), 0x600030)
+
+    def test_output(self):
+        """printf/puts/putchar."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"%s=%d %04x %c%%\n\x00")
+        self.Triton.setConcreteMemoryAreaValue(0x1100, b"key\x00")
+        self.assertEqual(self.call("printf", 0x1000, 0x1100, 0xfffffffffffffffd, 0xab, ord('Z')), 15)
+        self.assertEqual(self.call("puts", 0x1100), 4)
+        self.assertEqual(self.call("putchar", ord('!')), ord('!'))
+        self.assertEqual(self.libc.getOutput(), "key=-3 00ab Z%\nkey\n!")
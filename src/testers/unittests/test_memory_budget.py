@@ -0,0 +1,95 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the memory budget of the symbolic engine."""
+
+import unittest
+
+from triton import ARCH, CPUSIZE, SYMBOLIC, Instruction, MemoryAccess, TritonContext
+
+
+class TestMemoryBudget(unittest.TestCase):
+
+    """Testing the concretization and summarization of stale entries."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+
+    def test_settings(self):
+        """Default values and setters."""
+        self.assertEqual(self.ctx.getMemoryBudget(), 0)
+        self.assertEqual(self.ctx.getMemoryBudgetDepth(), 0)
+        self.assertEqual(self.ctx.getMemoryBudgetPolicy(), SYMBOLIC.BUDGET_LRU)
+
+        self.ctx.setMemoryBudget(100)
+        self.ctx.setMemoryBudgetDepth(10)
+        self.ctx.setMemoryBudgetPolicy(SYMBOLIC.BUDGET_DEPTH)
+        self.assertEqual(self.ctx.getMemoryBudget(), 100)
+        self.assertEqual(self.ctx.getMemoryBudgetDepth(), 10)
+        self.assertEqual(self.ctx.getMemoryBudgetPolicy(), SYMBOLIC.BUDGET_DEPTH)
+        self.assertRaises(TypeError, self.ctx.setMemoryBudgetPolicy, 1234)
+
+    def test_lru(self):
+        """The least recently used bytes are concretized first."""
+        self.ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x1000, CPUSIZE.DQWORD))
+        self.assertEqual(self.ctx.getMemoryBudgetUsage(), 16)
+
+        self.ctx.setMemoryBudget(8)
+        self.ctx.getMemoryAst(MemoryAccess(0x1000, CPUSIZE.DWORD))
+        self.ctx.enforceMemoryBudget()
+
+        self.assertEqual(self.ctx.getMemoryBudgetUsage(), 6)
+        self.assertTrue(self.ctx.isMemorySymbolized(0x1000, 4))
+
+        drops = self.ctx.getMemoryBudgetDrops()
+        self.assertEqual(len(drops), 10)
+        for drop in drops:
+            self.assertFalse(drop["summarized"])
+            self.assertFalse(self.ctx.isMemorySymbolized(drop["address"]))
+
+        self.ctx.clearMemoryBudgetDrops()
+        self.assertEqual(len(self.ctx.getMemoryBudgetDrops()), 0)
+
+    def run_store(self, policy):
+        """Symbolizes 4 bytes then stores 8 concrete bytes."""
+        self.ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x1000, CPUSIZE.DWORD))
+        self.ctx.setMemoryBudget(16)
+        self.ctx.setMemoryBudgetPolicy(policy)
+
+        # mov [rax], rbx
+        self.ctx.setConcreteRegisterValue(self.ctx.registers.rax, 0x2000)
+        self.ctx.setConcreteRegisterValue(self.ctx.registers.rbx, 0x4142434445464748)
+        self.ctx.processing(Instruction(0x400000, b"\x48\x89\x18"))
+        self.assertLessEqual(self.ctx.getMemoryBudgetUsage(), 12)
+        self.assertEqual(self.ctx.getConcreteMemoryValue(MemoryAccess(0x2000, CPUSIZE.QWORD)), 0x4142434445464748)
+
+    def test_not_symbolized_first(self):
+        """Entries without symbolic variable are dropped first."""
+        self.run_store(SYMBOLIC.BUDGET_NOT_SYMBOLIZED)
+        self.assertTrue(self.ctx.isMemorySymbolized(0x1000, 4))
+
+    def test_lru_drops_old_symbolic_bytes(self):
+        """With LRU, the old symbolic bytes are dropped first."""
+        self.run_store(SYMBOLIC.BUDGET_LRU)
+        self.assertFalse(self.ctx.isMemorySymbolized(0x1000, 4))
+
+    def test_depth(self):
+        """Deep registers are summarized by fresh variables."""
+        self.ctx.setConcreteRegisterValue(self.ctx.registers.rax, 1)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rax)
+        self.ctx.setMemoryBudgetDepth(10)
+
+        # add rax, rax
+        for i in range(20):
+            self.ctx.processing(Instruction(0x400000, b"\x48\x01\xc0"))
+
+        self.assertEqual(self.ctx.getConcreteRegisterValue(self.ctx.registers.rax), 1 << 20)
+        self.assertTrue(self.ctx.isRegisterSymbolized(self.ctx.registers.rax))
+        self.assertEqual(self.ctx.getRegisterAst(self.ctx.registers.rax).evaluate(), 1 << 20)
+
+        drops = [d for d in self.ctx.getMemoryBudgetDrops() if "register" in d and d["register"].getName() == "rax"]
+        self.assertGreater(len(drops), 0)
+        for drop in drops:
+            self.assertTrue(drop["summarized"])
+        self.assertGreater(len(self.ctx.getSymbolicVariables()), 1)
@@ -0,0 +1,86 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the enumeration of the models."""
+
+import unittest
+
+from triton import ARCH, SOLVER_STATE, TritonContext
+
+
+class TestModelEnumeration(unittest.TestCase):
+
+    """Testing the enumeration of the models."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ast = self.ctx.getAstContext()
+
+        self.x = self.ctx.newSymbolicVariable(32)
+        self.y = self.ctx.newSymbolicVariable(32)
+        x = self.ast.variable(self.x)
+        y = self.ast.variable(self.y)
+
+        # 100 values of x, and many values of y for each of them
+        self.node = self.ast.land([
+            self.ast.bvult(x, self.ast.bv(100, 32)),
+            self.ast.equal(self.ast.bvand(y, self.ast.bv(3, 32)), self.ast.bv(1, 32)),
+        ])
+        self.small = self.ast.land([
+            self.ast.bvult(x, self.ast.bv(5, 32)),
+            self.ast.bvult(y, self.ast.bv(4, 32)),
+        ])
+
+    def enumerate(self, node, projection=[], limit=0, threads=1):
+        """Returns the models of an enumeration and its status."""
+        models = []
+        status = self.ctx.enumerateModels(node, models.append, projection, limit, threads)
+        return models, status
+
+    def test_projection(self):
+        """Check that the models are distinct on the projection."""
+        for threads in (1, 4):
+            models, status = self.enumerate(self.node, [self.x], 0, threads)
+            self.assertEqual(status, SOLVER_STATE.SAT)
+            values = [m[self.x.getId()].getValue() for m in models]
+            self.assertEqual(sorted(values), range(100))
+            for m in models:
+                self.assertEqual(m[self.y.getId()].getValue() & 3, 1)
+
+    def test_all_variables(self):
+        """Check that the models are distinct on all the variables without projection."""
+        for threads in (1, 4):
+            models, status = self.enumerate(self.small, [], 0, threads)
+            self.assertEqual(status, SOLVER_STATE.SAT)
+            pairs = set((m[self.x.getId()].getValue(), m[self.y.getId()].getValue()) for m in models)
+            self.assertEqual(len(models), 20)
+            self.assertEqual(len(pairs), 20)
+
+        # getModels keeps its behavior
+        self.assertEqual(len(self.ctx.getModels(self.small, 100)), 20)
+
+    def test_stop(self):
+        """Check the limit and the stop of the callback."""
+        for threads in (1, 4):
+            models, status = self.enumerate(self.node, [self.x], 7, threads)
+            self.assertEqual(status, SOLVER_STATE.SAT)
+            self.assertEqual(len(models), 7)
+
+            count = [0]
+            def callback(model):
+                count[0] += 1
+                return count[0] < 3
+            self.ctx.enumerateModels(self.node, callback, [self.x], 0, threads)
+            self.assertEqual(count[0], 3)
+
+    def test_unsat(self):
+        """Check an enumeration without model."""
+        node = self.ast.land([self.small, self.ast.bvugt(self.ast.variable(self.x), self.ast.bv(10, 32))])
+        self.assertEqual(self.enumerate(node, [self.x], 0, 4), ([], SOLVER_STATE.UNSAT))
+
+    def test_callback_error(self):
+        """Check that the exception of a callback is raised."""
+        def callback(model):
+            raise ValueError("stop")
+        with self.assertRaises(ValueError):
+            self.ctx.enumerateModels(self.node, callback, [self.x], 0, 4)
@@ -4,7 +4,7 @@
 
 import unittest
 
-from triton import ARCH, MODE, CPUSIZE, TritonContext, Instruction, MemoryAccess
+from triton import ARCH, CALLBACK, MODE, CPUSIZE, TritonContext, Instruction, MemoryAccess
 
 
 def checkAstIntegrity(instruction):
@@ -165,3 +165,152 @@ class TestOnlySymbolizedMode(unittest.TestCase):
         self.assertEqual(inst.getOperands()[1].getAddress(), 0x1337)
         self.assertIsNotNone(inst.getOperands()[1].getLeaAst())
 
+    def test_9(self):
+        for taint in (False, True):
+            ctx = TritonContext()
+            ctx.setArchitecture(ARCH.X86_64)
+            ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+            ctx.enableTaintEngine(taint)
+            ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+
+            inst = Instruction("\x48\xc7\xc0\x01\x00\x00\x00") # mov rax, 1
+            self.assertTrue(ctx.processing(inst))
+            self.assertTrue(checkAstIntegrity(inst))
+            self.assertEqual(ctx.getNativeCount(), 1)
+
+            self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+            self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 1)
+            self.assertFalse(ctx.isRegisterSymbolized(ctx.registers.rax))
+
+    def test_10(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.enableTaintEngine(False)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0x1234)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+
+        inst = Instruction("\xb0\x01") # mov al, 1
+        self.assertTrue(ctx.processing(inst))
+        self.assertTrue(checkAstIntegrity(inst))
+        self.assertEqual(ctx.getNativeCount(), 0)
+
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 0x1201)
+        self.assertTrue(ctx.isRegisterSymbolized(ctx.registers.rax))
+
+        inst = Instruction("\xb3\x01") # mov bl, 1
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getNativeCount(), 1)
+        self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+
+    def test_11(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.enableTaintEngine(False)
+        ctx.setConcreteRegisterValue(ctx.registers.zf, 1)
+        ctx.setConcreteRegisterValue(ctx.registers.rbx, 2)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rcx)
+
+        inst = Instruction("\x48\x0f\x45\xd9") # cmovne rbx, rcx
+        self.assertTrue(ctx.processing(inst))
+        self.assertTrue(checkAstIntegrity(inst))
+        self.assertEqual(ctx.getNativeCount(), 0)
+
+        self.assertFalse(inst.isConditionTaken())
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rbx), 2)
+        self.assertTrue(ctx.isRegisterSymbolized(ctx.registers.rbx))
+
+    def test_12(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.enableTaintEngine(False)
+        ctx.setConcreteRegisterValue(ctx.registers.rsp, 0x1000)
+        ctx.setConcreteRegisterValue(ctx.registers.rax, 0x1337)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rdx)
+
+        inst = Instruction("\x50") # push rax
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+
+        inst = Instruction("\x48\x8b\x0c\x24") # mov rcx, qword ptr [rsp]
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(len(inst.getSymbolicExpressions()), 0)
+        self.assertEqual(inst.getOperands()[1].getAddress(), 0xff8)
+        self.assertEqual(ctx.getNativeCount(), 2)
+
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rsp), 0xff8)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rcx), 0x1337)
+        self.assertTrue(ctx.isRegisterSymbolized(ctx.registers.rdx))
+
+    def test_13(self):
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, True)
+        ctx.setConcreteRegisterValue(ctx.registers.rsp, 0x1000)
+        ctx.taintRegister(ctx.registers.rax)
+        ctx.taintRegister(ctx.registers.rcx)
+
+        # The taint is spread by the semantics
+        inst = Instruction("\x48\x89\xc3") # mov rbx, rax
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getNativeCount(), 0)
+        self.assertTrue(ctx.isRegisterTainted(ctx.registers.rbx))
+
+        inst = Instruction("\x50") # push rax
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getNativeCount(), 0)
+        self.assertTrue(ctx.isMemoryTainted(MemoryAccess(0xff8, CPUSIZE.QWORD)))
+
+        # Untainted sources untaint their destinations
+        inst = Instruction("\x48\xc7\xc1\x01\x00\x00\x00") # mov rcx, 1
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getNativeCount(), 1)
+        self.assertFalse(ctx.isRegisterTainted(ctx.registers.rcx))
+
+        ctx.setConcreteRegisterValue(ctx.registers.rdx, 2)
+        inst = Instruction("\x48\x89\x14\x24") # mov qword ptr [rsp], rdx
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getNativeCount(), 2)
+        self.assertFalse(ctx.isMemoryTainted(MemoryAccess(0xff8, CPUSIZE.QWORD)))
+        self.assertTrue(ctx.isRegisterTainted(ctx.registers.rax))
+
+    def test_14(self):
+        """The callbacks see the accesses of a fallback instruction once."""
+        counts = list()
+        for mode in (False, True):
+            ctx = TritonContext()
+            ctx.setArchitecture(ARCH.X86_64)
+            ctx.enableMode(MODE.ONLY_ON_SYMBOLIZED, mode)
+            ctx.setConcreteRegisterValue(ctx.registers.rsp, 0x1000)
+            ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+
+            count = {CALLBACK.GET_CONCRETE_MEMORY_VALUE: 0, CALLBACK.SET_CONCRETE_MEMORY_VALUE: 0,
+                     CALLBACK.GET_CONCRETE_REGISTER_VALUE: 0, CALLBACK.SET_CONCRETE_REGISTER_VALUE: 0}
+            def cb(kind):
+                def f(ctx, *args):
+                    count[kind] += 1
+                return f
+            for kind in count:
+                ctx.addCallback(cb(kind), kind)
+
+            inst = Instruction("\x48\x01\x04\x24") # add qword ptr [rsp], rax
+            self.assertTrue(ctx.processing(inst))
+            self.assertEqual(ctx.getNativeCount(), 0)
+            counts.append(count)
+
+        self.assertEqual(counts[0], counts[1])
+
+        # The native execution is only seen once too
+        ctx.removeAllCallbacks()
+        loads = list()
+        stores = list()
+        ctx.addCallback(lambda ctx, mem: loads.append(mem.getAddress()), CALLBACK.GET_CONCRETE_MEMORY_VALUE)
+        ctx.addCallback(lambda ctx, mem, value: stores.append(mem.getAddress()), CALLBACK.SET_CONCRETE_MEMORY_VALUE)
+
+        inst = Instruction("\x48\x01\x4c\x24\x08") # add qword ptr [rsp+8], rcx
+        self.assertTrue(ctx.processing(inst))
+        self.assertEqual(ctx.getNativeCount(), 1)
+        self.assertEqual(loads, [0x1008])
+        self.assertEqual(stores, [0x1008])
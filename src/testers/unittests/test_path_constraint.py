@@ -65,3 +65,102 @@ class TestPathConstraint(unittest.TestCase):
         self.assertEqual(pc[0]['dstAddr'], 91)
         self.assertEqual(pc[1]['dstAddr'], 23)
 
+
+
+class TestPathConstraintPrefixes(unittest.TestCase):
+
+    """Testing the cached prefix conjunctions."""
+
+    def setUp(self):
+        """Define the arch and take three branches on a symbolic eax."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.eax)
+
+        for i in range(1, 4):
+            self.ctx.processing(Instruction("\x83\xf8" + chr(i)))  # cmp eax, i
+            self.ctx.processing(Instruction("\x74\x02"))           # je +2
+
+    def test_conjunction(self):
+        """The whole conjunction is the last prefix."""
+        self.assertEqual(len(self.ctx.getPathConstraints()), 3)
+        crst = self.ctx.getPathConstraintsAst()
+        self.assertEqual(len(crst.getChildren()), 2)
+        self.assertTrue(crst.getChildren()[0].equalTo(self.ctx.getPrefixPathConstraintsAst(2)))
+        self.assertEqual(crst.evaluate(), 1)
+        self.assertEqual(str(crst), str(self.ctx.getPathConstraintsAst()))
+        self.assertNotEqual(len(self.ctx.getModel(crst)), 0)
+
+        self.ctx.clearPathConstraints()
+        self.assertEqual(self.ctx.getPathConstraintsAst().evaluate(), 1)
+        self.assertEqual(len(self.ctx.getPathConstraintsAst().getChildren()), 2)
+
+    def test_prefixes(self):
+        """Prefixes and negations."""
+        self.assertEqual(self.ctx.getPrefixPathConstraintsAst(0).evaluate(), 1)
+        for i in range(4):
+            self.assertEqual(self.ctx.getPrefixPathConstraintsAst(i).evaluate(), 1)
+        self.assertRaises(TypeError, self.ctx.getPrefixPathConstraintsAst, 4)
+
+        for i in range(3):
+            crst = self.ctx.getNegatedPathConstraintsAst(i)
+            self.assertEqual(crst.evaluate(), 0)
+            model = self.ctx.getModel(crst)
+            self.assertEqual(model[0].getValue(), i + 1)
+        self.assertRaises(TypeError, self.ctx.getNegatedPathConstraintsAst, 3)
+
+    def test_shared(self):
+        """The prefixes are shared between the calls, not rebuilt."""
+        for i in range(1, 3):
+            prefix = self.ctx.getPrefixPathConstraintsAst(i)
+            following = self.ctx.getPrefixPathConstraintsAst(i + 1)
+            # A rebuilt prefix would have no parent, the shared one is the child of the next prefix
+            self.assertTrue(any(p.equalTo(following) for p in prefix.getParents()))
+            self.assertTrue(following.getChildren()[0].equalTo(prefix))
+
+
+class TestPathConstraintLoops(unittest.TestCase):
+
+    """Testing the deduplication and the compression of the loop branches."""
+
+    def setUp(self):
+        """Define the arch and a symbolic eax."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.eax)
+
+    def iterate(self, count, guard):
+        """Execute `count` iterations of a loop body at the same addresses."""
+        for i in range(1, count + 1):
+            self.ctx.processing(Instruction(0x1000, "\x83\xf8" + chr(guard(i))))  # cmp eax, guard(i)
+            self.ctx.processing(Instruction(0x1003, "\x74\x02"))                   # je +2
+
+    def test_deduplication(self):
+        """The same guard is only recorded once."""
+        self.iterate(10, lambda i: 0x41)
+        self.assertEqual(len(self.ctx.getPathConstraints()), 10)
+
+        self.ctx.clearPathConstraints()
+        self.ctx.setMode(MODE.PC_DEDUPLICATION, True)
+        self.iterate(10, lambda i: 0x41)
+        self.assertEqual(len(self.ctx.getPathConstraints()), 1)
+
+        # Another guard is still recorded
+        self.iterate(10, lambda i: i)
+        self.assertEqual(len(self.ctx.getPathConstraints()), 11)
+
+    def test_compression(self):
+        """Only the first and the last instances of a branch are kept."""
+        self.ctx.setPathConstraintsCompression(0x1003, 2, 1)
+        self.iterate(10, lambda i: i)
+        self.assertEqual(len(self.ctx.getPathConstraints()), 3)
+
+        values = []
+        for i in range(3):
+            self.assertEqual(self.ctx.getPrefixPathConstraintsAst(i + 1).evaluate(), 1)
+            values.append(self.ctx.getModel(self.ctx.getNegatedPathConstraintsAst(i))[0].getValue())
+        self.assertEqual(values, [1, 2, 10])
+
+        self.ctx.removePathConstraintsCompression(0x1003)
+        self.iterate(2, lambda i: i)
+        self.assertEqual(len(self.ctx.getPathConstraints()), 5)
@@ -0,0 +1,96 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the pre-solver of the trivial constraints."""
+
+import unittest
+
+from triton import ARCH, MODE, SOLVER_STATE, Instruction, TritonContext
+
+
+class TestPreSolver(unittest.TestCase):
+
+    """Testing the pre-solver of the trivial constraints."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ctx.setMode(MODE.PRESOLVING, True)
+        self.ast = self.ctx.getAstContext()
+
+        self.sv = self.ctx.newSymbolicVariable(32)
+        self.ctx.setConcreteVariableValue(self.sv, 0x11223344)
+        self.x = self.ast.variable(self.sv)
+
+    def check(self, node, model):
+        """Check that a model satisfies a constraint."""
+        value = model[self.sv.getId()].getValue()
+        self.ctx.setConcreteVariableValue(self.sv, value)
+        self.assertEqual(node.evaluate(), 1)
+        return value
+
+    def test_chain(self):
+        """Check the inversion of a chain of operations."""
+        byte = self.ast.extract(7, 0, self.x)
+        node = self.ast.equal(self.ast.bvxor(self.ast.bvadd(byte, self.ast.bv(0x10, 8)), self.ast.bv(0x55, 8)), self.ast.bv(0x41, 8))
+        model, status = self.ctx.getModel(node, True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        # The bits out of the constraint keep their concrete value
+        self.assertEqual(self.check(node, model), 0x11223304)
+
+    def test_intervals(self):
+        """Check the conjunctions of intervals."""
+        byte = self.ast.extract(15, 8, self.x)
+        node = self.ast.land([
+            self.ast.bvuge(byte, self.ast.bv(0x40, 8)),
+            self.ast.bvult(byte, self.ast.bv(0x44, 8)),
+            self.ast.distinct(byte, self.ast.bv(0x41, 8)),
+        ])
+        models, status = self.ctx.getModels(node, 10, True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        # The other bits are free, so there are more than 3 models
+        self.assertEqual(len(models), 10)
+        self.assertEqual(len(set(self.check(node, m) for m in models)), 10)
+
+        node = self.ast.land([node, self.ast.bvsgt(byte, self.ast.bv(0x50, 8))])
+        model, status = self.ctx.getModel(node, True)
+        self.assertEqual(status, SOLVER_STATE.UNSAT)
+        self.assertEqual(model, {})
+        self.assertFalse(self.ctx.isSat(node))
+
+    def test_flags(self):
+        """Check a path constraint built from the flags."""
+        var = self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.al)
+        self.ctx.processing(Instruction(0x1000, b"\x34\x13"))  # xor al, 0x13
+        self.ctx.processing(Instruction(0x1002, b"\x3c\x37"))  # cmp al, 0x37
+        self.ctx.processing(Instruction(0x1004, b"\x74\x02"))  # je +2
+
+        values = set()
+        for branch in self.ctx.getPathConstraints()[-1].getBranchConstraints():
+            model = self.ctx.getModel(branch['constraint'])
+            self.assertEqual(len(model), 1)
+            value = model[var.getId()].getValue()
+            self.ctx.setConcreteVariableValue(var, value)
+            self.assertEqual(branch['constraint'].evaluate(), 1)
+            self.ctx.setConcreteVariableValue(var, 0)
+            values.add(value)
+
+        # The branch not taken keeps the concrete value of al
+        self.assertEqual(values, set([0x24, 0]))
+
+    def test_background(self):
+        """Check that a trivial query is decided at its submission."""
+        node = self.ast.equal(self.ast.bvnot(self.x), self.ast.bv(0, 32))
+        ticket = self.ctx.submitQuery(node)
+        self.assertTrue(self.ctx.pollQuery(ticket))
+        status, models = self.ctx.waitQuery(ticket)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(models[0][self.sv.getId()].getValue(), 0xffffffff)
+        self.assertEqual(models[0][self.sv.getId()].getVariable().getId(), self.sv.getId())
+
+    def test_fallback(self):
+        """Check that the other constraints reach the solver."""
+        y = self.ast.variable(self.ctx.newSymbolicVariable(32))
+        node = self.ast.equal(self.x + y, self.ast.bv(0x100, 32))
+        model, status = self.ctx.getModel(node, True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(len(model), 2)
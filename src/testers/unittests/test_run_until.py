@@ -0,0 +1,111 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the concrete fast-forward execution."""
+
+import struct
+import unittest
+
+from triton import ARCH, Instruction, TritonContext
+
+
+class TestRunUntil(unittest.TestCase):
+
+    """Testing runUntil() against processing()."""
+
+    def load(self, arch, base, code, stack):
+        """Return a context with the code mapped and the stack pointer set."""
+        ctx = TritonContext()
+        ctx.setArchitecture(arch)
+        ctx.setConcreteMemoryAreaValue(base, code)
+        ctx.setConcreteRegisterValue(ctx.getRegister('sp' if arch == ARCH.AARCH64 else 'rsp'), stack)
+        ctx.setConcreteRegisterValue(ctx.getRegister('pc' if arch == ARCH.AARCH64 else 'rip'), base)
+        return ctx
+
+    def process(self, ctx, stop):
+        """Run the code with processing() and return the number of instructions."""
+        pc = ctx.registers.pc if ctx.getArchitecture() == ARCH.AARCH64 else ctx.registers.rip
+        count = 0
+        while ctx.getConcreteRegisterValue(pc) != stop:
+            addr = ctx.getConcreteRegisterValue(pc)
+            inst = Instruction(addr, bytes(ctx.getConcreteMemoryAreaValue(addr, 16)))
+            self.assertTrue(ctx.processing(inst))
+            count += 1
+        return count
+
+    def check(self, arch, base, code, stop, regs, stack=0x8000):
+        """Check that the fast-forward and the processing agree."""
+        ref = self.load(arch, base, code, stack)
+        count = self.process(ref, stop)
+
+        ctx = self.load(arch, base, code, stack)
+        ctx.enableSymbolicEngine(False)
+        ctx.enableTaintEngine(False)
+        self.assertEqual(ctx.runUntil(stop), count)
+
+        for name in regs:
+            reg = ctx.getRegister(name)
+            self.assertEqual(ctx.getConcreteRegisterValue(reg), ref.getConcreteRegisterValue(reg), name)
+        self.assertEqual(ctx.getConcreteMemoryAreaValue(stack - 0x20, 0x40), ref.getConcreteMemoryAreaValue(stack - 0x20, 0x40))
+
+    def test_x86_64(self):
+        """Check a loop, a call and flags on x86-64."""
+        code = b"".join([
+            b"\x48\xc7\xc1\x0a\x00\x00\x00",  # mov rcx, 10
+            b"\x31\xc0",                      # xor eax, eax
+            b"\x48\x01\xc8",                  # add rax, rcx
+            b"\x48\xff\xc9",                  # dec rcx
+            b"\x75\xf8",                      # jne 0x1009
+            b"\x50",                          # push rax
+            b"\xe8\x16\x00\x00\x00",          # call 0x102d
+            b"\x5b",                          # pop rbx
+            b"\x48\x8d\x54\x43\x05",          # lea rdx, [rbx + rax*2 + 5]
+            b"\x48\x81\xfa\x00\x01\x00\x00",  # cmp rdx, 0x100
+            b"\x40\x0f\x9c\xc6",              # setl sil
+            b"\x48\xc1\xe2\x03",              # shl rdx, 3
+            b"\xf4",                          # hlt
+            b"\x48\x8b\x44\x24\x08",          # mov rax, [rsp + 8]
+            b"\x48\xd1\xf8",                  # sar rax, 1
+            b"\xc3",                          # ret
+        ])
+        regs = ['rax', 'rbx', 'rcx', 'rdx', 'rsi', 'rsp', 'rip', 'cf', 'pf', 'af', 'zf', 'sf', 'of']
+        self.check(ARCH.X86_64, 0x1000, code, 0x102c, regs)
+
+    def test_aarch64(self):
+        """Check a loop, loads, stores and branches on AArch64."""
+        code = b"".join(struct.pack("<I", w) for w in [
+            0xd2800000,  # mov  x0, #0
+            0xd28000a1,  # mov  x1, #5
+            0x8b010000,  # add  x0, x0, x1
+            0xf1000421,  # subs x1, x1, #1
+            0x54ffffc1,  # b.ne 0x1008
+            0xf90007e0,  # str  x0, [sp, #8]
+            0xf94007e2,  # ldr  x2, [sp, #8]
+            0xf1003c5f,  # cmp  x2, #15
+            0xb4000041,  # cbz  x1, 0x1028
+            0xd503201f,  # nop
+        ])
+        regs = ['x0', 'x1', 'x2', 'sp', 'pc', 'n', 'z', 'c', 'v']
+        self.check(ARCH.AARCH64, 0x1000, code, 0x1028, regs)
+
+    def test_engines(self):
+        """Check that the symbolic state is built when the engines are enabled."""
+        code = b"\x48\x01\xc8\x48\x01\xc8\xf4"  # add rax, rcx ; add rax, rcx ; hlt
+        ctx = self.load(ARCH.X86_64, 0x1000, code, 0x8000)
+        ctx.setConcreteRegisterValue(ctx.registers.rcx, 3)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rcx)
+        self.assertEqual(ctx.runUntil(0x1006), 2)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 6)
+        self.assertTrue(ctx.isRegisterSymbolized(ctx.registers.rax))
+
+    def test_stop(self):
+        """Check the count limit and the stop predicate."""
+        code = b"\x48\xff\xc0\xeb\xfb"  # inc rax ; jmp 0x1000
+        ctx = self.load(ARCH.X86_64, 0x1000, code, 0x8000)
+        ctx.enableSymbolicEngine(False)
+        ctx.enableTaintEngine(False)
+        self.assertEqual(ctx.runUntil(None, 10), 10)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 5)
+        self.assertEqual(ctx.runUntil(lambda pc: ctx.getConcreteRegisterValue(ctx.registers.rax) == 8), 5)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rax), 8)
+        self.assertEqual(ctx.runUntil(0x1000, 100), 1)
+        self.assertEqual(ctx.getConcreteRegisterValue(ctx.registers.rip), 0x1000)
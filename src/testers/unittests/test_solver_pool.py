@@ -0,0 +1,114 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the pool of solver processes."""
+
+import os
+import signal
+import time
+import unittest
+
+from triton import ARCH, SOLVER_STATE, TritonContext
+
+
+class TestSolverPool(unittest.TestCase):
+
+    """Testing the pool of solver processes."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ast = self.ctx.getAstContext()
+
+        self.x = self.ctx.newSymbolicVariable(64)
+        self.y = self.ctx.newSymbolicVariable(64)
+        x = self.ast.variable(self.x)
+        y = self.ast.variable(self.y)
+
+        self.easy = self.ast.equal(self.ast.extract(7, 0, x), self.ast.bv(0x41, 8))
+        self.unsat = self.ast.land([self.easy, self.ast.equal(self.ast.extract(7, 0, x), self.ast.bv(0x42, 8))])
+
+        # Factoring a 64-bit semiprime takes far longer than the limits below
+        self.hard = self.ast.land([
+            self.ast.equal(x * y, self.ast.bv(0xD6DC9F0C4A7E30B9, 64)),
+            self.ast.bvugt(x, self.ast.bv(1, 64)),
+            self.ast.bvugt(y, self.ast.bv(1, 64)),
+            self.ast.bvult(x, self.ast.bv(0xffffffff, 64)),
+            self.ast.bvult(y, self.ast.bv(0xffffffff, 64)),
+        ])
+
+    def tearDown(self):
+        self.ctx.setSolverPool(0)
+
+    def test_queries(self):
+        """Check the models and the status of the queries solved by the workers."""
+        self.ctx.setSolverPool(2)
+        self.assertEqual(self.ctx.getSolverPoolWorkers(), [0, 0])
+
+        model, status = self.ctx.getModel(self.easy, True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(model[self.x.getId()].getValue() & 0xff, 0x41)
+        self.assertEqual(model[self.x.getId()].getVariable().getId(), self.x.getId())
+
+        self.assertEqual(len(self.ctx.getModels(self.easy, 3)), 3)
+        self.assertEqual(self.ctx.getModel(self.unsat, True)[1], SOLVER_STATE.UNSAT)
+        self.assertFalse(self.ctx.isSat(self.unsat))
+        self.assertNotEqual(self.ctx.getSolverPoolWorkers()[0], 0)
+
+        self.ctx.setSolverPool(0)
+        self.assertEqual(self.ctx.getSolverPoolWorkers(), [])
+        self.assertTrue(self.ctx.isSat(self.easy))
+
+    def test_timeout(self):
+        """Check that a worker is killed once it exceeds the time limit of the pool."""
+        self.ctx.setSolverPool(1, 200)
+        self.assertTrue(self.ctx.isSat(self.easy))
+        self.assertNotEqual(self.ctx.getSolverPoolWorkers()[0], 0)
+
+        start = time.time()
+        self.assertEqual(self.ctx.getModel(self.hard, True)[1], SOLVER_STATE.TIMEOUT)
+        self.assertLess(time.time() - start, 5)
+        self.assertEqual(self.ctx.getSolverPoolWorkers(), [0])
+
+        # A fresh worker solves the next query
+        self.assertTrue(self.ctx.isSat(self.easy))
+        self.assertNotEqual(self.ctx.getSolverPoolWorkers()[0], 0)
+
+    def test_dead_worker(self):
+        """Check that a dead worker is replaced."""
+        self.ctx.setSolverPool(1)
+        self.assertTrue(self.ctx.isSat(self.easy))
+        pid = self.ctx.getSolverPoolWorkers()[0]
+
+        os.kill(pid, signal.SIGKILL)
+        time.sleep(0.2)
+
+        self.assertEqual(self.ctx.getModel(self.easy, True)[1], SOLVER_STATE.SAT)
+        self.assertNotIn(self.ctx.getSolverPoolWorkers()[0], (0, pid))
+
+    def test_max_queries(self):
+        """Check that a worker is replaced after its maximum number of queries."""
+        self.ctx.setSolverPool(1, 0, 2)
+        self.assertTrue(self.ctx.isSat(self.easy))
+        pid = self.ctx.getSolverPoolWorkers()[0]
+        self.assertNotEqual(pid, 0)
+
+        self.assertFalse(self.ctx.isSat(self.unsat))
+        self.assertEqual(self.ctx.getSolverPoolWorkers(), [0])
+
+        self.assertTrue(self.ctx.isSat(self.easy))
+        self.assertNotIn(self.ctx.getSolverPoolWorkers()[0], (0, pid))
+
+    def test_background(self):
+        """Check that the submitted queries are solved and cancelled by the pool."""
+        self.ctx.setSolverPool(2)
+        hard = self.ctx.submitQuery(self.hard)
+        easy = self.ctx.submitQuery(self.easy)
+
+        status, models = self.ctx.waitQuery(easy)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(models[0][self.x.getId()].getValue() & 0xff, 0x41)
+
+        self.assertFalse(self.ctx.pollQuery(hard))
+        self.assertTrue(self.ctx.cancelQuery(hard))
+        self.assertTrue(self.ctx.pollQuery(hard))
+        self.assertEqual(self.ctx.waitQuery(hard)[0], SOLVER_STATE.UNKNOWN)
@@ -0,0 +1,112 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the solver limits and the background queries."""
+
+import time
+import unittest
+
+from triton import ARCH, SOLVER_STATE, TritonContext
+
+
+class TestSolverQueries(unittest.TestCase):
+
+    """Testing the solver limits and the background queries."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ast = self.ctx.getAstContext()
+
+        self.x = self.ctx.newSymbolicVariable(64)
+        self.y = self.ctx.newSymbolicVariable(64)
+        x = self.ast.variable(self.x)
+        y = self.ast.variable(self.y)
+
+        self.easy = self.ast.equal(self.ast.extract(7, 0, x), self.ast.bv(0x41, 8))
+        self.unsat = self.ast.land([self.easy, self.ast.equal(self.ast.extract(7, 0, x), self.ast.bv(0x42, 8))])
+
+        # Factoring a 64-bit semiprime takes far longer than the limits below
+        self.hard = self.ast.land([
+            self.ast.equal(x * y, self.ast.bv(0xD6DC9F0C4A7E30B9, 64)),
+            self.ast.bvugt(x, self.ast.bv(1, 64)),
+            self.ast.bvugt(y, self.ast.bv(1, 64)),
+            self.ast.bvult(x, self.ast.bv(0xffffffff, 64)),
+            self.ast.bvult(y, self.ast.bv(0xffffffff, 64)),
+        ])
+
+    def test_status(self):
+        """Check the status of the synchronous queries."""
+        model, status = self.ctx.getModel(self.easy, True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(model[self.x.getId()].getValue() & 0xff, 0x41)
+
+        model, status = self.ctx.getModel(self.unsat, True)
+        self.assertEqual(status, SOLVER_STATE.UNSAT)
+        self.assertEqual(len(model), 0)
+
+        models, status = self.ctx.getModels(self.easy, 3, True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(len(models), 3)
+
+        # Without the status flag the result is unchanged
+        self.assertEqual(len(self.ctx.getModel(self.easy)), 1)
+
+    def test_timeout(self):
+        """Check that a hard query stops at its time limit."""
+        start = time.time()
+        model, status = self.ctx.getModel(self.hard, True, 200)
+        self.assertEqual(status, SOLVER_STATE.TIMEOUT)
+        self.assertEqual(len(model), 0)
+        self.assertLess(time.time() - start, 10)
+
+        self.ctx.setSolverTimeout(200)
+        self.assertFalse(self.ctx.isSat(self.hard))
+        self.ctx.setSolverTimeout(0)
+
+    def test_resource_limit(self):
+        """Check that a hard query stops at its resource limit."""
+        self.ctx.setSolverResourceLimit(50000)
+        model, status = self.ctx.getModel(self.hard, True)
+        self.assertEqual(status, SOLVER_STATE.UNKNOWN)
+        self.ctx.setSolverResourceLimit(0)
+        self.assertTrue(self.ctx.isSat(self.easy))
+
+    def test_background(self):
+        """Check the queries solved in background."""
+        sat = self.ctx.submitQuery(self.easy, 2)
+        unsat = self.ctx.submitQuery(self.unsat)
+        check = self.ctx.submitQuery(self.easy, 0)
+
+        status, models = self.ctx.waitQuery(sat)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(len(models), 2)
+        for model in models:
+            self.assertEqual(model[self.x.getId()].getVariable().getId(), self.x.getId())
+            self.assertEqual(model[self.x.getId()].getValue() & 0xff, 0x41)
+
+        self.assertEqual(self.ctx.waitQuery(unsat), (SOLVER_STATE.UNSAT, []))
+        self.assertEqual(self.ctx.waitQuery(check), (SOLVER_STATE.SAT, []))
+
+        # A waited ticket is forgotten
+        with self.assertRaises(TypeError):
+            self.ctx.pollQuery(sat)
+
+    def test_cancel(self):
+        """Check the cancellation of a running and of a pending query."""
+        running = self.ctx.submitQuery(self.hard)
+        pending = self.ctx.submitQuery(self.hard)
+        time.sleep(0.05)
+        self.assertFalse(self.ctx.pollQuery(running))
+
+        start = time.time()
+        self.assertTrue(self.ctx.cancelQuery(pending))
+        self.assertTrue(self.ctx.cancelQuery(running))
+        self.assertFalse(self.ctx.cancelQuery(running))
+        self.assertTrue(self.ctx.pollQuery(running))
+        self.assertEqual(self.ctx.waitQuery(running), (SOLVER_STATE.UNKNOWN, []))
+        self.assertEqual(self.ctx.waitQuery(pending), (SOLVER_STATE.UNKNOWN, []))
+
+        # The thread is free again
+        ticket = self.ctx.submitQuery(self.easy)
+        self.assertEqual(self.ctx.waitQuery(ticket)[0], SOLVER_STATE.SAT)
+        self.assertLess(time.time() - start, 10)
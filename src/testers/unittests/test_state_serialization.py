@@ -0,0 +1,134 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Testing the save and load of the symbolic state."""
+
+import os
+import tempfile
+import unittest
+
+from triton import ARCH, Instruction, MemoryAccess, TritonContext, CPUSIZE
+
+
+class TestStateSerialization(unittest.TestCase):
+
+    """Testing the save and load of the symbolic state."""
+
+    def setUp(self):
+        """Run a small trace with symbolic inputs."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.var = self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rax, "input")
+        self.ctx.setConcreteVariableValue(self.var, 0x41)
+        self.ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x1000, CPUSIZE.QWORD))
+
+        code = [
+            (0x400000, b"\x48\x01\xc0"),                  # add rax, rax
+            (0x400003, b"\x48\x8b\x1c\x25\x00\x10\x00\x00"),  # mov rbx, [0x1000]
+            (0x40000b, b"\x48\x31\xd8"),                  # xor rax, rbx
+            (0x40000e, b"\x48\x89\x04\x25\x00\x20\x00\x00"),  # mov [0x2000], rax
+            (0x400016, b"\x48\x3d\x34\x12\x00\x00"),      # cmp rax, 0x1234
+            (0x40001c, b"\x74\x02"),                      # je +2
+        ]
+        for addr, opcode in code:
+            self.ctx.processing(Instruction(addr, opcode))
+
+    def load(self, data):
+        """Return a new context loaded from a saved state."""
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.loadState(data)
+        return ctx
+
+    def test_round_trip(self):
+        """Check that the loaded state is the saved one."""
+        ctx = self.load(self.ctx.saveState())
+
+        for reg in [ctx.registers.rax, ctx.registers.rbx, ctx.registers.zf]:
+            a = self.ctx.getSymbolicRegister(reg)
+            b = ctx.getSymbolicRegister(reg)
+            self.assertEqual(a.getId(), b.getId())
+            self.assertEqual(str(self.ctx.getAstContext().unrollAst(a.getAst())), str(ctx.getAstContext().unrollAst(b.getAst())))
+            self.assertEqual(a.getAst().evaluate(), b.getAst().evaluate())
+
+        for addr in range(0x2000, 0x2008):
+            self.assertEqual(self.ctx.getSymbolicMemory(addr).getId(), ctx.getSymbolicMemory(addr).getId())
+
+        var = ctx.getSymbolicVariableFromName(self.var.getName())
+        self.assertEqual(var.getComment(), "input")
+        self.assertEqual(ctx.getConcreteVariableValue(var), 0x41)
+        self.assertEqual(len(ctx.getSymbolicVariables()), 2)
+
+        self.assertEqual(len(ctx.getPathConstraints()), 1)
+        a = self.ctx.getAstContext().unrollAst(self.ctx.getPathConstraintsAst())
+        b = ctx.getAstContext().unrollAst(ctx.getPathConstraintsAst())
+        self.assertEqual(str(a), str(b))
+
+    def test_unused_variable(self):
+        """Check a symbolic variable which is not used in an AST."""
+        unused = self.ctx.newSymbolicVariable(16, "unused")
+        ctx = self.load(self.ctx.saveState())
+
+        var = ctx.getSymbolicVariableFromName(unused.getName())
+        self.assertEqual(var.getId(), unused.getId())
+        self.assertEqual(var.getSize(), 16)
+        self.assertEqual(var.getComment(), "unused")
+        self.assertEqual(len(ctx.getSymbolicVariables()), 3)
+
+    def test_resume(self):
+        """Check that a loaded state can be extended and solved."""
+        ctx = self.load(self.ctx.saveState())
+        expr = ctx.newSymbolicExpression(ctx.getAstContext().bv(1, 8))
+        self.assertGreater(expr.getId(), self.ctx.getSymbolicRegister(self.ctx.registers.zf).getId())
+
+        zf = ctx.getSymbolicRegister(ctx.registers.zf).getAst()
+        model = ctx.getModel(zf == 1)
+        self.assertEqual(len(model), 2)
+
+    def test_file(self):
+        """Check the save to and the load from a file."""
+        fd, path = tempfile.mkstemp(suffix=".state")
+        os.close(fd)
+        try:
+            self.assertIsNone(self.ctx.saveState(path))
+            with open(path, "rb") as f:
+                self.assertEqual(f.read(), self.ctx.saveState())
+            ctx = self.load(path)
+            self.assertEqual(len(ctx.getPathConstraints()), 1)
+        finally:
+            os.remove(path)
+
+    def test_size(self):
+        """Check that the shared nodes are saved once."""
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86_64)
+        ctx.convertRegisterToSymbolicVariable(ctx.registers.rax)
+        for _ in range(200):
+            ctx.processing(Instruction(b"\x48\x0f\xaf\xc0"))  # imul rax, rax
+        # The unrolled AST of rax has 2^200 leaves
+        data = ctx.saveState()
+        self.assertLess(len(data), 1 << 20)
+        loaded = self.load(data)
+        a = ctx.getSymbolicRegister(ctx.registers.rax).getAst()
+        b = loaded.getSymbolicRegister(loaded.registers.rax).getAst()
+        self.assertEqual(a.evaluate(), b.evaluate())
+
+    def test_invalid(self):
+        """Check that invalid states are rejected."""
+        data = self.ctx.saveState()
+        ctx = self.load(data)
+
+        # A bad header keeps the current state
+        with self.assertRaises(TypeError):
+            ctx.loadState(b"TRTX" + data[4:])
+        self.assertEqual(len(ctx.getSymbolicVariables()), 2)
+
+        # A truncated state leaves an empty state
+        with self.assertRaises(TypeError):
+            ctx.loadState(data[:len(data) // 2])
+        self.assertEqual(len(ctx.getSymbolicVariables()), 0)
+        self.assertEqual(len(ctx.getPathConstraints()), 0)
+
+        ctx = TritonContext()
+        ctx.setArchitecture(ARCH.X86)
+        with self.assertRaises(TypeError):
+            ctx.loadState(data)
@@ -84,3 +84,115 @@ class TestSymbolicExpression(unittest.TestCase):
         self.expr1.setComment("test")
         self.assertEqual(self.expr1.getComment(), "test")
 
+
+
+class TestSymbolicExpressionTable(unittest.TestCase):
+
+    """Testing the table of symbolic expressions."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+
+    def test_lifetime(self):
+        """Dead and removed expressions leave the table."""
+        astCtxt = self.ctx.getAstContext()
+        exprs = [self.ctx.newSymbolicExpression(astCtxt.bv(i, 8)) for i in range(100)]
+        ids = [e.getId() for e in exprs]
+        self.assertEqual(sorted(self.ctx.getSymbolicExpressions().keys()), ids)
+
+        exprs[50] = None
+        self.assertFalse(self.ctx.isSymbolicExpressionIdExists(ids[50]))
+        self.assertTrue(self.ctx.isSymbolicExpressionIdExists(ids[51]))
+
+        # Only the last expression stays alive
+        last = exprs[-1]
+        del exprs
+        self.assertEqual(list(self.ctx.getSymbolicExpressions().keys()), [last.getId()])
+        self.assertEqual(self.ctx.getSymbolicExpressionFromId(last.getId()).getId(), last.getId())
+        self.assertRaises(TypeError, self.ctx.getSymbolicExpressionFromId, ids[0])
+        self.assertRaises(TypeError, self.ctx.getSymbolicExpressionFromId, last.getId() + 1)
+
+        # New ids keep growing
+        self.assertEqual(self.ctx.newSymbolicExpression(astCtxt.bv(0, 8)).getId(), last.getId() + 1)
+
+    def test_remove(self):
+        """Removing an expression concretizes the registers and cells assigned to it."""
+        self.ctx.setConcreteMemoryValue(MemoryAccess(0x1000, CPUSIZE.WORD), 0x4142)
+        self.ctx.convertMemoryToSymbolicVariable(MemoryAccess(0x1000, CPUSIZE.WORD))
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rax)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rbx)
+
+        rax = self.ctx.getSymbolicRegister(self.ctx.registers.rax)
+        self.ctx.assignSymbolicExpressionToRegister(rax, self.ctx.registers.rcx)
+        self.ctx.removeSymbolicExpression(rax.getId())
+        self.assertFalse(self.ctx.isRegisterSymbolized(self.ctx.registers.rax))
+        self.assertFalse(self.ctx.isRegisterSymbolized(self.ctx.registers.rcx))
+        self.assertTrue(self.ctx.isRegisterSymbolized(self.ctx.registers.rbx))
+
+        byte = self.ctx.getSymbolicMemory(0x1001)
+        self.ctx.removeSymbolicExpression(byte.getId())
+        self.assertFalse(self.ctx.isMemorySymbolized(0x1001))
+        self.assertTrue(self.ctx.isMemorySymbolized(0x1000))
+        self.assertEqual(self.ctx.getConcreteMemoryValue(MemoryAccess(0x1000, CPUSIZE.WORD)), 0x4142)
+
+        # Removing an unknown expression does nothing
+        self.ctx.removeSymbolicExpression(rax.getId())
+        self.assertTrue(self.ctx.isRegisterSymbolized(self.ctx.registers.rbx))
+
+
+class TestSlicing(unittest.TestCase):
+
+    """Testing the dependency graph of the symbolic expressions."""
+
+    def setUp(self):
+        """Define the arch and a small dataflow."""
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rax)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rbx)
+        self.ctx.convertRegisterToSymbolicVariable(self.ctx.registers.rsi)
+
+        for opcode in [b"\x48\x89\xc1",                 # mov rcx, rax
+                       b"\x48\x01\xd9",                 # add rcx, rbx
+                       b"\x48\xc7\xc2\x01\x00\x00\x00", # mov rdx, 1
+                       b"\x48\x31\xca"]:                # xor rdx, rcx
+            self.ctx.processing(Instruction(opcode))
+
+    def test_slice(self):
+        """Backward slicing walks the references."""
+        rdx = self.ctx.getSymbolicRegister(self.ctx.registers.rdx)
+        slice = self.ctx.sliceExpressions(rdx)
+
+        self.assertIn(rdx.getId(), slice)
+        self.assertIn(self.ctx.getSymbolicRegister(self.ctx.registers.rcx).getId(), slice)
+        self.assertIn(self.ctx.getSymbolicRegister(self.ctx.registers.rax).getId(), slice)
+        self.assertIn(self.ctx.getSymbolicRegister(self.ctx.registers.rbx).getId(), slice)
+        self.assertNotIn(self.ctx.getSymbolicRegister(self.ctx.registers.rsi).getId(), slice)
+
+        # Slices are stable across calls
+        self.assertEqual(sorted(self.ctx.sliceExpressions(rdx).keys()), sorted(slice.keys()))
+
+    def test_variables(self):
+        """Only rax and rbx influence rdx."""
+        rdx = self.ctx.getSymbolicRegister(self.ctx.registers.rdx)
+        self.assertEqual(sorted(self.ctx.sliceVariables(rdx).keys()), [0, 1])
+
+        rsi = self.ctx.getSymbolicRegister(self.ctx.registers.rsi)
+        self.assertEqual(list(self.ctx.sliceVariables(rsi).keys()), [2])
+
+    def test_references(self):
+        """The references follow the AST of the expression."""
+        astCtxt = self.ctx.getAstContext()
+        rdx = self.ctx.getSymbolicRegister(self.ctx.registers.rdx)
+        rcx = self.ctx.getSymbolicRegister(self.ctx.registers.rcx)
+
+        ids = [e.getId() for e in rdx.getReferences()]
+        self.assertIn(rcx.getId(), ids)
+        self.assertEqual(ids, sorted(set(ids)))
+
+        expr = self.ctx.newSymbolicExpression(astCtxt.bv(1, 64))
+        self.assertEqual(expr.getReferences(), [])
+        expr.setAst(astCtxt.reference(rcx) + astCtxt.reference(rcx))
+        self.assertEqual([e.getId() for e in expr.getReferences()], [rcx.getId()])
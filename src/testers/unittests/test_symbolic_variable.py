@@ -37,6 +37,10 @@ class TestSymbolicVariable(unittest.TestCase):
         self.assertEqual(self.v0.getName(), "SymVar_0")
         self.assertEqual(self.v1.getName(), "SymVar_1")
         self.assertEqual(self.v2.getName(), "SymVar_2")
+        self.assertEqual(self.ctx.getSymbolicVariableFromName("SymVar_1").getId(), 1)
+        self.assertEqual(self.ctx.getSymbolicVariableFromName("SymVar_3").getAlias(), "v3")
+        self.assertRaises(TypeError, self.ctx.getSymbolicVariableFromName, "v3")
+        self.assertRaises(TypeError, self.ctx.getSymbolicVariableFromName, "SymVar_4")
 
     def test_bitsize(self):
         """Test name"""
@@ -0,0 +1,137 @@
+#!/usr/bin/env python2
+# coding: utf-8
+"""Test the native Linux syscall emulator."""
+
+import unittest
+
+from triton import ARCH, CPUSIZE, Instruction, MemoryAccess, TritonContext
+
+
+class TestX8664SyscallEmulator(unittest.TestCase):
+
+    """Testing the x86-64 Linux ABI."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.X86_64)
+        self.sys = self.Triton.newSyscallEmulator()
+
+    def syscall(self, number, *args):
+        """Emulate a syscall and return rax as a signed integer."""
+        regs = [self.Triton.registers.rdi, self.Triton.registers.rsi, self.Triton.registers.rdx,
+                self.Triton.registers.r10, self.Triton.registers.r8, self.Triton.registers.r9]
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.rax, number)
+        for reg, arg in zip(regs, args):
+            self.Triton.setConcreteRegisterValue(reg, arg & 0xffffffffffffffff)
+        self.sys.emulate()
+        ret = self.Triton.getConcreteRegisterValue(self.Triton.registers.rax)
+        return ret - (1 << 64) if ret >> 63 else ret
+
+    def test_is_syscall(self):
+        """Check the syscall detection."""
+        inst = Instruction(b"\x0f\x05")
+        self.Triton.processing(inst)
+        self.assertTrue(self.sys.isSyscall(inst))
+
+        inst = Instruction(b"\x90")
+        self.Triton.processing(inst)
+        self.assertFalse(self.sys.isSyscall(inst))
+
+    def test_write_stdout(self):
+        """write(1, buf, n) goes to /dev/stdout."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"hello\n")
+        self.assertEqual(self.syscall(1, 1, 0x1000, 6), 6)
+        self.assertEqual(self.syscall(1, 1, 0x1000, 6), 6)
+        self.assertEqual(self.sys.getFileContent("/dev/stdout"), b"hello\nhello\n")
+        self.assertEqual(self.syscall(1, 42, 0x1000, 6), -9)
+
+    def test_read_stdin_symbolized(self):
+        """read(0, buf, n) symbolizes and taints the bytes."""
+        self.sys.setStdin(b"abcd", True, True)
+        self.assertEqual(self.syscall(0, 0, 0x2000, 3), 3)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x2000, 3), b"abc")
+        self.assertTrue(self.Triton.isMemorySymbolized(0x2001))
+        self.assertTrue(self.Triton.isMemoryTainted(0x2002))
+        self.assertEqual(len(self.Triton.getSymbolicVariables()), 3)
+
+        self.assertEqual(self.syscall(0, 0, 0x2000, 3), 1)
+        self.assertEqual(self.syscall(0, 0, 0x2000, 3), 0)
+
+    def test_files(self):
+        """open/lseek/read/close on the virtual file system."""
+        self.sys.addFile("/etc/key", b"SECRET")
+        self.Triton.setConcreteMemoryAreaValue(0x3000, b"/etc/key\x00")
+        self.Triton.setConcreteMemoryAreaValue(0x3100, b"/tmp/out\x00")
+
+        fd = self.syscall(257, -100, 0x3000, 0)
+        self.assertEqual(fd, 3)
+        self.assertEqual(self.syscall(8, fd, 2, 0), 2)
+        self.assertEqual(self.syscall(0, fd, 0x4000, 16), 4)
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x4000, 4), b"CRET")
+        self.assertFalse(self.Triton.isMemorySymbolized(0x4000))
+
+        self.assertEqual(self.syscall(5, fd, 0x5000), 0)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(MemoryAccess(0x5000 + 48, CPUSIZE.QWORD)), 6)
+        self.assertEqual(self.syscall(3, fd), 0)
+        self.assertEqual(self.syscall(3, fd), -9)
+
+        self.assertEqual(self.syscall(2, 0x3100, 0), -2)
+        fd = self.syscall(2, 0x3100, 0x41)
+        self.assertEqual(self.syscall(1, fd, 0x3000, 4), 4)
+        self.assertEqual(self.sys.getFileContent("/tmp/out"), b"/etc")
+
+    def test_heap(self):
+        """brk and anonymous mmap."""
+        self.assertEqual(self.syscall(12, 0), 0)
+        self.sys.setBrk(0x601000)
+        self.assertEqual(self.syscall(12, 0), 0x601000)
+        self.assertEqual(self.syscall(12, 0x622000), 0x622000)
+        self.assertEqual(self.sys.getBrk(), 0x622000)
+
+        self.sys.setMmapBase(0x7f0000000000)
+        self.assertEqual(self.syscall(9, 0, 0x1234, 3, 0x22, -1, 0), 0x7f0000000000)
+        self.assertEqual(self.syscall(9, 0, 0x10, 3, 0x22, -1, 0), 0x7f0000002000)
+
+    def test_misc(self):
+        """arch_prctl, unsupported syscalls and exit."""
+        self.assertEqual(self.syscall(158, 0x1002, 0x7000), 0)
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.fs), 0x7000)
+        self.assertEqual(self.syscall(999), -38)
+
+        self.assertFalse(self.sys.hasExited())
+        self.syscall(231, 0x42)
+        self.assertTrue(self.sys.hasExited())
+        self.assertEqual(self.sys.getExitCode(), 0x42)
+
+
+class TestAArch64SyscallEmulator(unittest.TestCase):
+
+    """Testing the AArch64 Linux ABI."""
+
+    def setUp(self):
+        """Define the arch."""
+        self.Triton = TritonContext()
+        self.Triton.setArchitecture(ARCH.AARCH64)
+        self.sys = self.Triton.newSyscallEmulator()
+
+    def test_write_exit(self):
+        """write(1, buf, n) then exit(3) through svc #0."""
+        self.Triton.setConcreteMemoryAreaValue(0x1000, b"hi")
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.x8, 64)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.x0, 1)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.x1, 0x1000)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.x2, 2)
+
+        inst = Instruction(b"\x01\x00\x00\xd4") # svc #0
+        self.Triton.processing(inst)
+        self.assertTrue(self.sys.isSyscall(inst))
+        self.assertTrue(self.sys.emulate())
+        self.assertEqual(self.Triton.getConcreteRegisterValue(self.Triton.registers.x0), 2)
+        self.assertEqual(self.sys.getFileContent("/dev/stdout"), b"hi")
+
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.x8, 93)
+        self.Triton.setConcreteRegisterValue(self.Triton.registers.x0, 3)
+        self.sys.emulate()
+        self.assertTrue(self.sys.hasExited())
+        self.assertEqual(self.sys.getExitCode(), 3)